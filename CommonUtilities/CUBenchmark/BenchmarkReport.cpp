@@ -0,0 +1,374 @@
+#include "BenchmarkReport.hpp"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cout << "Usage: CUBenchmark [options]\n"
+			"  --count N        elements per benchmark (default: each benchmark's own)\n"
+			"  --repeats N      runs per measurement, the fastest is kept (default 10)\n"
+			"  --filter TEXT    only run benchmark groups whose name contains TEXT\n"
+			"  --json FILE      write the results as JSON\n"
+			"  --compare FILE   compare against a JSON baseline, exit code 1 on regressions\n"
+			"  --tolerance F    allowed ns/op slowdown in compare mode (default 0.10 = 10%)" << std::endl;
+	}
+
+	std::string EscapeJson(const std::string& aText)
+	{
+		std::string escaped;
+		for (const char character : aText)
+		{
+			if (character == '"' || character == '\\')
+			{
+				escaped += '\\';
+			}
+			escaped += character;
+		}
+		return escaped;
+	}
+
+	// Just enough JSON for the files WriteJson produces: objects, arrays, strings and numbers
+	class JsonScanner
+	{
+	public:
+		explicit JsonScanner(const std::string& aText) : myText(aText), myPosition(0) {}
+
+		bool Expect(const char aCharacter)
+		{
+			SkipWhitespace();
+			if (myPosition < myText.size() && myText[myPosition] == aCharacter)
+			{
+				++myPosition;
+				return true;
+			}
+			return false;
+		}
+
+		bool ReadString(std::string& aString)
+		{
+			if (!Expect('"'))
+			{
+				return false;
+			}
+			aString.clear();
+			while (myPosition < myText.size() && myText[myPosition] != '"')
+			{
+				if (myText[myPosition] == '\\' && myPosition + 1 < myText.size())
+				{
+					++myPosition;
+				}
+				aString += myText[myPosition++];
+			}
+			return Expect('"');
+		}
+
+		bool ReadNumber(double& aNumber)
+		{
+			SkipWhitespace();
+			const char* start = myText.c_str() + myPosition;
+			char* end = nullptr;
+			aNumber = std::strtod(start, &end);
+			if (end == start)
+			{
+				return false;
+			}
+			myPosition += end - start;
+			return true;
+		}
+
+		// Skips a value of any type that the caller doesn't need
+		bool SkipValue()
+		{
+			SkipWhitespace();
+			if (myPosition >= myText.size())
+			{
+				return false;
+			}
+			const char character = myText[myPosition];
+			if (character == '"')
+			{
+				std::string ignored;
+				return ReadString(ignored);
+			}
+			if (character == '{' || character == '[')
+			{
+				const char closing = character == '{' ? '}' : ']';
+				++myPosition;
+				while (!Expect(closing))
+				{
+					if (character == '{')
+					{
+						std::string ignored;
+						if (!ReadString(ignored) || !Expect(':'))
+						{
+							return false;
+						}
+					}
+					if (!SkipValue())
+					{
+						return false;
+					}
+					Expect(',');
+				}
+				return true;
+			}
+			double ignored;
+			return ReadNumber(ignored);
+		}
+
+	private:
+		void SkipWhitespace()
+		{
+			while (myPosition < myText.size() && isspace(static_cast<unsigned char>(myText[myPosition])))
+			{
+				++myPosition;
+			}
+		}
+
+		const std::string& myText;
+		size_t myPosition;
+	};
+
+	bool ReadResult(JsonScanner& aScanner, CUBenchmark::BenchmarkResult& aResult)
+	{
+		if (!aScanner.Expect('{'))
+		{
+			return false;
+		}
+		aResult = CUBenchmark::BenchmarkResult{ "", 0, 0.0 };
+		while (!aScanner.Expect('}'))
+		{
+			std::string key;
+			if (!aScanner.ReadString(key) || !aScanner.Expect(':'))
+			{
+				return false;
+			}
+
+			double number = 0.0;
+			if (key == "name")
+			{
+				if (!aScanner.ReadString(aResult.myName))
+				{
+					return false;
+				}
+			}
+			else if (key == "count" || key == "milliseconds")
+			{
+				if (!aScanner.ReadNumber(number))
+				{
+					return false;
+				}
+				if (key == "count")
+				{
+					aResult.myCount = static_cast<int>(number);
+				}
+				else
+				{
+					aResult.myMilliseconds = number;
+				}
+			}
+			else if (!aScanner.SkipValue())
+			{
+				return false;
+			}
+			aScanner.Expect(',');
+		}
+		return true;
+	}
+}
+
+namespace CUBenchmark
+{
+	double BenchmarkResult::GetNanosecondsPerOp() const
+	{
+		return myCount > 0 ? myMilliseconds * 1000000.0 / myCount : 0.0;
+	}
+
+	double BenchmarkResult::GetOpsPerSecond() const
+	{
+		return myMilliseconds > 0.0 ? myCount * 1000.0 / myMilliseconds : 0.0;
+	}
+
+	bool ParseOptions(const int anArgumentCount, const char* const anArguments[], BenchmarkOptions& anOptions)
+	{
+		for (int index = 1; index < anArgumentCount; ++index)
+		{
+			const std::string argument = anArguments[index];
+			const bool hasValue = index + 1 < anArgumentCount;
+			if (argument == "--count" && hasValue)
+			{
+				anOptions.myCount = std::atoi(anArguments[++index]);
+			}
+			else if (argument == "--repeats" && hasValue)
+			{
+				anOptions.myRepeats = std::atoi(anArguments[++index]);
+			}
+			else if (argument == "--filter" && hasValue)
+			{
+				anOptions.myFilter = anArguments[++index];
+			}
+			else if (argument == "--json" && hasValue)
+			{
+				anOptions.myJsonPath = anArguments[++index];
+			}
+			else if (argument == "--compare" && hasValue)
+			{
+				anOptions.myBaselinePath = anArguments[++index];
+			}
+			else if (argument == "--tolerance" && hasValue)
+			{
+				anOptions.myTolerance = std::atof(anArguments[++index]);
+			}
+			else
+			{
+				PrintUsage();
+				return false;
+			}
+		}
+
+		if (anOptions.myCount < 0 || anOptions.myRepeats <= 0 || anOptions.myTolerance < 0.0)
+		{
+			PrintUsage();
+			return false;
+		}
+		return true;
+	}
+
+	void BenchmarkReport::Add(const std::string& aName, const double aMilliseconds, const int aCount)
+	{
+		myResults.push_back(BenchmarkResult{ aName, aCount, aMilliseconds });
+		const BenchmarkResult& result = myResults.back();
+		std::cout << aName << ": " << aMilliseconds << " ms, " << result.GetNanosecondsPerOp() << " ns/op, "
+			<< result.GetOpsPerSecond() / 1000000.0 << " Mops/s" << std::endl;
+	}
+
+	const std::vector<BenchmarkResult>& BenchmarkReport::GetResults() const
+	{
+		return myResults;
+	}
+
+	bool BenchmarkReport::WriteJson(const std::string& aPath, const std::string& aSimdLevel) const
+	{
+		std::ofstream file(aPath);
+		if (!file)
+		{
+			return false;
+		}
+
+		file << std::setprecision(9);
+		file << "{\n\t\"simdLevel\": \"" << EscapeJson(aSimdLevel) << "\",\n\t\"results\": [";
+		for (size_t index = 0; index < myResults.size(); ++index)
+		{
+			const BenchmarkResult& result = myResults[index];
+			file << (index == 0 ? "\n" : ",\n");
+			file << "\t\t{ \"name\": \"" << EscapeJson(result.myName) << "\", \"count\": " << result.myCount
+				<< ", \"milliseconds\": " << result.myMilliseconds << ", \"nsPerOp\": " << result.GetNanosecondsPerOp()
+				<< ", \"opsPerSecond\": " << result.GetOpsPerSecond() << " }";
+		}
+		file << "\n\t]\n}\n";
+		return static_cast<bool>(file);
+	}
+
+	int BenchmarkReport::Compare(const std::string& aBaselinePath, const double aTolerance) const
+	{
+		std::vector<BenchmarkResult> baseline;
+		if (!ReadJson(aBaselinePath, baseline))
+		{
+			std::cout << "Can't read baseline " << aBaselinePath << std::endl;
+			return -1;
+		}
+
+		int regressions = 0;
+		std::cout << "\nCompared with " << aBaselinePath << " (tolerance " << aTolerance * 100.0 << "%):" << std::endl;
+		for (const BenchmarkResult& result : myResults)
+		{
+			const BenchmarkResult* previous = nullptr;
+			for (const BenchmarkResult& candidate : baseline)
+			{
+				if (candidate.myName == result.myName)
+				{
+					previous = &candidate;
+				}
+			}
+
+			if (previous == nullptr || previous->GetNanosecondsPerOp() <= 0.0)
+			{
+				std::cout << "  new         " << result.myName << std::endl;
+				continue;
+			}
+
+			const double ratio = result.GetNanosecondsPerOp() / previous->GetNanosecondsPerOp();
+			const bool regressed = ratio > 1.0 + aTolerance;
+			regressions += regressed ? 1 : 0;
+
+			char change[32];
+			std::snprintf(change, sizeof(change), "%+7.1f%%", (ratio - 1.0) * 100.0);
+			std::cout << (regressed ? "  REGRESSION " : "  ok         ") << change << "  " << result.myName << " ("
+				<< previous->GetNanosecondsPerOp() << " -> " << result.GetNanosecondsPerOp() << " ns/op)" << std::endl;
+		}
+
+		std::cout << regressions << " regression(s)" << std::endl;
+		return regressions;
+	}
+
+	bool BenchmarkReport::ReadJson(const std::string& aPath, std::vector<BenchmarkResult>& aResults)
+	{
+		std::ifstream file(aPath);
+		if (!file)
+		{
+			return false;
+		}
+		std::stringstream contents;
+		contents << file.rdbuf();
+		const std::string text = contents.str();
+
+		aResults.clear();
+		JsonScanner scanner(text);
+		if (!scanner.Expect('{'))
+		{
+			return false;
+		}
+		while (!scanner.Expect('}'))
+		{
+			std::string key;
+			if (!scanner.ReadString(key) || !scanner.Expect(':'))
+			{
+				return false;
+			}
+
+			if (key != "results")
+			{
+				if (!scanner.SkipValue())
+				{
+					return false;
+				}
+			}
+			else
+			{
+				if (!scanner.Expect('['))
+				{
+					return false;
+				}
+				while (!scanner.Expect(']'))
+				{
+					BenchmarkResult result;
+					if (!ReadResult(scanner, result))
+					{
+						return false;
+					}
+					aResults.push_back(result);
+					scanner.Expect(',');
+				}
+			}
+			scanner.Expect(',');
+		}
+		return true;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace CUBenchmark
+{
+	struct BenchmarkResult
+	{
+		std::string myName;
+		int myCount;
+		double myMilliseconds;
+
+		double GetNanosecondsPerOp() const;
+		double GetOpsPerSecond() const;
+	};
+
+	struct BenchmarkOptions
+	{
+		// 0 keeps every benchmark's own element count
+		int myCount = 0;
+		int myRepeats = 10;
+		std::string myFilter;
+		std::string myJsonPath;
+		std::string myBaselinePath;
+		// Relative slowdown in ns/op that counts as a regression in compare mode
+		double myTolerance = 0.10;
+	};
+
+	// Returns false and prints the usage on unknown or malformed arguments
+	bool ParseOptions(const int anArgumentCount, const char* const anArguments[], BenchmarkOptions& anOptions);
+
+	// Collects results, prints them as they come in, and writes or compares them as JSON:
+	// { "simdLevel": "avx2", "results": [ { "name": "...", "count": 1000, "milliseconds": 1.5,
+	//   "nsPerOp": 1.5, "opsPerSecond": 666666666 }, ... ] }
+	class BenchmarkReport
+	{
+	public:
+		void Add(const std::string& aName, const double aMilliseconds, const int aCount);
+		const std::vector<BenchmarkResult>& GetResults() const;
+
+		bool WriteJson(const std::string& aPath, const std::string& aSimdLevel) const;
+
+		// Prints every result next to the baseline one of the same name and returns how many got
+		// slower than aTolerance allows, or -1 if the baseline can't be read
+		int Compare(const std::string& aBaselinePath, const double aTolerance) const;
+
+		static bool ReadJson(const std::string& aPath, std::vector<BenchmarkResult>& aResults);
+
+	private:
+		std::vector<BenchmarkResult> myResults;
+	};
+}
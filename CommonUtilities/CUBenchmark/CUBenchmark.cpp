@@ -0,0 +1,1733 @@
+// CUBenchmark.cpp : Measures the hot paths of CommonUtilities. Run in Release.
+// CUBenchmark --help lists the options: element counts, JSON output and comparison against a baseline.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "BenchmarkReport.hpp"
+#include "BVH.hpp"
+#include "DaryHeap.hpp"
+#include "DynamicAABBTree.hpp"
+#include "DynamicBitset.hpp"
+#include "FlatHashMap.hpp"
+#include "FrameArena.hpp"
+#include "GrowingArray.hpp"
+#include "IndexedHeap.hpp"
+#include "Intersection.hpp"
+#include "LineVolume.hpp"
+#include "Matrix3x3.hpp"
+#include "MpmcRing.hpp"
+#include "ObjectPool.hpp"
+#include "PlaneVolume.hpp"
+#include "SimdLevel.hpp"
+#include "SpscRing.hpp"
+#include "StaticArray.hpp"
+#include "Timer.hpp"
+#include "TransformBatch.hpp"
+#include "VectorOnStack.hpp"
+#include "Vector2.hpp"
+#include "Vector3Stream.hpp"
+
+#define CU CommonUtilities
+
+namespace
+{
+	CUBenchmark::BenchmarkOptions ourOptions;
+	CUBenchmark::BenchmarkReport ourReport;
+
+	// Results are written here so the measured loops can't be optimized away
+	volatile float ourSink;
+
+	// Runs aFunction ourOptions.myRepeats times and returns the fastest run in milliseconds
+	template<class Function>
+	double MeasureBestOf(Function aFunction)
+	{
+		double best = 1e30;
+		for (int repeat = 0; repeat < ourOptions.myRepeats; ++repeat)
+		{
+			const auto start = std::chrono::high_resolution_clock::now();
+			aFunction();
+			const auto end = std::chrono::high_resolution_clock::now();
+			const double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+			best = milliseconds < best ? milliseconds : best;
+		}
+		return best;
+	}
+
+	void Report(const char* aName, const double aMilliseconds, const int aCount)
+	{
+		ourReport.Add(aName, aMilliseconds, aCount);
+	}
+
+	void BenchmarkTransformPoints(const int aCount)
+	{
+		std::vector<CU::Vector3<float>> points(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			points[index] = CU::Vector3<float>(index * 0.001f, 1.f - index * 0.002f, index * 0.0005f);
+		}
+		std::vector<CU::Vector3<float>> transformed(aCount);
+
+		CU::Matrix4x4<float> transform = CU::Matrix4x4<float>::CreateRotationAroundY(0.3f) * CU::Matrix4x4<float>::CreateRotationAroundZ(1.2f);
+		transform(4, 1) = 5.f;
+		transform(4, 2) = -2.f;
+		transform(4, 3) = 1.f;
+
+		const double scalarLoopTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				const CU::Vector4<float> result = CU::operator*<float>(CU::Vector4<float>(points[index].x, points[index].y, points[index].z, 1.f), transform);
+				transformed[index] = CU::Vector3<float>(result.x, result.y, result.z);
+			}
+		});
+
+		const double loopTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				const CU::Vector4<float> result = CU::Vector4<float>(points[index].x, points[index].y, points[index].z, 1.f) * transform;
+				transformed[index] = CU::Vector3<float>(result.x, result.y, result.z);
+			}
+		});
+
+		const double batchTime = MeasureBestOf([&]()
+		{
+			CU::TransformPoints(transform, points.data(), transformed.data(), aCount);
+		});
+
+		Report("TransformPoints generic template loop", scalarLoopTime, aCount);
+		Report("TransformPoints per-vector loop", loopTime, aCount);
+		Report("TransformPoints batch", batchTime, aCount);
+		std::cout << "TransformPoints speedup: " << loopTime / batchTime << "x over per-vector loop, "
+			<< scalarLoopTime / batchTime << "x over generic template loop" << std::endl;
+	}
+
+	void BenchmarkMatrixInverse(const int aCount)
+	{
+		std::vector<CU::Matrix4x4<float>> matrices(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			matrices[index] = CU::Matrix4x4<float>::CreateRotationAroundY(index * 0.001f) * CU::Matrix4x4<float>::CreateRotationAroundX(0.5f);
+			matrices[index](4, 1) = index * 0.01f;
+			matrices[index](4, 3) = -2.f;
+		}
+		std::vector<CU::Matrix4x4<float>> inverses(aCount);
+
+		const double genericTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				inverses[index] = CU::Matrix4x4<float>::Inverse(matrices[index]);
+			}
+		});
+
+		const double affineTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				inverses[index] = CU::Matrix4x4<float>::InverseAffine(matrices[index]);
+			}
+		});
+
+		const double fastTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				inverses[index] = CU::Matrix4x4<float>::FastInverse(matrices[index]);
+			}
+		});
+
+		const double batchTime = MeasureBestOf([&]()
+		{
+			CU::InverseMatrices(matrices.data(), inverses.data(), aCount);
+		});
+
+		Report("Inverse", genericTime, aCount);
+		Report("InverseAffine", affineTime, aCount);
+		Report("FastInverse", fastTime, aCount);
+		Report("InverseMatrices batch", batchTime, aCount);
+	}
+
+	void BenchmarkQuaternionToMatrix(const int aCount)
+	{
+		std::vector<CU::Quaternion<float>> rotations(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			rotations[index] = CU::Quaternion<float>(CU::Vector3<float>(index * 0.001f, 0.5f, -index * 0.002f));
+		}
+		std::vector<CU::Matrix4x4<float>> matrices(aCount);
+
+		const double loopTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				matrices[index] = rotations[index].GetRotationMatrix4x4();
+			}
+		});
+
+		const double batchTime = MeasureBestOf([&]()
+		{
+			CU::QuaternionsToMatrices(rotations.data(), matrices.data(), aCount);
+		});
+
+		const double slerpTime = MeasureBestOf([&]()
+		{
+			for (int index = 1; index < aCount; ++index)
+			{
+				rotations[index - 1] = CU::Quaternion<float>::Slerp(rotations[index - 1], rotations[index], 0.5f);
+			}
+		});
+
+		Report("GetRotationMatrix4x4 loop", loopTime, aCount);
+		Report("QuaternionsToMatrices batch", batchTime, aCount);
+		Report("Quaternion Slerp", slerpTime, aCount);
+	}
+
+	void BenchmarkCreateTRS(const int aCount)
+	{
+		CU::Vector3Stream<float> translations;
+		CU::Vector3Stream<float> angles;
+		CU::Vector3Stream<float> scales;
+		for (int index = 0; index < aCount; ++index)
+		{
+			translations.Add(CU::Vector3<float>(index * 0.01f, 2.f, -index * 0.02f));
+			angles.Add(CU::Vector3<float>(index * 0.001f, 0.5f - index * 0.002f, index * 0.003f));
+			scales.Add(CU::Vector3<float>(1.f, 2.f, 1.f + index * 0.0001f));
+		}
+		std::vector<CU::Matrix4x4<float>> matrices(aCount);
+
+		const double composedTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				const CU::Vector3<float> angle = angles.Get(index);
+				const CU::Vector3<float> scale = scales.Get(index);
+				CU::Matrix4x4<float> transform = CU::Matrix4x4<float>::CreateRotationAroundX(angle.x) *
+					CU::Matrix4x4<float>::CreateRotationAroundY(angle.y) * CU::Matrix4x4<float>::CreateRotationAroundZ(angle.z);
+				for (int column = 1; column <= 3; ++column)
+				{
+					transform(1, column) *= scale.x;
+					transform(2, column) *= scale.y;
+					transform(3, column) *= scale.z;
+				}
+				transform(4, 1) = translations.GetX()[index];
+				transform(4, 2) = translations.GetY()[index];
+				transform(4, 3) = translations.GetZ()[index];
+				matrices[index] = transform;
+			}
+		});
+
+		const double createTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				matrices[index] = CU::Matrix4x4<float>::CreateTRS(translations.Get(index), angles.Get(index), scales.Get(index));
+			}
+		});
+
+		const double batchTime = MeasureBestOf([&]()
+		{
+			CU::CreateTRSMatrices(translations, angles, scales, matrices.data());
+		});
+
+		Report("TRS from rotation matrix products", composedTime, aCount);
+		Report("CreateTRS", createTime, aCount);
+		Report("CreateTRSMatrices batch", batchTime, aCount);
+	}
+
+	void BenchmarkVectorExpressions(const int aCount)
+	{
+		std::vector<CU::Vector3<float>> positions(aCount);
+		std::vector<CU::Vector3<float>> velocities(aCount);
+		std::vector<CU::Vector3<float>> results(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			positions[index] = CU::Vector3<float>(index * 0.001f, 1.f - index * 0.002f, index * 0.0005f);
+			velocities[index] = CU::Vector3<float>(1.f, index * 0.003f, -2.f);
+		}
+		const CU::Vector3<float> gravity(0.f, -9.82f, 0.f);
+		const float deltaTime = 0.016f;
+
+		// Every operator materialized into its own vector, the way the operators used to work
+		const double temporariesTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				const CU::Vector3<float> scaled = CU::Vector3<float>(velocities[index] * deltaTime);
+				const CU::Vector3<float> moved = CU::Vector3<float>(positions[index] + scaled);
+				results[index] = CU::Vector3<float>(moved - gravity);
+			}
+		});
+
+		const double expressionTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				results[index] = positions[index] + velocities[index] * deltaTime - gravity;
+			}
+		});
+
+		const double compoundTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				results[index] += velocities[index] * deltaTime;
+			}
+		});
+
+		Report("a + b * s - c with temporaries", temporariesTime, aCount);
+		Report("a + b * s - c as one expression", expressionTime, aCount);
+		Report("a += b * s in place", compoundTime, aCount);
+	}
+
+	void BenchmarkVector3Stream(const int aCount)
+	{
+		std::vector<CU::Vector3<float>> vectors(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			vectors[index] = CU::Vector3<float>(index * 0.001f + 1.f, 1.f - index * 0.002f, index * 0.0005f);
+		}
+		std::vector<CU::Vector3<float>> normalized(aCount);
+		CU::Vector3Stream<float> stream(vectors);
+		CU::Vector3Stream<float> normalizedStream(aCount);
+		std::vector<float> lengths(aCount);
+
+		const double normalizeLoopTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				normalized[index] = vectors[index].GetNormalized();
+			}
+		});
+
+		const double normalizeStreamTime = MeasureBestOf([&]()
+		{
+			normalizedStream = stream;
+			normalizedStream.Normalize();
+		});
+
+		const double lengthLoopTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				lengths[index] = vectors[index].Length();
+			}
+		});
+
+		const double lengthStreamTime = MeasureBestOf([&]()
+		{
+			stream.Length(lengths.data());
+		});
+
+		const double conversionTime = MeasureBestOf([&]()
+		{
+			stream.Assign(vectors);
+			stream.CopyTo(normalized);
+		});
+
+		Report("Normalize Vector3 loop", normalizeLoopTime, aCount);
+		Report("Normalize Vector3Stream (copy + normalize)", normalizeStreamTime, aCount);
+		Report("Length Vector3 loop", lengthLoopTime, aCount);
+		Report("Length Vector3Stream", lengthStreamTime, aCount);
+		Report("Vector3Stream round trip conversion", conversionTime, aCount);
+		std::cout << "Vector3Stream speedup: " << normalizeLoopTime / normalizeStreamTime << "x normalize, "
+			<< lengthLoopTime / lengthStreamTime << "x length" << std::endl;
+	}
+
+	template<class Vector>
+	void BenchmarkVectorType(const char* aTypeName, const std::vector<Vector>& aFirst, const std::vector<Vector>& aSecond, std::vector<Vector>& aResults)
+	{
+		const int count = static_cast<int>(aFirst.size());
+		const std::string name = aTypeName;
+
+		const double addTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < count; ++index)
+			{
+				aResults[index] = aFirst[index] + aSecond[index] * 0.5f;
+			}
+		});
+
+		float dotSum = 0.f;
+		const double dotTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < count; ++index)
+			{
+				dotSum += aFirst[index].Dot(aSecond[index]);
+			}
+		});
+
+		float lengthSum = 0.f;
+		const double lengthTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < count; ++index)
+			{
+				lengthSum += aFirst[index].Length();
+			}
+		});
+
+		const double normalizeTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < count; ++index)
+			{
+				aResults[index] = aSecond[index].GetNormalized();
+			}
+		});
+		ourSink = dotSum + lengthSum;
+
+		Report((name + " a + b * s").c_str(), addTime, count);
+		Report((name + " Dot").c_str(), dotTime, count);
+		Report((name + " Length").c_str(), lengthTime, count);
+		Report((name + " GetNormalized").c_str(), normalizeTime, count);
+	}
+
+	void BenchmarkVectors(const int aCount)
+	{
+		std::vector<CU::Vector2<float>> first2(aCount), second2(aCount), results2(aCount);
+		std::vector<CU::Vector3<float>> first3(aCount), second3(aCount), results3(aCount);
+		std::vector<CU::Vector4<float>> first4(aCount), second4(aCount), results4(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			const float value = index * 0.001f;
+			first2[index] = CU::Vector2<float>(value, 1.f - value);
+			second2[index] = CU::Vector2<float>(2.f, value + 1.f);
+			first3[index] = CU::Vector3<float>(value, 1.f - value, 0.5f);
+			second3[index] = CU::Vector3<float>(2.f, value + 1.f, -value);
+			first4[index] = CU::Vector4<float>(value, 1.f - value, 0.5f, 1.f);
+			second4[index] = CU::Vector4<float>(2.f, value + 1.f, -value, 0.f);
+		}
+
+		BenchmarkVectorType("Vector2", first2, second2, results2);
+		BenchmarkVectorType("Vector3", first3, second3, results3);
+		BenchmarkVectorType("Vector4", first4, second4, results4);
+
+		const double crossTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				results3[index] = first3[index].Cross(second3[index]);
+			}
+		});
+		Report("Vector3 Cross", crossTime, aCount);
+	}
+
+	template<class Matrix>
+	void BenchmarkMatrixType(const char* aTypeName, const int aCount)
+	{
+		const std::string name = aTypeName;
+		std::vector<Matrix> matrices(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			matrices[index] = Matrix::CreateRotationAroundY(index * 0.001f) * Matrix::CreateRotationAroundX(0.5f);
+		}
+		std::vector<Matrix> results(aCount);
+		const Matrix rotation = Matrix::CreateRotationAroundZ(0.3f);
+
+		const double multiplyTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				results[index] = matrices[index] * rotation;
+			}
+		});
+
+		const double transposeTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				results[index] = Matrix::Transpose(matrices[index]);
+			}
+		});
+
+		const double rotationTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				results[index] = Matrix::CreateRotationAroundY(index * 0.001f);
+			}
+		});
+
+		Report((name + " multiply").c_str(), multiplyTime, aCount);
+		Report((name + " Transpose").c_str(), transposeTime, aCount);
+		Report((name + " CreateRotationAroundY").c_str(), rotationTime, aCount);
+	}
+
+	void BenchmarkMatrices(const int aCount)
+	{
+		BenchmarkMatrixType<CU::Matrix3x3<float>>("Matrix3x3", aCount);
+		BenchmarkMatrixType<CU::Matrix4x4<float>>("Matrix4x4", aCount);
+	}
+
+	void BenchmarkStaticArray(const int aCount)
+	{
+		const int arrayCount = aCount / 64 > 0 ? aCount / 64 : 1;
+		std::vector<CU::StaticArray<float, 64>> arrays(arrayCount);
+		std::vector<CU::StaticArray<float, 64>> copies(arrayCount);
+		for (CU::StaticArray<float, 64>& array : arrays)
+		{
+			for (int index = 0; index < 64; ++index)
+			{
+				array[index] = index * 0.5f;
+			}
+		}
+
+		const double insertTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < arrayCount; ++index)
+			{
+				arrays[index].Insert(index % 64, 1.f);
+			}
+		});
+
+		const double copyTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < arrayCount; ++index)
+			{
+				copies[index] = arrays[index];
+			}
+		});
+
+		float sum = 0.f;
+		const double indexTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < arrayCount; ++index)
+			{
+				const CU::StaticArray<float, 64>& array = arrays[index];
+				for (int element = 0; element < 64; ++element)
+				{
+					sum += array[element];
+				}
+			}
+		});
+		ourSink = sum + copies[arrayCount - 1][63];
+
+		Report("StaticArray<float, 64> Insert", insertTime, arrayCount);
+		Report("StaticArray<float, 64> copy", copyTime, arrayCount);
+		Report("StaticArray<float, 64> indexing", indexTime, arrayCount * 64);
+	}
+
+	struct Particle
+	{
+		CU::Vector3<float> myPosition;
+		CU::Vector3<float> myVelocity;
+		float myLifeTime;
+	};
+
+	// Spawns aCount particles, then kills one at a pseudo random index and spawns a new one aCount times
+	template<class Container, class Add, class RemoveCyclic>
+	double MeasureChurn(const int aCount, Container& aContainer, Add anAdd, RemoveCyclic aRemoveCyclic)
+	{
+		return MeasureBestOf([&]()
+		{
+			Container container;
+			for (int index = 0; index < aCount; ++index)
+			{
+				anAdd(container, Particle{ CU::Vector3<float>(index * 0.1f, 0.f, 0.f), CU::Vector3<float>(0.f, 1.f, 0.f), 1.f });
+			}
+			unsigned int random = 12345u;
+			for (int index = 0; index < aCount; ++index)
+			{
+				random = random * 1664525u + 1013904223u;
+				aRemoveCyclic(container, static_cast<int>(random % static_cast<unsigned int>(aCount)));
+				anAdd(container, Particle{ CU::Vector3<float>(0.f, index * 0.1f, 0.f), CU::Vector3<float>(1.f, 0.f, 0.f), 2.f });
+			}
+			aContainer = std::move(container);
+		});
+	}
+
+	void BenchmarkGrowingArray(const int aCount)
+	{
+		std::vector<Particle> vector;
+		const double vectorTime = MeasureChurn(aCount, vector, [](std::vector<Particle>& aVector, const Particle& aParticle)
+		{
+			aVector.push_back(aParticle);
+		}, [](std::vector<Particle>& aVector, const int anIndex)
+		{
+			aVector[anIndex] = aVector.back();
+			aVector.pop_back();
+		});
+
+		CU::GrowingArray<Particle> array;
+		const double arrayTime = MeasureChurn(aCount, array, [](CU::GrowingArray<Particle>& anArray, const Particle& aParticle)
+		{
+			anArray.Add(aParticle);
+		}, [](CU::GrowingArray<Particle>& anArray, const int anIndex)
+		{
+			anArray.RemoveCyclicAtIndex(anIndex);
+		});
+		ourSink = vector.back().myLifeTime + array.GetLast().myLifeTime;
+
+		Report("std::vector push/remove churn", vectorTime, aCount * 3);
+		Report("GrowingArray push/remove churn", arrayTime, aCount * 3);
+		std::cout << "GrowingArray speedup: " << vectorTime / arrayTime << "x" << std::endl;
+	}
+
+	// Allocates aCount particles, then replaces one at a pseudo random index aCount times and frees them all
+	template<class Create, class Destroy>
+	double MeasureAllocationChurn(const int aCount, Create aCreate, Destroy aDestroy)
+	{
+		std::vector<Particle*> particles(aCount);
+		return MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				particles[index] = aCreate(index);
+			}
+			unsigned int random = 12345u;
+			for (int index = 0; index < aCount; ++index)
+			{
+				random = random * 1664525u + 1013904223u;
+				Particle*& particle = particles[random % static_cast<unsigned int>(aCount)];
+				aDestroy(particle);
+				particle = aCreate(index);
+			}
+			for (Particle* particle : particles)
+			{
+				aDestroy(particle);
+			}
+		});
+	}
+
+	void BenchmarkObjectPool(const int aCount)
+	{
+		const double newTime = MeasureAllocationChurn(aCount, [](const int anIndex)
+		{
+			return new Particle{ CU::Vector3<float>(anIndex * 0.1f, 0.f, 0.f), CU::Vector3<float>(0.f, 1.f, 0.f), 1.f };
+		}, [](Particle* aParticle)
+		{
+			delete aParticle;
+		});
+
+		CU::ObjectPool<Particle> pool(1024);
+		const double poolTime = MeasureAllocationChurn(aCount, [&pool](const int anIndex)
+		{
+			return pool.Acquire(Particle{ CU::Vector3<float>(anIndex * 0.1f, 0.f, 0.f), CU::Vector3<float>(0.f, 1.f, 0.f), 1.f });
+		}, [&pool](Particle* aParticle)
+		{
+			pool.Release(aParticle);
+		});
+
+		Report("new/delete churn", newTime, aCount * 3);
+		Report("ObjectPool churn", poolTime, aCount * 3);
+		std::cout << "ObjectPool speedup: " << newTime / poolTime << "x" << std::endl;
+	}
+
+	// aCount short-lived std::vectors of 32 floats, a new frame every 1000 of them
+	template<class Allocator, class BeginFrame>
+	double MeasureTemporaries(const int aCount, const Allocator& anAllocator, BeginFrame aBeginFrame)
+	{
+		float sum = 0.f;
+		const double time = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				std::vector<float, Allocator> temporary(32, index * 0.5f, anAllocator);
+				sum += temporary[index % 32];
+				if (index % 1000 == 999)
+				{
+					aBeginFrame();
+				}
+			}
+		});
+		ourSink = sum;
+		return time;
+	}
+
+	void BenchmarkFrameArena(const int aCount)
+	{
+		const double heapTime = MeasureTemporaries(aCount, std::allocator<float>(), []()
+		{
+		});
+
+		CU::FrameArena arena(1024 * 1024);
+		const double arenaTime = MeasureTemporaries(aCount, CU::FrameAllocator<float>(arena), [&arena]()
+		{
+			arena.BeginFrame();
+		});
+
+		Report("std::vector temporaries on the heap", heapTime, aCount);
+		Report("std::vector temporaries on a FrameArena", arenaTime, aCount);
+		std::cout << "FrameArena speedup: " << heapTime / arenaTime << "x, high-water mark " << arena.GetPeakHighWaterMark() << " bytes" << std::endl;
+	}
+
+	// Heap allocations made through the counting allocators below
+	int ourAllocationCount;
+
+	template<class T>
+	struct CountingAllocator
+	{
+		typedef T value_type;
+
+		CountingAllocator() = default;
+		template<class U>
+		CountingAllocator(const CountingAllocator<U>&) {}
+
+		T* allocate(const size_t aCount)
+		{
+			++ourAllocationCount;
+			return std::allocator<T>().allocate(aCount);
+		}
+
+		void deallocate(T* aPointer, const size_t aCount)
+		{
+			std::allocator<T>().deallocate(aPointer, aCount);
+		}
+
+		template<class U>
+		bool operator==(const CountingAllocator<U>&) const { return true; }
+		template<class U>
+		bool operator!=(const CountingAllocator<U>&) const { return false; }
+	};
+
+	struct CountingAlignedAllocator
+	{
+		void* Allocate(const size_t aSize, const size_t anAlignment)
+		{
+			++ourAllocationCount;
+			return CU::AlignedAllocator().Allocate(aSize, anAlignment);
+		}
+
+		void Free(void* aMemory)
+		{
+			CU::AlignedAllocator().Free(aMemory);
+		}
+	};
+
+	// Builds aCount short-lived lists of up to 12 ints, with every 256th list holding 2000
+	template<class List, class Add>
+	double MeasureSmallLists(const int aCount, Add anAdd, int& aAllocationCount)
+	{
+		int sum = 0;
+		ourAllocationCount = 0;
+		const double time = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				const int length = index % 256 == 255 ? 2000 : index % 13;
+				List list;
+				for (int element = 0; element < length; ++element)
+				{
+					anAdd(list, element + index);
+				}
+				sum += length > 0 ? list[length - 1] : 0;
+			}
+		});
+		aAllocationCount = ourAllocationCount / ourOptions.myRepeats;
+		ourSink = static_cast<float>(sum);
+		return time;
+	}
+
+	void BenchmarkVectorOnStack(const int aCount)
+	{
+		int vectorAllocations;
+		const double vectorTime = MeasureSmallLists<std::vector<int, CountingAllocator<int>>>(aCount, [](std::vector<int, CountingAllocator<int>>& aList, const int aValue)
+		{
+			aList.push_back(aValue);
+		}, vectorAllocations);
+
+		int stackAllocations;
+		const double stackTime = MeasureSmallLists<CU::VectorOnStack<int, 16, CountingAlignedAllocator>>(aCount, [](CU::VectorOnStack<int, 16, CountingAlignedAllocator>& aList, const int aValue)
+		{
+			aList.Add(aValue);
+		}, stackAllocations);
+
+		Report("std::vector small lists", vectorTime, aCount);
+		Report("VectorOnStack<16> small lists", stackTime, aCount);
+		std::cout << "Heap allocations per run: std::vector " << vectorAllocations << ", VectorOnStack " << stackAllocations << std::endl;
+		std::cout << "VectorOnStack speedup: " << vectorTime / stackTime << "x" << std::endl;
+	}
+
+	void InsertKey(std::unordered_map<unsigned int, int>& aMap, const unsigned int aKey, const int aValue)
+	{
+		aMap.emplace(aKey, aValue);
+	}
+
+	void InsertKey(CU::FlatHashMap<unsigned int, int>& aMap, const unsigned int aKey, const int aValue)
+	{
+		aMap.Insert(aKey, aValue);
+	}
+
+	const int* FindKey(const std::unordered_map<unsigned int, int>& aMap, const unsigned int aKey)
+	{
+		const auto found = aMap.find(aKey);
+		return found != aMap.end() ? &found->second : nullptr;
+	}
+
+	const int* FindKey(const CU::FlatHashMap<unsigned int, int>& aMap, const unsigned int aKey)
+	{
+		return aMap.Find(aKey);
+	}
+
+	// Inserts aSize keys into an empty map, then looks each of them up and looks up aSize keys that aren't there
+	template<class Map>
+	void MeasureMap(const char* aMapName, const int aSize, double& anInsertTime, double& aHitTime, double& aMissTime)
+	{
+		std::vector<unsigned int> keys(aSize);
+		for (int index = 0; index < aSize; ++index)
+		{
+			// Distinct keys spread over the whole range
+			keys[index] = static_cast<unsigned int>(index) * 2654435761u;
+		}
+		// Looked up in another order than inserted, so std::unordered_map doesn't walk its nodes in allocation order
+		std::vector<unsigned int> lookups(keys);
+		std::shuffle(lookups.begin(), lookups.end(), std::mt19937(12345u));
+
+		Map map;
+		anInsertTime = MeasureBestOf([&]()
+		{
+			Map fresh;
+			for (int index = 0; index < aSize; ++index)
+			{
+				InsertKey(fresh, keys[index], index);
+			}
+			map = std::move(fresh);
+		});
+
+		int sum = 0;
+		aHitTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aSize; ++index)
+			{
+				sum += *FindKey(map, lookups[index]);
+			}
+		});
+
+		int misses = 0;
+		aMissTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aSize; ++index)
+			{
+				misses += FindKey(map, lookups[index] + 1u) == nullptr ? 1 : 0;
+			}
+		});
+		ourSink = static_cast<float>(sum + misses);
+
+		const std::string name = std::string(aMapName) + " " + std::to_string(aSize) + " ";
+		Report((name + "insert").c_str(), anInsertTime, aSize);
+		Report((name + "hit").c_str(), aHitTime, aSize);
+		Report((name + "miss").c_str(), aMissTime, aSize);
+	}
+
+	// Sizes from 1K up to aCount (10M by default), ten times apart
+	void BenchmarkFlatHashMap(const int aCount)
+	{
+		for (int size = 1000; size <= aCount; size *= 10)
+		{
+			double stdInsert, stdHit, stdMiss;
+			MeasureMap<std::unordered_map<unsigned int, int>>("std::unordered_map", size, stdInsert, stdHit, stdMiss);
+			double flatInsert, flatHit, flatMiss;
+			MeasureMap<CU::FlatHashMap<unsigned int, int>>("FlatHashMap", size, flatInsert, flatHit, flatMiss);
+			std::cout << "FlatHashMap speedup at " << size << ": insert " << stdInsert / flatInsert << "x, hit " << stdHit / flatHit << "x, miss " << stdMiss / flatMiss << "x" << std::endl;
+		}
+	}
+
+	// Culling masks of aCount objects: about a third visible, seven in eight enabled. Each variant
+	// combines the two masks, counts the result and sums the indices of the objects left.
+	void BenchmarkBitsets(const int aCount)
+	{
+		std::vector<bool> visibleVector(aCount);
+		std::vector<bool> enabledVector(aCount);
+		std::vector<bool> combinedVector(aCount);
+		std::vector<unsigned char> visibleBytes(aCount);
+		std::vector<unsigned char> enabledBytes(aCount);
+		std::vector<unsigned char> combinedBytes(aCount);
+		CU::DynamicBitset<> visibleBits(aCount);
+		CU::DynamicBitset<> enabledBits(aCount);
+		CU::DynamicBitset<> combinedBits(aCount);
+		unsigned int random = 1u;
+		for (int index = 0; index < aCount; ++index)
+		{
+			random = random * 1664525u + 1013904223u;
+			const bool visible = random % 3 == 0;
+			const bool enabled = (random >> 8 & 7) != 0;
+			visibleVector[index] = visible;
+			enabledVector[index] = enabled;
+			visibleBytes[index] = visible ? 1 : 0;
+			enabledBytes[index] = enabled ? 1 : 0;
+			visibleBits.Set(index, visible);
+			enabledBits.Set(index, enabled);
+		}
+
+		long long sum = 0;
+		const double vectorTime = MeasureBestOf([&]()
+		{
+			int count = 0;
+			for (int index = 0; index < aCount; ++index)
+			{
+				combinedVector[index] = visibleVector[index] && enabledVector[index];
+				count += combinedVector[index] ? 1 : 0;
+			}
+			for (int index = 0; index < aCount; ++index)
+			{
+				sum += combinedVector[index] ? index : 0;
+			}
+			sum += count;
+		});
+
+		const double bytesTime = MeasureBestOf([&]()
+		{
+			int count = 0;
+			for (int index = 0; index < aCount; ++index)
+			{
+				combinedBytes[index] = visibleBytes[index] & enabledBytes[index];
+				count += combinedBytes[index];
+			}
+			for (int index = 0; index < aCount; ++index)
+			{
+				sum += combinedBytes[index] != 0 ? index : 0;
+			}
+			sum += count;
+		});
+
+		const double bitsTime = MeasureBestOf([&]()
+		{
+			combinedBits = visibleBits;
+			combinedBits &= enabledBits;
+			const int count = combinedBits.PopCount();
+			for (const int index : combinedBits.GetSetBits())
+			{
+				sum += index;
+			}
+			sum += count;
+		});
+		ourSink = static_cast<float>(sum);
+
+		Report("std::vector<bool> and/count/iterate", vectorTime, aCount);
+		Report("bool array and/count/iterate", bytesTime, aCount);
+		Report("DynamicBitset and/count/iterate", bitsTime, aCount);
+		std::cout << "DynamicBitset speedup: " << vectorTime / bitsTime << "x over std::vector<bool>, " << bytesTime / bitsTime << "x over bool array, "
+			<< aCount / 8 << " bytes per mask instead of " << aCount << std::endl;
+	}
+
+	// A 256x256 grid where each cell costs 1 to 9 to enter and about one in five is a wall
+	struct PathGrid
+	{
+		static const int ourSize = 256;
+		std::vector<unsigned char> myCosts;
+	};
+
+	struct OpenNode
+	{
+		int myEstimate;
+		int myCell;
+
+		bool operator<(const OpenNode& aNode) const { return myEstimate < aNode.myEstimate; }
+		bool operator>(const OpenNode& aNode) const { return myEstimate > aNode.myEstimate; }
+	};
+
+	int GetHeuristic(const int aCell, const int aGoal)
+	{
+		const int dx = aCell % PathGrid::ourSize - aGoal % PathGrid::ourSize;
+		const int dy = aCell / PathGrid::ourSize - aGoal / PathGrid::ourSize;
+		return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+	}
+
+	// Calls aVisit(neighbour, cost to enter it) for the open neighbours of aCell
+	template<class Visit>
+	void ForEachNeighbour(const PathGrid& aGrid, const int aCell, Visit aVisit)
+	{
+		const int x = aCell % PathGrid::ourSize;
+		const int y = aCell / PathGrid::ourSize;
+		const int neighbours[4] = { x > 0 ? aCell - 1 : -1, x < PathGrid::ourSize - 1 ? aCell + 1 : -1, y > 0 ? aCell - PathGrid::ourSize : -1, y < PathGrid::ourSize - 1 ? aCell + PathGrid::ourSize : -1 };
+		for (const int neighbour : neighbours)
+		{
+			if (neighbour >= 0 && aGrid.myCosts[neighbour] != 0)
+			{
+				aVisit(neighbour, aGrid.myCosts[neighbour]);
+			}
+		}
+	}
+
+	// A* that pushes a cell again whenever its cost improves and skips the stale copies on pop,
+	// the only option with std::priority_queue. Returns the path cost; aPeakCount is the largest heap.
+	template<class Heap, class PushNode, class PopNode>
+	int FindPathWithDuplicates(const PathGrid& aGrid, const int aStart, const int aGoal, Heap& aHeap, PushNode aPush, PopNode aPop, std::vector<int>& someCosts, int& aPeakCount)
+	{
+		std::fill(someCosts.begin(), someCosts.end(), INT_MAX);
+		someCosts[aStart] = 0;
+		aPush(aHeap, OpenNode{ GetHeuristic(aStart, aGoal), aStart });
+		while (!aHeap.empty())
+		{
+			aPeakCount = static_cast<int>(aHeap.size()) > aPeakCount ? static_cast<int>(aHeap.size()) : aPeakCount;
+			const OpenNode node = aPop(aHeap);
+			const int cost = someCosts[node.myCell];
+			if (node.myEstimate != cost + GetHeuristic(node.myCell, aGoal))
+			{
+				continue;
+			}
+			if (node.myCell == aGoal)
+			{
+				break;
+			}
+			ForEachNeighbour(aGrid, node.myCell, [&](const int aNeighbour, const int aCost)
+			{
+				if (cost + aCost < someCosts[aNeighbour])
+				{
+					someCosts[aNeighbour] = cost + aCost;
+					aPush(aHeap, OpenNode{ cost + aCost + GetHeuristic(aNeighbour, aGoal), aNeighbour });
+				}
+			});
+		}
+		while (!aHeap.empty())
+		{
+			aPop(aHeap);
+		}
+		return someCosts[aGoal];
+	}
+
+	// DaryHeap behind the std::priority_queue interface FindPathWithDuplicates uses
+	struct DaryOpenList
+	{
+		CU::DaryHeap<OpenNode, 4> myHeap;
+
+		bool empty() const { return myHeap.IsEmpty(); }
+		int size() const { return myHeap.Count(); }
+	};
+
+	// A* that keeps each cell in the heap once and lowers its estimate with DecreaseKey
+	int FindPathWithDecreaseKey(const PathGrid& aGrid, const int aStart, const int aGoal, CU::IndexedHeap<OpenNode, 4>& aHeap, std::vector<int>& someCosts, std::vector<int>& someHandles, int& aPeakCount)
+	{
+		std::fill(someCosts.begin(), someCosts.end(), INT_MAX);
+		std::fill(someHandles.begin(), someHandles.end(), -1);
+		someCosts[aStart] = 0;
+		someHandles[aStart] = aHeap.Push(OpenNode{ GetHeuristic(aStart, aGoal), aStart });
+		while (!aHeap.IsEmpty())
+		{
+			aPeakCount = aHeap.Count() > aPeakCount ? aHeap.Count() : aPeakCount;
+			const OpenNode node = aHeap.Pop();
+			someHandles[node.myCell] = -1;
+			if (node.myCell == aGoal)
+			{
+				break;
+			}
+			const int cost = someCosts[node.myCell];
+			ForEachNeighbour(aGrid, node.myCell, [&](const int aNeighbour, const int aCost)
+			{
+				if (cost + aCost < someCosts[aNeighbour])
+				{
+					someCosts[aNeighbour] = cost + aCost;
+					const OpenNode open{ cost + aCost + GetHeuristic(aNeighbour, aGoal), aNeighbour };
+					if (someHandles[aNeighbour] >= 0)
+					{
+						aHeap.DecreaseKey(someHandles[aNeighbour], open);
+					}
+					else
+					{
+						someHandles[aNeighbour] = aHeap.Push(open);
+					}
+				}
+			});
+		}
+		aHeap.Clear();
+		return someCosts[aGoal];
+	}
+
+	// aCount searches between random open cells of one grid, reported per search
+	void BenchmarkHeaps(const int aCount)
+	{
+		PathGrid grid;
+		grid.myCosts.resize(PathGrid::ourSize * PathGrid::ourSize);
+		unsigned int random = 99u;
+		for (unsigned char& cost : grid.myCosts)
+		{
+			random = random * 1664525u + 1013904223u;
+			cost = (random >> 24) % 5 == 0 ? 0 : static_cast<unsigned char>(1 + (random >> 16) % 9);
+		}
+		std::vector<int> starts(aCount);
+		std::vector<int> goals(aCount);
+		for (int search = 0; search < aCount; ++search)
+		{
+			do
+			{
+				random = random * 1664525u + 1013904223u;
+				starts[search] = static_cast<int>((random >> 8) % grid.myCosts.size());
+				random = random * 1664525u + 1013904223u;
+				goals[search] = static_cast<int>((random >> 8) % grid.myCosts.size());
+			} while (grid.myCosts[starts[search]] == 0 || grid.myCosts[goals[search]] == 0);
+		}
+
+		std::vector<int> costs(grid.myCosts.size());
+		std::vector<int> handles(grid.myCosts.size());
+		long long total = 0;
+		int stdPeak = 0;
+		std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> stdHeap;
+		const double stdTime = MeasureBestOf([&]()
+		{
+			for (int search = 0; search < aCount; ++search)
+			{
+				total += FindPathWithDuplicates(grid, starts[search], goals[search], stdHeap, [](std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>>& aHeap, const OpenNode& aNode)
+				{
+					aHeap.push(aNode);
+				}, [](std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>>& aHeap)
+				{
+					const OpenNode top = aHeap.top();
+					aHeap.pop();
+					return top;
+				}, costs, stdPeak);
+			}
+		});
+
+		int daryPeak = 0;
+		DaryOpenList daryHeap;
+		const double daryTime = MeasureBestOf([&]()
+		{
+			for (int search = 0; search < aCount; ++search)
+			{
+				total += FindPathWithDuplicates(grid, starts[search], goals[search], daryHeap, [](DaryOpenList& aHeap, const OpenNode& aNode)
+				{
+					aHeap.myHeap.Push(aNode);
+				}, [](DaryOpenList& aHeap)
+				{
+					return aHeap.myHeap.Pop();
+				}, costs, daryPeak);
+			}
+		});
+
+		int indexedPeak = 0;
+		CU::IndexedHeap<OpenNode, 4> indexedHeap;
+		const double indexedTime = MeasureBestOf([&]()
+		{
+			for (int search = 0; search < aCount; ++search)
+			{
+				total += FindPathWithDecreaseKey(grid, starts[search], goals[search], indexedHeap, costs, handles, indexedPeak);
+			}
+		});
+		ourSink = static_cast<float>(total);
+
+		Report("A* std::priority_queue with duplicates", stdTime, aCount);
+		Report("A* DaryHeap<4> with duplicates", daryTime, aCount);
+		Report("A* IndexedHeap<4> with DecreaseKey", indexedTime, aCount);
+		std::cout << "Heap speedup: DaryHeap " << stdTime / daryTime << "x, IndexedHeap " << stdTime / indexedTime << "x; peak heap size "
+			<< stdPeak << " with duplicates, " << indexedPeak << " with DecreaseKey" << std::endl;
+	}
+
+	// aCount agents scattered over a map, tested against a view trapezoid of four lines
+	void BenchmarkLineVolume(const int aCount)
+	{
+		std::vector<CU::Vector2<float>> agents(aCount);
+		std::mt19937 random(21);
+		std::uniform_real_distribution<float> coordinate(-1000.f, 1000.f);
+		for (CU::Vector2<float>& agent : agents)
+		{
+			agent = CU::Vector2<float>(coordinate(random), coordinate(random));
+		}
+		const CU::Vector2<float> nearLeft(-100.f, -300.f);
+		const CU::Vector2<float> farLeft(-600.f, 600.f);
+		const CU::Vector2<float> farRight(600.f, 600.f);
+		const CU::Vector2<float> nearRight(100.f, -300.f);
+		const CU::LineVolume<float> view({ CU::Line<float>(nearLeft, farLeft), CU::Line<float>(farLeft, farRight), CU::Line<float>(farRight, nearRight), CU::Line<float>(nearRight, nearLeft) });
+
+		int loopInside = 0;
+		const double loopTime = MeasureBestOf([&]()
+		{
+			loopInside = 0;
+			for (const CU::Vector2<float>& agent : agents)
+			{
+				loopInside += view.Inside(agent) ? 1 : 0;
+			}
+		});
+
+		CU::DynamicBitset<> mask(aCount);
+		const double maskTime = MeasureBestOf([&]()
+		{
+			view.Inside(agents.data(), aCount, mask.GetWords());
+		});
+
+		CU::GrowingArray<int> indices;
+		indices.Reserve(aCount);
+		const double indexTime = MeasureBestOf([&]()
+		{
+			indices.RemoveAll();
+			view.Inside(agents.data(), aCount, indices);
+		});
+		ourSink = static_cast<float>(loopInside + mask.PopCount() + indices.Size());
+
+		Report("LineVolume::Inside per point", loopTime, aCount);
+		Report("LineVolume::Inside batch to bitmask", maskTime, aCount);
+		Report("LineVolume::Inside batch to index list", indexTime, aCount);
+		std::cout << "LineVolume speedup: " << loopTime / maskTime << "x bitmask, " << loopTime / indexTime << "x index list, "
+			<< indices.Size() << " of " << aCount << " inside" << std::endl;
+	}
+
+	// aCount objects around a camera at the origin, culled against its frustum as spheres and as boxes.
+	// The objects are stored cell by cell, as a scene grid would keep them. The cached runs reuse the plane
+	// cache of the previous run, like objects that didn't move since last frame.
+	void BenchmarkFrustumCulling(const int aCount)
+	{
+		const float depthScale = 1000.f / (1000.f - 0.1f);
+		const CU::Matrix4x4<float> projection(
+			1.f, 0.f, 0.f, 0.f,
+			0.f, 1.7777f, 0.f, 0.f,
+			0.f, 0.f, depthScale, 1.f,
+			0.f, 0.f, -0.1f * depthScale, 0.f);
+		const CU::PlaneVolume<float> frustum = CU::PlaneVolume<float>::CreateFrustum(CU::Matrix4x4<float>::CreateRotationAroundY(0.3f) * projection);
+
+		CU::Vector3Stream<float> centers(aCount);
+		CU::Vector3Stream<float> extents(aCount);
+		std::vector<float> radii(aCount);
+		std::mt19937 random(31);
+		std::uniform_real_distribution<float> coordinate(-1000.f, 1000.f);
+		std::uniform_real_distribution<float> size(0.5f, 10.f);
+		std::vector<CU::Vector3<float>> positions(aCount);
+		for (CU::Vector3<float>& position : positions)
+		{
+			position = CU::Vector3<float>(coordinate(random), coordinate(random) * 0.1f, coordinate(random));
+		}
+		auto getCell = [](const CU::Vector3<float>& aPosition)
+		{
+			return static_cast<int>((aPosition.z + 1000.f) / 50.f) * 64 + static_cast<int>((aPosition.x + 1000.f) / 50.f);
+		};
+		std::sort(positions.begin(), positions.end(), [&getCell](const CU::Vector3<float>& aLeft, const CU::Vector3<float>& aRight)
+		{
+			return getCell(aLeft) < getCell(aRight);
+		});
+		for (int index = 0; index < aCount; ++index)
+		{
+			centers.Set(index, positions[index]);
+			extents.Set(index, CU::Vector3<float>(size(random), size(random), size(random)));
+			radii[index] = size(random);
+		}
+
+		int loopVisible = 0;
+		const double loopTime = MeasureBestOf([&]()
+		{
+			loopVisible = 0;
+			for (int index = 0; index < aCount; ++index)
+			{
+				loopVisible += frustum.ClassifySphere(centers.Get(index), radii[index]) != CU::Containment::Outside ? 1 : 0;
+			}
+		});
+
+		CU::DynamicBitset<> visible(aCount);
+		CU::DynamicBitset<> inside(aCount);
+		const double sphereTime = MeasureBestOf([&]()
+		{
+			frustum.ClassifySpheres(centers, radii.data(), visible.GetWords(), inside.GetWords());
+		});
+
+		std::vector<unsigned char> sphereCache(CU::PlaneVolume<float>::GetPlaneCacheSize(aCount), 0);
+		frustum.ClassifySpheres(centers, radii.data(), visible.GetWords(), inside.GetWords(), sphereCache.data());
+		const double sphereCachedTime = MeasureBestOf([&]()
+		{
+			frustum.ClassifySpheres(centers, radii.data(), visible.GetWords(), inside.GetWords(), sphereCache.data());
+		});
+		const int sphereVisible = visible.PopCount();
+
+		const double boxTime = MeasureBestOf([&]()
+		{
+			frustum.ClassifyAABBs(centers, extents, visible.GetWords(), inside.GetWords());
+		});
+
+		std::vector<unsigned char> boxCache(CU::PlaneVolume<float>::GetPlaneCacheSize(aCount), 0);
+		frustum.ClassifyAABBs(centers, extents, visible.GetWords(), inside.GetWords(), boxCache.data());
+		const double boxCachedTime = MeasureBestOf([&]()
+		{
+			frustum.ClassifyAABBs(centers, extents, visible.GetWords(), inside.GetWords(), boxCache.data());
+		});
+		ourSink = static_cast<float>(loopVisible + sphereVisible + visible.PopCount());
+
+		Report("PlaneVolume::ClassifySphere per object", loopTime, aCount);
+		Report("PlaneVolume::ClassifySpheres batch", sphereTime, aCount);
+		Report("PlaneVolume::ClassifySpheres batch with plane cache", sphereCachedTime, aCount);
+		Report("PlaneVolume::ClassifyAABBs batch", boxTime, aCount);
+		Report("PlaneVolume::ClassifyAABBs batch with plane cache", boxCachedTime, aCount);
+		std::cout << "FrustumCulling speedup: " << loopTime / sphereTime << "x spheres, " << loopTime / sphereCachedTime << "x spheres with plane cache; "
+			<< sphereVisible << " of " << aCount << " spheres visible" << std::endl;
+	}
+
+	void BenchmarkIntersection(const int aCount)
+	{
+		std::mt19937 random(37);
+		std::uniform_real_distribution<float> coordinate(-100.f, 100.f);
+		std::uniform_real_distribution<float> size(0.5f, 10.f);
+		auto nextVector = [&](const float aScale) -> CU::Vector3<float>
+		{
+			const float x = coordinate(random);
+			const float y = coordinate(random);
+			return CU::Vector3<float>(x, y, coordinate(random)) * aScale;
+		};
+
+		// Ray packets: a camera's worth of rays against one box and one triangle
+		CU::Vector3Stream<float> origins(aCount);
+		CU::Vector3Stream<float> directions(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			origins.Set(index, nextVector(0.01f));
+			directions.Set(index, CU::Vector3<float>(coordinate(random) * 0.01f, coordinate(random) * 0.01f, 1.f));
+		}
+		const CU::AABB3D<float> aabb(CU::Vector3<float>(-20.f, -10.f, 40.f), CU::Vector3<float>(10.f, 30.f, 60.f));
+		const CU::Vector3<float> corner0(-40.f, -30.f, 50.f);
+		const CU::Vector3<float> corner1(50.f, -20.f, 60.f);
+		const CU::Vector3<float> corner2(0.f, 40.f, 45.f);
+
+		CU::DynamicBitset<> hits(aCount);
+		std::vector<float> distances(aCount);
+		int loopHits = 0;
+		const double aabbLoopTime = MeasureBestOf([&]()
+		{
+			float distance = 0.f;
+			for (int index = 0; index < aCount; ++index)
+			{
+				loopHits += CU::IntersectionAABBRay(aabb, CU::Ray<float>(origins.Get(index), directions.Get(index)), distance) ? 1 : 0;
+			}
+		});
+		const double aabbRaysTime = MeasureBestOf([&]()
+		{
+			CU::IntersectionAABBRays(aabb, origins, directions, distances.data(), hits.GetWords());
+		});
+		const int aabbRayHits = hits.PopCount();
+
+		const double triangleLoopTime = MeasureBestOf([&]()
+		{
+			float distance = 0.f;
+			for (int index = 0; index < aCount; ++index)
+			{
+				loopHits += CU::IntersectionTriangleRay(corner0, corner1, corner2, CU::Ray<float>(origins.Get(index), directions.Get(index)), distance) ? 1 : 0;
+			}
+		});
+		const double triangleRaysTime = MeasureBestOf([&]()
+		{
+			CU::IntersectionTriangleRays(corner0, corner1, corner2, origins, directions, distances.data(), hits.GetWords());
+		});
+		const int triangleRayHits = hits.PopCount();
+
+		// Shape packets: one ray against a scene's worth of boxes and triangles
+		CU::Vector3Stream<float> mins(aCount);
+		CU::Vector3Stream<float> maxs(aCount);
+		CU::Vector3Stream<float> corners0(aCount);
+		CU::Vector3Stream<float> corners1(aCount);
+		CU::Vector3Stream<float> corners2(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			const CU::Vector3<float> center = nextVector(1.f);
+			mins.Set(index, center);
+			maxs.Set(index, center + CU::Vector3<float>(size(random), size(random), size(random)));
+			corners0.Set(index, center);
+			corners1.Set(index, center + nextVector(0.1f));
+			corners2.Set(index, center + nextVector(0.1f));
+		}
+		const CU::Ray<float> ray(CU::Vector3<float>(-100.f, -90.f, -100.f), CU::Vector3<float>(1.f, 0.9f, 1.f));
+
+		const double aabbsLoopTime = MeasureBestOf([&]()
+		{
+			float distance = 0.f;
+			for (int index = 0; index < aCount; ++index)
+			{
+				loopHits += CU::IntersectionAABBRay(CU::AABB3D<float>(mins.Get(index), maxs.Get(index)), ray, distance) ? 1 : 0;
+			}
+		});
+		const double aabbsRayTime = MeasureBestOf([&]()
+		{
+			CU::IntersectionAABBsRay(mins, maxs, ray, distances.data(), hits.GetWords());
+		});
+
+		const double trianglesLoopTime = MeasureBestOf([&]()
+		{
+			float distance = 0.f;
+			for (int index = 0; index < aCount; ++index)
+			{
+				loopHits += CU::IntersectionTriangleRay(corners0.Get(index), corners1.Get(index), corners2.Get(index), ray, distance) ? 1 : 0;
+			}
+		});
+		const double trianglesRayTime = MeasureBestOf([&]()
+		{
+			CU::IntersectionTrianglesRay(corners0, corners1, corners2, ray, distances.data(), hits.GetWords());
+		});
+		ourSink = static_cast<float>(loopHits + aabbRayHits + triangleRayHits + hits.PopCount()) + distances[0];
+
+		Report("IntersectionAABBRay per ray", aabbLoopTime, aCount);
+		Report("IntersectionAABBRays packet", aabbRaysTime, aCount);
+		Report("IntersectionTriangleRay per ray", triangleLoopTime, aCount);
+		Report("IntersectionTriangleRays packet", triangleRaysTime, aCount);
+		Report("IntersectionAABBRay per box", aabbsLoopTime, aCount);
+		Report("IntersectionAABBsRay packet", aabbsRayTime, aCount);
+		Report("IntersectionTriangleRay per triangle", trianglesLoopTime, aCount);
+		Report("IntersectionTrianglesRay packet", trianglesRayTime, aCount);
+		std::cout << "Intersection speedup: " << aabbLoopTime / aabbRaysTime << "x box rays, " << triangleLoopTime / triangleRaysTime << "x triangle rays, "
+			<< aabbsLoopTime / aabbsRayTime << "x boxes, " << trianglesLoopTime / trianglesRayTime << "x triangles; "
+			<< aabbRayHits << " and " << triangleRayHits << " of " << aCount << " rays hit" << std::endl;
+	}
+
+	// aCount triangles of a rolling heightfield, like static level geometry
+	void BenchmarkBVH(const int aCount)
+	{
+		const int side = std::max(1, static_cast<int>(sqrt(aCount / 2.0)));
+		const int triangleCount = side * side * 2;
+		auto getHeight = [](const int aX, const int aZ)
+		{
+			return sinf(static_cast<float>(aX) * 0.05f) * 20.f + cosf(static_cast<float>(aZ) * 0.03f) * 15.f;
+		};
+		std::vector<CU::Vector3<float>> corners(triangleCount * 3);
+		std::vector<CU::AABB3D<float>> bounds(triangleCount);
+		for (int z = 0; z < side; ++z)
+		{
+			for (int x = 0; x < side; ++x)
+			{
+				const CU::Vector3<float> corner00(static_cast<float>(x), getHeight(x, z), static_cast<float>(z));
+				const CU::Vector3<float> corner10(static_cast<float>(x + 1), getHeight(x + 1, z), static_cast<float>(z));
+				const CU::Vector3<float> corner01(static_cast<float>(x), getHeight(x, z + 1), static_cast<float>(z + 1));
+				const CU::Vector3<float> corner11(static_cast<float>(x + 1), getHeight(x + 1, z + 1), static_cast<float>(z + 1));
+				const CU::Vector3<float> cellCorners[6] = { corner00, corner01, corner10, corner10, corner01, corner11 };
+				for (int triangle = 0; triangle < 2; ++triangle)
+				{
+					const int index = (z * side + x) * 2 + triangle;
+					CU::Vector3<float> min = cellCorners[triangle * 3];
+					CU::Vector3<float> max = min;
+					for (int corner = 0; corner < 3; ++corner)
+					{
+						const CU::Vector3<float>& position = cellCorners[triangle * 3 + corner];
+						corners[index * 3 + corner] = position;
+						for (int axis = 0; axis < 3; ++axis)
+						{
+							min[axis] = std::min(min[axis], position[axis]);
+							max[axis] = std::max(max[axis], position[axis]);
+						}
+					}
+					bounds[index] = CU::AABB3D<float>(min, max);
+				}
+			}
+		}
+
+		CU::BVH<float> bvh;
+		const double serialBuildTime = MeasureBestOf([&]()
+		{
+			bvh.Build(bounds.data(), triangleCount, 1);
+		});
+		const double parallelBuildTime = MeasureBestOf([&]()
+		{
+			bvh.Build(bounds.data(), triangleCount);
+		});
+
+		// Rays from above the terrain looking down at an angle, and small boxes around it
+		const int queryCount = 100000;
+		std::mt19937 random(41);
+		std::uniform_real_distribution<float> position(0.f, static_cast<float>(side));
+		std::uniform_real_distribution<float> slope(-0.5f, 0.5f);
+		std::vector<CU::Ray<float>> rays(queryCount);
+		std::vector<CU::AABB3D<float>> areas(queryCount);
+		for (int query = 0; query < queryCount; ++query)
+		{
+			rays[query] = CU::Ray<float>(CU::Vector3<float>(position(random), 60.f, position(random)), CU::Vector3<float>(slope(random), -1.f, slope(random)));
+			areas[query].InitWithCenterAndExtents(CU::Vector3<float>(position(random), 0.f, position(random)), CU::Vector3<float>(2.f, 40.f, 2.f));
+		}
+		auto testTriangle = [&corners](const int aTriangle, const CU::Ray<float>& aRay, float& aDistance)
+		{
+			return CU::IntersectionTriangleRay(corners[aTriangle * 3], corners[aTriangle * 3 + 1], corners[aTriangle * 3 + 2], aRay, aDistance);
+		};
+
+		int hitCount = 0;
+		const double nearestTime = MeasureBestOf([&]()
+		{
+			hitCount = 0;
+			for (const CU::Ray<float>& ray : rays)
+			{
+				int triangle = 0;
+				float distance = 0.f;
+				hitCount += bvh.FindNearest(ray, testTriangle, triangle, distance) ? 1 : 0;
+			}
+		});
+		CU::GrowingArray<int> found;
+		found.Reserve(1024);
+		int overlapCount = 0;
+		const double overlapTime = MeasureBestOf([&]()
+		{
+			overlapCount = 0;
+			for (const CU::AABB3D<float>& area : areas)
+			{
+				found.RemoveAll();
+				bvh.QueryOverlaps(area, found);
+				overlapCount += found.Size();
+			}
+		});
+		ourSink = static_cast<float>(hitCount + overlapCount);
+
+		Report("BVH::Build one thread, per triangle", serialBuildTime, triangleCount);
+		Report("BVH::Build all threads, per triangle", parallelBuildTime, triangleCount);
+		Report("BVH::FindNearest triangle", nearestTime, queryCount);
+		Report("BVH::QueryOverlaps", overlapTime, queryCount);
+		std::cout << "BVH: " << triangleCount << " triangles, " << bvh.GetNodeCount() << " nodes, built in " << serialBuildTime << " ms on one thread and "
+			<< parallelBuildTime << " ms on " << std::thread::hardware_concurrency() << "; " << hitCount << " of " << queryCount << " rays hit, "
+			<< static_cast<double>(overlapCount) / queryCount << " triangles per overlap query" << std::endl;
+	}
+
+	void BenchmarkDynamicAABBTree(const int aCount)
+	{
+		// Actors of about one unit walking around a square world with ten units of room each
+		const float worldSize = sqrtf(static_cast<float>(aCount) * 10.f);
+		std::mt19937 random(43);
+		std::uniform_real_distribution<float> position(0.f, worldSize);
+		std::uniform_real_distribution<float> velocity(-0.05f, 0.05f);
+		std::uniform_real_distribution<float> size(0.5f, 1.5f);
+		std::vector<CU::Vector2<float>> positions(aCount);
+		std::vector<CU::Vector2<float>> velocities(aCount);
+		std::vector<CU::Vector2<float>> sizes(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			positions[index] = CU::Vector2<float>(position(random), position(random));
+			velocities[index] = CU::Vector2<float>(velocity(random), velocity(random));
+			sizes[index] = CU::Vector2<float>(size(random), size(random));
+		}
+
+		CU::DynamicAABBTree<CU::Vector2<float>> tree(0.2f);
+		std::vector<int> proxies(aCount);
+		const double createTime = MeasureBestOf([&]()
+		{
+			tree.RemoveAll();
+			for (int index = 0; index < aCount; ++index)
+			{
+				proxies[index] = tree.CreateProxy(positions[index], positions[index] + sizes[index], index);
+			}
+		});
+
+		// One frame moves every actor, turning back at the edges, and collects the new candidate pairs
+		CU::GrowingArray<CU::DynamicAABBTreePair> pairs;
+		pairs.Reserve(aCount);
+		tree.QueryMovedPairs(pairs);
+		const int frameCount = 10;
+		int reinsertCount = 0;
+		int movedPairCount = 0;
+		const double frameTime = MeasureBestOf([&]()
+		{
+			reinsertCount = 0;
+			movedPairCount = 0;
+			for (int frame = 0; frame < frameCount; ++frame)
+			{
+				for (int index = 0; index < aCount; ++index)
+				{
+					CU::Vector2<float>& actor = positions[index];
+					CU::Vector2<float>& actorVelocity = velocities[index];
+					actor += actorVelocity;
+					for (int axis = 0; axis < 2; ++axis)
+					{
+						if (actor[axis] < 0.f || actor[axis] > worldSize)
+						{
+							actorVelocity[axis] = -actorVelocity[axis];
+						}
+					}
+					reinsertCount += tree.MoveProxy(proxies[index], actor, actor + sizes[index], actorVelocity) ? 1 : 0;
+				}
+				tree.QueryMovedPairs(pairs);
+				movedPairCount += pairs.Size();
+			}
+		});
+		const double allPairsTime = MeasureBestOf([&]()
+		{
+			tree.QueryAllPairs(pairs);
+		});
+		ourSink = static_cast<float>(reinsertCount + movedPairCount + pairs.Size());
+
+		Report("DynamicAABBTree::CreateProxy", createTime, aCount);
+		Report("DynamicAABBTree::MoveProxy and QueryMovedPairs, per actor and frame", frameTime, aCount * frameCount);
+		Report("DynamicAABBTree::QueryAllPairs, per actor", allPairsTime, aCount);
+		std::cout << "DynamicAABBTree: " << aCount << " actors, height " << tree.GetHeight() << ", " << static_cast<double>(reinsertCount) / frameCount
+			<< " reinserted and " << static_cast<double>(movedPairCount) / frameCount << " new pairs per frame, " << pairs.Size() << " overlapping pairs" << std::endl;
+	}
+
+	struct RingMessage
+	{
+		long long myPushTime;
+	};
+
+	long long GetNanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Sends aCount messages from aThreadCount producers to as many consumers. Returns the best time and
+	// writes the average push to pop latency of the last run to aLatency.
+	template<class Push, class Pop>
+	double MeasureTransfer(const int aCount, const int aThreadCount, Push aPush, Pop aPop, double& aLatency)
+	{
+		const int countPerProducer = aCount / aThreadCount;
+		const int count = countPerProducer * aThreadCount;
+		return MeasureBestOf([&]()
+		{
+			std::atomic<int> popped(0);
+			std::atomic<long long> latencySum(0);
+			std::vector<std::thread> threads;
+			for (int thread = 0; thread < aThreadCount; ++thread)
+			{
+				threads.emplace_back([&]()
+				{
+					for (int index = 0; index < countPerProducer; ++index)
+					{
+						const RingMessage message = { GetNanoseconds() };
+						while (!aPush(message))
+						{
+							std::this_thread::yield();
+						}
+					}
+				});
+				threads.emplace_back([&]()
+				{
+					long long sum = 0;
+					RingMessage message;
+					while (popped.load(std::memory_order_relaxed) < count)
+					{
+						if (aPop(message))
+						{
+							sum += GetNanoseconds() - message.myPushTime;
+							popped.fetch_add(1, std::memory_order_relaxed);
+						}
+						else
+						{
+							std::this_thread::yield();
+						}
+					}
+					latencySum.fetch_add(sum);
+				});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			aLatency = static_cast<double>(latencySum.load()) / count;
+		});
+	}
+
+	void ReportTransfer(const std::string& aName, const int aThreadCount, const double aMilliseconds, const double aLatency, const int aCount)
+	{
+		const std::string threads = std::to_string(aThreadCount);
+		Report((aName + " " + threads + "x" + threads + " threads").c_str(), aMilliseconds, aCount / aThreadCount * aThreadCount);
+		std::cout << "  average latency: " << aLatency << " ns" << std::endl;
+	}
+
+	void BenchmarkRings(const int aCount)
+	{
+		static const int ourRingSize = 1024;
+		std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+		double latency = 0.0;
+		CU::SpscRing<RingMessage, ourRingSize> spscRing;
+		const double spscTime = MeasureTransfer(aCount, 1, [&](const RingMessage& aMessage)
+		{
+			return spscRing.Push(aMessage);
+		}, [&](RingMessage& aMessage)
+		{
+			return spscRing.Pop(aMessage);
+		}, latency);
+		ReportTransfer("SpscRing", 1, spscTime, latency, aCount);
+
+		for (int threadCount = 1; threadCount <= 16; threadCount *= 2)
+		{
+			CU::MpmcRing<RingMessage, ourRingSize> mpmcRing;
+			const double mpmcTime = MeasureTransfer(aCount, threadCount, [&](const RingMessage& aMessage)
+			{
+				return mpmcRing.Push(aMessage);
+			}, [&](RingMessage& aMessage)
+			{
+				return mpmcRing.Pop(aMessage);
+			}, latency);
+			ReportTransfer("MpmcRing", threadCount, mpmcTime, latency, aCount);
+
+			// What the rings replace, bounded to the same size
+			std::mutex mutex;
+			std::deque<RingMessage> deque;
+			const double dequeTime = MeasureTransfer(aCount, threadCount, [&](const RingMessage& aMessage)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (deque.size() == ourRingSize)
+				{
+					return false;
+				}
+				deque.push_back(aMessage);
+				return true;
+			}, [&](RingMessage& aMessage)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (deque.empty())
+				{
+					return false;
+				}
+				aMessage = deque.front();
+				deque.pop_front();
+				return true;
+			}, latency);
+			ReportTransfer("std::deque with mutex", threadCount, dequeTime, latency, aCount);
+		}
+	}
+
+	void BenchmarkTimer(const int aCount)
+	{
+		Timer timer;
+		float total = 0.f;
+		const double updateTime = MeasureBestOf([&]()
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				timer.Update();
+				total += timer.GetDeltaTime();
+			}
+		});
+		ourSink = total;
+
+		Report("Timer::Update", updateTime, aCount);
+	}
+
+	void Run(const char* aGroupName, void (*aBenchmark)(const int), const int aDefaultCount)
+	{
+		if (std::string(aGroupName).find(ourOptions.myFilter) == std::string::npos)
+		{
+			return;
+		}
+		aBenchmark(ourOptions.myCount > 0 ? ourOptions.myCount : aDefaultCount);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (!CUBenchmark::ParseOptions(argc, argv, ourOptions))
+	{
+		return 2;
+	}
+
+	std::cout << "SIMD level: " << CU::GetSimdLevelName(CU::GetSimdLevel()) << " (CU_SIMD_LEVEL forces scalar, sse2, avx2 or avx512)" << std::endl;
+
+	Run("TransformPoints", &BenchmarkTransformPoints, 1000000);
+	Run("MatrixInverse", &BenchmarkMatrixInverse, 100000);
+	Run("QuaternionToMatrix", &BenchmarkQuaternionToMatrix, 1000000);
+	Run("CreateTRS", &BenchmarkCreateTRS, 100000);
+	Run("VectorExpressions", &BenchmarkVectorExpressions, 1000000);
+	Run("Vector3Stream", &BenchmarkVector3Stream, 1000000);
+	Run("Vectors", &BenchmarkVectors, 1000000);
+	Run("Matrices", &BenchmarkMatrices, 100000);
+	Run("StaticArray", &BenchmarkStaticArray, 1000000);
+	Run("GrowingArray", &BenchmarkGrowingArray, 1000000);
+	Run("ObjectPool", &BenchmarkObjectPool, 1000000);
+	Run("FrameArena", &BenchmarkFrameArena, 1000000);
+	Run("VectorOnStack", &BenchmarkVectorOnStack, 1000000);
+	Run("FlatHashMap", &BenchmarkFlatHashMap, 10000000);
+	Run("Bitsets", &BenchmarkBitsets, 1000000);
+	Run("Heaps", &BenchmarkHeaps, 50);
+	Run("LineVolume", &BenchmarkLineVolume, 100000);
+	Run("FrustumCulling", &BenchmarkFrustumCulling, 200000);
+	Run("Intersection", &BenchmarkIntersection, 100000);
+	Run("BVH", &BenchmarkBVH, 1000000);
+	Run("DynamicAABBTree", &BenchmarkDynamicAABBTree, 50000);
+	Run("Timer", &BenchmarkTimer, 100000);
+	Run("Rings", &BenchmarkRings, 100000);
+
+	if (!ourOptions.myJsonPath.empty() && !ourReport.WriteJson(ourOptions.myJsonPath, CU::GetSimdLevelName(CU::GetSimdLevel())))
+	{
+		std::cout << "Can't write " << ourOptions.myJsonPath << std::endl;
+		return 2;
+	}
+
+	if (!ourOptions.myBaselinePath.empty())
+	{
+		const int regressions = ourReport.Compare(ourOptions.myBaselinePath, ourOptions.myTolerance);
+		return regressions < 0 ? 2 : (regressions > 0 ? 1 : 0);
+	}
+	return 0;
+}
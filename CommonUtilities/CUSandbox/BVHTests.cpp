@@ -0,0 +1,239 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <vector>
+#include "BVH.hpp"
+#include "Intersection.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(BVHTests)
+	{
+	public:
+
+		static float NextFloat(unsigned int& aRandom, const float aScale)
+		{
+			aRandom = aRandom * 1664525u + 1013904223u;
+			return static_cast<float>(aRandom >> 8) / 16777216.f * aScale;
+		}
+
+		static CU::Vector3<float> NextVector(unsigned int& aRandom, const float aScale)
+		{
+			const float x = NextFloat(aRandom, aScale) - aScale * 0.5f;
+			const float y = NextFloat(aRandom, aScale) - aScale * 0.5f;
+			return CU::Vector3<float>(x, y, NextFloat(aRandom, aScale) - aScale * 0.5f);
+		}
+
+		static std::vector<CU::AABB3D<float>> MakeBoxes(const int aCount, unsigned int aRandom)
+		{
+			std::vector<CU::AABB3D<float>> boxes(aCount);
+			for (CU::AABB3D<float>& box : boxes)
+			{
+				const float size = NextFloat(aRandom, 4.f);
+				box.InitWithCenterAndExtents(NextVector(aRandom, 200.f), CU::Vector3<float>(size, NextFloat(aRandom, 4.f), size));
+			}
+			return boxes;
+		}
+
+		static std::vector<int> Sorted(const CU::GrowingArray<int>& someIndices)
+		{
+			std::vector<int> sorted(someIndices.begin(), someIndices.end());
+			std::sort(sorted.begin(), sorted.end());
+			return sorted;
+		}
+
+		// Every primitive in exactly one leaf of at most MaxLeafSize, children inside their parents and
+		// escape links one past each subtree
+		static void AssertValidTree(const CU::BVH<float>& aBVH)
+		{
+			std::vector<int> seen(aBVH.GetPrimitiveCount(), 0);
+			std::vector<int> escapes;
+			for (int index = 0; index < aBVH.GetNodeCount(); ++index)
+			{
+				while (!escapes.empty() && escapes.back() == index)
+				{
+					escapes.pop_back();
+				}
+				const CU::BVHNode<float>& node = aBVH.GetNode(index);
+				if (index > 0)
+				{
+					const CU::BVHNode<float>& root = aBVH.GetNode(0);
+					Assert::IsTrue(CU::AABB3D<float>(root.myMin, root.myMax).IsInside(node.myMin));
+					Assert::IsTrue(CU::AABB3D<float>(root.myMin, root.myMax).IsInside(node.myMax));
+				}
+				if (node.myPrimitiveCount > 0)
+				{
+					Assert::IsTrue(node.myPrimitiveCount <= CU::BVH<float>::MaxLeafSize);
+					for (int slot = node.myEscapeOrFirst; slot < node.myEscapeOrFirst + node.myPrimitiveCount; ++slot)
+					{
+						++seen[slot];
+					}
+				}
+				else
+				{
+					Assert::IsTrue(node.myEscapeOrFirst > index + 2 && node.myEscapeOrFirst <= aBVH.GetNodeCount());
+					Assert::IsTrue(escapes.empty() || node.myEscapeOrFirst <= escapes.back());
+					escapes.push_back(node.myEscapeOrFirst);
+				}
+			}
+			Assert::IsTrue(std::count(seen.begin(), seen.end(), 1) == static_cast<int>(seen.size()));
+		}
+
+		TEST_METHOD(QueriesMatchBruteForce)
+		{
+			const std::vector<CU::AABB3D<float>> boxes = MakeBoxes(2000, 7u);
+			CU::BVH<float> bvh;
+			bvh.Build(boxes.data(), static_cast<int>(boxes.size()), 1);
+			Assert::AreEqual(2000, bvh.GetPrimitiveCount());
+			AssertValidTree(bvh);
+
+			unsigned int random = 11u;
+			CU::GrowingArray<int> found;
+			CU::GrowingArray<int> expected;
+			int rayHits = 0;
+			int overlapHits = 0;
+			for (int query = 0; query < 100; ++query)
+			{
+				const CU::Ray<float> ray(NextVector(random, 300.f), NextVector(random, 2.f) + CU::Vector3<float>(0.001f, 0.001f, 0.001f));
+				found.RemoveAll();
+				expected.RemoveAll();
+				bvh.QueryRay(ray, found);
+				float distance = 0.f;
+				float nearest = 1e30f;
+				for (int index = 0; index < static_cast<int>(boxes.size()); ++index)
+				{
+					if (CU::IntersectionAABBRay(boxes[index], ray, distance))
+					{
+						expected.Add(index);
+						nearest = distance < nearest ? distance : nearest;
+					}
+				}
+				Assert::IsTrue(Sorted(expected) == Sorted(found));
+				rayHits += found.Size();
+
+				int primitive = -1;
+				Assert::AreEqual(expected.Size() > 0, bvh.FindNearest(ray, primitive, distance));
+				if (expected.Size() > 0)
+				{
+					Assert::AreEqual(nearest, distance);
+				}
+
+				CU::AABB3D<float> area;
+				area.InitWithCenterAndExtents(NextVector(random, 200.f), CU::Vector3<float>(10.f, 10.f, 10.f));
+				found.RemoveAll();
+				expected.RemoveAll();
+				bvh.QueryOverlaps(area, found);
+				for (int index = 0; index < static_cast<int>(boxes.size()); ++index)
+				{
+					if (area.Overlaps(boxes[index]))
+					{
+						expected.Add(index);
+					}
+				}
+				Assert::IsTrue(Sorted(expected) == Sorted(found));
+				overlapHits += found.Size();
+			}
+			Assert::IsTrue(rayHits > 0 && overlapHits > 0);
+		}
+
+		TEST_METHOD(NearestTriangleMatchesBruteForce)
+		{
+			const int count = 3000;
+			unsigned int random = 13u;
+			std::vector<CU::Vector3<float>> corners(count * 3);
+			std::vector<CU::AABB3D<float>> bounds(count);
+			for (int triangle = 0; triangle < count; ++triangle)
+			{
+				const CU::Vector3<float> center = NextVector(random, 100.f);
+				CU::Vector3<float> min = center;
+				CU::Vector3<float> max = center;
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					const CU::Vector3<float> position = center + NextVector(random, 8.f);
+					corners[triangle * 3 + corner] = position;
+					for (int axis = 0; axis < 3; ++axis)
+					{
+						min[axis] = std::min(min[axis], position[axis]);
+						max[axis] = std::max(max[axis], position[axis]);
+					}
+				}
+				bounds[triangle] = CU::AABB3D<float>(min, max);
+			}
+			CU::BVH<float> bvh;
+			bvh.Build(bounds.data(), count, 1);
+
+			auto testTriangle = [&corners](const int aTriangle, const CU::Ray<float>& aRay, float& aDistance)
+			{
+				return CU::IntersectionTriangleRay(corners[aTriangle * 3], corners[aTriangle * 3 + 1], corners[aTriangle * 3 + 2], aRay, aDistance);
+			};
+			int hitCount = 0;
+			for (int query = 0; query < 200; ++query)
+			{
+				const CU::Ray<float> ray(NextVector(random, 250.f), NextVector(random, 2.f));
+				float expected = 1e30f;
+				bool anyHit = false;
+				for (int triangle = 0; triangle < count; ++triangle)
+				{
+					float distance = 0.f;
+					if (testTriangle(triangle, ray, distance) && distance < expected)
+					{
+						expected = distance;
+						anyHit = true;
+					}
+				}
+				int primitive = -1;
+				float distance = 0.f;
+				Assert::AreEqual(anyHit, bvh.FindNearest(ray, testTriangle, primitive, distance));
+				if (anyHit)
+				{
+					Assert::AreEqual(expected, distance);
+					float primitiveDistance = 0.f;
+					Assert::IsTrue(testTriangle(primitive, ray, primitiveDistance));
+					Assert::AreEqual(expected, primitiveDistance);
+					++hitCount;
+				}
+			}
+			Assert::IsTrue(hitCount > 0 && hitCount < 200);
+		}
+
+		TEST_METHOD(ParallelBuildMatchesSerialBuild)
+		{
+			// Large enough for the root to be binned and split on several threads, with a clump of identical
+			// boxes that can only be split by count
+			std::vector<CU::AABB3D<float>> boxes = MakeBoxes(100000, 17u);
+			for (int index = 0; index < 100; ++index)
+			{
+				boxes[index * 7] = CU::AABB3D<float>(CU::Vector3<float>(1.f, 1.f, 1.f), CU::Vector3<float>(2.f, 2.f, 2.f));
+			}
+			CU::BVH<float> serial;
+			serial.Build(boxes.data(), static_cast<int>(boxes.size()), 1);
+			CU::BVH<float> parallel;
+			parallel.Build(boxes.data(), static_cast<int>(boxes.size()), 4);
+			AssertValidTree(serial);
+			AssertValidTree(parallel);
+			Assert::AreEqual(serial.GetNodeCount(), parallel.GetNodeCount());
+
+			unsigned int random = 19u;
+			CU::GrowingArray<int> serialFound;
+			CU::GrowingArray<int> parallelFound;
+			for (int query = 0; query < 50; ++query)
+			{
+				CU::AABB3D<float> area;
+				area.InitWithCenterAndExtents(NextVector(random, 200.f), CU::Vector3<float>(5.f, 5.f, 5.f));
+				if (query == 0)
+				{
+					area.InitWithCenterAndExtents(CU::Vector3<float>(1.5f, 1.5f, 1.5f), CU::Vector3<float>(0.1f, 0.1f, 0.1f));
+				}
+				serialFound.RemoveAll();
+				parallelFound.RemoveAll();
+				serial.QueryOverlaps(area, serialFound);
+				parallel.QueryOverlaps(area, parallelFound);
+				Assert::IsTrue(Sorted(serialFound) == Sorted(parallelFound));
+				Assert::IsTrue(query > 0 || serialFound.Size() >= 100);
+			}
+		}
+	};
+}
@@ -0,0 +1,136 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <vector>
+#include "DynamicBitset.hpp"
+#include "StaticBitset.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(BitsetTests)
+	{
+	public:
+
+		TEST_METHOD(StaticBitsetSetsAndFinds)
+		{
+			CU::StaticBitset<130> bitset;
+			Assert::IsTrue(bitset.None());
+			Assert::AreEqual(CU::StaticBitset<130>::FoundNone, bitset.FindFirst());
+
+			bitset.Set(3);
+			bitset.Set(64);
+			bitset.Set(129);
+			Assert::IsTrue(bitset[64]);
+			Assert::IsFalse(bitset[65]);
+			Assert::AreEqual(3, bitset.PopCount());
+			Assert::AreEqual(3, bitset.FindFirst());
+			Assert::AreEqual(64, bitset.FindNext(3));
+			Assert::AreEqual(129, bitset.FindNext(64));
+			Assert::AreEqual(CU::StaticBitset<130>::FoundNone, bitset.FindNext(129));
+
+			CU::StaticBitset<130> inverse = ~bitset;
+			Assert::AreEqual(127, inverse.PopCount());
+			Assert::IsTrue((inverse | bitset).All());
+			Assert::IsTrue((inverse & bitset).None());
+			inverse.AndNot(~CU::StaticBitset<130>());
+			Assert::IsTrue(inverse.None());
+
+			bitset.Flip(3);
+			bitset.Set(64, false);
+			Assert::AreEqual(129, bitset.FindFirst());
+		}
+
+		TEST_METHOD(IteratesSetBits)
+		{
+			CU::StaticBitset<300> bitset;
+			const int expected[] = { 0, 63, 64, 127, 200, 299 };
+			for (const int index : expected)
+			{
+				bitset.Set(index);
+			}
+			std::vector<int> found;
+			for (const int index : bitset.GetSetBits())
+			{
+				found.push_back(index);
+			}
+			Assert::AreEqual(6, static_cast<int>(found.size()));
+			for (int index = 0; index < 6; ++index)
+			{
+				Assert::AreEqual(expected[index], found[index]);
+			}
+
+			CU::StaticBitset<300> empty;
+			Assert::IsTrue(empty.GetSetBits().begin() == empty.GetSetBits().end());
+		}
+
+		TEST_METHOD(DynamicBitsetMatchesReference)
+		{
+			// 21 words, so every kernel width leaves a remainder
+			const int size = 1300;
+			CU::DynamicBitset<> first(size);
+			CU::DynamicBitset<> second(size);
+			std::vector<bool> firstReference(size);
+			std::vector<bool> secondReference(size);
+			unsigned int random = 7u;
+			for (int index = 0; index < size; ++index)
+			{
+				random = random * 1664525u + 1013904223u;
+				firstReference[index] = (random >> 28 & 1) != 0;
+				secondReference[index] = (random >> 29 & 1) != 0;
+				first.Set(index, firstReference[index]);
+				second.Set(index, secondReference[index]);
+			}
+
+			CU::DynamicBitset<> andBits = first;
+			andBits &= second;
+			CU::DynamicBitset<> orBits = first;
+			orBits |= second;
+			CU::DynamicBitset<> xorBits = first;
+			xorBits ^= second;
+			CU::DynamicBitset<> andNotBits = first;
+			andNotBits.AndNot(second);
+
+			int count = 0;
+			for (int index = 0; index < size; ++index)
+			{
+				const bool left = firstReference[index];
+				const bool right = secondReference[index];
+				Assert::AreEqual(left && right, andBits[index]);
+				Assert::AreEqual(left || right, orBits[index]);
+				Assert::AreEqual(left != right, xorBits[index]);
+				Assert::AreEqual(left && !right, andNotBits[index]);
+				count += left ? 1 : 0;
+			}
+			Assert::AreEqual(count, first.PopCount());
+
+			int iterated = 0;
+			for (const int index : first.GetSetBits())
+			{
+				Assert::IsTrue(firstReference[index]);
+				++iterated;
+			}
+			Assert::AreEqual(count, iterated);
+		}
+
+		TEST_METHOD(DynamicBitsetResizes)
+		{
+			CU::DynamicBitset<> bitset(70);
+			bitset.SetAll();
+			Assert::AreEqual(70, bitset.PopCount());
+			Assert::IsTrue(bitset.All());
+
+			bitset.Resize(65);
+			bitset.Resize(200);
+			Assert::AreEqual(65, bitset.PopCount());
+			Assert::AreEqual(CU::DynamicBitset<>::FoundNone, bitset.FindNext(64));
+
+			CU::DynamicBitset<> moved = std::move(bitset);
+			Assert::AreEqual(200, moved.Size());
+			moved.FlipAll();
+			Assert::AreEqual(135, moved.PopCount());
+			Assert::AreEqual(65, moved.FindFirst());
+		}
+	};
+}
@@ -16,7 +16,11 @@ namespace CUSandbox
 			CU::StaticArray<float, 10> myArray = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
 
 			myArray.Insert(0, 30.f);
-			myArray.DeleteAll();
+			Assert::AreEqual(30.f, myArray[0]);
+
+			CU::StaticArray<float*, 2> pointers = { new float(1.f), nullptr };
+			pointers.DeleteAll();
+			Assert::IsTrue(pointers[0] == nullptr);
 		}
 	};
 }
\ No newline at end of file
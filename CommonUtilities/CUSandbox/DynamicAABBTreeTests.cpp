@@ -0,0 +1,189 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "DynamicAABBTree.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(DynamicAABBTreeTests)
+	{
+	public:
+
+		static float NextFloat(unsigned int& aRandom, const float aScale)
+		{
+			aRandom = aRandom * 1664525u + 1013904223u;
+			return static_cast<float>(aRandom >> 8) / 16777216.f * aScale;
+		}
+
+		template<class VectorType>
+		static VectorType NextVector(unsigned int& aRandom, const float aScale)
+		{
+			VectorType vector;
+			for (int axis = 0; axis < VectorType::ourSize; ++axis)
+			{
+				vector[axis] = NextFloat(aRandom, aScale) - aScale * 0.5f;
+			}
+			return vector;
+		}
+
+		// Between 0.5 and 4.5 along every axis
+		template<class VectorType>
+		static VectorType NextSize(unsigned int& aRandom)
+		{
+			VectorType size;
+			for (int axis = 0; axis < VectorType::ourSize; ++axis)
+			{
+				size[axis] = NextFloat(aRandom, 4.f) + 0.5f;
+			}
+			return size;
+		}
+
+		template<class VectorType>
+		static bool FatBoxesOverlap(const CU::DynamicAABBTree<VectorType>& aTree, const int aFirst, const int aSecond)
+		{
+			for (int axis = 0; axis < VectorType::ourSize; ++axis)
+			{
+				if (aTree.GetFatMin(aFirst)[axis] > aTree.GetFatMax(aSecond)[axis] || aTree.GetFatMin(aSecond)[axis] > aTree.GetFatMax(aFirst)[axis])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static std::vector<std::pair<int, int>> Sorted(const CU::GrowingArray<CU::DynamicAABBTreePair>& somePairs)
+		{
+			std::vector<std::pair<int, int>> sorted;
+			for (const CU::DynamicAABBTreePair& pair : somePairs)
+			{
+				Assert::IsTrue(pair.myFirst < pair.mySecond);
+				sorted.push_back(std::make_pair(pair.myFirst, pair.mySecond));
+			}
+			std::sort(sorted.begin(), sorted.end());
+			return sorted;
+		}
+
+		// Creates, moves and destroys proxies at random and checks the pair queries against every pair of fat boxes
+		template<class VectorType>
+		static void CheckPairsMatchBruteForce(const unsigned int aSeed)
+		{
+			CU::DynamicAABBTree<VectorType> tree(0.5f);
+			unsigned int random = aSeed;
+			std::vector<int> proxies;
+			for (int index = 0; index < 600; ++index)
+			{
+				const VectorType min = NextVector<VectorType>(random, 100.f);
+				proxies.push_back(tree.CreateProxy(min, min + NextSize<VectorType>(random), index));
+			}
+
+			CU::GrowingArray<CU::DynamicAABBTreePair> pairs;
+			for (int frame = 0; frame < 5; ++frame)
+			{
+				std::vector<bool> moved(proxies.size(), frame == 0);
+				if (frame > 0)
+				{
+					for (int index = 0; index < static_cast<int>(proxies.size()); ++index)
+					{
+						if (index % 3 == frame % 3)
+						{
+							const VectorType min = NextVector<VectorType>(random, 100.f);
+							moved[index] = tree.MoveProxy(proxies[index], min, min + NextSize<VectorType>(random), NextVector<VectorType>(random, 1.f));
+						}
+					}
+				}
+				tree.QueryMovedPairs(pairs);
+				std::vector<std::pair<int, int>> expectedMoved;
+				std::vector<std::pair<int, int>> expectedAll;
+				for (int first = 0; first < static_cast<int>(proxies.size()); ++first)
+				{
+					for (int second = first + 1; second < static_cast<int>(proxies.size()); ++second)
+					{
+						if (FatBoxesOverlap(tree, proxies[first], proxies[second]))
+						{
+							const std::pair<int, int> pair = std::minmax(proxies[first], proxies[second]);
+							expectedAll.push_back(pair);
+							if (moved[first] || moved[second])
+							{
+								expectedMoved.push_back(pair);
+							}
+						}
+					}
+				}
+				std::sort(expectedMoved.begin(), expectedMoved.end());
+				std::sort(expectedAll.begin(), expectedAll.end());
+				Assert::IsTrue(expectedMoved == Sorted(pairs));
+				tree.QueryAllPairs(pairs);
+				Assert::IsTrue(expectedAll == Sorted(pairs));
+				Assert::IsTrue(expectedAll.size() > 0);
+			}
+		}
+
+		TEST_METHOD(PairsMatchBruteForce2D)
+		{
+			CheckPairsMatchBruteForce<CU::Vector2<float>>(3u);
+		}
+
+		TEST_METHOD(PairsMatchBruteForce3D)
+		{
+			CheckPairsMatchBruteForce<CU::Vector3<float>>(5u);
+		}
+
+		TEST_METHOD(SmallMovesKeepTreeAndRotationsKeepItBalanced)
+		{
+			// Boxes inserted in sorted order along a line would make a list without the rotations
+			CU::DynamicAABBTree<CU::Vector3<float>> tree(0.25f);
+			std::vector<int> proxies;
+			for (int index = 0; index < 4096; ++index)
+			{
+				const CU::Vector3<float> min(static_cast<float>(index) * 2.f, 0.f, 0.f);
+				proxies.push_back(tree.CreateProxy(min, min + CU::Vector3<float>(1.f, 1.f, 1.f), index * 10));
+			}
+			Assert::AreEqual(4096, tree.GetProxyCount());
+			Assert::IsTrue(tree.GetHeight() >= 12 && tree.GetHeight() <= 20);
+			CU::GrowingArray<CU::DynamicAABBTreePair> pairs;
+			tree.QueryMovedPairs(pairs);
+			Assert::AreEqual(0, pairs.Size());
+
+			// Inside the margin nothing changes and nothing is reported
+			const CU::Vector3<float> fatMin = tree.GetFatMin(proxies[7]);
+			const CU::Vector3<float> moved(14.2f, 0.1f, -0.2f);
+			Assert::IsFalse(tree.MoveProxy(proxies[7], moved, moved + CU::Vector3<float>(1.f, 1.f, 1.f), CU::Vector3<float>(0.2f, 0.1f, -0.2f)));
+			Assert::AreEqual(fatMin.x, tree.GetFatMin(proxies[7]).x);
+			Assert::AreEqual(fatMin.z, tree.GetFatMin(proxies[7]).z);
+			tree.QueryMovedPairs(pairs);
+			Assert::AreEqual(0, pairs.Size());
+
+			// Onto its neighbour, stretched along the displacement
+			const CU::Vector3<float> onto(15.5f, 0.f, 0.f);
+			Assert::IsTrue(tree.MoveProxy(proxies[7], onto, onto + CU::Vector3<float>(1.f, 1.f, 1.f), CU::Vector3<float>(1.f, 0.f, 0.f)));
+			Assert::AreEqual(15.25f, tree.GetFatMin(proxies[7]).x);
+			Assert::AreEqual(18.75f, tree.GetFatMax(proxies[7]).x);
+			tree.QueryMovedPairs(pairs);
+			Assert::AreEqual(2, pairs.Size());
+			Assert::IsTrue(Sorted(pairs) == std::vector<std::pair<int, int>>({ std::make_pair(proxies[7], proxies[8]), std::make_pair(proxies[7], proxies[9]) }));
+
+			// Destroying every other proxy keeps the tree balanced
+			for (int index = 0; index < 4096; index += 2)
+			{
+				tree.DestroyProxy(proxies[index]);
+			}
+			Assert::AreEqual(2048, tree.GetProxyCount());
+			Assert::IsTrue(tree.GetHeight() >= 11 && tree.GetHeight() <= 18);
+			const int reused = tree.CreateProxy(CU::Vector3<float>(1.f, 0.f, 0.f), CU::Vector3<float>(3.f, 1.f, 1.f), 5);
+			Assert::AreEqual(5, tree.GetUserData(reused));
+			Assert::AreEqual(30, tree.GetUserData(proxies[3]));
+
+			CU::GrowingArray<int> found;
+			tree.Query(CU::Vector3<float>(0.f, 0.f, 0.f), CU::Vector3<float>(4.f, 1.f, 1.f), found);
+			std::sort(found.begin(), found.end());
+			Assert::AreEqual(2, found.Size());
+			Assert::AreEqual(std::min(reused, proxies[1]), found[0]);
+			Assert::AreEqual(std::max(reused, proxies[1]), found[1]);
+		}
+	};
+}
@@ -0,0 +1,127 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <string>
+#include <unordered_map>
+#include "FlatHashMap.hpp"
+#include "FlatHashSet.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(FlatHashMapTests)
+	{
+	public:
+
+		// Sends every key to the same group to exercise probing past full groups
+		struct CollidingHash
+		{
+			size_t operator()(const int aKey) const
+			{
+				return static_cast<size_t>(aKey & 0x3) << 7;
+			}
+		};
+
+		TEST_METHOD(InsertFindErase)
+		{
+			CU::FlatHashMap<int, int> map;
+			for (int key = 0; key < 1000; ++key)
+			{
+				Assert::IsTrue(map.Insert(key, key * 2));
+			}
+			Assert::IsFalse(map.Insert(5, 0));
+			Assert::AreEqual(1000, map.Count());
+			Assert::AreEqual(10, *map.Find(5));
+			Assert::IsTrue(map.Find(1000) == nullptr);
+
+			for (int key = 0; key < 1000; key += 2)
+			{
+				Assert::IsTrue(map.Erase(key));
+			}
+			Assert::IsFalse(map.Erase(0));
+			Assert::AreEqual(500, map.Count());
+			for (int key = 0; key < 1000; ++key)
+			{
+				Assert::AreEqual(key % 2 == 1, map.Contains(key));
+			}
+
+			map.Set(1, 7);
+			map[2] = 9;
+			++map[3];
+			Assert::AreEqual(7, map[1]);
+			Assert::AreEqual(9, map[2]);
+			Assert::AreEqual(7, map[3]);
+
+			int sum = 0;
+			for (const std::pair<int, int>& entry : map)
+			{
+				sum += entry.first;
+			}
+			Assert::AreEqual(250000 + 2, sum);
+		}
+
+		TEST_METHOD(MatchesUnorderedMapUnderChurn)
+		{
+			CU::FlatHashMap<int, int, CollidingHash> map;
+			std::unordered_map<int, int> reference;
+			unsigned int random = 1u;
+			for (int step = 0; step < 20000; ++step)
+			{
+				random = random * 1664525u + 1013904223u;
+				const int key = static_cast<int>(random >> 24);
+				if ((random & 0x300) == 0)
+				{
+					Assert::AreEqual(reference.erase(key) == 1, map.Erase(key));
+				}
+				else
+				{
+					Assert::AreEqual(reference.emplace(key, step).second, map.Insert(key, step));
+				}
+			}
+			Assert::AreEqual(static_cast<int>(reference.size()), map.Count());
+			for (const std::pair<const int, int>& entry : reference)
+			{
+				Assert::AreEqual(entry.second, *map.Find(entry.first));
+			}
+		}
+
+		TEST_METHOD(ReserveAndRehash)
+		{
+			CU::FlatHashSet<int> set;
+			set.Reserve(1000);
+			const int capacity = set.Capacity();
+			Assert::IsTrue(capacity >= 1000);
+			for (int key = 0; key < 1000; ++key)
+			{
+				set.Insert(key);
+			}
+			Assert::AreEqual(capacity, set.Capacity());
+
+			for (int key = 0; key < 990; ++key)
+			{
+				set.Erase(key);
+			}
+			set.Rehash(0);
+			Assert::AreEqual(16, set.Capacity());
+			Assert::AreEqual(10, set.Count());
+			Assert::IsTrue(set.Contains(995));
+
+			CU::FlatHashSet<int> copy = set;
+			CU::FlatHashSet<int> moved = std::move(set);
+			Assert::IsTrue(set.IsEmpty());
+			Assert::IsTrue(copy.Contains(999) && moved.Contains(999));
+		}
+
+		TEST_METHOD(HeterogeneousLookup)
+		{
+			CU::FlatHashMap<std::string, int> map = { { "alpha", 1 }, { "beta", 2 } };
+			map.Insert(std::string(64, 'x'), 3);
+			Assert::AreEqual(1, *map.Find("alpha"));
+			Assert::IsTrue(map.Contains(std::string("beta")));
+			Assert::IsFalse(map.Contains("gamma"));
+			Assert::IsTrue(map.Erase("beta"));
+			Assert::AreEqual(2, map.Count());
+		}
+	};
+}
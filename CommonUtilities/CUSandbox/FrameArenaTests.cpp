@@ -0,0 +1,175 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <vector>
+#include "FrameArena.hpp"
+#include "GrowingArray.hpp"
+#include "Timer.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(FrameArenaTests)
+	{
+	public:
+
+		TEST_METHOD(AllocationsAreAlignedAndFreedPerFrame)
+		{
+			CU::FrameArena arena(1024);
+			char* first = static_cast<char*>(arena.Allocate(3, 1));
+			double* second = arena.AllocateArray<double>(4);
+			Assert::IsTrue(reinterpret_cast<std::uintptr_t>(second) % alignof(double) == 0);
+			Assert::IsTrue(reinterpret_cast<char*>(second) >= first + 3);
+			Assert::AreEqual(size_t(40), arena.GetUsed());
+
+			arena.BeginFrame();
+			Assert::AreEqual(size_t(0), arena.GetUsed());
+			Assert::AreEqual(size_t(40), arena.GetHighWaterMark());
+			Assert::IsTrue(first == arena.Allocate(8, 1));
+
+			arena.BeginFrame();
+			Assert::AreEqual(size_t(8), arena.GetHighWaterMark());
+			Assert::AreEqual(size_t(40), arena.GetPeakHighWaterMark());
+
+			bool threw = false;
+			try
+			{
+				arena.Allocate(2048, 8);
+			}
+			catch (const std::bad_alloc&)
+			{
+				threw = true;
+			}
+			Assert::IsTrue(threw);
+		}
+
+		TEST_METHOD(HugeAllocationsThrowInsteadOfWrapping)
+		{
+			// start + aSize wraps around for these sizes and would look like it fits
+			CU::FrameArena arena(1024);
+			arena.Allocate(16, 1);
+			const size_t hugeSizes[] = { SIZE_MAX, SIZE_MAX - 8, SIZE_MAX - 1024 };
+			for (const size_t size : hugeSizes)
+			{
+				const size_t used = arena.GetUsed();
+				bool threw = false;
+				try
+				{
+					arena.Allocate(size, 8);
+				}
+				catch (const std::bad_alloc&)
+				{
+					threw = true;
+				}
+				Assert::IsTrue(threw);
+				Assert::AreEqual(used, arena.GetUsed());
+
+				CU::FrameArena::SubArena subArena(arena, 128);
+				subArena.Allocate(8, 8);
+				threw = false;
+				try
+				{
+					subArena.Allocate(size, 8);
+				}
+				catch (const std::bad_alloc&)
+				{
+					threw = true;
+				}
+				Assert::IsTrue(threw);
+			}
+			Assert::IsTrue(arena.Allocate(64, 8) != nullptr);
+		}
+
+		TEST_METHOD(BuffersKeepEarlierFramesIntact)
+		{
+			CU::FrameArena arena(256, 3);
+			int* frames[3];
+			for (int frame = 0; frame < 3; ++frame)
+			{
+				frames[frame] = arena.New<int>(frame + 10);
+				arena.BeginFrame();
+			}
+			Assert::AreEqual(10, *frames[0]);
+			Assert::AreEqual(11, *frames[1]);
+			Assert::AreEqual(12, *frames[2]);
+
+			// The fourth frame is back in the first buffer
+			Assert::IsTrue(arena.New<int>(13) == frames[0]);
+		}
+
+		TEST_METHOD(ContainersUseTheArena)
+		{
+			CU::FrameArena arena(64 * 1024);
+			const CU::FrameAllocator<float> allocator(arena);
+			std::vector<float, CU::FrameAllocator<float>> floats(allocator);
+			floats.reserve(100);
+			for (int index = 0; index < 100; ++index)
+			{
+				floats.push_back(index * 0.5f);
+			}
+			Assert::IsTrue(arena.GetUsed() >= 400);
+
+			CU::GrowingArray<int, int, CU::FrameArenaAllocator> ints(100, CU::FrameArenaAllocator{ &arena });
+			for (int index = 0; index < 100; ++index)
+			{
+				ints.Add(index);
+			}
+			Assert::AreEqual(99, ints.GetLast());
+			Assert::AreEqual(49.5f, floats[99]);
+			Assert::IsTrue(arena.GetUsed() >= 800 && arena.GetUsed() < 1024);
+		}
+
+		TEST_METHOD(SubArenasAllocateFromWorkers)
+		{
+			static const int threadCount = 4;
+			CU::FrameArena arena(1024 * 1024);
+			std::vector<std::thread> threads;
+			std::vector<char> valid(threadCount);
+			for (int thread = 0; thread < threadCount; ++thread)
+			{
+				threads.emplace_back([&arena, &valid, thread]()
+				{
+					CU::FrameArena::SubArena subArena(arena, 4096);
+					std::vector<int*> values;
+					for (int index = 0; index < 1000; ++index)
+					{
+						int* value = static_cast<int*>(subArena.Allocate(sizeof(int), alignof(int)));
+						*value = thread * 1000 + index;
+						values.push_back(value);
+					}
+					bool allValid = true;
+					for (int index = 0; index < 1000; ++index)
+					{
+						allValid = allValid && *values[index] == thread * 1000 + index;
+					}
+					valid[thread] = allValid ? 1 : 0;
+				});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			for (const char isValid : valid)
+			{
+				Assert::IsTrue(isValid != 0);
+			}
+			Assert::IsTrue(arena.GetUsed() >= threadCount * 4000);
+		}
+
+		TEST_METHOD(TimerUpdateBeginsFrame)
+		{
+			CU::FrameArena arena(1024);
+			Timer timer;
+			timer.SetFrameArena(&arena);
+			arena.Allocate(100);
+			timer.Update();
+			Assert::AreEqual(size_t(0), arena.GetUsed());
+			Assert::AreEqual(size_t(100), arena.GetHighWaterMark());
+			Assert::AreEqual(1u, arena.GetFrameIndex());
+		}
+	};
+}
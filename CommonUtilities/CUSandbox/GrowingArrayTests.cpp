@@ -0,0 +1,175 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <string>
+#include "GrowingArray.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(GrowingArrayTests)
+	{
+	public:
+
+		// Counts live instances so leaks and double destruction show up
+		struct Tracked
+		{
+			static int ourLiveCount;
+
+			Tracked(const int aValue = 0) : myValue(aValue) { ++ourLiveCount; }
+			Tracked(const Tracked& aTracked) : myValue(aTracked.myValue) { ++ourLiveCount; }
+			Tracked(Tracked&& aTracked) : myValue(aTracked.myValue) { aTracked.myValue = -1; ++ourLiveCount; }
+			~Tracked() { --ourLiveCount; }
+			Tracked& operator=(const Tracked& aTracked) { myValue = aTracked.myValue; return (*this); }
+			Tracked& operator=(Tracked&& aTracked) { myValue = aTracked.myValue; aTracked.myValue = -1; return (*this); }
+			bool operator==(const Tracked& aTracked) const { return myValue == aTracked.myValue; }
+
+			int myValue;
+		};
+
+		struct CountingAllocator
+		{
+			void* Allocate(const size_t aSize, const size_t anAlignment)
+			{
+				++*myAllocations;
+				return CU::AlignedAllocate(aSize, anAlignment > sizeof(void*) ? anAlignment : sizeof(void*));
+			}
+
+			void Free(void* aMemory)
+			{
+				++*myFrees;
+				CU::AlignedFree(aMemory);
+			}
+
+			int* myAllocations;
+			int* myFrees;
+		};
+
+		TEST_METHOD(AddInsertAndRemoveKeepValues)
+		{
+			CU::GrowingArray<int> array = { 1, 2, 3 };
+			array.Insert(0, 0);
+			array.Insert(4, 4);
+			array.Insert(2, 9);
+			const int expected[] = { 0, 1, 9, 2, 3, 4 };
+			Assert::AreEqual(6, array.Size());
+			for (int index = 0; index < array.Size(); ++index)
+			{
+				Assert::AreEqual(expected[index], array[index]);
+			}
+
+			array.RemoveAtIndex(2);
+			Assert::AreEqual(2, array[2]);
+			array.RemoveCyclicAtIndex(0);
+			Assert::AreEqual(4, array[0]);
+			Assert::AreEqual(3, array.GetLast());
+			Assert::IsTrue(array.RemoveCyclic(1));
+			Assert::IsFalse(array.RemoveCyclic(1));
+			Assert::AreEqual(CU::GrowingArray<int>::FoundNone, array.Find(1));
+			Assert::AreEqual(3, array.Size());
+
+			int sum = 0;
+			for (const int value : array)
+			{
+				sum += value;
+			}
+			Assert::AreEqual(9, sum);
+		}
+
+		TEST_METHOD(GrowthFactorAndReserve)
+		{
+			CU::GrowingArray<float, unsigned short> array;
+			array.SetGrowthFactor(1.5f);
+			for (int index = 0; index < 10; ++index)
+			{
+				array.Add(static_cast<float>(index));
+			}
+			Assert::IsTrue(array.Capacity() == 13);
+
+			array.Reserve(100);
+			Assert::IsTrue(array.Capacity() == 100);
+			Assert::AreEqual(9.f, array[9]);
+
+			array.Optimize();
+			Assert::IsTrue(array.Capacity() == 10);
+			array.RemoveAll();
+			array.Optimize();
+			Assert::IsTrue(array.Capacity() == 0 && array.IsEmpty());
+		}
+
+		TEST_METHOD(NonTrivialElementsAreMovedAndDestroyed)
+		{
+			Tracked::ourLiveCount = 0;
+			{
+				CU::GrowingArray<Tracked> array;
+				for (int index = 0; index < 20; ++index)
+				{
+					array.Emplace(index);
+				}
+				// Adding an element of the array itself while it grows
+				array.Add(array[0]);
+				array.Insert(1, array[5]);
+				Assert::AreEqual(22, Tracked::ourLiveCount);
+				Assert::AreEqual(0, array.GetLast().myValue);
+				Assert::AreEqual(5, array[1].myValue);
+
+				CU::GrowingArray<Tracked> copy = array;
+				Assert::AreEqual(44, Tracked::ourLiveCount);
+				CU::GrowingArray<Tracked> moved = std::move(copy);
+				Assert::IsTrue(copy.IsEmpty());
+				Assert::AreEqual(22, moved.Size());
+				Assert::AreEqual(44, Tracked::ourLiveCount);
+
+				moved.RemoveCyclicAtIndex(0);
+				moved.RemoveAtIndex(3);
+				moved.Resize(5);
+				Assert::AreEqual(27, Tracked::ourLiveCount);
+				Assert::AreEqual(3, moved[3].myValue);
+			}
+			Assert::AreEqual(0, Tracked::ourLiveCount);
+
+			CU::GrowingArray<std::string> strings;
+			strings.Add("first");
+			strings.Add(std::string(64, 'x'));
+			strings.Insert(0, "zero");
+			Assert::AreEqual(std::string("zero"), strings[0]);
+			Assert::AreEqual(size_t(64), strings[2].size());
+		}
+
+		TEST_METHOD(CustomAllocatorIsUsed)
+		{
+			int allocations = 0;
+			int frees = 0;
+			{
+				CU::GrowingArray<double, int, CountingAllocator> array(CountingAllocator{ &allocations, &frees });
+				array.SetGrowthFactor(4.f);
+				for (int index = 0; index < 64; ++index)
+				{
+					array.Add(index * 0.5);
+				}
+				// 1, 4, 16, 64
+				Assert::AreEqual(4, allocations);
+
+				CU::GrowingArray<double, int, CountingAllocator> copy(array);
+				Assert::AreEqual(5, allocations);
+				Assert::AreEqual(31.5, copy.GetLast());
+			}
+			Assert::AreEqual(allocations, frees);
+		}
+
+		TEST_METHOD(DeleteAllDeletesPointers)
+		{
+			Tracked::ourLiveCount = 0;
+			CU::GrowingArray<Tracked*> pointers;
+			pointers.Add(new Tracked(1));
+			pointers.Add(new Tracked(2));
+			Assert::AreEqual(2, Tracked::ourLiveCount);
+			pointers.DeleteAll();
+			Assert::AreEqual(0, Tracked::ourLiveCount);
+			Assert::IsTrue(pointers.IsEmpty());
+		}
+	};
+
+	int GrowingArrayTests::Tracked::ourLiveCount = 0;
+}
@@ -0,0 +1,118 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "DaryHeap.hpp"
+#include "IndexedHeap.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(HeapTests)
+	{
+	public:
+
+		template<class Heap, class Compare>
+		static void CheckSorts(Heap& aHeap, Compare aCompare)
+		{
+			std::vector<int> values;
+			unsigned int random = 3u;
+			for (int index = 0; index < 500; ++index)
+			{
+				random = random * 1664525u + 1013904223u;
+				values.push_back(static_cast<int>(random >> 20));
+				aHeap.Push(values.back());
+			}
+			std::sort(values.begin(), values.end(), aCompare);
+			Assert::AreEqual(500, aHeap.Count());
+			for (const int value : values)
+			{
+				Assert::AreEqual(value, aHeap.GetTop());
+				Assert::AreEqual(value, aHeap.Pop());
+			}
+			Assert::IsTrue(aHeap.IsEmpty());
+		}
+
+		TEST_METHOD(DaryHeapPopsInOrder)
+		{
+			CU::DaryHeap<int, 2> binary;
+			CheckSorts(binary, std::less<int>());
+			CU::DaryHeap<int> quaternary;
+			CheckSorts(quaternary, std::less<int>());
+			CU::DaryHeap<int, 8, std::greater<int>> maxHeap;
+			CheckSorts(maxHeap, std::greater<int>());
+		}
+
+		TEST_METHOD(IndexedHeapChangesPushedElements)
+		{
+			CU::IndexedHeap<int> heap;
+			std::vector<CU::IndexedHeap<int>::Handle> handles;
+			for (int value = 0; value < 100; ++value)
+			{
+				handles.push_back(heap.Push(1000 + value));
+			}
+
+			heap.DecreaseKey(handles[50], 5);
+			Assert::AreEqual(handles[50], heap.GetTopHandle());
+			heap.Update(handles[50], 2000);
+			heap.Update(handles[99], 1);
+			heap.Remove(handles[0]);
+			Assert::IsFalse(heap.Contains(handles[0]));
+			Assert::AreEqual(2000, heap.Get(handles[50]));
+			Assert::AreEqual(99, heap.Count());
+
+			std::vector<int> popped;
+			while (!heap.IsEmpty())
+			{
+				popped.push_back(heap.Pop());
+			}
+			Assert::IsTrue(std::is_sorted(popped.begin(), popped.end()));
+			Assert::AreEqual(1, popped.front());
+			Assert::AreEqual(2000, popped.back());
+			Assert::IsFalse(heap.Contains(handles[50]));
+		}
+
+		TEST_METHOD(IndexedHeapMatchesReferenceUnderChurn)
+		{
+			CU::IndexedHeap<int, 3> heap;
+			std::vector<int> values;
+			std::vector<CU::IndexedHeap<int, 3>::Handle> handles;
+			unsigned int random = 11u;
+			for (int step = 0; step < 5000; ++step)
+			{
+				random = random * 1664525u + 1013904223u;
+				const int value = static_cast<int>(random >> 16);
+				const int action = static_cast<int>(random % 4);
+				if (action == 0 || values.empty())
+				{
+					values.push_back(value);
+					handles.push_back(heap.Push(value));
+				}
+				else if (action == 1)
+				{
+					const int index = value % static_cast<int>(values.size());
+					values[index] = value;
+					heap.Update(handles[index], value);
+				}
+				else if (action == 2)
+				{
+					const int index = value % static_cast<int>(values.size());
+					heap.Remove(handles[index]);
+					values[index] = values.back();
+					handles[index] = handles.back();
+					values.pop_back();
+					handles.pop_back();
+				}
+				else
+				{
+					const int top = *std::min_element(values.begin(), values.end());
+					Assert::AreEqual(top, heap.GetTop());
+				}
+			}
+			Assert::AreEqual(static_cast<int>(values.size()), heap.Count());
+		}
+	};
+}
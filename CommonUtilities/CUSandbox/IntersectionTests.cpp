@@ -0,0 +1,243 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <vector>
+#include "DynamicBitset.hpp"
+#include "Intersection.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(IntersectionTests)
+	{
+	public:
+
+		// Small integers keep every product exact, so the packets must agree with the single tests bit for bit
+		static float NextInteger(unsigned int& aRandom, const int aRange)
+		{
+			aRandom = aRandom * 1664525u + 1013904223u;
+			return static_cast<float>(static_cast<int>((aRandom >> 8) % (2 * aRange + 1)) - aRange);
+		}
+
+		static CU::Vector3<float> NextVector(unsigned int& aRandom, const int aRange)
+		{
+			const float x = NextInteger(aRandom, aRange);
+			const float y = NextInteger(aRandom, aRange);
+			return CU::Vector3<float>(x, y, NextInteger(aRandom, aRange));
+		}
+
+		// A direction with no zero components, so the slab test never divides by zero
+		static CU::Vector3<float> NextDirection(unsigned int& aRandom)
+		{
+			CU::Vector3<float> direction = NextVector(aRandom, 4);
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				direction[axis] = direction[axis] == 0.f ? 1.f : direction[axis];
+			}
+			return direction;
+		}
+
+		static void AssertMatches(const bool anExpectedHit, const float anExpectedDistance, const CU::DynamicBitset<>& someHits, const std::vector<float>& someDistances, const int anIndex)
+		{
+			Assert::AreEqual(anExpectedHit, someHits[anIndex]);
+			if (anExpectedHit)
+			{
+				Assert::AreEqual(anExpectedDistance, someDistances[anIndex]);
+			}
+		}
+
+		TEST_METHOD(SingleRayTests)
+		{
+			const CU::Ray<float> ray(CU::Vector3<float>(0.f, 0.f, -10.f), CU::Vector3<float>(0.f, 0.f, 2.f));
+			float distance = -1.f;
+
+			Assert::IsTrue(CU::IntersectionAABBRay(CU::AABB3D<float>(CU::Vector3<float>(-1.f, -1.f, -1.f), CU::Vector3<float>(1.f, 1.f, 1.f)), ray, distance));
+			Assert::AreEqual(4.5f, distance);
+			Assert::IsFalse(CU::IntersectionAABBRay(CU::AABB3D<float>(CU::Vector3<float>(2.f, -1.f, -1.f), CU::Vector3<float>(3.f, 1.f, 1.f)), ray, distance));
+			Assert::IsFalse(CU::IntersectionAABBRay(CU::AABB3D<float>(CU::Vector3<float>(-1.f, -1.f, -20.f), CU::Vector3<float>(1.f, 1.f, -15.f)), ray, distance));
+			Assert::IsTrue(CU::IntersectionAABBRay(CU::AABB3D<float>(CU::Vector3<float>(-1.f, -1.f, -11.f), CU::Vector3<float>(1.f, 1.f, 1.f)), ray, distance));
+			Assert::AreEqual(0.f, distance);
+
+			Assert::IsTrue(CU::IntersectionSphereRay(CU::Sphere<float>(CU::Vector3<float>(0.f, 0.f, 0.f), 2.f), ray, distance));
+			Assert::AreEqual(4.f, distance);
+			Assert::IsFalse(CU::IntersectionSphereRay(CU::Sphere<float>(CU::Vector3<float>(3.f, 0.f, 0.f), 2.f), ray, distance));
+			Assert::IsFalse(CU::IntersectionSphereRay(CU::Sphere<float>(CU::Vector3<float>(0.f, 0.f, -20.f), 2.f), ray, distance));
+
+			CU::Plane<float> plane(CU::Vector3<float>(0.f, 0.f, 6.f), CU::Vector3<float>(0.f, 0.f, -1.f));
+			Assert::IsTrue(CU::IntersectionPlaneRay(plane, ray, distance));
+			Assert::AreEqual(8.f, distance);
+			plane.InitWithPointAndNormal(CU::Vector3<float>(0.f, 0.f, -12.f), CU::Vector3<float>(0.f, 0.f, 1.f));
+			Assert::IsFalse(CU::IntersectionPlaneRay(plane, ray, distance));
+			plane.InitWithPointAndNormal(CU::Vector3<float>(0.f, 0.f, 0.f), CU::Vector3<float>(1.f, 0.f, 0.f));
+			Assert::IsFalse(CU::IntersectionPlaneRay(plane, ray, distance));
+
+			const CU::Vector3<float> corner0(-1.f, -1.f, 2.f);
+			const CU::Vector3<float> corner1(3.f, -1.f, 2.f);
+			const CU::Vector3<float> corner2(-1.f, 3.f, 2.f);
+			Assert::IsTrue(CU::IntersectionTriangleRay(corner0, corner1, corner2, ray, distance));
+			Assert::AreEqual(6.f, distance);
+			Assert::IsTrue(CU::IntersectionTriangleRay(corner0, corner2, corner1, ray, distance));
+			const CU::Ray<float> outside(CU::Vector3<float>(2.f, 2.f, -10.f), CU::Vector3<float>(0.f, 0.f, 1.f));
+			Assert::IsFalse(CU::IntersectionTriangleRay(corner0, corner1, corner2, outside, distance));
+			Assert::IsFalse(CU::IntersectionTriangleRay(corner0, corner1, corner2, CU::Ray<float>(CU::Vector3<float>(0.f, 0.f, 5.f), CU::Vector3<float>(0.f, 0.f, 1.f)), distance));
+		}
+
+		TEST_METHOD(RayPacketsMatchSingleTests)
+		{
+			// 1003 rays leave a remainder for every pack width
+			const int count = 1003;
+			unsigned int random = 29u;
+			CU::Vector3Stream<float> origins(count);
+			CU::Vector3Stream<float> directions(count);
+			for (int index = 0; index < count; ++index)
+			{
+				origins.Set(index, NextVector(random, 12));
+				directions.Set(index, NextDirection(random));
+			}
+			const CU::AABB3D<float> aabb(CU::Vector3<float>(-2.5f, -1.5f, -3.5f), CU::Vector3<float>(3.5f, 2.5f, 1.5f));
+			const CU::Sphere<float> sphere(CU::Vector3<float>(1.f, -2.f, 0.f), 5.f);
+			const CU::Plane<float> plane(CU::Vector3<float>(0.f, 1.f, 0.f), CU::Vector3<float>(1.f, 2.f, -1.f));
+			const CU::Vector3<float> corner0(-6.f, -4.f, 0.f);
+			const CU::Vector3<float> corner1(7.f, -5.f, 2.f);
+			const CU::Vector3<float> corner2(0.f, 8.f, -3.f);
+
+			CU::DynamicBitset<> hits(count);
+			std::vector<float> distances(count);
+			int hitCount[4] = {};
+			for (int shape = 0; shape < 4; ++shape)
+			{
+				switch (shape)
+				{
+				case 0: CU::IntersectionAABBRays(aabb, origins, directions, distances.data(), hits.GetWords()); break;
+				case 1: CU::IntersectionSphereRays(sphere, origins, directions, distances.data(), hits.GetWords()); break;
+				case 2: CU::IntersectionPlaneRays(plane, origins, directions, distances.data(), hits.GetWords()); break;
+				default: CU::IntersectionTriangleRays(corner0, corner1, corner2, origins, directions, distances.data(), hits.GetWords()); break;
+				}
+				for (int index = 0; index < count; ++index)
+				{
+					const CU::Ray<float> ray(origins.Get(index), directions.Get(index));
+					float distance = 0.f;
+					bool hit = false;
+					switch (shape)
+					{
+					case 0: hit = CU::IntersectionAABBRay(aabb, ray, distance); break;
+					case 1: hit = CU::IntersectionSphereRay(sphere, ray, distance); break;
+					case 2: hit = CU::IntersectionPlaneRay(plane, ray, distance); break;
+					default: hit = CU::IntersectionTriangleRay(corner0, corner1, corner2, ray, distance); break;
+					}
+					AssertMatches(hit, distance, hits, distances, index);
+					hitCount[shape] += hit ? 1 : 0;
+				}
+				Assert::IsTrue(hitCount[shape] > 0 && hitCount[shape] < count);
+			}
+		}
+
+		TEST_METHOD(ShapePacketsMatchSingleTests)
+		{
+			const int count = 1003;
+			unsigned int random = 31u;
+			CU::Vector3Stream<float> first(count);
+			CU::Vector3Stream<float> second(count);
+			CU::Vector3Stream<float> third(count);
+			std::vector<float> scalars(count);
+			for (int index = 0; index < count; ++index)
+			{
+				first.Set(index, NextVector(random, 10));
+				second.Set(index, NextVector(random, 10));
+				third.Set(index, NextVector(random, 10));
+				scalars[index] = NextInteger(random, 6);
+			}
+			const CU::Ray<float> ray(CU::Vector3<float>(-1.f, 2.f, -3.f), CU::Vector3<float>(1.f, -2.f, 3.f));
+
+			// Boxes from the first stream with half-integer sizes, so no box face goes through the origin
+			CU::Vector3Stream<float> maxs(count);
+			for (int index = 0; index < count; ++index)
+			{
+				maxs.Set(index, first.Get(index) + CU::Vector3<float>(6.5f, 6.5f, 6.5f));
+			}
+			CU::DynamicBitset<> hits(count);
+			std::vector<float> distances(count);
+			int hitCount = 0;
+			CU::IntersectionAABBsRay(first, maxs, ray, distances.data(), hits.GetWords());
+			for (int index = 0; index < count; ++index)
+			{
+				float distance = 0.f;
+				const bool hit = CU::IntersectionAABBRay(CU::AABB3D<float>(first.Get(index), maxs.Get(index)), ray, distance);
+				AssertMatches(hit, distance, hits, distances, index);
+				hitCount += hit ? 1 : 0;
+			}
+			Assert::IsTrue(hitCount > 0 && hitCount < count);
+
+			hitCount = 0;
+			CU::IntersectionSpheresRay(first, scalars.data(), ray, distances.data(), hits.GetWords());
+			for (int index = 0; index < count; ++index)
+			{
+				float distance = 0.f;
+				const bool hit = CU::IntersectionSphereRay(CU::Sphere<float>(first.Get(index), scalars[index]), ray, distance);
+				AssertMatches(hit, distance, hits, distances, index);
+				hitCount += hit ? 1 : 0;
+			}
+			Assert::IsTrue(hitCount > 0 && hitCount < count);
+
+			hitCount = 0;
+			CU::IntersectionPlanesRay(first, scalars.data(), ray, distances.data(), hits.GetWords());
+			for (int index = 0; index < count; ++index)
+			{
+				CU::Plane<float> plane;
+				plane.InitWithNormalAndOffset(first.Get(index), scalars[index]);
+				float distance = 0.f;
+				const bool hit = CU::IntersectionPlaneRay(plane, ray, distance);
+				AssertMatches(hit, distance, hits, distances, index);
+				hitCount += hit ? 1 : 0;
+			}
+			Assert::IsTrue(hitCount > 0 && hitCount < count);
+
+			hitCount = 0;
+			CU::IntersectionTrianglesRay(first, second, third, ray, distances.data(), hits.GetWords());
+			for (int index = 0; index < count; ++index)
+			{
+				float distance = 0.f;
+				const bool hit = CU::IntersectionTriangleRay(first.Get(index), second.Get(index), third.Get(index), ray, distance);
+				AssertMatches(hit, distance, hits, distances, index);
+				hitCount += hit ? 1 : 0;
+			}
+			Assert::IsTrue(hitCount > 0 && hitCount < count);
+		}
+
+		// An empty packet against a single shape or ray must leave the output alone
+		template<class T>
+		static void AssertEmptyPacketsWriteNothing()
+		{
+			const CU::Vector3Stream<T> empty;
+			const CU::Vector3<T> corner0(-1, -1, 0);
+			const CU::Vector3<T> corner1(1, -1, 0);
+			const CU::Vector3<T> corner2(0, 1, 0);
+			const CU::Ray<T> ray(CU::Vector3<T>(0, 0, -5), CU::Vector3<T>(0, 0, 1));
+			for (int test = 0; test < 8; ++test)
+			{
+				uint64_t hitWord = ~0ull;
+				T distance = -1;
+				switch (test)
+				{
+				case 0: CU::IntersectionAABBRays(CU::AABB3D<T>(corner0, corner1 + corner2), empty, empty, &distance, &hitWord); break;
+				case 1: CU::IntersectionSphereRays(CU::Sphere<T>(corner0, 2), empty, empty, &distance, &hitWord); break;
+				case 2: CU::IntersectionPlaneRays(CU::Plane<T>(corner0, corner1, corner2), empty, empty, &distance, &hitWord); break;
+				case 3: CU::IntersectionTriangleRays(corner0, corner1, corner2, empty, empty, &distance, &hitWord); break;
+				case 4: CU::IntersectionAABBsRay(empty, empty, ray, &distance, &hitWord); break;
+				case 5: CU::IntersectionSpheresRay(empty, static_cast<const T*>(nullptr), ray, &distance, &hitWord); break;
+				case 6: CU::IntersectionPlanesRay(empty, static_cast<const T*>(nullptr), ray, &distance, &hitWord); break;
+				default: CU::IntersectionTrianglesRay(empty, empty, empty, ray, &distance, &hitWord); break;
+				}
+				Assert::IsTrue(hitWord == ~0ull);
+				Assert::AreEqual(static_cast<T>(-1), distance);
+			}
+		}
+
+		TEST_METHOD(EmptyPacketsWriteNothing)
+		{
+			AssertEmptyPacketsWriteNothing<float>();
+			AssertEmptyPacketsWriteNothing<double>();
+		}
+	};
+}
@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <vector>
+#include "DynamicBitset.hpp"
+#include "LineVolume.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(LineVolumeTests)
+	{
+	public:
+
+		// Clockwise with y up, so every normal points out
+		static CU::LineVolume<float> MakeTriangle()
+		{
+			const CU::Vector2<float> a(-20.f, -10.f);
+			const CU::Vector2<float> b(0.f, 30.f);
+			const CU::Vector2<float> c(25.f, -10.f);
+			return CU::LineVolume<float>({ CU::Line<float>(a, b), CU::Line<float>(b, c), CU::Line<float>(c, a) });
+		}
+
+		TEST_METHOD(LineSidesAndDistance)
+		{
+			CU::Line<float> line(CU::Vector2<float>(0.f, 0.f), CU::Vector2<float>(4.f, 0.f));
+			Assert::IsTrue(line.Inside(CU::Vector2<float>(2.f, -1.f)));
+			Assert::IsFalse(line.Inside(CU::Vector2<float>(2.f, 1.f)));
+			Assert::IsFalse(line.Inside(CU::Vector2<float>(7.f, 0.f)));
+			Assert::AreEqual(12.f, line.GetDistance(CU::Vector2<float>(-3.f, 3.f)));
+
+			line.Normalize();
+			Assert::AreEqual(1.f, line.GetNormal().Length());
+			Assert::AreEqual(3.f, line.GetDistance(CU::Vector2<float>(-3.f, 3.f)));
+
+			CU::Line<int> exact;
+			exact.InitWith2Points(CU::Vector2<int>(1, 1), CU::Vector2<int>(1, 5));
+			Assert::IsTrue(exact.Inside(CU::Vector2<int>(2, 100)));
+			Assert::IsFalse(exact.Inside(CU::Vector2<int>(0, 0)));
+		}
+
+		TEST_METHOD(VolumeInsideSinglePoints)
+		{
+			const CU::LineVolume<float> triangle = MakeTriangle();
+			Assert::AreEqual(3, triangle.GetLineCount());
+			Assert::IsTrue(triangle.Inside(CU::Vector2<float>(0.f, 0.f)));
+			Assert::IsFalse(triangle.Inside(CU::Vector2<float>(0.f, -11.f)));
+			Assert::IsFalse(triangle.Inside(CU::Vector2<float>(-15.f, 20.f)));
+			Assert::IsFalse(triangle.Inside(CU::Vector2<float>(0.f, 30.f)));
+
+			CU::LineVolume<float> empty;
+			Assert::IsTrue(empty.Inside(CU::Vector2<float>(1000.f, 1000.f)));
+		}
+
+		TEST_METHOD(BatchMatchesSinglePoints)
+		{
+			const CU::LineVolume<float> triangle = MakeTriangle();
+			// Integer coordinates keep the products exact, so points on an edge agree too.
+			// 1003 points leave a remainder for every pack width.
+			std::vector<CU::Vector2<float>> points;
+			unsigned int random = 5u;
+			for (int index = 0; index < 1003; ++index)
+			{
+				random = random * 1664525u + 1013904223u;
+				points.push_back(CU::Vector2<float>(static_cast<float>(static_cast<int>(random >> 16 & 63) - 32), static_cast<float>(static_cast<int>(random >> 24 & 63) - 24)));
+			}
+
+			CU::DynamicBitset<> mask(static_cast<int>(points.size()));
+			mask.SetAll();
+			triangle.Inside(points.data(), static_cast<int>(points.size()), mask.GetWords());
+			CU::GrowingArray<int> indices;
+			triangle.Inside(points.data(), static_cast<int>(points.size()), indices);
+
+			int insideCount = 0;
+			for (int index = 0; index < static_cast<int>(points.size()); ++index)
+			{
+				const bool inside = triangle.Inside(points[index]);
+				Assert::AreEqual(inside, mask[index]);
+				if (inside)
+				{
+					Assert::AreEqual(index, indices[insideCount]);
+					++insideCount;
+				}
+			}
+			Assert::IsTrue(insideCount > 0);
+			Assert::AreEqual(insideCount, indices.Size());
+			Assert::AreEqual(insideCount, mask.PopCount());
+		}
+	};
+}
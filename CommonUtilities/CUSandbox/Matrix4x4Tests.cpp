@@ -0,0 +1,211 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <new>
+#include <vector>
+#include "Matrix3x3.hpp"
+#include "Matrix4x4.hpp"
+#include "Quaternion.hpp"
+#include "TransformBatch.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(Matrix4x4Tests)
+	{
+	public:
+
+		TEST_METHOD(MatrixMultiplyMatchesGenericTemplate)
+		{
+			CU::Matrix4x4<float> left(1.f, 2.f, 3.f, 4.f,
+									  -5.f, 6.f, 0.5f, 8.f,
+									  9.f, -10.f, 11.f, 0.25f,
+									  13.f, 14.f, -15.f, 16.f);
+			CU::Matrix4x4<float> right = CU::Matrix4x4<float>::CreateRotationAroundY(0.7f);
+			right(4, 1) = 3.f;
+			right(4, 2) = -2.f;
+			right(4, 3) = 7.f;
+
+			const CU::Matrix4x4<float> simdResult = left * right;
+			const CU::Matrix4x4<float> scalarResult = CU::operator*<float>(left, right);
+
+			for (int row = 1; row <= 4; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					Assert::AreEqual(scalarResult(row, column), simdResult(row, column), 0.0001f);
+				}
+			}
+		}
+
+		TEST_METHOD(MatrixMultiplyByIdentityIsExact)
+		{
+			CU::Matrix4x4<float> matrix = CU::Matrix4x4<float>::CreateRotationAroundZ(1.3f);
+			matrix(4, 1) = 10.f;
+
+			Assert::IsTrue(matrix * CU::Matrix4x4<float>() == matrix);
+			Assert::IsTrue(CU::Matrix4x4<float>() * matrix == matrix);
+		}
+
+		TEST_METHOD(VectorMultiplyMatchesGenericTemplate)
+		{
+			const CU::Matrix4x4<float> matrix = CU::Matrix4x4<float>::CreateRotationAroundX(-0.4f) * CU::Matrix4x4<float>::CreateRotationAroundZ(2.1f);
+			const CU::Vector4<float> vector(3.f, -1.5f, 8.f, 1.f);
+
+			const CU::Vector4<float> simdResult = vector * matrix;
+			const CU::Vector4<float> scalarResult = CU::operator*<float>(vector, matrix);
+
+			Assert::AreEqual(scalarResult.x, simdResult.x, 0.0001f);
+			Assert::AreEqual(scalarResult.y, simdResult.y, 0.0001f);
+			Assert::AreEqual(scalarResult.z, simdResult.z, 0.0001f);
+			Assert::AreEqual(scalarResult.w, simdResult.w, 0.0001f);
+		}
+
+		CU::Matrix4x4<float> CreateRigidTransform()
+		{
+			CU::Matrix4x4<float> transform = CU::Matrix4x4<float>::CreateRotationAroundY(0.6f) * CU::Matrix4x4<float>::CreateRotationAroundX(-1.1f);
+			transform(4, 1) = 12.f;
+			transform(4, 2) = -3.5f;
+			transform(4, 3) = 0.75f;
+			return transform;
+		}
+
+		void AssertIdentity(const CU::Matrix4x4<float>& aMatrix)
+		{
+			for (int row = 1; row <= 4; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					Assert::AreEqual(row == column ? 1.f : 0.f, aMatrix(row, column), 0.0001f);
+				}
+			}
+		}
+
+		void AssertMatricesEqual(const CU::Matrix4x4<float>& anExpected, const CU::Matrix4x4<float>& anActual)
+		{
+			for (int row = 1; row <= 4; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					Assert::AreEqual(anExpected(row, column), anActual(row, column), 0.0001f);
+				}
+			}
+		}
+
+		TEST_METHOD(InverseOfGeneralMatrix)
+		{
+			const CU::Matrix4x4<float> matrix(2.f, 0.5f, -1.f, 0.25f,
+											  1.f, 3.f, 0.f, -0.5f,
+											  0.f, -2.f, 4.f, 1.f,
+											  5.f, 1.f, 2.f, 1.f);
+
+			const CU::Matrix4x4<float> inverse = CU::Matrix4x4<float>::Inverse(matrix);
+
+			AssertIdentity(CU::operator*<float>(matrix, inverse));
+			AssertIdentity(CU::operator*<float>(inverse, matrix));
+			// The SSE float version against the generic template in double precision
+			const CU::Matrix4x4<double> reference = CU::Matrix4x4<double>::Inverse(CU::Matrix4x4<double>(2.0, 0.5, -1.0, 0.25,
+																										1.0, 3.0, 0.0, -0.5,
+																										0.0, -2.0, 4.0, 1.0,
+																										5.0, 1.0, 2.0, 1.0));
+			for (int row = 1; row <= 4; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					Assert::AreEqual(static_cast<float>(reference(row, column)), inverse(row, column), 0.0001f);
+				}
+			}
+		}
+
+		TEST_METHOD(AffineAndFastInverseMatchGeneralInverse)
+		{
+			const CU::Matrix4x4<float> rigid = CreateRigidTransform();
+			CU::Matrix4x4<float> scaled = rigid;
+			scaled(1, 1) *= 2.f;
+			scaled(2, 3) += 0.5f;
+
+			AssertMatricesEqual(CU::Matrix4x4<float>::Inverse(rigid), CU::Matrix4x4<float>::FastInverse(rigid));
+			AssertMatricesEqual(CU::Matrix4x4<float>::Inverse(rigid), CU::Matrix4x4<float>::InverseAffine(rigid));
+			AssertMatricesEqual(CU::Matrix4x4<float>::Inverse(scaled), CU::Matrix4x4<float>::InverseAffine(scaled));
+			AssertIdentity(CU::Matrix4x4<float>::FastInverse(rigid) * rigid);
+		}
+
+		TEST_METHOD(BatchInverseMatchesSingleInverse)
+		{
+			// Odd count exercises the single matrix remainder
+			std::vector<CU::Matrix4x4<float>> matrices;
+			for (int index = 0; index < 7; ++index)
+			{
+				CU::Matrix4x4<float> matrix = CU::Matrix4x4<float>::CreateRotationAroundZ(index * 0.4f) * CU::Matrix4x4<float>::CreateRotationAroundX(0.3f);
+				matrix(1, 4) = index * 0.1f;
+				matrix(4, 1) = static_cast<float>(index);
+				matrix(3, 3) = 2.f + index;
+				matrices.push_back(matrix);
+			}
+			std::vector<CU::Matrix4x4<float>> inverses(matrices.size());
+
+			CU::InverseMatrices(matrices.data(), inverses.data(), static_cast<int>(matrices.size()));
+
+			for (size_t index = 0; index < matrices.size(); ++index)
+			{
+				AssertMatricesEqual(CU::Matrix4x4<float>::Inverse(matrices[index]), inverses[index]);
+			}
+		}
+
+		TEST_METHOD(Matrix3x3Inverse)
+		{
+			const CU::Matrix3x3<float> matrix(2.f, 0.5f, -1.f, 1.f, 3.f, 0.f, 0.f, -2.f, 4.f);
+			const CU::Matrix4x4<float> product = CU::Matrix4x4<float>(matrix) * CU::Matrix4x4<float>(CU::Matrix3x3<float>::Inverse(matrix));
+
+			for (int row = 1; row <= 3; ++row)
+			{
+				for (int column = 1; column <= 3; ++column)
+				{
+					Assert::AreEqual(row == column ? 1.f : 0.f, product(row, column), 0.0001f);
+				}
+			}
+		}
+
+		TEST_METHOD(CreateTRSMatchesComposedMatrices)
+		{
+			const CU::Vector3<float> translation(4.f, -2.f, 9.f);
+			const CU::Vector3<float> angles(0.4f, -2.2f, 1.3f);
+			const CU::Vector3<float> scale(2.f, 0.5f, 3.f);
+
+			CU::Matrix4x4<float> scaling;
+			scaling(1, 1) = scale.x;
+			scaling(2, 2) = scale.y;
+			scaling(3, 3) = scale.z;
+			CU::Matrix4x4<float> translating;
+			translating(4, 1) = translation.x;
+			translating(4, 2) = translation.y;
+			translating(4, 3) = translation.z;
+			const CU::Matrix4x4<float> expected = scaling * CU::Matrix4x4<float>::CreateRotationAroundX(angles.x) *
+				CU::Matrix4x4<float>::CreateRotationAroundY(angles.y) * CU::Matrix4x4<float>::CreateRotationAroundZ(angles.z) * translating;
+
+			AssertMatricesEqual(expected, CU::Matrix4x4<float>::CreateTRS(translation, angles, scale));
+			AssertMatricesEqual(expected, CU::Matrix4x4<float>::CreateTRS(translation, CU::Quaternion<float>(angles), scale));
+		}
+
+		TEST_METHOD(FloatTypesAreSimdAligned)
+		{
+			Assert::AreEqual(static_cast<size_t>(16), alignof(CU::Vector4<float>));
+			Assert::AreEqual(static_cast<size_t>(16), alignof(CU::Matrix4x4<float>));
+		}
+
+		TEST_METHOD(MatrixMultiplyAtOddSixteenByteAddresses)
+		{
+			// Matrices are only 16-byte aligned, so a 32-byte SIMD path must not assume more
+			alignas(32) unsigned char storage[4 * sizeof(CU::Matrix4x4<float>) + 16];
+			CU::Matrix4x4<float>* left = new (storage + 16) CU::Matrix4x4<float>(CU::Matrix4x4<float>::CreateRotationAroundY(0.7f));
+			CU::Matrix4x4<float>* right = new (storage + 16 + sizeof(CU::Matrix4x4<float>) * 2) CU::Matrix4x4<float>(CreateRigidTransform());
+			Assert::AreEqual(static_cast<size_t>(16), reinterpret_cast<size_t>(left) % 32);
+			Assert::AreEqual(static_cast<size_t>(16), reinterpret_cast<size_t>(right) % 32);
+
+			CU::Matrix4x4<float>* result = new (storage + 16 + sizeof(CU::Matrix4x4<float>)) CU::Matrix4x4<float>();
+			*result = *left * *right;
+			AssertMatricesEqual(CU::operator*<float>(*left, *right), *result);
+		}
+	};
+}
@@ -0,0 +1,101 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Matrix.hpp"
+#include "Matrix3x3.hpp"
+#include "Matrix4x4.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	namespace
+	{
+		// Everything below is evaluated by the compiler
+		constexpr CU::Matrix<float, 2, 3> ourWide(1.f, 2.f, 3.f,
+												   4.f, 5.f, 6.f);
+		constexpr CU::Matrix<float, 3, 2> ourTall = ourWide.GetTransposed();
+		constexpr CU::Matrix<float, 2, 2> ourProduct = ourWide * ourTall;
+		constexpr CU::Matrix4x4<float> ourTranslation(1.f, 0.f, 0.f, 0.f,
+													  0.f, 1.f, 0.f, 0.f,
+													  0.f, 0.f, 1.f, 0.f,
+													  5.f, -2.f, 3.f, 1.f);
+		constexpr CU::Matrix<float, 4, 4> ourDoubleTranslation = CU::Matrix<float, 4, 4>::Multiply(ourTranslation, ourTranslation);
+
+		constexpr CU::Matrix<int, 3, 3> ourIdentity;
+
+		static_assert(ourIdentity(2, 2) == 1 && ourIdentity(2, 3) == 0 && ourIdentity == CU::Matrix<int, 3, 3>::Identity(), "Default matrix is not the identity");
+		static_assert(ourTall.Get<3, 1>() == 3.f && ourTall.Get<1, 2>() == 4.f, "Transpose is wrong");
+		static_assert(ourProduct.Get<1, 1>() == 14.f && ourProduct.Get<1, 2>() == 32.f && ourProduct.Get<2, 2>() == 77.f, "Product is wrong");
+		static_assert(ourDoubleTranslation.Get<4, 1>() == 10.f && ourDoubleTranslation.Get<4, 4>() == 1.f, "Matrix4x4 product is wrong");
+		static_assert(CU::Matrix3x3<float>(ourTranslation) == CU::Matrix3x3<float>(), "Matrix3x3 from Matrix4x4 is wrong");
+	}
+
+	TEST_CLASS(MatrixTests)
+	{
+	public:
+
+		TEST_METHOD(LayoutDoesNotChangeElements)
+		{
+			const CU::Matrix<float, 3, 4, CU::MatrixLayout::RowMajor> rowMajor(1.f, 2.f, 3.f, 4.f,
+																				5.f, 6.f, 7.f, 8.f,
+																				9.f, 10.f, 11.f, 12.f);
+			const CU::Matrix<float, 3, 4, CU::MatrixLayout::ColumnMajor> columnMajor(1.f, 2.f, 3.f, 4.f,
+																					  5.f, 6.f, 7.f, 8.f,
+																					  9.f, 10.f, 11.f, 12.f);
+
+			for (int row = 1; row <= 3; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					Assert::AreEqual(rowMajor(row, column), columnMajor(row, column));
+				}
+			}
+
+			// The second stored element is (1, 2) in rows and (2, 1) in columns
+			Assert::AreEqual(2.f, rowMajor.GetData()[1]);
+			Assert::AreEqual(5.f, columnMajor.GetData()[1]);
+		}
+
+		TEST_METHOD(ColumnMajorProductMatchesRowMajor)
+		{
+			const CU::Matrix<double, 2, 3, CU::MatrixLayout::ColumnMajor> left(1.0, -2.0, 0.5,
+																				3.0, 4.0, -1.0);
+			const CU::Matrix<double, 3, 2, CU::MatrixLayout::ColumnMajor> right(2.0, 1.0,
+																				 0.0, -3.0,
+																				 5.0, 2.0);
+
+			const CU::Matrix<double, 2, 2, CU::MatrixLayout::ColumnMajor> product = left * right;
+
+			Assert::AreEqual(1.0 * 2.0 + -2.0 * 0.0 + 0.5 * 5.0, product(1, 1));
+			Assert::AreEqual(1.0 * 1.0 + -2.0 * -3.0 + 0.5 * 2.0, product(1, 2));
+			Assert::AreEqual(3.0 * 2.0 + 4.0 * 0.0 + -1.0 * 5.0, product(2, 1));
+			Assert::AreEqual(3.0 * 1.0 + 4.0 * -3.0 + -1.0 * 2.0, product(2, 2));
+		}
+
+		TEST_METHOD(ElementWiseOperators)
+		{
+			CU::Matrix<int, 2, 2> matrix(1, 2,
+										 3, 4);
+			const CU::Matrix<int, 2, 2> doubled = 2 * matrix;
+
+			Assert::IsTrue(doubled - matrix == matrix);
+			Assert::IsTrue(doubled + matrix != doubled);
+			Assert::AreEqual(12, (doubled + matrix).Get<2, 2>());
+
+			matrix(2, 1) = 7;
+			Assert::AreEqual(7, matrix.Get<2, 1>());
+		}
+
+		TEST_METHOD(WrappersKeepTheirLayoutAndSize)
+		{
+			Assert::AreEqual(sizeof(float) * 16, sizeof(CU::Matrix4x4<float>));
+			Assert::AreEqual(sizeof(float) * 9, sizeof(CU::Matrix3x3<float>));
+			Assert::AreEqual(static_cast<size_t>(16), alignof(CU::Matrix<float, 4, 4>));
+
+			const CU::Matrix4x4<float> rotation = CU::Matrix4x4<float>::CreateRotationAroundZ(0.5f);
+			Assert::AreEqual(rotation(1, 2), rotation.GetData()[1]);
+			Assert::AreEqual(rotation(2, 1), CU::Matrix4x4<float>::Transpose(rotation)(1, 2));
+		}
+	};
+}
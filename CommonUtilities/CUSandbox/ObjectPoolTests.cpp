@@ -0,0 +1,161 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <string>
+#include <thread>
+#include <vector>
+#include "GrowingArray.hpp"
+#include "ObjectPool.hpp"
+#include "StaticArray.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(ObjectPoolTests)
+	{
+	public:
+
+		struct Enemy
+		{
+			static int ourLiveCount;
+
+			Enemy(const int aHealth, const std::string& aName) : myHealth(aHealth), myName(aName) { ++ourLiveCount; }
+			~Enemy() { --ourLiveCount; }
+
+			int myHealth;
+			std::string myName;
+		};
+
+		TEST_METHOD(ReleasedMemoryIsReused)
+		{
+			CU::ObjectPool<Enemy> pool(4);
+			Enemy* first = pool.Acquire(10, "first");
+			Enemy* second = pool.Acquire(20, "second");
+			Assert::AreEqual(2, pool.Count());
+			Assert::AreEqual(4, pool.Capacity());
+
+			pool.Release(first);
+			Enemy* third = pool.Acquire(30, "third");
+			Assert::IsTrue(first == third);
+			Assert::AreEqual(std::string("second"), second->myName);
+
+			for (int index = 0; index < 6; ++index)
+			{
+				pool.Acquire(index, "more");
+			}
+			Assert::AreEqual(8, pool.Count());
+			Assert::AreEqual(8, pool.Capacity());
+		}
+
+		TEST_METHOD(ResetDestroysLiveObjectsAndKeepsChunks)
+		{
+			Enemy::ourLiveCount = 0;
+			{
+				CU::ObjectPool<Enemy> pool(3);
+				std::vector<Enemy*> enemies;
+				for (int index = 0; index < 10; ++index)
+				{
+					enemies.push_back(pool.Acquire(index, std::string(32, 'e')));
+				}
+				pool.Release(enemies[1]);
+				pool.Release(enemies[7]);
+				Assert::AreEqual(8, Enemy::ourLiveCount);
+
+				pool.Reset();
+				Assert::AreEqual(0, Enemy::ourLiveCount);
+				Assert::AreEqual(0, pool.Count());
+				Assert::AreEqual(12, pool.Capacity());
+
+				Enemy* reused = pool.Acquire(1, "reused");
+				Assert::IsTrue(reused == enemies[0]);
+				pool.Acquire(2, "left alive");
+			}
+			// The pool destroys what is still alive
+			Assert::AreEqual(0, Enemy::ourLiveCount);
+		}
+
+		TEST_METHOD(UniquePointersReplaceOwningRawPointers)
+		{
+			Enemy::ourLiveCount = 0;
+			CU::ObjectPool<Enemy> pool;
+			{
+				CU::GrowingArray<CU::ObjectPool<Enemy>::UniquePointer> enemies;
+				CU::StaticArray<CU::ObjectPool<Enemy>::UniquePointer, 4> bosses;
+				for (int index = 0; index < 100; ++index)
+				{
+					enemies.Add(pool.MakeUnique(index, "grunt"));
+				}
+				bosses[0] = pool.MakeUnique(1000, "boss");
+				enemies.RemoveCyclicAtIndex(0);
+				Assert::AreEqual(100, pool.Count());
+				Assert::AreEqual(99, enemies[0]->myHealth);
+			}
+			Assert::AreEqual(0, pool.Count());
+			Assert::AreEqual(0, Enemy::ourLiveCount);
+		}
+
+		TEST_METHOD(LocalCachesShareOnePool)
+		{
+			static const int threadCount = 4;
+			CU::ObjectPool<int> pool(64);
+			std::vector<std::thread> threads;
+			for (int thread = 0; thread < threadCount; ++thread)
+			{
+				threads.emplace_back([&pool]()
+				{
+					CU::ObjectPool<int>::LocalCache cache(pool, 8);
+					std::vector<int*> held;
+					for (int round = 0; round < 50; ++round)
+					{
+						for (int index = 0; index < 20; ++index)
+						{
+							held.push_back(cache.Acquire(index));
+						}
+						for (int* value : held)
+						{
+							cache.Release(value);
+						}
+						held.clear();
+					}
+				});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			Assert::AreEqual(0, pool.Count());
+			Assert::IsTrue(pool.Capacity() <= threadCount * 64);
+		}
+
+		TEST_METHOD(UniquePointersReleaseIntoTheirCache)
+		{
+			static const int threadCount = 4;
+			CU::ObjectPool<std::string> pool(16);
+			std::vector<std::thread> threads;
+			for (int thread = 0; thread < threadCount; ++thread)
+			{
+				threads.emplace_back([&pool]()
+				{
+					CU::ObjectPool<std::string>::LocalCache cache(pool, 4);
+					for (int round = 0; round < 50; ++round)
+					{
+						CU::GrowingArray<CU::ObjectPool<std::string>::UniquePointer> names;
+						for (int index = 0; index < 20; ++index)
+						{
+							names.Add(cache.MakeUnique(static_cast<size_t>(32 + index), 'e'));
+						}
+						names.RemoveCyclicAtIndex(3);
+					}
+				});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			Assert::AreEqual(0, pool.Count());
+		}
+	};
+
+	int ObjectPoolTests::Enemy::ourLiveCount = 0;
+}
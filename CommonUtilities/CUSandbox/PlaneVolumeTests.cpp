@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <vector>
+#include "DynamicBitset.hpp"
+#include "PlaneVolume.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(PlaneVolumeTests)
+	{
+	public:
+
+		// Left-handed perspective looking down +z from the origin, 90 degrees field of view, depth 1 to 100
+		static CU::Matrix4x4<float> MakeProjection()
+		{
+			const float nearDepth = 1.f;
+			const float farDepth = 100.f;
+			const float depthScale = farDepth / (farDepth - nearDepth);
+			return CU::Matrix4x4<float>(
+				1.f, 0.f, 0.f, 0.f,
+				0.f, 1.f, 0.f, 0.f,
+				0.f, 0.f, depthScale, 1.f,
+				0.f, 0.f, -nearDepth * depthScale, 0.f);
+		}
+
+		TEST_METHOD(PlaneSidesAndDistance)
+		{
+			CU::Plane<float> plane(CU::Vector3<float>(0.f, 2.f, 0.f), CU::Vector3<float>(1.f, 2.f, 0.f), CU::Vector3<float>(0.f, 2.f, 1.f));
+			Assert::AreEqual(-1.f, plane.GetNormal().y);
+			Assert::IsTrue(plane.Inside(CU::Vector3<float>(5.f, 3.f, -5.f)));
+			Assert::IsFalse(plane.Inside(CU::Vector3<float>(0.f, 1.f, 0.f)));
+			Assert::AreEqual(-1.f, plane.GetDistance(CU::Vector3<float>(7.f, 3.f, 7.f)));
+
+			CU::Plane<float> scaled(CU::Vector3<float>(0.f, 0.f, 4.f), CU::Vector3<float>(0.f, 0.f, 3.f));
+			Assert::AreEqual(6.f, scaled.GetDistance(CU::Vector3<float>(1.f, 1.f, 6.f)));
+			scaled.Normalize();
+			Assert::AreEqual(2.f, scaled.GetDistance(CU::Vector3<float>(1.f, 1.f, 6.f)));
+		}
+
+		TEST_METHOD(FrustumClassifiesSingleBounds)
+		{
+			const CU::PlaneVolume<float> frustum = CU::PlaneVolume<float>::CreateFrustum(MakeProjection());
+			Assert::AreEqual(6, frustum.GetPlaneCount());
+			Assert::IsTrue(frustum.Inside(CU::Vector3<float>(0.f, 0.f, 10.f)));
+			Assert::IsTrue(frustum.Inside(CU::Vector3<float>(9.f, -9.f, 10.f)));
+			Assert::IsFalse(frustum.Inside(CU::Vector3<float>(11.f, 0.f, 10.f)));
+			Assert::IsFalse(frustum.Inside(CU::Vector3<float>(0.f, 0.f, 0.5f)));
+			Assert::IsFalse(frustum.Inside(CU::Vector3<float>(0.f, 0.f, 101.f)));
+
+			Assert::IsTrue(frustum.ClassifySphere(CU::Vector3<float>(0.f, 0.f, 50.f), 5.f) == CU::Containment::Inside);
+			Assert::IsTrue(frustum.ClassifySphere(CU::Vector3<float>(0.f, 0.f, 0.5f), 1.f) == CU::Containment::Intersecting);
+			Assert::IsTrue(frustum.ClassifySphere(CU::Vector3<float>(0.f, 60.f, 50.f), 5.f) == CU::Containment::Outside);
+			Assert::IsTrue(frustum.ClassifyAABB(CU::Vector3<float>(0.f, 0.f, 50.f), CU::Vector3<float>(2.f, 2.f, 2.f)) == CU::Containment::Inside);
+			Assert::IsTrue(frustum.ClassifyAABB(CU::Vector3<float>(52.f, 0.f, 50.f), CU::Vector3<float>(3.f, 3.f, 3.f)) == CU::Containment::Intersecting);
+			Assert::IsTrue(frustum.ClassifyAABB(CU::Vector3<float>(0.f, 0.f, -5.f), CU::Vector3<float>(3.f, 3.f, 3.f)) == CU::Containment::Outside);
+		}
+
+		TEST_METHOD(BatchMatchesSingleBounds)
+		{
+			const CU::PlaneVolume<float> frustum = CU::PlaneVolume<float>::CreateFrustum(MakeProjection());
+			// 1003 bounds leave a remainder for every pack width
+			const int count = 1003;
+			CU::Vector3Stream<float> centers(count);
+			CU::Vector3Stream<float> extents(count);
+			std::vector<float> radii(count);
+			unsigned int random = 17u;
+			auto next = [&random](const float aScale)
+			{
+				random = random * 1664525u + 1013904223u;
+				return static_cast<float>(random >> 8) / 16777216.f * aScale;
+			};
+			for (int index = 0; index < count; ++index)
+			{
+				centers.Set(index, CU::Vector3<float>(next(240.f) - 120.f, next(240.f) - 120.f, next(130.f) - 15.f));
+				extents.Set(index, CU::Vector3<float>(next(6.f), next(6.f), next(6.f)));
+				radii[index] = next(6.f);
+			}
+
+			CU::DynamicBitset<> visible(count);
+			CU::DynamicBitset<> inside(count);
+			std::vector<unsigned char> cache(CU::PlaneVolume<float>::GetPlaneCacheSize(count), 0);
+			for (int frame = 0; frame < 2; ++frame)
+			{
+				frustum.ClassifySpheres(centers, radii.data(), visible.GetWords(), inside.GetWords(), cache.data());
+				for (int index = 0; index < count; ++index)
+				{
+					const CU::Containment expected = frustum.ClassifySphere(centers.Get(index), radii[index]);
+					Assert::AreEqual(expected != CU::Containment::Outside, visible[index]);
+					Assert::AreEqual(expected == CU::Containment::Inside, inside[index]);
+					Assert::IsTrue(cache[index / 16] < 6);
+				}
+			}
+
+			int visibleCount = 0;
+			int insideCount = 0;
+			frustum.ClassifyAABBs(centers, extents, visible.GetWords(), inside.GetWords());
+			for (int index = 0; index < count; ++index)
+			{
+				const CU::Containment expected = frustum.ClassifyAABB(centers.Get(index), extents.Get(index));
+				Assert::AreEqual(expected != CU::Containment::Outside, visible[index]);
+				Assert::AreEqual(expected == CU::Containment::Inside, inside[index]);
+				visibleCount += visible[index] ? 1 : 0;
+				insideCount += inside[index] ? 1 : 0;
+			}
+			Assert::IsTrue(insideCount > 0 && visibleCount > insideCount && visibleCount < count);
+		}
+
+		// Fills a plane cache against the whole frustum, then keeps using it after all but two planes are removed
+		template<class T>
+		static void CheckCacheSurvivesRemovedPlanes()
+		{
+			const CU::Matrix4x4<float> projection = MakeProjection();
+			CU::Matrix4x4<T> typedProjection;
+			for (int row = 1; row <= 4; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					typedProjection(row, column) = static_cast<T>(projection(row, column));
+				}
+			}
+			CU::PlaneVolume<T> volume = CU::PlaneVolume<T>::CreateFrustum(typedProjection);
+
+			// Groups of 16 bounds far behind and above the camera, so the last planes reject them
+			const int count = 320;
+			CU::Vector3Stream<T> centers(count);
+			std::vector<T> radii(count, static_cast<T>(1));
+			for (int index = 0; index < count; ++index)
+			{
+				const T group = static_cast<T>(index / 16);
+				centers.Set(index, CU::Vector3<T>(static_cast<T>(index % 16), group * 20 - 200, index < count / 2 ? static_cast<T>(-50) : static_cast<T>(500)));
+			}
+			CU::DynamicBitset<> visible(count);
+			std::vector<unsigned char> cache(CU::PlaneVolume<T>::GetPlaneCacheSize(count), 0);
+			volume.ClassifySpheres(centers, radii.data(), visible.GetWords(), nullptr, cache.data());
+			Assert::IsTrue(*std::max_element(cache.begin(), cache.end()) >= 2);
+
+			const CU::Plane<T> left = volume.GetPlane(0);
+			const CU::Plane<T> right = volume.GetPlane(1);
+			volume.RemoveAll();
+			volume.AddPlane(left);
+			volume.AddPlane(right);
+			for (int frame = 0; frame < 2; ++frame)
+			{
+				volume.ClassifySpheres(centers, radii.data(), visible.GetWords(), nullptr, cache.data());
+				for (int index = 0; index < count; ++index)
+				{
+					Assert::AreEqual(volume.ClassifySphere(centers.Get(index), radii[index]) != CU::Containment::Outside, visible[index]);
+					Assert::IsTrue(cache[index / 16] < 2);
+				}
+			}
+		}
+
+		TEST_METHOD(PlaneCacheSurvivesRemovedPlanes)
+		{
+			CheckCacheSurvivesRemovedPlanes<float>();
+			CheckCacheSurvivesRemovedPlanes<double>();
+		}
+	};
+}
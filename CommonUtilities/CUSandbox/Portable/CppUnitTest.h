@@ -0,0 +1,168 @@
+#pragma once
+// Stand-in for the Visual Studio CppUnitTest framework, so the CUSandbox tests build and run with GCC
+// and Clang. Only the CMake build puts this directory on the include path; TestRunner.cpp runs the tests.
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Microsoft
+{
+	namespace VisualStudio
+	{
+		namespace CppUnitTestFramework
+		{
+			struct TestFailure
+			{
+				std::string myMessage;
+			};
+
+			struct TestMethodInfo
+			{
+				const char* myClassName;
+				const char* myMethodName;
+				void (*myRun)();
+			};
+
+			inline std::vector<TestMethodInfo>& GetTestMethods()
+			{
+				static std::vector<TestMethodInfo> ourMethods;
+				return ourMethods;
+			}
+
+			struct TestMethodRegistration
+			{
+				TestMethodRegistration(const char* aClassName, const char* aMethodName, void (*aRun)())
+				{
+					GetTestMethods().push_back({ aClassName, aMethodName, aRun });
+				}
+			};
+
+			// Referencing ourRegistration from TEST_METHOD instantiates it, which registers the method before main
+			template<class Method>
+			struct TestMethodRegistrar
+			{
+				static TestMethodRegistration ourRegistration;
+			};
+
+			template<class Method>
+			TestMethodRegistration TestMethodRegistrar<Method>::ourRegistration(Method::ClassName(), Method::Name(), &Method::Run);
+
+			template<class T>
+			class TestClass
+			{
+			public:
+				typedef T ThisClass;
+			};
+
+			class Assert
+			{
+			public:
+				template<class T>
+				static void AreEqual(const T& anExpected, const T& anActual, const wchar_t* aMessage = nullptr)
+				{
+					if (!(anExpected == anActual))
+					{
+						Fail("AreEqual", ToString(anExpected), ToString(anActual), aMessage);
+					}
+				}
+
+				static void AreEqual(const float anExpected, const float anActual, const float aTolerance, const wchar_t* aMessage = nullptr)
+				{
+					if (!(std::fabs(anExpected - anActual) <= aTolerance))
+					{
+						Fail("AreEqual", ToString(anExpected), ToString(anActual), aMessage);
+					}
+				}
+
+				static void AreEqual(const double anExpected, const double anActual, const double aTolerance, const wchar_t* aMessage = nullptr)
+				{
+					if (!(std::fabs(anExpected - anActual) <= aTolerance))
+					{
+						Fail("AreEqual", ToString(anExpected), ToString(anActual), aMessage);
+					}
+				}
+
+				template<class T>
+				static void AreNotEqual(const T& aNotExpected, const T& anActual, const wchar_t* aMessage = nullptr)
+				{
+					if (aNotExpected == anActual)
+					{
+						Fail("AreNotEqual", ToString(aNotExpected), ToString(anActual), aMessage);
+					}
+				}
+
+				static void IsTrue(const bool aCondition, const wchar_t* aMessage = nullptr)
+				{
+					if (!aCondition)
+					{
+						Fail("IsTrue", "true", "false", aMessage);
+					}
+				}
+
+				static void IsFalse(const bool aCondition, const wchar_t* aMessage = nullptr)
+				{
+					if (aCondition)
+					{
+						Fail("IsFalse", "false", "true", aMessage);
+					}
+				}
+
+				static void Fail(const wchar_t* aMessage = nullptr)
+				{
+					Fail("Fail", "", "", aMessage);
+				}
+
+			private:
+				template<class T>
+				static typename std::enable_if<std::is_arithmetic<T>::value, std::string>::type ToString(const T& aValue)
+				{
+					std::ostringstream stream;
+					stream.precision(9);
+					stream << +aValue;
+					return stream.str();
+				}
+
+				template<class T>
+				static typename std::enable_if<!std::is_arithmetic<T>::value, std::string>::type ToString(const T&)
+				{
+					return "<object>";
+				}
+
+				static void Fail(const char* anAssert, const std::string& anExpected, const std::string& anActual, const wchar_t* aMessage)
+				{
+					std::string message = std::string(anAssert) + " failed";
+					if (!anExpected.empty() || !anActual.empty())
+					{
+						message += ": expected <" + anExpected + "> actual <" + anActual + ">";
+					}
+					if (aMessage != nullptr)
+					{
+						message += " - ";
+						for (const wchar_t* character = aMessage; *character != 0; ++character)
+						{
+							message += static_cast<char>(*character);
+						}
+					}
+					throw TestFailure{ message };
+				}
+			};
+		}
+	}
+}
+
+#define TEST_CLASS(aClassName) \
+	class aClassName; \
+	inline const char* CppUnitTestClassName(aClassName*) { return #aClassName; } \
+	class aClassName : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<aClassName>
+
+#define TEST_METHOD(aMethodName) \
+	struct aMethodName##Method \
+	{ \
+		static const char* ClassName() { return CppUnitTestClassName(static_cast<ThisClass*>(nullptr)); } \
+		static const char* Name() { return #aMethodName; } \
+		static void Run() { ThisClass().aMethodName(); } \
+		static const void* Registration() { return &::Microsoft::VisualStudio::CppUnitTestFramework::TestMethodRegistrar<aMethodName##Method>::ourRegistration; } \
+	}; \
+	void aMethodName()
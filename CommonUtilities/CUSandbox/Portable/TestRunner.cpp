@@ -0,0 +1,53 @@
+// TestRunner.cpp : Runs every TEST_METHOD registered through Portable/CppUnitTest.h.
+// Pass a filter to run only the tests whose "Class::Method" name contains it. Returns the number of failures.
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+int main(int argc, char* argv[])
+{
+	const std::string filter = argc > 1 ? argv[1] : "";
+
+	std::vector<TestMethodInfo> methods = GetTestMethods();
+	std::sort(methods.begin(), methods.end(), [](const TestMethodInfo& aLeft, const TestMethodInfo& aRight)
+	{
+		const int classOrder = std::string(aLeft.myClassName).compare(aRight.myClassName);
+		return classOrder != 0 ? classOrder < 0 : std::string(aLeft.myMethodName) < aRight.myMethodName;
+	});
+
+	int run = 0;
+	int failed = 0;
+	for (const TestMethodInfo& method : methods)
+	{
+		const std::string name = std::string(method.myClassName) + "::" + method.myMethodName;
+		if (name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		++run;
+		try
+		{
+			method.myRun();
+			std::cout << "[  PASSED  ] " << name << std::endl;
+		}
+		catch (const TestFailure& aFailure)
+		{
+			++failed;
+			std::cout << "[  FAILED  ] " << name << ": " << aFailure.myMessage << std::endl;
+		}
+		catch (const std::exception& anException)
+		{
+			++failed;
+			std::cout << "[  FAILED  ] " << name << ": exception " << anException.what() << std::endl;
+		}
+	}
+
+	std::cout << run - failed << " of " << run << " tests passed" << std::endl;
+	return failed;
+}
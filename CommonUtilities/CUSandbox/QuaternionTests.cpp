@@ -0,0 +1,126 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <vector>
+#include "Quaternion.hpp"
+#include "TransformBatch.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(QuaternionTests)
+	{
+	public:
+
+		void AssertMatricesEqual(const CU::Matrix4x4<float>& anExpected, const CU::Matrix4x4<float>& anActual)
+		{
+			for (int row = 1; row <= 4; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					Assert::AreEqual(anExpected(row, column), anActual(row, column), 0.0001f);
+				}
+			}
+		}
+
+		void AssertSameRotation(const CU::Quaternion<float>& anExpected, const CU::Quaternion<float>& anActual)
+		{
+			// q and -q describe the same rotation
+			Assert::AreEqual(1.f, fabsf(anExpected.Dot(anActual)), 0.0001f);
+		}
+
+		TEST_METHOD(AxisAngleMatchesRotationMatrices)
+		{
+			AssertMatricesEqual(CU::Matrix4x4<float>::CreateRotationAroundX(0.7f), CU::Quaternion<float>(CU::Vector3<float>(1.f, 0.f, 0.f), 0.7f).GetRotationMatrix4x4());
+			AssertMatricesEqual(CU::Matrix4x4<float>::CreateRotationAroundY(-1.2f), CU::Quaternion<float>(CU::Vector3<float>(0.f, 1.f, 0.f), -1.2f).GetRotationMatrix4x4());
+			AssertMatricesEqual(CU::Matrix4x4<float>::CreateRotationAroundZ(2.5f), CU::Quaternion<float>(CU::Vector3<float>(0.f, 0.f, 1.f), 2.5f).GetRotationMatrix4x4());
+		}
+
+		TEST_METHOD(EulerAnglesRotateXThenYThenZ)
+		{
+			const CU::Quaternion<float> rotation(CU::Vector3<float>(0.3f, -0.8f, 1.1f));
+			const CU::Matrix4x4<float> expected = CU::Matrix4x4<float>::CreateRotationAroundX(0.3f) *
+				CU::Matrix4x4<float>::CreateRotationAroundY(-0.8f) * CU::Matrix4x4<float>::CreateRotationAroundZ(1.1f);
+
+			AssertMatricesEqual(expected, rotation.GetRotationMatrix4x4());
+		}
+
+		TEST_METHOD(MultiplyAppliesLeftRotationFirst)
+		{
+			const CU::Quaternion<float> first(CU::Vector3<float>(0.f, 1.f, 0.f), 0.9f);
+			const CU::Quaternion<float> second(CU::Vector3<float>(0.6f, 0.f, 0.8f), -0.4f);
+
+			AssertMatricesEqual(first.GetRotationMatrix4x4() * second.GetRotationMatrix4x4(), (first * second).GetRotationMatrix4x4());
+
+			const CU::Quaternion<float> generic = CU::operator*<float>(first, second);
+			AssertSameRotation(generic, first * second);
+
+			CU::Quaternion<float> combined = first;
+			combined *= second;
+			AssertSameRotation(first * second, combined);
+		}
+
+		TEST_METHOD(RotateVectorMatchesMatrix)
+		{
+			const CU::Quaternion<float> rotation(CU::Vector3<float>(0.5f, -1.f, 2.f));
+			const CU::Vector3<float> vector(3.f, -2.f, 0.5f);
+
+			const CU::Vector3<float> rotated = rotation.RotateVector(vector);
+			const CU::Vector3<float> expected = vector * rotation.GetRotationMatrix3x3();
+
+			Assert::AreEqual(expected.x, rotated.x, 0.0001f);
+			Assert::AreEqual(expected.y, rotated.y, 0.0001f);
+			Assert::AreEqual(expected.z, rotated.z, 0.0001f);
+
+			const CU::Vector3<float> back = rotation.GetConjugate().RotateVector(rotated);
+			Assert::AreEqual(vector.x, back.x, 0.0001f);
+			Assert::AreEqual(vector.y, back.y, 0.0001f);
+			Assert::AreEqual(vector.z, back.z, 0.0001f);
+		}
+
+		TEST_METHOD(SlerpMovesAtConstantAngularSpeed)
+		{
+			const CU::Vector3<float> axis(0.f, 0.f, 1.f);
+			const CU::Quaternion<float> from(axis, 0.2f);
+			const CU::Quaternion<float> to(axis, 1.8f);
+
+			AssertSameRotation(from, CU::Quaternion<float>::Slerp(from, to, 0.f));
+			AssertSameRotation(to, CU::Quaternion<float>::Slerp(from, to, 1.f));
+			AssertSameRotation(CU::Quaternion<float>(axis, 0.6f), CU::Quaternion<float>::Slerp(from, to, 0.25f));
+
+			const CU::Quaternion<double> generic = CU::Quaternion<double>::Slerp(CU::Quaternion<double>(CU::Vector3<double>(0.0, 0.0, 1.0), 0.2),
+				CU::Quaternion<double>(CU::Vector3<double>(0.0, 0.0, 1.0), 1.8), 0.25);
+			Assert::AreEqual(sin(0.3), generic.z, 0.000001);
+			Assert::AreEqual(cos(0.3), generic.w, 0.000001);
+
+			// Halfway is exact for both, and the negated target still takes the short way
+			const CU::Quaternion<float> negatedTo(-to.x, -to.y, -to.z, -to.w);
+			AssertSameRotation(CU::Quaternion<float>(axis, 1.f), CU::Quaternion<float>::Nlerp(from, negatedTo, 0.5f));
+			AssertSameRotation(CU::Quaternion<float>(axis, 1.f), CU::Quaternion<float>::Slerp(from, negatedTo, 0.5f));
+			Assert::AreEqual(1.f, CU::Quaternion<float>::Nlerp(from, to, 0.3f).Length(), 0.0001f);
+		}
+
+		TEST_METHOD(BatchConversionMatchesSingleConversion)
+		{
+			std::vector<CU::Quaternion<float>> rotations;
+			for (int index = 0; index < 11; ++index)
+			{
+				rotations.push_back(CU::Quaternion<float>(CU::Vector3<float>(index * 0.3f, 1.f - index * 0.2f, index * 0.1f)));
+			}
+			std::vector<CU::Matrix4x4<float>> matrices(rotations.size());
+
+			CU::QuaternionsToMatrices(rotations.data(), matrices.data(), static_cast<int>(rotations.size()));
+
+			for (size_t index = 0; index < rotations.size(); ++index)
+			{
+				AssertMatricesEqual(rotations[index].GetRotationMatrix4x4(), matrices[index]);
+			}
+		}
+
+		TEST_METHOD(QuaternionIsSixteenBytes)
+		{
+			Assert::AreEqual(sizeof(float) * 4, sizeof(CU::Quaternion<float>));
+		}
+	};
+}
@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "MpmcRing.hpp"
+#include "SpscRing.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(RingTests)
+	{
+	public:
+
+		template<class Ring>
+		void AssertFillsAndEmptiesInOrder(Ring& aRing)
+		{
+			// Three laps so the indices wrap around the buffer
+			int next = 0;
+			int expected = 0;
+			for (int lap = 0; lap < 3; ++lap)
+			{
+				while (aRing.Push(next))
+				{
+					++next;
+				}
+				Assert::AreEqual(Ring::Capacity(), aRing.Count());
+
+				int value;
+				while (aRing.Pop(value))
+				{
+					Assert::AreEqual(expected++, value);
+				}
+				Assert::AreEqual(0, aRing.Count());
+			}
+			Assert::AreEqual(next, expected);
+		}
+
+		TEST_METHOD(SingleThreadFullAndEmpty)
+		{
+			CU::SpscRing<int, 8> spsc;
+			AssertFillsAndEmptiesInOrder(spsc);
+			CU::MpmcRing<int, 8> mpmc;
+			AssertFillsAndEmptiesInOrder(mpmc);
+		}
+
+		TEST_METHOD(BatchesStopAtCapacity)
+		{
+			CU::SpscRing<int, 16> ring;
+			int values[20];
+			for (int index = 0; index < 20; ++index)
+			{
+				values[index] = index;
+			}
+			Assert::AreEqual(10, ring.PushBatch(values, 10));
+			Assert::AreEqual(6, ring.PushBatch(values + 10, 10));
+			Assert::AreEqual(0, ring.PushBatch(values, 1));
+
+			int output[20];
+			Assert::AreEqual(4, ring.PopBatch(output, 4));
+			Assert::AreEqual(4, ring.PushBatch(values + 16, 4));
+			Assert::AreEqual(16, ring.PopBatch(output + 4, 20));
+			for (int index = 0; index < 20; ++index)
+			{
+				Assert::AreEqual(index, output[index]);
+			}
+
+			CU::MpmcRing<int, 16> mpmc;
+			Assert::AreEqual(16, mpmc.PushBatch(values, 20));
+			Assert::AreEqual(16, mpmc.PopBatch(output, 20));
+			Assert::AreEqual(15, output[15]);
+		}
+
+		TEST_METHOD(SpscKeepsOrderAcrossThreads)
+		{
+			static const int count = 100000;
+			CU::SpscRing<int, 64> ring;
+			std::thread producer([&ring]()
+			{
+				for (int value = 0; value < count; ++value)
+				{
+					while (!ring.Push(value))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+
+			bool inOrder = true;
+			for (int expected = 0; expected < count;)
+			{
+				int values[16];
+				const int popped = ring.PopBatch(values, 16);
+				for (int index = 0; index < popped; ++index)
+				{
+					inOrder = inOrder && values[index] == expected++;
+				}
+				if (popped == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+			producer.join();
+			Assert::IsTrue(inOrder);
+		}
+
+		TEST_METHOD(MpmcDeliversEveryValueOnce)
+		{
+			static const int threadCount = 4;
+			static const int countPerProducer = 20000;
+			CU::MpmcRing<int, 128> ring;
+			std::vector<std::atomic<int>> seen(threadCount * countPerProducer);
+			for (std::atomic<int>& flag : seen)
+			{
+				flag.store(0);
+			}
+			std::atomic<int> consumed(0);
+
+			std::vector<std::thread> threads;
+			for (int thread = 0; thread < threadCount; ++thread)
+			{
+				threads.emplace_back([&ring, thread]()
+				{
+					for (int index = 0; index < countPerProducer; ++index)
+					{
+						while (!ring.Push(thread * countPerProducer + index))
+						{
+							std::this_thread::yield();
+						}
+					}
+				});
+				threads.emplace_back([&ring, &seen, &consumed]()
+				{
+					int value;
+					while (consumed.load() < threadCount * countPerProducer)
+					{
+						if (ring.Pop(value))
+						{
+							seen[value].fetch_add(1);
+							consumed.fetch_add(1);
+						}
+						else
+						{
+							std::this_thread::yield();
+						}
+					}
+				});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+
+			for (const std::atomic<int>& flag : seen)
+			{
+				Assert::AreEqual(1, flag.load());
+			}
+		}
+	};
+}
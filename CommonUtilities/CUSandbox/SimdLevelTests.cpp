@@ -0,0 +1,135 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <string>
+#include <vector>
+#include "SimdLevel.hpp"
+#include "TransformBatch.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(SimdLevelTests)
+	{
+	public:
+
+		// Odd sizes so every level also runs its tail
+		static const int ourCount = 53;
+
+		struct Results
+		{
+			std::vector<float> myDots;
+			std::vector<float> myLengths;
+			std::vector<float> myNormalized;
+			std::vector<float> myInterleaved;
+			std::vector<CU::Vector3<float>> myPoints;
+			std::vector<CU::Vector4<float>> myVectors;
+			std::vector<CU::Matrix4x4<float>> myTRS;
+			std::vector<CU::Matrix4x4<float>> myInverses;
+		};
+
+		Results RunAt(const CU::SimdLevel aLevel)
+		{
+			const CU::SimdLevel previous = CU::GetSimdLevel();
+			CU::SetSimdLevel(aLevel);
+
+			std::vector<float> x(ourCount), y(ourCount), z(ourCount);
+			std::vector<CU::Vector3<float>> points(ourCount);
+			std::vector<CU::Vector4<float>> vectors(ourCount);
+			CU::Vector3Stream<float> translations, angles, scales;
+			for (int index = 0; index < ourCount; ++index)
+			{
+				x[index] = index * 0.25f - 3.f;
+				y[index] = 2.f - index * 0.125f;
+				z[index] = index * index * 0.01f + 0.5f;
+				points[index] = CU::Vector3<float>(x[index], y[index], z[index]);
+				vectors[index] = CU::Vector4<float>(x[index], y[index], z[index], index % 2 == 0 ? 1.f : 0.f);
+				translations.Add(points[index]);
+				angles.Add(CU::Vector3<float>(index * 0.31f, -index * 0.17f, index * 0.07f - 1.f));
+				scales.Add(CU::Vector3<float>(1.f + index * 0.01f, 2.f, 0.5f));
+			}
+
+			const CU::Matrix4x4<float> transform = CU::Matrix4x4<float>::CreateTRS(CU::Vector3<float>(5.f, -2.f, 1.f), CU::Vector3<float>(0.3f, 1.2f, -0.4f), CU::Vector3<float>(1.f, 2.f, 3.f));
+
+			Results results;
+			results.myDots.resize(ourCount);
+			results.myLengths.resize(ourCount);
+			results.myInterleaved.resize(ourCount * 3);
+			results.myPoints.resize(ourCount);
+			results.myVectors.resize(ourCount);
+			results.myTRS.resize(ourCount);
+			results.myInverses.resize(ourCount);
+
+			CU::Vector3StreamKernels::Dot(x.data(), y.data(), z.data(), z.data(), x.data(), y.data(), results.myDots.data(), ourCount);
+			CU::Vector3StreamKernels::Length(x.data(), y.data(), z.data(), results.myLengths.data(), ourCount);
+			CU::Vector3StreamKernels::Interleave(x.data(), y.data(), z.data(), results.myInterleaved.data(), ourCount);
+			CU::Vector3StreamKernels::Normalize(x.data(), y.data(), z.data(), ourCount);
+			results.myNormalized = x;
+			CU::TransformPoints(transform, points.data(), results.myPoints.data(), ourCount);
+			CU::TransformVectors(transform, vectors.data(), results.myVectors.data(), ourCount);
+			CU::CreateTRSMatrices(translations, angles, scales, results.myTRS.data());
+			CU::InverseMatrices(results.myTRS.data(), results.myInverses.data(), ourCount);
+
+			CU::SetSimdLevel(previous);
+			return results;
+		}
+
+		void AssertFloatsEqual(const std::vector<float>& anExpected, const std::vector<float>& anActual)
+		{
+			Assert::AreEqual(anExpected.size(), anActual.size());
+			for (size_t index = 0; index < anExpected.size(); ++index)
+			{
+				Assert::AreEqual(anExpected[index], anActual[index], 0.0005f);
+			}
+		}
+
+		void AssertMatricesEqual(const std::vector<CU::Matrix4x4<float>>& anExpected, const std::vector<CU::Matrix4x4<float>>& anActual)
+		{
+			for (size_t index = 0; index < anExpected.size(); ++index)
+			{
+				for (int element = 0; element < 16; ++element)
+				{
+					Assert::AreEqual(anExpected[index].GetData()[element], anActual[index].GetData()[element], 0.0005f);
+				}
+			}
+		}
+
+		TEST_METHOD(EveryLevelMatchesScalar)
+		{
+			const Results expected = RunAt(CU::SimdLevel::Scalar);
+			for (int level = static_cast<int>(CU::SimdLevel::SSE2); level <= static_cast<int>(CU::SimdLevel::AVX512); ++level)
+			{
+				const Results actual = RunAt(static_cast<CU::SimdLevel>(level));
+				AssertFloatsEqual(expected.myDots, actual.myDots);
+				AssertFloatsEqual(expected.myLengths, actual.myLengths);
+				AssertFloatsEqual(expected.myNormalized, actual.myNormalized);
+				AssertFloatsEqual(expected.myInterleaved, actual.myInterleaved);
+				for (int index = 0; index < ourCount; ++index)
+				{
+					Assert::AreEqual(expected.myPoints[index].x, actual.myPoints[index].x, 0.0005f);
+					Assert::AreEqual(expected.myPoints[index].y, actual.myPoints[index].y, 0.0005f);
+					Assert::AreEqual(expected.myPoints[index].z, actual.myPoints[index].z, 0.0005f);
+					Assert::AreEqual(expected.myVectors[index].w, actual.myVectors[index].w, 0.0005f);
+					Assert::AreEqual(expected.myVectors[index].x, actual.myVectors[index].x, 0.0005f);
+				}
+				AssertMatricesEqual(expected.myTRS, actual.myTRS);
+				AssertMatricesEqual(expected.myInverses, actual.myInverses);
+			}
+		}
+
+		TEST_METHOD(ForcedLevelIsClampedToSupported)
+		{
+			const CU::SimdLevel previous = CU::GetSimdLevel();
+			const CU::SimdLevel supported = CU::GetSupportedSimdLevel();
+
+			Assert::IsTrue(CU::SetSimdLevel(CU::SimdLevel::AVX512) == supported);
+			Assert::IsTrue(CU::GetSimdLevel() == supported);
+			Assert::IsTrue(CU::SetSimdLevel(CU::SimdLevel::Scalar) == CU::SimdLevel::Scalar);
+			Assert::IsTrue(previous <= supported);
+
+			CU::SetSimdLevel(previous);
+			Assert::AreEqual(std::string("avx2"), std::string(CU::GetSimdLevelName(CU::SimdLevel::AVX2)));
+		}
+	};
+}
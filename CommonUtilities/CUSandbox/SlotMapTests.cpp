@@ -0,0 +1,90 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <string>
+#include <vector>
+#include "SlotMap.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(SlotMapTests)
+	{
+	public:
+
+		TEST_METHOD(HandlesSurviveErasingOthers)
+		{
+			CU::SlotMap<std::string> map;
+			std::vector<CU::SlotMapHandle> handles;
+			for (int index = 0; index < 10; ++index)
+			{
+				handles.push_back(map.Insert(std::to_string(index)));
+			}
+
+			Assert::IsTrue(map.Erase(handles[0]));
+			Assert::IsTrue(map.Erase(handles[4]));
+			Assert::AreEqual(8, map.Count());
+			for (int index = 0; index < 10; ++index)
+			{
+				if (index == 0 || index == 4)
+				{
+					continue;
+				}
+				Assert::AreEqual(std::to_string(index), map[handles[index]]);
+			}
+		}
+
+		TEST_METHOD(StaleHandlesAreDetected)
+		{
+			CU::SlotMap<int> map;
+			const CU::SlotMapHandle first = map.Insert(1);
+			Assert::IsTrue(map.Erase(first));
+			Assert::IsFalse(map.Erase(first));
+
+			// The slot is reused with a new generation
+			const CU::SlotMapHandle second = map.Emplace(2);
+			Assert::AreEqual(first.myIndex, second.myIndex);
+			Assert::IsTrue(first != second);
+			Assert::IsFalse(map.Contains(first));
+			Assert::IsTrue(map.Get(first) == nullptr);
+			Assert::AreEqual(2, *map.Get(second));
+
+			Assert::IsFalse(map.Contains(CU::SlotMapHandle()));
+
+			map.Clear();
+			Assert::AreEqual(0, map.Count());
+			Assert::IsFalse(map.Contains(second));
+		}
+
+		TEST_METHOD(IterationIsDenseAndMatchesHandles)
+		{
+			CU::SlotMap<int> map;
+			std::vector<CU::SlotMapHandle> handles;
+			for (int index = 0; index < 100; ++index)
+			{
+				handles.push_back(map.Insert(index));
+			}
+			for (int index = 0; index < 100; index += 3)
+			{
+				map.Erase(handles[index]);
+			}
+
+			int count = 0;
+			int sum = 0;
+			for (const int value : map)
+			{
+				Assert::IsTrue(value % 3 != 0);
+				sum += value;
+				++count;
+			}
+			Assert::AreEqual(map.Count(), count);
+			Assert::AreEqual(4950 - 1683, sum);
+
+			for (int index = 0; index < map.Count(); ++index)
+			{
+				Assert::AreEqual(map.GetAt(index), map[map.GetHandleAt(index)]);
+			}
+		}
+	};
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <memory>
+#include <string>
+#include "StaticArray.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	static_assert(sizeof(CU::StaticArray<float, 7>) == sizeof(float) * 7, "StaticArray must not store anything but its elements");
+	static_assert(sizeof(CU::StaticArray<std::string, 3>) == sizeof(std::string) * 3, "StaticArray must not store anything but its elements");
+	static_assert(std::is_trivially_copyable<CU::StaticArray<int, 16>>::value, "StaticArray of trivial elements must copy as plain memory");
+	static_assert(std::is_nothrow_move_constructible<CU::StaticArray<std::string, 4>>::value, "StaticArray must move its elements");
+
+	constexpr CU::StaticArray<int, 4> CreateCountdown()
+	{
+		CU::StaticArray<int, 4> countdown = { 3, 2 };
+		countdown[2] = 1;
+		return countdown;
+	}
+	static_assert(CreateCountdown()[0] == 3 && CreateCountdown()[2] == 1 && CreateCountdown()[3] == 0, "StaticArray must work in constant expressions");
+	static_assert(CU::StaticArray<int, 4>::Count() == 4, "Count is known at compile time");
+
+	TEST_CLASS(StaticArrayTests)
+	{
+	public:
+
+		TEST_METHOD(InsertShiftsUpAndDropsLast)
+		{
+			CU::StaticArray<int, 5> array = { 1, 2, 3, 4, 5 };
+			array.Insert(1, 9);
+			const int expected[] = { 1, 9, 2, 3, 4 };
+			for (int index = 0; index < array.Count(); ++index)
+			{
+				Assert::AreEqual(expected[index], array[index]);
+			}
+
+			// Inserting one of its own elements
+			array.Insert(0, array[4]);
+			Assert::AreEqual(4, array[0]);
+			Assert::AreEqual(3, array[4]);
+			array.Insert(4, 7);
+			Assert::AreEqual(7, array[4]);
+		}
+
+		TEST_METHOD(NonTrivialElementsAreMoved)
+		{
+			CU::StaticArray<std::string, 3> strings = { "a", "b", "c" };
+			strings.Insert(0, std::string(32, 'x'));
+			Assert::AreEqual(std::string(32, 'x'), strings[0]);
+			Assert::AreEqual(std::string("a"), strings[1]);
+			Assert::AreEqual(std::string("b"), strings[2]);
+
+			CU::StaticArray<std::string, 3> moved = std::move(strings);
+			Assert::AreEqual(std::string("a"), moved[1]);
+			CU::StaticArray<std::string, 3> copy = moved;
+			copy[1] = "changed";
+			Assert::AreEqual(std::string("a"), moved[1]);
+
+			CU::StaticArray<std::unique_ptr<int>, 2> owners;
+			owners.Insert(0, std::unique_ptr<int>(new int(5)));
+			CU::StaticArray<std::unique_ptr<int>, 2> movedOwners = std::move(owners);
+			Assert::IsTrue(owners[0] == nullptr);
+			Assert::AreEqual(5, *movedOwners[0]);
+		}
+
+		TEST_METHOD(PointersStartNullAndCanBeDeleted)
+		{
+			CU::StaticArray<int*, 4> pointers;
+			int count = 0;
+			for (int* pointer : pointers)
+			{
+				Assert::IsTrue(pointer == nullptr);
+				++count;
+			}
+			Assert::AreEqual(4, count);
+
+			pointers[1] = new int(2);
+			pointers.DeleteAll();
+			Assert::IsTrue(pointers[1] == nullptr);
+		}
+	};
+}
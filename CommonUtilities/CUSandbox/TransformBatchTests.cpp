@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <vector>
+#include "TransformBatch.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(TransformBatchTests)
+	{
+	public:
+
+		CU::Matrix4x4<float> CreateTransform()
+		{
+			CU::Matrix4x4<float> transform = CU::Matrix4x4<float>::CreateRotationAroundY(0.6f) * CU::Matrix4x4<float>::CreateRotationAroundX(-1.1f);
+			transform(4, 1) = 12.f;
+			transform(4, 2) = -3.5f;
+			transform(4, 3) = 0.75f;
+			return transform;
+		}
+
+		std::vector<CU::Vector3<float>> CreatePoints(const int aCount)
+		{
+			std::vector<CU::Vector3<float>> points;
+			for (int index = 0; index < aCount; ++index)
+			{
+				points.push_back(CU::Vector3<float>(index * 0.5f, 3.f - index, index * index * 0.01f));
+			}
+			return points;
+		}
+
+		TEST_METHOD(TransformPointsMatchesVectorMultiply)
+		{
+			const CU::Matrix4x4<float> transform = CreateTransform();
+
+			// Odd counts exercise the SIMD remainder paths
+			for (int count = 0; count < 37; ++count)
+			{
+				const std::vector<CU::Vector3<float>> points = CreatePoints(count);
+				std::vector<CU::Vector3<float>> transformed(count);
+				CU::TransformPoints(transform, points.data(), transformed.data(), count);
+
+				for (int index = 0; index < count; ++index)
+				{
+					const CU::Vector4<float> expected = CU::Vector4<float>(points[index].x, points[index].y, points[index].z, 1.f) * transform;
+					Assert::AreEqual(expected.x, transformed[index].x, 0.001f);
+					Assert::AreEqual(expected.y, transformed[index].y, 0.001f);
+					Assert::AreEqual(expected.z, transformed[index].z, 0.001f);
+				}
+			}
+		}
+
+		TEST_METHOD(TransformDirectionsInPlaceIgnoresTranslation)
+		{
+			const CU::Matrix4x4<float> transform = CreateTransform();
+			const std::vector<CU::Vector3<float>> directions = CreatePoints(21);
+			std::vector<CU::Vector3<float>> transformed = directions;
+			CU::TransformDirections(transform, transformed.data(), static_cast<int>(transformed.size()));
+
+			for (size_t index = 0; index < directions.size(); ++index)
+			{
+				const CU::Vector4<float> expected = CU::Vector4<float>(directions[index].x, directions[index].y, directions[index].z, 0.f) * transform;
+				Assert::AreEqual(expected.x, transformed[index].x, 0.001f);
+				Assert::AreEqual(expected.y, transformed[index].y, 0.001f);
+				Assert::AreEqual(expected.z, transformed[index].z, 0.001f);
+			}
+		}
+
+		TEST_METHOD(TransformVectorsMatchesVectorMultiply)
+		{
+			const CU::Matrix4x4<float> transform = CreateTransform();
+			std::vector<CU::Vector4<float>> vectors;
+			for (int index = 0; index < 11; ++index)
+			{
+				vectors.push_back(CU::Vector4<float>(index * 1.5f, -2.f * index, 4.f, index % 2 == 0 ? 1.f : 0.f));
+			}
+
+			std::vector<CU::Vector4<float>> transformed = vectors;
+			CU::TransformVectors(transform, transformed.data(), static_cast<int>(transformed.size()));
+
+			for (size_t index = 0; index < vectors.size(); ++index)
+			{
+				const CU::Vector4<float> expected = vectors[index] * transform;
+				Assert::AreEqual(expected.x, transformed[index].x, 0.001f);
+				Assert::AreEqual(expected.y, transformed[index].y, 0.001f);
+				Assert::AreEqual(expected.z, transformed[index].z, 0.001f);
+				Assert::AreEqual(expected.w, transformed[index].w, 0.001f);
+			}
+		}
+
+		void AssertMatricesEqual(const CU::Matrix4x4<float>& anExpected, const CU::Matrix4x4<float>& anActual)
+		{
+			for (int row = 1; row <= 4; ++row)
+			{
+				for (int column = 1; column <= 4; ++column)
+				{
+					Assert::AreEqual(anExpected(row, column), anActual(row, column), 0.0001f);
+				}
+			}
+		}
+
+		TEST_METHOD(CreateTRSMatricesMatchesCreateTRS)
+		{
+			// Angles well outside [-pi, pi] exercise every quadrant of the batched sin and cos
+			for (int count = 0; count < 21; ++count)
+			{
+				CU::Vector3Stream<float> translations;
+				CU::Vector3Stream<float> angles;
+				CU::Vector3Stream<float> scales;
+				std::vector<CU::Quaternion<float>> rotations;
+				for (int index = 0; index < count; ++index)
+				{
+					translations.Add(CU::Vector3<float>(index * 2.f, -1.f, index * 0.5f));
+					angles.Add(CU::Vector3<float>(index * 0.7f - 7.f, 10.f - index * 1.3f, index * 0.9f));
+					scales.Add(CU::Vector3<float>(1.f + index * 0.1f, 0.5f, 2.f));
+					rotations.push_back(CU::Quaternion<float>(angles.Get(index)));
+				}
+				std::vector<CU::Matrix4x4<float>> eulerMatrices(count);
+				std::vector<CU::Matrix4x4<float>> quaternionMatrices(count);
+
+				CU::CreateTRSMatrices(translations, angles, scales, eulerMatrices.data());
+				CU::CreateTRSMatrices(translations, rotations.data(), scales, quaternionMatrices.data());
+
+				for (int index = 0; index < count; ++index)
+				{
+					AssertMatricesEqual(CU::Matrix4x4<float>::CreateTRS(translations.Get(index), angles.Get(index), scales.Get(index)), eulerMatrices[index]);
+					AssertMatricesEqual(CU::Matrix4x4<float>::CreateTRS(translations.Get(index), rotations[index], scales.Get(index)), quaternionMatrices[index]);
+				}
+			}
+		}
+	};
+}
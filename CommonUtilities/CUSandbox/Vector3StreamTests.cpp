@@ -0,0 +1,159 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <vector>
+#include "Vector3Stream.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(Vector3StreamTests)
+	{
+	public:
+
+		std::vector<CU::Vector3<float>> CreateVectors(const int aCount, const float anOffset)
+		{
+			std::vector<CU::Vector3<float>> vectors;
+			for (int index = 0; index < aCount; ++index)
+			{
+				vectors.push_back(CU::Vector3<float>(index * 0.5f + anOffset, 3.f - index, index * index * 0.01f + 1.f));
+			}
+			return vectors;
+		}
+
+		void AssertVectorsEqual(const CU::Vector3<float>& anExpected, const CU::Vector3<float>& anActual)
+		{
+			Assert::AreEqual(anExpected.x, anActual.x, 0.001f);
+			Assert::AreEqual(anExpected.y, anActual.y, 0.001f);
+			Assert::AreEqual(anExpected.z, anActual.z, 0.001f);
+		}
+
+		void AssertVectorsIdentical(const CU::Vector3<float>& anExpected, const CU::Vector3<float>& anActual)
+		{
+			Assert::AreEqual(anExpected.x, anActual.x);
+			Assert::AreEqual(anExpected.y, anActual.y);
+			Assert::AreEqual(anExpected.z, anActual.z);
+		}
+
+		TEST_METHOD(ConversionRoundTripIsExact)
+		{
+			// Odd counts exercise the SIMD remainder paths
+			for (int count = 0; count < 37; ++count)
+			{
+				const std::vector<CU::Vector3<float>> vectors = CreateVectors(count, 0.f);
+				const CU::Vector3Stream<float> stream(vectors);
+				const std::vector<CU::Vector3<float>> result = stream.ToVector();
+
+				Assert::AreEqual(count, stream.Count());
+				for (int index = 0; index < count; ++index)
+				{
+					AssertVectorsIdentical(vectors[index], result[index]);
+					AssertVectorsIdentical(vectors[index], stream.Get(index));
+				}
+			}
+		}
+
+		TEST_METHOD(ArraysAreCacheLineAligned)
+		{
+			CU::Vector3Stream<float> stream(5);
+			stream.Add(CU::Vector3<float>(1.f, 2.f, 3.f));
+
+			Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(stream.GetX()) % 64);
+			Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(stream.GetY()) % 64);
+			Assert::AreEqual(static_cast<size_t>(0), reinterpret_cast<size_t>(stream.GetZ()) % 64);
+			AssertVectorsIdentical(CU::Vector3<float>(1.f, 2.f, 3.f), stream.Get(5));
+		}
+
+		TEST_METHOD(DotAndLengthMatchVector3)
+		{
+			for (int count = 0; count < 37; ++count)
+			{
+				const std::vector<CU::Vector3<float>> vectors = CreateVectors(count, 0.f);
+				const std::vector<CU::Vector3<float>> others = CreateVectors(count, 2.f);
+				const CU::Vector3Stream<float> stream(vectors);
+				const CU::Vector3Stream<float> otherStream(others);
+				const CU::Vector3<float> direction(0.25f, -1.f, 2.f);
+
+				std::vector<float> dotVector(count), dotStream(count), lengths(count), lengthsSqr(count);
+				stream.Dot(direction, dotVector.data());
+				stream.Dot(otherStream, dotStream.data());
+				stream.Length(lengths.data());
+				stream.LengthSqr(lengthsSqr.data());
+
+				for (int index = 0; index < count; ++index)
+				{
+					Assert::AreEqual(vectors[index].Dot(direction), dotVector[index], 0.001f);
+					Assert::AreEqual(vectors[index].Dot(others[index]), dotStream[index], 0.001f);
+					Assert::AreEqual(vectors[index].Length(), lengths[index], 0.001f);
+					Assert::AreEqual(vectors[index].LengthSqr(), lengthsSqr[index], 0.001f);
+				}
+			}
+		}
+
+		TEST_METHOD(NormalizeAndCrossMatchVector3)
+		{
+			for (int count = 0; count < 37; ++count)
+			{
+				const std::vector<CU::Vector3<float>> vectors = CreateVectors(count, 0.f);
+				const std::vector<CU::Vector3<float>> others = CreateVectors(count, 2.f);
+				CU::Vector3Stream<float> stream(vectors);
+				const CU::Vector3Stream<float> otherStream(others);
+
+				CU::Vector3Stream<float> crossed;
+				stream.Cross(otherStream, crossed);
+				stream.Normalize();
+
+				for (int index = 0; index < count; ++index)
+				{
+					AssertVectorsEqual(vectors[index].Cross(others[index]), crossed.Get(index));
+					AssertVectorsEqual(vectors[index].GetNormalized(), stream.Get(index));
+				}
+			}
+		}
+
+		TEST_METHOD(ArithmeticMatchesVector3)
+		{
+			for (int count = 0; count < 37; ++count)
+			{
+				const std::vector<CU::Vector3<float>> vectors = CreateVectors(count, 0.f);
+				const std::vector<CU::Vector3<float>> others = CreateVectors(count, 2.f);
+				const CU::Vector3Stream<float> otherStream(others);
+
+				CU::Vector3Stream<float> added(vectors);
+				added += otherStream;
+				CU::Vector3Stream<float> subtracted(vectors);
+				subtracted -= otherStream;
+				CU::Vector3Stream<float> scaled(vectors);
+				scaled *= 1.5f;
+				CU::Vector3Stream<float> addedScaled(vectors);
+				addedScaled.AddScaled(otherStream, -0.5f);
+
+				for (int index = 0; index < count; ++index)
+				{
+					AssertVectorsEqual(vectors[index] + others[index], added.Get(index));
+					AssertVectorsEqual(vectors[index] - others[index], subtracted.Get(index));
+					AssertVectorsEqual(vectors[index] * 1.5f, scaled.Get(index));
+					AssertVectorsEqual(vectors[index] + others[index] * -0.5f, addedScaled.Get(index));
+				}
+			}
+		}
+
+		TEST_METHOD(DoubleStreamUsesScalarPath)
+		{
+			std::vector<CU::Vector3<double>> vectors;
+			vectors.push_back(CU::Vector3<double>(3.0, 4.0, 0.0));
+			vectors.push_back(CU::Vector3<double>(0.0, 0.0, 2.0));
+			CU::Vector3Stream<double> stream(vectors);
+
+			std::vector<double> lengths(2);
+			stream.Length(lengths.data());
+			stream.Normalize();
+
+			Assert::AreEqual(5.0, lengths[0]);
+			Assert::AreEqual(2.0, lengths[1]);
+			Assert::AreEqual(0.6, stream.Get(0).x, 0.000001);
+			Assert::AreEqual(1.0, stream.Get(1).z);
+		}
+	};
+}
@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Matrix4x4.hpp"
+#include "Vector.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(VectorExpressionTests)
+	{
+	public:
+
+		TEST_METHOD(ChainedExpressionMatchesComponents)
+		{
+			const CU::Vector3<float> a(1.f, 2.f, 3.f);
+			const CU::Vector3<float> b(-4.f, 0.5f, 8.f);
+			const CU::Vector3<float> c(0.25f, -1.f, 2.f);
+
+			const CU::Vector3<float> result = a + b * 2.f - c / 4.f;
+
+			Assert::AreEqual(1.f + -4.f * 2.f - 0.25f / 4.f, result.x);
+			Assert::AreEqual(2.f + 0.5f * 2.f - -1.f / 4.f, result.y);
+			Assert::AreEqual(3.f + 8.f * 2.f - 2.f / 4.f, result.z);
+		}
+
+		TEST_METHOD(TargetCanAppearInExpression)
+		{
+			CU::Vector2<float> a(1.f, 2.f);
+			const CU::Vector2<float> b(10.f, 20.f);
+
+			a = b - a * 3.f;
+
+			Assert::AreEqual(7.f, a.x);
+			Assert::AreEqual(14.f, a.y);
+		}
+
+		TEST_METHOD(CompoundOperatorsUpdateInPlace)
+		{
+			CU::Vector4<float> vector(1.f, 2.f, 3.f, 4.f);
+			const CU::Vector4<float> other(1.f, 1.f, 1.f, 1.f);
+
+			((vector += other * 2.f) -= other) *= 2.f;
+			vector /= 4.f;
+
+			Assert::AreEqual(1.f, vector.x);
+			Assert::AreEqual(1.5f, vector.y);
+			Assert::AreEqual(2.f, vector.z);
+			Assert::AreEqual(2.5f, vector.w);
+
+			CU::Vector3<float> offset(1.f, 2.f, 3.f);
+			offset += 0.5f;
+			Assert::AreEqual(3.5f, offset.z);
+		}
+
+		TEST_METHOD(ExpressionConvertsWhereVectorIsExpected)
+		{
+			const CU::Vector3<float> a(3.f, 0.f, 0.f);
+			const CU::Vector3<float> b(0.f, 4.f, 0.f);
+
+			Assert::AreEqual(25.f, CU::Vector3<float>(a + b).LengthSqr());
+			Assert::AreEqual(9.f, a.Dot(a + b));
+
+			const CU::Vector4<float> point(1.f, 2.f, 3.f, 0.f);
+			const CU::Vector4<float> moved = CU::Vector4<float>(point + CU::Vector4<float>(0.f, 0.f, 0.f, 1.f)) * CU::Matrix4x4<float>();
+			Assert::AreEqual(1.f, moved.w);
+		}
+
+		TEST_METHOD(ExpressionsHaveTheVectorFunctions)
+		{
+			const CU::Vector3<float> a(4.f, 6.f, 0.f);
+			const CU::Vector3<float> b(1.f, 2.f, 0.f);
+			const CU::Vector3<float> c(0.f, 0.f, 2.f);
+
+			Assert::AreEqual(5.f, (a - b).Length());
+			Assert::AreEqual(25.f, (a - b).LengthSqr());
+			Assert::AreEqual(3.f, (a - b).Eval().x);
+			Assert::AreEqual(0.6f, (a - b).GetNormalized().x);
+			Assert::AreEqual(34.f, (a + b).Dot(a * 0.5f + c));
+			Assert::AreEqual(16.f, (a + b).Cross(c).x);
+			Assert::AreEqual(-10.f, (a + b).Cross(c * 1.f).y);
+
+			const CU::Vector2<float> flat(3.f, 4.f);
+			Assert::AreEqual(10.f, (flat * 2.f).Length());
+			Assert::AreEqual(-4.f, (-1.f * flat).Dot(CU::Vector2<float>(0.f, 1.f)));
+			const CU::Vector4<float> point(1.f, 2.f, 2.f, 0.f);
+			Assert::AreEqual(9.f, (point + point / 2.f).LengthSqr() / 2.25f);
+		}
+
+		static auto ScaledUp(const float aX, const float aY, const float aZ, const float aScale)
+		{
+			return CU::Vector3<float>(aX, aY, aZ) * aScale;
+		}
+
+		TEST_METHOD(ExpressionsOfTemporariesOutliveThem)
+		{
+			auto fromLambda = [](const float aScale)
+			{
+				return CU::Vector2<float>(1.f, 2.f) + CU::Vector2<float>(3.f, 4.f) * aScale;
+			};
+			const auto lambdaExpression = fromLambda(2.f);
+			const auto functionExpression = ScaledUp(1.f, -2.f, 3.f, 4.f);
+			const auto localExpression = CU::Vector4<float>(1.f, 2.f, 3.f, 4.f) - CU::Vector4<float>(4.f, 3.f, 2.f, 1.f);
+
+			// Overwrite the stack the temporaries lived on
+			volatile float scratch[64];
+			for (int index = 0; index < 64; ++index)
+			{
+				scratch[index] = -100.f;
+			}
+			Assert::AreEqual(-100.f, static_cast<float>(scratch[63]));
+
+			const CU::Vector2<float> fromLambdaResult = lambdaExpression;
+			Assert::AreEqual(7.f, fromLambdaResult.x);
+			Assert::AreEqual(10.f, fromLambdaResult.y);
+			const CU::Vector3<float> fromFunctionResult = functionExpression;
+			Assert::AreEqual(4.f, fromFunctionResult.x);
+			Assert::AreEqual(-8.f, fromFunctionResult.y);
+			Assert::AreEqual(12.f, fromFunctionResult.z);
+			const CU::Vector4<float> localResult = localExpression;
+			Assert::AreEqual(-3.f, localResult.x);
+			Assert::AreEqual(3.f, localResult.w);
+		}
+
+		TEST_METHOD(VectorsKeepTheirSize)
+		{
+			Assert::AreEqual(sizeof(float) * 2, sizeof(CU::Vector2<float>));
+			Assert::AreEqual(sizeof(float) * 3, sizeof(CU::Vector3<float>));
+			Assert::AreEqual(sizeof(float) * 4, sizeof(CU::Vector4<float>));
+		}
+	};
+}
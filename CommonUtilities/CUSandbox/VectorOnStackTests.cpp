@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <string>
+#include "VectorOnStack.hpp"
+
+#define CU CommonUtilities
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CUSandbox
+{
+	TEST_CLASS(VectorOnStackTests)
+	{
+	public:
+
+		struct CountingAllocator
+		{
+			static int ourAllocations;
+
+			void* Allocate(const size_t aSize, const size_t anAlignment)
+			{
+				++ourAllocations;
+				return CU::AlignedAllocator().Allocate(aSize, anAlignment);
+			}
+
+			void Free(void* aMemory)
+			{
+				CU::AlignedAllocator().Free(aMemory);
+			}
+		};
+
+		TEST_METHOD(StaysInlineUntilFull)
+		{
+			CountingAllocator::ourAllocations = 0;
+			CU::VectorOnStack<int, 4, CountingAllocator> vector;
+			for (int index = 0; index < 4; ++index)
+			{
+				vector.Add(index);
+			}
+			Assert::IsFalse(vector.IsOnHeap());
+			Assert::AreEqual(0, CountingAllocator::ourAllocations);
+
+			vector.Add(4);
+			Assert::IsTrue(vector.IsOnHeap());
+			Assert::AreEqual(1, CountingAllocator::ourAllocations);
+			Assert::AreEqual(8, vector.Capacity());
+			for (int index = 0; index < vector.Count(); ++index)
+			{
+				Assert::AreEqual(index, vector[index]);
+			}
+		}
+
+		TEST_METHOD(InsertAndRemove)
+		{
+			CU::VectorOnStack<int, 8> vector = { 1, 2, 3 };
+			vector.Insert(0, 0);
+			vector.Insert(4, 4);
+			vector.Insert(2, vector[4]);
+			const int expected[] = { 0, 1, 4, 2, 3, 4 };
+			Assert::AreEqual(6, vector.Count());
+			for (int index = 0; index < vector.Count(); ++index)
+			{
+				Assert::AreEqual(expected[index], vector[index]);
+			}
+
+			vector.RemoveCyclicAtIndex(0);
+			Assert::AreEqual(4, vector[0]);
+			Assert::IsTrue(vector.RemoveCyclic(1));
+			Assert::IsFalse(vector.RemoveCyclic(9));
+			vector.RemoveAtIndex(0);
+			Assert::AreEqual(3, vector.Count());
+			Assert::AreEqual(3, vector[0]);
+			Assert::AreEqual(4, vector[1]);
+			Assert::AreEqual(2, vector[2]);
+		}
+
+		TEST_METHOD(MovesFromStackAndHeap)
+		{
+			CU::VectorOnStack<std::string, 2> small;
+			small.Add("a");
+			small.Add(std::string(40, 'b'));
+			CU::VectorOnStack<std::string, 2> movedSmall = std::move(small);
+			Assert::IsTrue(small.IsEmpty());
+			Assert::AreEqual(std::string(40, 'b'), movedSmall[1]);
+
+			CU::VectorOnStack<std::string, 2> large;
+			for (int index = 0; index < 10; ++index)
+			{
+				large.Add(std::to_string(index));
+			}
+			const std::string* data = large.GetData();
+			CU::VectorOnStack<std::string, 2> movedLarge = std::move(large);
+			// Heap memory changes owner without copying
+			Assert::IsTrue(movedLarge.GetData() == data);
+			Assert::IsFalse(large.IsOnHeap());
+
+			movedSmall = movedLarge;
+			Assert::AreEqual(10, movedSmall.Count());
+			Assert::AreEqual(std::string("9"), movedSmall.GetLast());
+			movedLarge = std::move(movedSmall);
+			Assert::AreEqual(std::string("5"), movedLarge[5]);
+		}
+	};
+
+	int VectorOnStackTests::CountingAllocator::ourAllocations = 0;
+}
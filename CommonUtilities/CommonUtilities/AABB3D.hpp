@@ -0,0 +1,91 @@
+#pragma once
+#include "Vector3.hpp"
+
+namespace CommonUtilities
+{
+	// Axis aligned box between myMin and myMax, both inclusive
+	template <class T>
+	class AABB3D
+	{
+	public:
+		AABB3D();
+		AABB3D(const Vector3<T>& aMin, const Vector3<T>& aMax);
+		void InitWithMinAndMax(const Vector3<T>& aMin, const Vector3<T>& aMax);
+		void InitWithCenterAndExtents(const Vector3<T>& aCenter, const Vector3<T>& anExtents);
+
+		bool IsInside(const Vector3<T>& aPosition) const;
+		bool Overlaps(const AABB3D<T>& anAABB) const;
+
+		const Vector3<T>& GetMin() const;
+		const Vector3<T>& GetMax() const;
+		Vector3<T> GetCenter() const;
+		// Half the size along each axis
+		Vector3<T> GetExtents() const;
+
+	private:
+		Vector3<T> myMin;
+		Vector3<T> myMax;
+	};
+
+	template <class T>
+	inline AABB3D<T>::AABB3D()
+	{
+	}
+
+	template <class T>
+	inline AABB3D<T>::AABB3D(const Vector3<T>& aMin, const Vector3<T>& aMax) : myMin(aMin), myMax(aMax)
+	{
+	}
+
+	template <class T>
+	inline void AABB3D<T>::InitWithMinAndMax(const Vector3<T>& aMin, const Vector3<T>& aMax)
+	{
+		myMin = aMin;
+		myMax = aMax;
+	}
+
+	template <class T>
+	inline void AABB3D<T>::InitWithCenterAndExtents(const Vector3<T>& aCenter, const Vector3<T>& anExtents)
+	{
+		myMin = aCenter - anExtents;
+		myMax = aCenter + anExtents;
+	}
+
+	template <class T>
+	inline bool AABB3D<T>::IsInside(const Vector3<T>& aPosition) const
+	{
+		return aPosition.x >= myMin.x && aPosition.y >= myMin.y && aPosition.z >= myMin.z &&
+			aPosition.x <= myMax.x && aPosition.y <= myMax.y && aPosition.z <= myMax.z;
+	}
+
+	template <class T>
+	inline bool AABB3D<T>::Overlaps(const AABB3D<T>& anAABB) const
+	{
+		return myMin.x <= anAABB.myMax.x && myMin.y <= anAABB.myMax.y && myMin.z <= anAABB.myMax.z &&
+			anAABB.myMin.x <= myMax.x && anAABB.myMin.y <= myMax.y && anAABB.myMin.z <= myMax.z;
+	}
+
+	template <class T>
+	inline const Vector3<T>& AABB3D<T>::GetMin() const
+	{
+		return myMin;
+	}
+
+	template <class T>
+	inline const Vector3<T>& AABB3D<T>::GetMax() const
+	{
+		return myMax;
+	}
+
+	template <class T>
+	inline Vector3<T> AABB3D<T>::GetCenter() const
+	{
+		return (myMin + myMax) * static_cast<T>(0.5);
+	}
+
+	template <class T>
+	inline Vector3<T> AABB3D<T>::GetExtents() const
+	{
+		return (myMax - myMin) * static_cast<T>(0.5);
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <stdlib.h>
+
+namespace CommonUtilities
+{
+	// Data written by different threads is kept this many bytes apart to avoid false sharing
+	static const size_t CacheLineSize = 64;
+
+	// Heap memory aligned to anAlignment bytes (a power of two, at least sizeof(void*)).
+	// Throws std::bad_alloc like operator new; release with AlignedFree.
+	inline void* AlignedAllocate(const size_t aSize, const size_t anAlignment)
+	{
+#ifdef _MSC_VER
+		void* memory = _aligned_malloc(aSize > 0 ? aSize : 1, anAlignment);
+#else
+		void* memory = nullptr;
+		if (posix_memalign(&memory, anAlignment, aSize > 0 ? aSize : 1) != 0)
+		{
+			memory = nullptr;
+		}
+#endif
+		if (memory == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		return memory;
+	}
+
+	inline void AlignedFree(void* aMemory)
+	{
+#ifdef _MSC_VER
+		_aligned_free(aMemory);
+#else
+		free(aMemory);
+#endif
+	}
+
+	// Default allocator of the containers. A custom one needs the same two members and is
+	// stored by value in each container, so it may carry state such as a pointer to an arena.
+	struct AlignedAllocator
+	{
+		void* Allocate(const size_t aSize, const size_t anAlignment)
+		{
+			return AlignedAllocate(aSize, anAlignment > sizeof(void*) ? anAlignment : sizeof(void*));
+		}
+
+		void Free(void* aMemory)
+		{
+			AlignedFree(aMemory);
+		}
+	};
+}
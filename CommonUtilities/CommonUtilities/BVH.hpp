@@ -0,0 +1,623 @@
+#pragma once
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+#include "AABB3D.hpp"
+#include "GrowingArray.hpp"
+#include "Ray.hpp"
+
+namespace CommonUtilities
+{
+	// BVH nodes are stored depth first, so an inner node's first child is the node right after it and
+	// myEscapeOrFirst is the node after its whole subtree, where traversal continues when the node is missed.
+	// A leaf has a myPrimitiveCount above 0 and myEscapeOrFirst is its first primitive.
+	template<class T>
+	struct alignas(32) BVHNode
+	{
+		Vector3<T> myMin;
+		int myEscapeOrFirst;
+		Vector3<T> myMax;
+		int myPrimitiveCount;
+	};
+
+	static_assert(sizeof(BVHNode<float>) == 32, "Two float BVH nodes should fit a cache line!");
+
+	// Static bounding volume hierarchy over boxes, built once with binned SAH and traversed without a
+	// stack by following the escape links. Primitives are referred to by their index in the built array.
+	template<class T>
+	class BVH
+	{
+	public:
+		static const int MaxLeafSize = 8;
+		static const int BinCount = 16;
+
+		BVH();
+
+		// aThreadCount 0 uses every hardware thread
+		void Build(const AABB3D<T>* someBounds, const int aCount, const int aThreadCount = 0);
+		void RemoveAll();
+
+		// Adds the indices of the primitives whose bounds the ray hits to someIndices, in tree order
+		void QueryRay(const Ray<T>& aRay, GrowingArray<int>& someIndices) const;
+		// Adds the indices of the primitives whose bounds overlap anAABB to someIndices, in tree order
+		void QueryOverlaps(const AABB3D<T>& anAABB, GrowingArray<int>& someIndices) const;
+
+		// The primitive whose bounds the ray enters first
+		bool FindNearest(const Ray<T>& aRay, int& aPrimitive, T& aDistance) const;
+		// The nearest primitive by aTest(primitive, ray, distance), which returns true with the distance on a
+		// hit, such as IntersectionTriangleRay. Only primitives in leaves hit before the best so far are tested.
+		template<class Test>
+		bool FindNearest(const Ray<T>& aRay, Test aTest, int& aPrimitive, T& aDistance) const;
+
+		int GetNodeCount() const;
+		int GetPrimitiveCount() const;
+		const BVHNode<T>& GetNode(const int anIndex) const;
+		AABB3D<T> GetBounds() const;
+
+	private:
+		// Box around a set of primitives or points
+		struct Bin
+		{
+			Vector3<T> myMin;
+			Vector3<T> myMax;
+			int myCount;
+
+			void Clear();
+			void Add(const Vector3<T>& aMin, const Vector3<T>& aMax);
+			void Add(const Bin& aBin);
+			T GetHalfArea() const;
+		};
+
+		struct Range
+		{
+			Bin myBounds;
+			Bin myCentroids;
+		};
+
+		struct Bins
+		{
+			Bin myBins[3][BinCount];
+		};
+
+		// The build moves copies of the primitives around rather than indices, so binning reads memory in order
+		struct BuildPrimitive
+		{
+			Vector3<T> myMin;
+			int myIndex;
+			Vector3<T> myMax;
+		};
+
+		struct BuildNode
+		{
+			Vector3<T> myMin;
+			Vector3<T> myMax;
+			// The right child is myLeft + 1
+			int myLeft;
+			int myBegin;
+			int myCount;
+			int mySubtreeSize;
+		};
+
+		struct Builder
+		{
+			GrowingArray<BuildPrimitive> myPrimitives;
+			GrowingArray<BuildNode> myNodes;
+			std::atomic<int> myNodeCount;
+		};
+
+		static Vector3<T> GetCentroid(const BuildPrimitive& aPrimitive);
+		static int GetBinIndex(const Range& aRange, const int anAxis, const T aScale, const int aBinCount, const Vector3<T>& aCentroid);
+		static void FillBins(const Builder& aBuilder, const Range& aRange, const int aBinCount, const int aBegin, const int anEnd, Bins& someBins);
+		static int BuildSubtree(Builder& aBuilder, const int aNode, const int aBegin, const int anEnd, const Range& aRange, const int aThreadCount);
+		static bool HitsBox(const Vector3<T>& aMin, const Vector3<T>& aMax, const Vector3<T>& anOrigin, const Vector3<T>& anInverseDirection, const T aMaxDistance, T& anEntry);
+		static Vector3<T> GetInverse(const Vector3<T>& aDirection);
+		// Nearest by aSlotTest(slot, distance), where a slot is a position in the tree's primitive order
+		template<class SlotTest>
+		bool FindNearestSlot(const Ray<T>& aRay, SlotTest aSlotTest, int& aPrimitive, T& aDistance) const;
+
+		GrowingArray<BVHNode<T>> myNodes;
+		GrowingArray<AABB3D<T>> myPrimitiveBounds;
+		GrowingArray<int> myPrimitiveIndices;
+	};
+
+	template<class T>
+	inline BVH<T>::BVH()
+	{
+	}
+
+	template<class T>
+	inline void BVH<T>::Build(const AABB3D<T>* someBounds, const int aCount, const int aThreadCount)
+	{
+		assert(aCount >= 0 && "Count can't be negative!");
+		RemoveAll();
+		if (aCount == 0)
+		{
+			return;
+		}
+
+		Builder builder;
+		builder.myPrimitives.Resize(aCount);
+		// Every leaf has at least one primitive, so the tree has at most 2n - 1 nodes
+		builder.myNodes.Resize(aCount * 2 - 1);
+		builder.myNodeCount = 1;
+		Range root;
+		root.myBounds.Clear();
+		root.myCentroids.Clear();
+		for (int index = 0; index < aCount; ++index)
+		{
+			BuildPrimitive& primitive = builder.myPrimitives[index];
+			primitive.myMin = someBounds[index].GetMin();
+			primitive.myMax = someBounds[index].GetMax();
+			primitive.myIndex = index;
+			root.myBounds.Add(primitive.myMin, primitive.myMax);
+			const Vector3<T> centroid = GetCentroid(primitive);
+			root.myCentroids.Add(centroid, centroid);
+		}
+		const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+		const int threadCount = aThreadCount > 0 ? aThreadCount : (hardwareThreads > 0 ? hardwareThreads : 1);
+		BuildSubtree(builder, 0, 0, aCount, root, threadCount);
+
+		// Lays the nodes out depth first, with the escape link of each node one past its subtree
+		struct Placement
+		{
+			int myBuildIndex;
+			int myFlatIndex;
+		};
+		myNodes.Resize(builder.myNodeCount);
+		GrowingArray<Placement> stack;
+		stack.Add({ 0, 0 });
+		while (!stack.IsEmpty())
+		{
+			const Placement placement = stack.GetLast();
+			stack.RemoveCyclicAtIndex(stack.Size() - 1);
+			const BuildNode& buildNode = builder.myNodes[placement.myBuildIndex];
+			BVHNode<T>& node = myNodes[placement.myFlatIndex];
+			node.myMin = buildNode.myMin;
+			node.myMax = buildNode.myMax;
+			node.myPrimitiveCount = buildNode.myCount;
+			if (buildNode.myCount > 0)
+			{
+				node.myEscapeOrFirst = buildNode.myBegin;
+			}
+			else
+			{
+				node.myEscapeOrFirst = placement.myFlatIndex + buildNode.mySubtreeSize;
+				stack.Add({ buildNode.myLeft + 1, placement.myFlatIndex + 1 + builder.myNodes[buildNode.myLeft].mySubtreeSize });
+				stack.Add({ buildNode.myLeft, placement.myFlatIndex + 1 });
+			}
+		}
+
+		myPrimitiveIndices.Resize(aCount);
+		myPrimitiveBounds.Resize(aCount);
+		for (int index = 0; index < aCount; ++index)
+		{
+			const BuildPrimitive& primitive = builder.myPrimitives[index];
+			myPrimitiveIndices[index] = primitive.myIndex;
+			myPrimitiveBounds[index].InitWithMinAndMax(primitive.myMin, primitive.myMax);
+		}
+	}
+
+	template<class T>
+	inline void BVH<T>::RemoveAll()
+	{
+		myNodes.RemoveAll();
+		myPrimitiveBounds.RemoveAll();
+		myPrimitiveIndices.RemoveAll();
+	}
+
+	template<class T>
+	inline void BVH<T>::QueryRay(const Ray<T>& aRay, GrowingArray<int>& someIndices) const
+	{
+		const Vector3<T>& origin = aRay.GetOrigin();
+		const Vector3<T> inverse = GetInverse(aRay.GetDirection());
+		const T infinity = std::numeric_limits<T>::infinity();
+		const int nodeCount = myNodes.Size();
+		int index = 0;
+		T entry;
+		while (index < nodeCount)
+		{
+			const BVHNode<T>& node = myNodes[index];
+			if (!HitsBox(node.myMin, node.myMax, origin, inverse, infinity, entry))
+			{
+				index = node.myPrimitiveCount > 0 ? index + 1 : node.myEscapeOrFirst;
+				continue;
+			}
+			for (int primitive = node.myEscapeOrFirst, end = primitive + node.myPrimitiveCount; primitive < end; ++primitive)
+			{
+				if (HitsBox(myPrimitiveBounds[primitive].GetMin(), myPrimitiveBounds[primitive].GetMax(), origin, inverse, infinity, entry))
+				{
+					someIndices.Add(myPrimitiveIndices[primitive]);
+				}
+			}
+			++index;
+		}
+	}
+
+	template<class T>
+	inline void BVH<T>::QueryOverlaps(const AABB3D<T>& anAABB, GrowingArray<int>& someIndices) const
+	{
+		const int nodeCount = myNodes.Size();
+		int index = 0;
+		while (index < nodeCount)
+		{
+			const BVHNode<T>& node = myNodes[index];
+			if (!anAABB.Overlaps(AABB3D<T>(node.myMin, node.myMax)))
+			{
+				index = node.myPrimitiveCount > 0 ? index + 1 : node.myEscapeOrFirst;
+				continue;
+			}
+			for (int primitive = node.myEscapeOrFirst, end = primitive + node.myPrimitiveCount; primitive < end; ++primitive)
+			{
+				if (anAABB.Overlaps(myPrimitiveBounds[primitive]))
+				{
+					someIndices.Add(myPrimitiveIndices[primitive]);
+				}
+			}
+			++index;
+		}
+	}
+
+	template<class T>
+	inline bool BVH<T>::FindNearest(const Ray<T>& aRay, int& aPrimitive, T& aDistance) const
+	{
+		const Vector3<T> inverse = GetInverse(aRay.GetDirection());
+		const T infinity = std::numeric_limits<T>::infinity();
+		return FindNearestSlot(aRay, [this, &aRay, &inverse, infinity](const int aSlot, T& aSlotDistance)
+		{
+			const AABB3D<T>& bounds = myPrimitiveBounds[aSlot];
+			return HitsBox(bounds.GetMin(), bounds.GetMax(), aRay.GetOrigin(), inverse, infinity, aSlotDistance);
+		}, aPrimitive, aDistance);
+	}
+
+	template<class T>
+	template<class Test>
+	inline bool BVH<T>::FindNearest(const Ray<T>& aRay, Test aTest, int& aPrimitive, T& aDistance) const
+	{
+		return FindNearestSlot(aRay, [this, &aRay, &aTest](const int aSlot, T& aSlotDistance)
+		{
+			return aTest(myPrimitiveIndices[aSlot], aRay, aSlotDistance);
+		}, aPrimitive, aDistance);
+	}
+
+	template<class T>
+	inline int BVH<T>::GetNodeCount() const
+	{
+		return myNodes.Size();
+	}
+
+	template<class T>
+	inline int BVH<T>::GetPrimitiveCount() const
+	{
+		return myPrimitiveIndices.Size();
+	}
+
+	template<class T>
+	inline const BVHNode<T>& BVH<T>::GetNode(const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < myNodes.Size() && "Index out of range!");
+		return myNodes[anIndex];
+	}
+
+	template<class T>
+	inline AABB3D<T> BVH<T>::GetBounds() const
+	{
+		assert(myNodes.Size() > 0 && "The BVH is empty!");
+		return AABB3D<T>(myNodes[0].myMin, myNodes[0].myMax);
+	}
+
+	template<class T>
+	template<class SlotTest>
+	inline bool BVH<T>::FindNearestSlot(const Ray<T>& aRay, SlotTest aSlotTest, int& aPrimitive, T& aDistance) const
+	{
+		const Vector3<T>& origin = aRay.GetOrigin();
+		const Vector3<T> inverse = GetInverse(aRay.GetDirection());
+		const int nodeCount = myNodes.Size();
+		T nearest = std::numeric_limits<T>::infinity();
+		int found = -1;
+		int index = 0;
+		T entry;
+		while (index < nodeCount)
+		{
+			const BVHNode<T>& node = myNodes[index];
+			// Nodes entered past the nearest hit so far can't hold a nearer one
+			if (!HitsBox(node.myMin, node.myMax, origin, inverse, nearest, entry))
+			{
+				index = node.myPrimitiveCount > 0 ? index + 1 : node.myEscapeOrFirst;
+				continue;
+			}
+			for (int slot = node.myEscapeOrFirst, end = slot + node.myPrimitiveCount; slot < end; ++slot)
+			{
+				T distance;
+				if (aSlotTest(slot, distance) && distance < nearest)
+				{
+					nearest = distance;
+					found = slot;
+				}
+			}
+			++index;
+		}
+		if (found < 0)
+		{
+			return false;
+		}
+		aPrimitive = myPrimitiveIndices[found];
+		aDistance = nearest;
+		return true;
+	}
+
+	template<class T>
+	inline void BVH<T>::Bin::Clear()
+	{
+		const T infinity = std::numeric_limits<T>::infinity();
+		myMin = Vector3<T>(infinity, infinity, infinity);
+		myMax = Vector3<T>(-infinity, -infinity, -infinity);
+		myCount = 0;
+	}
+
+	template<class T>
+	inline void BVH<T>::Bin::Add(const Vector3<T>& aMin, const Vector3<T>& aMax)
+	{
+		myMin.x = aMin.x < myMin.x ? aMin.x : myMin.x;
+		myMin.y = aMin.y < myMin.y ? aMin.y : myMin.y;
+		myMin.z = aMin.z < myMin.z ? aMin.z : myMin.z;
+		myMax.x = aMax.x > myMax.x ? aMax.x : myMax.x;
+		myMax.y = aMax.y > myMax.y ? aMax.y : myMax.y;
+		myMax.z = aMax.z > myMax.z ? aMax.z : myMax.z;
+		++myCount;
+	}
+
+	template<class T>
+	inline void BVH<T>::Bin::Add(const Bin& aBin)
+	{
+		const int count = myCount + aBin.myCount;
+		Add(aBin.myMin, aBin.myMax);
+		myCount = count;
+	}
+
+	template<class T>
+	inline T BVH<T>::Bin::GetHalfArea() const
+	{
+		if (myCount == 0)
+		{
+			return 0;
+		}
+		const Vector3<T> size = myMax - myMin;
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+
+	template<class T>
+	inline Vector3<T> BVH<T>::GetCentroid(const BuildPrimitive& aPrimitive)
+	{
+		return (aPrimitive.myMin + aPrimitive.myMax) * static_cast<T>(0.5);
+	}
+
+	template<class T>
+	inline int BVH<T>::GetBinIndex(const Range& aRange, const int anAxis, const T aScale, const int aBinCount, const Vector3<T>& aCentroid)
+	{
+		const int bin = static_cast<int>((aCentroid[anAxis] - aRange.myCentroids.myMin[anAxis]) * aScale);
+		return bin < aBinCount - 1 ? bin : aBinCount - 1;
+	}
+
+	template<class T>
+	inline void BVH<T>::FillBins(const Builder& aBuilder, const Range& aRange, const int aBinCount, const int aBegin, const int anEnd, Bins& someBins)
+	{
+		T scales[3];
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const T extent = aRange.myCentroids.myMax[axis] - aRange.myCentroids.myMin[axis];
+			scales[axis] = extent > 0 ? static_cast<T>(aBinCount) / extent : 0;
+			for (int bin = 0; bin < aBinCount; ++bin)
+			{
+				someBins.myBins[axis][bin].Clear();
+			}
+		}
+		// The bin indices of a block are worked out before any bin is touched. Neighbouring primitives
+		// tend to share bins, and updating a bin whose address was only just computed from the previous
+		// primitive's data keeps the CPU from running the loads ahead of the stores.
+		const int blockSize = 64;
+		int blockBins[blockSize][3];
+		const BuildPrimitive* primitives = aBuilder.myPrimitives.GetData();
+		for (int blockBegin = aBegin; blockBegin < anEnd; blockBegin += blockSize)
+		{
+			const int blockEnd = anEnd - blockBegin < blockSize ? anEnd : blockBegin + blockSize;
+			for (int index = blockBegin; index < blockEnd; ++index)
+			{
+				const Vector3<T> centroid = GetCentroid(primitives[index]);
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					blockBins[index - blockBegin][axis] = GetBinIndex(aRange, axis, scales[axis], aBinCount, centroid);
+				}
+			}
+			for (int index = blockBegin; index < blockEnd; ++index)
+			{
+				const BuildPrimitive& primitive = primitives[index];
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					someBins.myBins[axis][blockBins[index - blockBegin][axis]].Add(primitive.myMin, primitive.myMax);
+				}
+			}
+		}
+	}
+
+	template<class T>
+	inline int BVH<T>::BuildSubtree(Builder& aBuilder, const int aNode, const int aBegin, const int anEnd, const Range& aRange, const int aThreadCount)
+	{
+		// Ranges this large bin and build their children on several threads
+		const int parallelCount = 1 << 15;
+		const int count = anEnd - aBegin;
+		BuildNode& node = aBuilder.myNodes[aNode];
+		node.myMin = aRange.myBounds.myMin;
+		node.myMax = aRange.myBounds.myMax;
+		node.myBegin = aBegin;
+		node.myCount = count;
+		node.mySubtreeSize = 1;
+		if (count == 1)
+		{
+			return 1;
+		}
+
+		// Small ranges get one bin per primitive, which is as fine as the split search can use
+		const int binCount = count < BinCount ? count : BinCount;
+		Bins bins;
+		if (aThreadCount > 1 && count >= parallelCount)
+		{
+			std::vector<Bins> threadBins(aThreadCount);
+			std::vector<std::thread> threads;
+			for (int thread = 1; thread < aThreadCount; ++thread)
+			{
+				threads.emplace_back([&aBuilder, &aRange, &threadBins, binCount, aBegin, count, aThreadCount, thread]()
+				{
+					FillBins(aBuilder, aRange, binCount, aBegin + static_cast<int>(static_cast<long long>(count) * thread / aThreadCount),
+						aBegin + static_cast<int>(static_cast<long long>(count) * (thread + 1) / aThreadCount), threadBins[thread]);
+				});
+			}
+			FillBins(aBuilder, aRange, binCount, aBegin, aBegin + count / aThreadCount, bins);
+			for (int thread = 1; thread < aThreadCount; ++thread)
+			{
+				threads[thread - 1].join();
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					for (int bin = 0; bin < binCount; ++bin)
+					{
+						bins.myBins[axis][bin].Add(threadBins[thread].myBins[axis][bin]);
+					}
+				}
+			}
+		}
+		else
+		{
+			FillBins(aBuilder, aRange, binCount, aBegin, anEnd, bins);
+		}
+
+		// Surface area heuristic, with traversing a node costing as much as testing a primitive
+		T bestCost = std::numeric_limits<T>::max();
+		int bestAxis = -1;
+		int bestSplit = 0;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			if (!(aRange.myCentroids.myMax[axis] > aRange.myCentroids.myMin[axis]))
+			{
+				continue;
+			}
+			T rightCosts[BinCount];
+			Bin right;
+			right.Clear();
+			for (int split = binCount - 1; split > 0; --split)
+			{
+				right.Add(bins.myBins[axis][split]);
+				rightCosts[split] = right.GetHalfArea() * static_cast<T>(right.myCount);
+			}
+			Bin left;
+			left.Clear();
+			for (int split = 1; split < binCount; ++split)
+			{
+				left.Add(bins.myBins[axis][split - 1]);
+				const T cost = left.GetHalfArea() * static_cast<T>(left.myCount) + rightCosts[split];
+				if (left.myCount > 0 && left.myCount < count && cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		const T area = aRange.myBounds.GetHalfArea();
+		if (count <= MaxLeafSize && (bestAxis < 0 || area * static_cast<T>(count) <= area + bestCost))
+		{
+			return 1;
+		}
+
+		BuildPrimitive* primitives = aBuilder.myPrimitives.GetData();
+		int middle;
+		if (bestAxis >= 0)
+		{
+			const T scale = static_cast<T>(binCount) / (aRange.myCentroids.myMax[bestAxis] - aRange.myCentroids.myMin[bestAxis]);
+			middle = static_cast<int>(std::partition(primitives + aBegin, primitives + anEnd, [&aRange, bestAxis, scale, binCount, bestSplit](const BuildPrimitive& aPrimitive)
+			{
+				return GetBinIndex(aRange, bestAxis, scale, binCount, GetCentroid(aPrimitive)) < bestSplit;
+			}) - primitives);
+		}
+		else
+		{
+			// Every centroid is in the same place, so any split is as good as another
+			middle = aBegin + count / 2;
+		}
+		Range leftRange;
+		Range rightRange;
+		leftRange.myBounds.Clear();
+		leftRange.myCentroids.Clear();
+		rightRange.myBounds.Clear();
+		rightRange.myCentroids.Clear();
+		if (bestAxis >= 0)
+		{
+			for (int bin = 0; bin < binCount; ++bin)
+			{
+				(bin < bestSplit ? leftRange : rightRange).myBounds.Add(bins.myBins[bestAxis][bin]);
+			}
+		}
+		for (int index = aBegin; index < anEnd; ++index)
+		{
+			Range& range = index < middle ? leftRange : rightRange;
+			if (bestAxis < 0)
+			{
+				range.myBounds.Add(primitives[index].myMin, primitives[index].myMax);
+			}
+			const Vector3<T> centroid = GetCentroid(primitives[index]);
+			range.myCentroids.Add(centroid, centroid);
+		}
+
+		const int left = aBuilder.myNodeCount.fetch_add(2);
+		node.myLeft = left;
+		node.myCount = 0;
+		int leftSize = 0;
+		int rightSize = 0;
+		if (aThreadCount > 1 && count >= parallelCount)
+		{
+			const int leftThreads = aThreadCount / 2;
+			std::thread leftThread([&aBuilder, &leftRange, &leftSize, left, aBegin, middle, leftThreads]()
+			{
+				leftSize = BuildSubtree(aBuilder, left, aBegin, middle, leftRange, leftThreads);
+			});
+			rightSize = BuildSubtree(aBuilder, left + 1, middle, anEnd, rightRange, aThreadCount - leftThreads);
+			leftThread.join();
+		}
+		else
+		{
+			leftSize = BuildSubtree(aBuilder, left, aBegin, middle, leftRange, aThreadCount);
+			rightSize = BuildSubtree(aBuilder, left + 1, middle, anEnd, rightRange, aThreadCount);
+		}
+		// The node array doesn't move during the build, so the reference is still good
+		node.mySubtreeSize = 1 + leftSize + rightSize;
+		return node.mySubtreeSize;
+	}
+
+	template<class T>
+	inline bool BVH<T>::HitsBox(const Vector3<T>& aMin, const Vector3<T>& aMax, const Vector3<T>& anOrigin, const Vector3<T>& anInverseDirection, const T aMaxDistance, T& anEntry)
+	{
+		// Slab test clipped to [0, aMaxDistance]
+		T nearest = 0;
+		T farthest = aMaxDistance;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const T entry = (aMin[axis] - anOrigin[axis]) * anInverseDirection[axis];
+			const T exit = (aMax[axis] - anOrigin[axis]) * anInverseDirection[axis];
+			const T axisNear = entry < exit ? entry : exit;
+			const T axisFar = entry > exit ? entry : exit;
+			nearest = axisNear > nearest ? axisNear : nearest;
+			farthest = axisFar < farthest ? axisFar : farthest;
+		}
+		anEntry = nearest;
+		return nearest <= farthest;
+	}
+
+	template<class T>
+	inline Vector3<T> BVH<T>::GetInverse(const Vector3<T>& aDirection)
+	{
+		const T one = static_cast<T>(1);
+		return Vector3<T>(one / aDirection.x, one / aDirection.y, one / aDirection.z);
+	}
+}
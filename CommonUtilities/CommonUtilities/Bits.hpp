@@ -0,0 +1,50 @@
+#pragma once
+#include <assert.h>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace CommonUtilities
+{
+	// Index of the lowest set bit (tzcnt/bsf), aMask must not be 0
+	inline int CountTrailingZeros(const uint32_t aMask)
+	{
+		assert(aMask != 0 && "Mask has no bits set!");
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, aMask);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(aMask);
+#endif
+	}
+
+	inline int CountTrailingZeros(const uint64_t aMask)
+	{
+		assert(aMask != 0 && "Mask has no bits set!");
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, aMask);
+		return static_cast<int>(index);
+#elif defined(_MSC_VER)
+		const uint32_t low = static_cast<uint32_t>(aMask);
+		return low != 0 ? CountTrailingZeros(low) : 32 + CountTrailingZeros(static_cast<uint32_t>(aMask >> 32));
+#else
+		return __builtin_ctzll(aMask);
+#endif
+	}
+
+	inline int PopCount(const uint64_t aWord)
+	{
+#ifdef _MSC_VER
+		// __popcnt64 needs a CPU with popcnt, the bit trick runs anywhere
+		uint64_t word = aWord - ((aWord >> 1) & 0x5555555555555555ull);
+		word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#else
+		return __builtin_popcountll(aWord);
+#endif
+	}
+}
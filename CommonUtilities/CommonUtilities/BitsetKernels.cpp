@@ -0,0 +1,183 @@
+#include "BitsetKernels.hpp"
+#include "SimdLevel.hpp"
+
+namespace CU = CommonUtilities;
+
+namespace
+{
+	// Word packs: ourWords 64-bit words per register, and Count giving the set bits per 64-bit lane
+	struct WordPackScalar
+	{
+		typedef uint64_t Type;
+		static const int ourWords = 1;
+
+		static Type Load(const uint64_t* aSource) { return *aSource; }
+		static void Store(uint64_t* aDestination, const Type aValue) { *aDestination = aValue; }
+		static Type And(const Type aLeft, const Type aRight) { return aLeft & aRight; }
+		static Type Or(const Type aLeft, const Type aRight) { return aLeft | aRight; }
+		static Type Xor(const Type aLeft, const Type aRight) { return aLeft ^ aRight; }
+		static Type AndNot(const Type aLeft, const Type aRight) { return aLeft & ~aRight; }
+		static Type Zero() { return 0; }
+		static Type Count(const Type aValue) { return static_cast<Type>(CU::PopCount(aValue)); }
+		static Type AddCounts(const Type aLeft, const Type aRight) { return aLeft + aRight; }
+		static uint64_t Sum(const Type aValue) { return aValue; }
+	};
+
+	namespace Scalar
+	{
+		typedef WordPackScalar WidePack;
+#include "BitsetKernels.inl"
+	}
+
+#ifdef CU_SIMD_SSE
+	struct WordPackSSE
+	{
+		typedef __m128i Type;
+		static const int ourWords = 2;
+
+		static Type Load(const uint64_t* aSource) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(aSource)); }
+		static void Store(uint64_t* aDestination, const Type aValue) { _mm_storeu_si128(reinterpret_cast<__m128i*>(aDestination), aValue); }
+		static Type And(const Type aLeft, const Type aRight) { return _mm_and_si128(aLeft, aRight); }
+		static Type Or(const Type aLeft, const Type aRight) { return _mm_or_si128(aLeft, aRight); }
+		static Type Xor(const Type aLeft, const Type aRight) { return _mm_xor_si128(aLeft, aRight); }
+		static Type AndNot(const Type aLeft, const Type aRight) { return _mm_andnot_si128(aRight, aLeft); }
+		static Type Zero() { return _mm_setzero_si128(); }
+		static Type AddCounts(const Type aLeft, const Type aRight) { return _mm_add_epi64(aLeft, aRight); }
+
+		// Bit counts of 2, 4 and 8 bits wide fields, then the bytes of each lane summed with psadbw
+		static Type Count(Type aValue)
+		{
+			aValue = _mm_sub_epi8(aValue, _mm_and_si128(_mm_srli_epi64(aValue, 1), _mm_set1_epi8(0x55)));
+			aValue = _mm_add_epi8(_mm_and_si128(aValue, _mm_set1_epi8(0x33)), _mm_and_si128(_mm_srli_epi64(aValue, 2), _mm_set1_epi8(0x33)));
+			aValue = _mm_and_si128(_mm_add_epi8(aValue, _mm_srli_epi64(aValue, 4)), _mm_set1_epi8(0x0F));
+			return _mm_sad_epu8(aValue, _mm_setzero_si128());
+		}
+
+		static uint64_t Sum(const Type aValue)
+		{
+			alignas(16) uint64_t lanes[2];
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), aValue);
+			return lanes[0] + lanes[1];
+		}
+	};
+
+	namespace Sse
+	{
+		typedef WordPackSSE WidePack;
+#include "BitsetKernels.inl"
+	}
+
+CU_SIMD_AVX2_BEGIN
+	struct WordPackAVX2
+	{
+		typedef __m256i Type;
+		static const int ourWords = 4;
+
+		static Type Load(const uint64_t* aSource) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aSource)); }
+		static void Store(uint64_t* aDestination, const Type aValue) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(aDestination), aValue); }
+		static Type And(const Type aLeft, const Type aRight) { return _mm256_and_si256(aLeft, aRight); }
+		static Type Or(const Type aLeft, const Type aRight) { return _mm256_or_si256(aLeft, aRight); }
+		static Type Xor(const Type aLeft, const Type aRight) { return _mm256_xor_si256(aLeft, aRight); }
+		static Type AndNot(const Type aLeft, const Type aRight) { return _mm256_andnot_si256(aRight, aLeft); }
+		static Type Zero() { return _mm256_setzero_si256(); }
+		static Type AddCounts(const Type aLeft, const Type aRight) { return _mm256_add_epi64(aLeft, aRight); }
+
+		// Looks up the bit count of each nibble with vpshufb
+		static Type Count(const Type aValue)
+		{
+			const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+			const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(aValue, lowNibbles));
+			const __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi64(aValue, 4), lowNibbles));
+			return _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+		}
+
+		static uint64_t Sum(const Type aValue)
+		{
+			alignas(32) uint64_t lanes[4];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), aValue);
+			return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+		}
+	};
+
+	namespace Avx2
+	{
+		typedef WordPackAVX2 WidePack;
+#include "BitsetKernels.inl"
+	}
+CU_SIMD_AVX2_END
+
+CU_SIMD_AVX512_BEGIN
+	struct WordPackAVX512
+	{
+		typedef __m512i Type;
+		static const int ourWords = 8;
+
+		static Type Load(const uint64_t* aSource) { return _mm512_loadu_si512(aSource); }
+		static void Store(uint64_t* aDestination, const Type aValue) { _mm512_storeu_si512(aDestination, aValue); }
+		static Type And(const Type aLeft, const Type aRight) { return _mm512_and_si512(aLeft, aRight); }
+		static Type Or(const Type aLeft, const Type aRight) { return _mm512_or_si512(aLeft, aRight); }
+		static Type Xor(const Type aLeft, const Type aRight) { return _mm512_xor_si512(aLeft, aRight); }
+		static Type AndNot(const Type aLeft, const Type aRight) { return _mm512_andnot_si512(aRight, aLeft); }
+		static Type Zero() { return _mm512_setzero_si512(); }
+		static Type AddCounts(const Type aLeft, const Type aRight) { return _mm512_add_epi64(aLeft, aRight); }
+
+		// AVX-512F has no byte shuffle or psadbw, so the whole count is done with 64-bit shifts and masks
+		static Type Count(Type aValue)
+		{
+			aValue = _mm512_sub_epi64(aValue, _mm512_and_si512(_mm512_srli_epi64(aValue, 1), _mm512_set1_epi64(0x5555555555555555ll)));
+			aValue = _mm512_add_epi64(_mm512_and_si512(aValue, _mm512_set1_epi64(0x3333333333333333ll)), _mm512_and_si512(_mm512_srli_epi64(aValue, 2), _mm512_set1_epi64(0x3333333333333333ll)));
+			aValue = _mm512_and_si512(_mm512_add_epi64(aValue, _mm512_srli_epi64(aValue, 4)), _mm512_set1_epi64(0x0F0F0F0F0F0F0F0Fll));
+			aValue = _mm512_add_epi64(aValue, _mm512_srli_epi64(aValue, 8));
+			aValue = _mm512_add_epi64(aValue, _mm512_srli_epi64(aValue, 16));
+			aValue = _mm512_add_epi64(aValue, _mm512_srli_epi64(aValue, 32));
+			return _mm512_and_si512(aValue, _mm512_set1_epi64(0x7F));
+		}
+
+		static uint64_t Sum(const Type aValue)
+		{
+			return static_cast<uint64_t>(_mm512_reduce_add_epi64(aValue));
+		}
+	};
+
+	namespace Avx512
+	{
+		typedef WordPackAVX512 WidePack;
+#include "BitsetKernels.inl"
+	}
+CU_SIMD_AVX512_END
+#endif
+}
+
+namespace CommonUtilities
+{
+	namespace BitsetKernels
+	{
+		void And(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+		{
+			CU_SIMD_DISPATCH(And(aDestination, aSource, aWordCount));
+		}
+
+		void Or(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+		{
+			CU_SIMD_DISPATCH(Or(aDestination, aSource, aWordCount));
+		}
+
+		void Xor(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+		{
+			CU_SIMD_DISPATCH(Xor(aDestination, aSource, aWordCount));
+		}
+
+		void AndNot(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+		{
+			CU_SIMD_DISPATCH(AndNot(aDestination, aSource, aWordCount));
+		}
+
+		int PopCount(const uint64_t* someWords, const int aWordCount)
+		{
+			int count = 0;
+			CU_SIMD_DISPATCH(PopCount(someWords, aWordCount, count));
+			return count;
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include "Bits.hpp"
+
+namespace CommonUtilities
+{
+	// Bulk operations on arrays of 64-bit words, SIMD kernels chosen at runtime (SimdLevel.hpp).
+	// DynamicBitset uses these; StaticBitset's word loops are short enough to inline.
+	namespace BitsetKernels
+	{
+		void And(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount);
+		void Or(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount);
+		void Xor(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount);
+		// aDestination &= ~aSource
+		void AndNot(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount);
+		int PopCount(const uint64_t* someWords, const int aWordCount);
+	}
+
+	// The indices of the set bits in an array of words, lowest first:
+	//   for (int index : bitset.GetSetBits())
+	class SetBitRange
+	{
+	public:
+		class Iterator
+		{
+		public:
+			Iterator(const uint64_t* someWords, const int aWordIndex, const int aWordCount) : myWords(someWords), myWordIndex(aWordIndex), myWordCount(aWordCount)
+			{
+				myWord = myWordIndex < myWordCount ? myWords[myWordIndex] : 0;
+				SkipEmptyWords();
+			}
+
+			int operator*() const
+			{
+				return myWordIndex * 64 + CountTrailingZeros(myWord);
+			}
+
+			Iterator& operator++()
+			{
+				// Clears the lowest set bit
+				myWord &= myWord - 1;
+				SkipEmptyWords();
+				return (*this);
+			}
+
+			bool operator==(const Iterator& anIterator) const { return myWordIndex == anIterator.myWordIndex && myWord == anIterator.myWord; }
+			bool operator!=(const Iterator& anIterator) const { return !((*this) == anIterator); }
+
+		private:
+			void SkipEmptyWords()
+			{
+				while (myWord == 0 && myWordIndex < myWordCount)
+				{
+					++myWordIndex;
+					myWord = myWordIndex < myWordCount ? myWords[myWordIndex] : 0;
+				}
+			}
+
+			const uint64_t* myWords;
+			uint64_t myWord;
+			int myWordIndex;
+			int myWordCount;
+		};
+
+		SetBitRange(const uint64_t* someWords, const int aWordCount) : myWords(someWords), myWordCount(aWordCount) {}
+
+		Iterator begin() const { return Iterator(myWords, 0, myWordCount); }
+		Iterator end() const { return Iterator(myWords, myWordCount, myWordCount); }
+
+	private:
+		const uint64_t* myWords;
+		int myWordCount;
+	};
+}
@@ -0,0 +1,85 @@
+// Bitset kernels written once over a word pack (BitsetKernels.cpp).
+// Included by BitsetKernels.cpp once per instruction set, inside a namespace that defines WidePack.
+// Each kernel runs [aBegin, anEnd) where the range is a multiple of Pack::ourWords.
+
+template<class Pack>
+void AndKernel(uint64_t* aDestination, const uint64_t* aSource, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWords)
+	{
+		Pack::Store(aDestination + index, Pack::And(Pack::Load(aDestination + index), Pack::Load(aSource + index)));
+	}
+}
+
+template<class Pack>
+void OrKernel(uint64_t* aDestination, const uint64_t* aSource, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWords)
+	{
+		Pack::Store(aDestination + index, Pack::Or(Pack::Load(aDestination + index), Pack::Load(aSource + index)));
+	}
+}
+
+template<class Pack>
+void XorKernel(uint64_t* aDestination, const uint64_t* aSource, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWords)
+	{
+		Pack::Store(aDestination + index, Pack::Xor(Pack::Load(aDestination + index), Pack::Load(aSource + index)));
+	}
+}
+
+template<class Pack>
+void AndNotKernel(uint64_t* aDestination, const uint64_t* aSource, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWords)
+	{
+		Pack::Store(aDestination + index, Pack::AndNot(Pack::Load(aDestination + index), Pack::Load(aSource + index)));
+	}
+}
+
+template<class Pack>
+int PopCountKernel(const uint64_t* someWords, const int aBegin, const int anEnd)
+{
+	typename Pack::Type counts = Pack::Zero();
+	for (int index = aBegin; index < anEnd; index += Pack::ourWords)
+	{
+		counts = Pack::AddCounts(counts, Pack::Count(Pack::Load(someWords + index)));
+	}
+	return static_cast<int>(Pack::Sum(counts));
+}
+
+#define CU_BITSET_KERNEL_RUN(aKernel, aCount, ...) \
+	{ \
+		const int packedEnd = (aCount) - (aCount) % WidePack::ourWords; \
+		aKernel<WidePack>(__VA_ARGS__, 0, packedEnd); \
+		aKernel<WordPackScalar>(__VA_ARGS__, packedEnd, (aCount)); \
+	}
+
+void And(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+{
+	CU_BITSET_KERNEL_RUN(AndKernel, aWordCount, aDestination, aSource);
+}
+
+void Or(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+{
+	CU_BITSET_KERNEL_RUN(OrKernel, aWordCount, aDestination, aSource);
+}
+
+void Xor(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+{
+	CU_BITSET_KERNEL_RUN(XorKernel, aWordCount, aDestination, aSource);
+}
+
+void AndNot(uint64_t* aDestination, const uint64_t* aSource, const int aWordCount)
+{
+	CU_BITSET_KERNEL_RUN(AndNotKernel, aWordCount, aDestination, aSource);
+}
+
+void PopCount(const uint64_t* someWords, const int aWordCount, int& aCount)
+{
+	const int packedEnd = aWordCount - aWordCount % WidePack::ourWords;
+	aCount = PopCountKernel<WidePack>(someWords, 0, packedEnd) + PopCountKernel<WordPackScalar>(someWords, packedEnd, aWordCount);
+}
+
+#undef CU_BITSET_KERNEL_RUN
@@ -0,0 +1,109 @@
+#include "CpuFeatures.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace
+{
+	void QueryCpuid(int aLeaf, int aSubLeaf, unsigned int aRegisters[4])
+	{
+		aRegisters[0] = aRegisters[1] = aRegisters[2] = aRegisters[3] = 0;
+#if defined(_MSC_VER)
+		int registers[4];
+		__cpuidex(registers, aLeaf, aSubLeaf);
+		for (int index = 0; index < 4; ++index)
+		{
+			aRegisters[index] = static_cast<unsigned int>(registers[index]);
+		}
+#elif defined(__x86_64__) || defined(__i386__)
+		__cpuid_count(aLeaf, aSubLeaf, aRegisters[0], aRegisters[1], aRegisters[2], aRegisters[3]);
+#else
+		(void)aLeaf;
+		(void)aSubLeaf;
+#endif
+	}
+
+	// Which register states the OS saves on context switches (XCR0)
+	unsigned long long QueryEnabledRegisterStates()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#elif defined(__x86_64__) || defined(__i386__)
+		unsigned int low;
+		unsigned int high;
+		__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+		return (static_cast<unsigned long long>(high) << 32) | low;
+#else
+		return 0;
+#endif
+	}
+}
+
+namespace CommonUtilities
+{
+	const CpuFeatures& CpuFeatures::Get()
+	{
+		static const CpuFeatures ourInstance = CpuFeatures();
+		return ourInstance;
+	}
+
+	CpuFeatures::CpuFeatures()
+	{
+		unsigned int registers[4];
+
+		QueryCpuid(0, 0, registers);
+		const unsigned int highestLeaf = registers[0];
+
+		QueryCpuid(1, 0, registers);
+		mySSE2 = (registers[3] & (1u << 26)) != 0;
+		mySSE41 = (registers[2] & (1u << 19)) != 0;
+		const bool osSavesYmm = (registers[2] & (1u << 27)) != 0 && (QueryEnabledRegisterStates() & 0x6) == 0x6;
+		myAVX = osSavesYmm && (registers[2] & (1u << 28)) != 0;
+		myFMA = myAVX && (registers[2] & (1u << 12)) != 0;
+
+		// AVX-512 also needs the OS to save the mask registers and both halves of zmm0-31
+		const bool osSavesZmm = osSavesYmm && (QueryEnabledRegisterStates() & 0xe0) == 0xe0;
+
+		myAVX2 = false;
+		myAVX512F = false;
+		if (highestLeaf >= 7)
+		{
+			QueryCpuid(7, 0, registers);
+			myAVX2 = myAVX && (registers[1] & (1u << 5)) != 0;
+			myAVX512F = osSavesZmm && myFMA && (registers[1] & (1u << 16)) != 0;
+		}
+	}
+
+	bool CpuFeatures::HasSSE2() const
+	{
+		return mySSE2;
+	}
+
+	bool CpuFeatures::HasSSE41() const
+	{
+		return mySSE41;
+	}
+
+	bool CpuFeatures::HasAVX() const
+	{
+		return myAVX;
+	}
+
+	bool CpuFeatures::HasAVX2() const
+	{
+		return myAVX2;
+	}
+
+	bool CpuFeatures::HasFMA() const
+	{
+		return myFMA;
+	}
+
+	bool CpuFeatures::HasAVX512F() const
+	{
+		return myAVX512F;
+	}
+}
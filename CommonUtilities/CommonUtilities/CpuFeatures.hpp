@@ -0,0 +1,28 @@
+#pragma once
+
+namespace CommonUtilities
+{
+	// Instruction sets supported by the CPU we are running on, queried once through cpuid
+	class CpuFeatures
+	{
+	public:
+		static const CpuFeatures& Get();
+
+		bool HasSSE2() const;
+		bool HasSSE41() const;
+		bool HasAVX() const;
+		bool HasAVX2() const;
+		bool HasFMA() const;
+		bool HasAVX512F() const;
+
+	private:
+		CpuFeatures();
+
+		bool mySSE2;
+		bool mySSE41;
+		bool myAVX;
+		bool myAVX2;
+		bool myFMA;
+		bool myAVX512F;
+	};
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include <assert.h>
+#include <functional>
+#include <utility>
+#include "GrowingArray.hpp"
+
+namespace CommonUtilities
+{
+	// Priority queue on a heap where every node has arity children, stored in a GrowingArray.
+	// A wider node makes the heap shallower and keeps the children of a node in one or two cache lines,
+	// so a pop touches fewer lines than in a binary heap; 4 is a good default.
+	// The top is the element that compares less than all others, so std::less gives a min-heap
+	// (the opposite of std::priority_queue).
+	template<class T, int arity = 4, class Compare = std::less<T>, class Allocator = AlignedAllocator>
+	class DaryHeap
+	{
+	public:
+		static_assert(arity >= 2, "A heap node needs at least two children!");
+
+		DaryHeap(const Compare& aCompare = Compare(), const Allocator& anAllocator = Allocator());
+
+		inline void Push(const T& anObject);
+		inline void Push(T&& anObject);
+		template<class... Arguments>
+		inline void Emplace(Arguments&&... someArguments);
+		// Removes and returns the top
+		inline T Pop();
+
+		inline const T& GetTop() const;
+		inline int Count() const;
+		inline bool IsEmpty() const;
+		inline void Clear();
+		inline void Reserve(const int aCapacity);
+
+		// The heap in storage order, the top first
+		inline const T* begin() const;
+		inline const T* end() const;
+
+	private:
+		void SiftUp(int anIndex);
+		void SiftDown(int anIndex);
+
+		GrowingArray<T, int, Allocator> myElements;
+		Compare myCompare;
+	};
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline DaryHeap<T, arity, Compare, Allocator>::DaryHeap(const Compare& aCompare, const Allocator& anAllocator) : myElements(anAllocator), myCompare(aCompare)
+	{
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void DaryHeap<T, arity, Compare, Allocator>::Push(const T& anObject)
+	{
+		myElements.Add(anObject);
+		SiftUp(myElements.Size() - 1);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void DaryHeap<T, arity, Compare, Allocator>::Push(T&& anObject)
+	{
+		myElements.Add(std::move(anObject));
+		SiftUp(myElements.Size() - 1);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	template<class... Arguments>
+	inline void DaryHeap<T, arity, Compare, Allocator>::Emplace(Arguments&&... someArguments)
+	{
+		myElements.Emplace(std::forward<Arguments>(someArguments)...);
+		SiftUp(myElements.Size() - 1);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline T DaryHeap<T, arity, Compare, Allocator>::Pop()
+	{
+		assert(!myElements.IsEmpty() && "Heap is empty!");
+		T top = std::move(myElements[0]);
+		const int last = myElements.Size() - 1;
+		if (last > 0)
+		{
+			myElements[0] = std::move(myElements[last]);
+		}
+		myElements.RemoveCyclicAtIndex(last);
+		if (last > 1)
+		{
+			SiftDown(0);
+		}
+		return top;
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline const T& DaryHeap<T, arity, Compare, Allocator>::GetTop() const
+	{
+		assert(!myElements.IsEmpty() && "Heap is empty!");
+		return myElements[0];
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline int DaryHeap<T, arity, Compare, Allocator>::Count() const
+	{
+		return myElements.Size();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline bool DaryHeap<T, arity, Compare, Allocator>::IsEmpty() const
+	{
+		return myElements.IsEmpty();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void DaryHeap<T, arity, Compare, Allocator>::Clear()
+	{
+		myElements.RemoveAll();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void DaryHeap<T, arity, Compare, Allocator>::Reserve(const int aCapacity)
+	{
+		myElements.Reserve(aCapacity);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline const T* DaryHeap<T, arity, Compare, Allocator>::begin() const
+	{
+		return myElements.begin();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline const T* DaryHeap<T, arity, Compare, Allocator>::end() const
+	{
+		return myElements.end();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void DaryHeap<T, arity, Compare, Allocator>::SiftUp(int anIndex)
+	{
+		// Moves parents down into the hole instead of swapping
+		T object = std::move(myElements[anIndex]);
+		while (anIndex > 0)
+		{
+			const int parent = (anIndex - 1) / arity;
+			if (!myCompare(object, myElements[parent]))
+			{
+				break;
+			}
+			myElements[anIndex] = std::move(myElements[parent]);
+			anIndex = parent;
+		}
+		myElements[anIndex] = std::move(object);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void DaryHeap<T, arity, Compare, Allocator>::SiftDown(int anIndex)
+	{
+		const int count = myElements.Size();
+		T object = std::move(myElements[anIndex]);
+		for (;;)
+		{
+			const int firstChild = anIndex * arity + 1;
+			if (firstChild >= count)
+			{
+				break;
+			}
+			const int lastChild = firstChild + arity < count ? firstChild + arity : count;
+			int best = firstChild;
+			for (int child = firstChild + 1; child < lastChild; ++child)
+			{
+				if (myCompare(myElements[child], myElements[best]))
+				{
+					best = child;
+				}
+			}
+			if (!myCompare(myElements[best], object))
+			{
+				break;
+			}
+			myElements[anIndex] = std::move(myElements[best]);
+			anIndex = best;
+		}
+		myElements[anIndex] = std::move(object);
+	}
+}
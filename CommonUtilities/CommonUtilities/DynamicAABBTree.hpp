@@ -0,0 +1,598 @@
+#pragma once
+#include <assert.h>
+#include "GrowingArray.hpp"
+#include "Vector.hpp"
+
+namespace CommonUtilities
+{
+	// Two proxies whose fat boxes overlap, with myFirst < mySecond
+	struct DynamicAABBTreePair
+	{
+		int myFirst;
+		int mySecond;
+	};
+
+	// Bounding volume tree for moving boxes, in 2D with Vector2 or in 3D with Vector3. Every proxy is stored
+	// with a box fattened by a margin, so moves that stay inside it leave the tree alone. A proxy that leaves
+	// its fat box is removed and reinserted next to the sibling that grows the tree the least, and the
+	// ancestors on the way up are refit and rebalanced with rotations like an AVL tree.
+	// Nodes live in one pooled array and a proxy id is the index of its leaf, which never moves.
+	template<class VectorType>
+	class DynamicAABBTree
+	{
+	public:
+		typedef typename VectorType::ValueType ValueType;
+		static const int ourDimensions = VectorType::ourSize;
+
+		DynamicAABBTree(const ValueType aMargin = static_cast<ValueType>(0.1));
+
+		// Returns the proxy id
+		int CreateProxy(const VectorType& aMin, const VectorType& aMax, const int aUserData);
+		void DestroyProxy(const int aProxy);
+		// aDisplacement is how far the proxy is expected to move next, the fat box is stretched that way.
+		// Returns false if the proxy still fit its fat box and the tree was left untouched.
+		bool MoveProxy(const int aProxy, const VectorType& aMin, const VectorType& aMax, const VectorType& aDisplacement);
+		void RemoveAll();
+
+		// Adds the proxies whose fat boxes overlap the box to someProxies
+		void Query(const VectorType& aMin, const VectorType& aMax, GrowingArray<int>& someProxies) const;
+		// Replaces somePairs with the overlapping pairs where at least one proxy was created or reinserted
+		// since the last call, and starts tracking moves anew
+		void QueryMovedPairs(GrowingArray<DynamicAABBTreePair>& somePairs);
+		// Replaces somePairs with every overlapping pair
+		void QueryAllPairs(GrowingArray<DynamicAABBTreePair>& somePairs) const;
+
+		int GetUserData(const int aProxy) const;
+		const VectorType& GetFatMin(const int aProxy) const;
+		const VectorType& GetFatMax(const int aProxy) const;
+		int GetProxyCount() const;
+		// 0 for a single proxy, -1 when empty
+		int GetHeight() const;
+
+	private:
+		static const int ourNull = -1;
+		// Enough for a balanced tree of any int sized proxy count
+		static const int ourStackSize = 64;
+
+		struct Node
+		{
+			VectorType myMin;
+			VectorType myMax;
+			// The next free node while in the free list
+			int myParent;
+			// ourNull for leaves
+			int myLeft;
+			int myRight;
+			// 0 for leaves, -1 for free nodes
+			int myHeight;
+			int myUserData;
+			// Position in myMovedProxies or ourNull
+			int myMovedIndex;
+
+			bool IsLeaf() const;
+		};
+
+		static bool Overlaps(const Node& aNode, const VectorType& aMin, const VectorType& aMax);
+		static bool Contains(const VectorType& anOuterMin, const VectorType& anOuterMax, const VectorType& anInnerMin, const VectorType& anInnerMax);
+		// Perimeter in 2D, half the surface area in 3D
+		static ValueType GetCost(const VectorType& aMin, const VectorType& aMax);
+		static void SetUnion(Node& aNode, const Node& aFirst, const Node& aSecond);
+
+		int AllocateNode();
+		void FreeNode(const int aNode);
+		void InsertLeaf(const int aLeaf);
+		void RemoveLeaf(const int aLeaf);
+		// Refits and rebalances from aNode up to the root
+		void RefitUpwards(int aNode);
+		// Rotates a grandchild up if aNode's subtrees differ in height by more than one, returns the node now in its place
+		int Balance(const int aNode);
+		void MarkMoved(const int aProxy);
+		template<class Callback>
+		void VisitOverlaps(const VectorType& aMin, const VectorType& aMax, Callback aCallback) const;
+
+		GrowingArray<Node> myNodes;
+		GrowingArray<int> myMovedProxies;
+		ValueType myMargin;
+		int myRoot;
+		int myFreeNode;
+		int myProxyCount;
+	};
+
+	template<class VectorType>
+	inline bool DynamicAABBTree<VectorType>::Node::IsLeaf() const
+	{
+		return myLeft == ourNull;
+	}
+
+	template<class VectorType>
+	inline DynamicAABBTree<VectorType>::DynamicAABBTree(const ValueType aMargin)
+	{
+		assert(aMargin >= 0 && "Margin can't be negative!");
+		myMargin = aMargin;
+		myRoot = ourNull;
+		myFreeNode = ourNull;
+		myProxyCount = 0;
+	}
+
+	template<class VectorType>
+	inline int DynamicAABBTree<VectorType>::CreateProxy(const VectorType& aMin, const VectorType& aMax, const int aUserData)
+	{
+		const int proxy = AllocateNode();
+		Node& node = myNodes[proxy];
+		for (int axis = 0; axis < ourDimensions; ++axis)
+		{
+			node.myMin[axis] = aMin[axis] - myMargin;
+			node.myMax[axis] = aMax[axis] + myMargin;
+		}
+		node.myUserData = aUserData;
+		node.myHeight = 0;
+		InsertLeaf(proxy);
+		MarkMoved(proxy);
+		++myProxyCount;
+		return proxy;
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::DestroyProxy(const int aProxy)
+	{
+		assert(aProxy >= 0 && aProxy < myNodes.Size() && myNodes[aProxy].myHeight == 0 && "Invalid proxy!");
+		const int movedIndex = myNodes[aProxy].myMovedIndex;
+		if (movedIndex != ourNull)
+		{
+			myMovedProxies.RemoveCyclicAtIndex(movedIndex);
+			if (movedIndex < myMovedProxies.Size())
+			{
+				myNodes[myMovedProxies[movedIndex]].myMovedIndex = movedIndex;
+			}
+		}
+		RemoveLeaf(aProxy);
+		FreeNode(aProxy);
+		--myProxyCount;
+	}
+
+	template<class VectorType>
+	inline bool DynamicAABBTree<VectorType>::MoveProxy(const int aProxy, const VectorType& aMin, const VectorType& aMax, const VectorType& aDisplacement)
+	{
+		assert(aProxy >= 0 && aProxy < myNodes.Size() && myNodes[aProxy].myHeight == 0 && "Invalid proxy!");
+		Node& node = myNodes[aProxy];
+		VectorType fatMin;
+		VectorType fatMax;
+		VectorType hugeMin;
+		VectorType hugeMax;
+		for (int axis = 0; axis < ourDimensions; ++axis)
+		{
+			// Twice the displacement leaves room for a couple of frames at the same speed
+			const ValueType stretch = aDisplacement[axis] * 2;
+			fatMin[axis] = aMin[axis] - myMargin + (stretch < 0 ? stretch : 0);
+			fatMax[axis] = aMax[axis] + myMargin + (stretch > 0 ? stretch : 0);
+			hugeMin[axis] = fatMin[axis] - myMargin * 4;
+			hugeMax[axis] = fatMax[axis] + myMargin * 4;
+		}
+		// A fat box that has grown much larger than needed is shrunk even if the proxy still fits it
+		if (Contains(node.myMin, node.myMax, aMin, aMax) && Contains(hugeMin, hugeMax, node.myMin, node.myMax))
+		{
+			return false;
+		}
+
+		RemoveLeaf(aProxy);
+		node.myMin = fatMin;
+		node.myMax = fatMax;
+		InsertLeaf(aProxy);
+		MarkMoved(aProxy);
+		return true;
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::RemoveAll()
+	{
+		myNodes.RemoveAll();
+		myMovedProxies.RemoveAll();
+		myRoot = ourNull;
+		myFreeNode = ourNull;
+		myProxyCount = 0;
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::Query(const VectorType& aMin, const VectorType& aMax, GrowingArray<int>& someProxies) const
+	{
+		VisitOverlaps(aMin, aMax, [&someProxies](const int aProxy)
+		{
+			someProxies.Add(aProxy);
+		});
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::QueryMovedPairs(GrowingArray<DynamicAABBTreePair>& somePairs)
+	{
+		somePairs.RemoveAll();
+		for (const int proxy : myMovedProxies)
+		{
+			const Node& node = myNodes[proxy];
+			VisitOverlaps(node.myMin, node.myMax, [this, &somePairs, proxy](const int anOther)
+			{
+				// A pair of two moved proxies is found from both sides, keep it from the lower id
+				const bool otherMoved = myNodes[anOther].myMovedIndex != ourNull;
+				if (anOther != proxy && (!otherMoved || proxy < anOther))
+				{
+					somePairs.Add(proxy < anOther ? DynamicAABBTreePair{ proxy, anOther } : DynamicAABBTreePair{ anOther, proxy });
+				}
+			});
+		}
+		for (const int proxy : myMovedProxies)
+		{
+			myNodes[proxy].myMovedIndex = ourNull;
+		}
+		myMovedProxies.RemoveAll();
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::QueryAllPairs(GrowingArray<DynamicAABBTreePair>& somePairs) const
+	{
+		somePairs.RemoveAll();
+		if (myRoot == ourNull)
+		{
+			return;
+		}
+
+		// The tree is descended against itself, so each pair of overlapping subtrees is visited once instead of
+		// querying the whole tree for every leaf. A pair of one node with itself stands for the pairs within it.
+		GrowingArray<DynamicAABBTreePair> stack;
+		stack.Reserve(ourStackSize);
+		stack.Add(DynamicAABBTreePair{ myRoot, myRoot });
+		while (!stack.IsEmpty())
+		{
+			const DynamicAABBTreePair pair = stack.GetLast();
+			stack.RemoveCyclicAtIndex(stack.Size() - 1);
+			const Node& first = myNodes[pair.myFirst];
+			const Node& second = myNodes[pair.mySecond];
+			if (pair.myFirst == pair.mySecond)
+			{
+				if (!first.IsLeaf())
+				{
+					stack.Add(DynamicAABBTreePair{ first.myLeft, first.myRight });
+					stack.Add(DynamicAABBTreePair{ first.myRight, first.myRight });
+					stack.Add(DynamicAABBTreePair{ first.myLeft, first.myLeft });
+				}
+				continue;
+			}
+			if (!Overlaps(first, second.myMin, second.myMax))
+			{
+				continue;
+			}
+			if (first.IsLeaf() && second.IsLeaf())
+			{
+				somePairs.Add(pair.myFirst < pair.mySecond ? pair : DynamicAABBTreePair{ pair.mySecond, pair.myFirst });
+			}
+			else if (second.IsLeaf() || (!first.IsLeaf() && first.myHeight >= second.myHeight))
+			{
+				stack.Add(DynamicAABBTreePair{ first.myRight, pair.mySecond });
+				stack.Add(DynamicAABBTreePair{ first.myLeft, pair.mySecond });
+			}
+			else
+			{
+				stack.Add(DynamicAABBTreePair{ pair.myFirst, second.myRight });
+				stack.Add(DynamicAABBTreePair{ pair.myFirst, second.myLeft });
+			}
+		}
+	}
+
+	template<class VectorType>
+	inline int DynamicAABBTree<VectorType>::GetUserData(const int aProxy) const
+	{
+		assert(aProxy >= 0 && aProxy < myNodes.Size() && myNodes[aProxy].myHeight == 0 && "Invalid proxy!");
+		return myNodes[aProxy].myUserData;
+	}
+
+	template<class VectorType>
+	inline const VectorType& DynamicAABBTree<VectorType>::GetFatMin(const int aProxy) const
+	{
+		assert(aProxy >= 0 && aProxy < myNodes.Size() && myNodes[aProxy].myHeight == 0 && "Invalid proxy!");
+		return myNodes[aProxy].myMin;
+	}
+
+	template<class VectorType>
+	inline const VectorType& DynamicAABBTree<VectorType>::GetFatMax(const int aProxy) const
+	{
+		assert(aProxy >= 0 && aProxy < myNodes.Size() && myNodes[aProxy].myHeight == 0 && "Invalid proxy!");
+		return myNodes[aProxy].myMax;
+	}
+
+	template<class VectorType>
+	inline int DynamicAABBTree<VectorType>::GetProxyCount() const
+	{
+		return myProxyCount;
+	}
+
+	template<class VectorType>
+	inline int DynamicAABBTree<VectorType>::GetHeight() const
+	{
+		return myRoot == ourNull ? -1 : myNodes[myRoot].myHeight;
+	}
+
+	template<class VectorType>
+	inline bool DynamicAABBTree<VectorType>::Overlaps(const Node& aNode, const VectorType& aMin, const VectorType& aMax)
+	{
+		for (int axis = 0; axis < ourDimensions; ++axis)
+		{
+			if (aNode.myMin[axis] > aMax[axis] || aMin[axis] > aNode.myMax[axis])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class VectorType>
+	inline bool DynamicAABBTree<VectorType>::Contains(const VectorType& anOuterMin, const VectorType& anOuterMax, const VectorType& anInnerMin, const VectorType& anInnerMax)
+	{
+		for (int axis = 0; axis < ourDimensions; ++axis)
+		{
+			if (anInnerMin[axis] < anOuterMin[axis] || anInnerMax[axis] > anOuterMax[axis])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class VectorType>
+	inline typename DynamicAABBTree<VectorType>::ValueType DynamicAABBTree<VectorType>::GetCost(const VectorType& aMin, const VectorType& aMax)
+	{
+		ValueType cost = 0;
+		for (int axis = 0; axis < ourDimensions; ++axis)
+		{
+			const ValueType size = aMax[axis] - aMin[axis];
+			const int next = (axis + 1) % ourDimensions;
+			cost += ourDimensions == 2 ? size : size * (aMax[next] - aMin[next]);
+		}
+		return cost;
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::SetUnion(Node& aNode, const Node& aFirst, const Node& aSecond)
+	{
+		for (int axis = 0; axis < ourDimensions; ++axis)
+		{
+			aNode.myMin[axis] = aFirst.myMin[axis] < aSecond.myMin[axis] ? aFirst.myMin[axis] : aSecond.myMin[axis];
+			aNode.myMax[axis] = aFirst.myMax[axis] > aSecond.myMax[axis] ? aFirst.myMax[axis] : aSecond.myMax[axis];
+		}
+	}
+
+	template<class VectorType>
+	inline int DynamicAABBTree<VectorType>::AllocateNode()
+	{
+		int index = myFreeNode;
+		if (index == ourNull)
+		{
+			index = myNodes.Size();
+			myNodes.Add(Node());
+		}
+		else
+		{
+			myFreeNode = myNodes[index].myParent;
+		}
+		Node& node = myNodes[index];
+		node.myParent = ourNull;
+		node.myLeft = ourNull;
+		node.myRight = ourNull;
+		node.myHeight = 0;
+		node.myUserData = 0;
+		node.myMovedIndex = ourNull;
+		return index;
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::FreeNode(const int aNode)
+	{
+		myNodes[aNode].myParent = myFreeNode;
+		myNodes[aNode].myHeight = -1;
+		myFreeNode = aNode;
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::InsertLeaf(const int aLeaf)
+	{
+		if (myRoot == ourNull)
+		{
+			myRoot = aLeaf;
+			myNodes[aLeaf].myParent = ourNull;
+			return;
+		}
+
+		// Descend towards the cheapest sibling. Placing the leaf under a node costs the area of the new parent,
+		// and every ancestor passed on the way grows to hold the leaf, which the children then inherit.
+		const int parent = AllocateNode();
+		const Node& leaf = myNodes[aLeaf];
+		Node combined;
+		int sibling = myRoot;
+		while (!myNodes[sibling].IsLeaf())
+		{
+			const Node& node = myNodes[sibling];
+			SetUnion(combined, node, leaf);
+			const ValueType combinedCost = GetCost(combined.myMin, combined.myMax);
+			const ValueType cost = combinedCost * 2;
+			const ValueType inheritedCost = (combinedCost - GetCost(node.myMin, node.myMax)) * 2;
+
+			ValueType childCosts[2];
+			const int children[2] = { node.myLeft, node.myRight };
+			for (int side = 0; side < 2; ++side)
+			{
+				const Node& child = myNodes[children[side]];
+				SetUnion(combined, child, leaf);
+				childCosts[side] = GetCost(combined.myMin, combined.myMax) + inheritedCost;
+				if (!child.IsLeaf())
+				{
+					childCosts[side] -= GetCost(child.myMin, child.myMax);
+				}
+			}
+			if (cost < childCosts[0] && cost < childCosts[1])
+			{
+				break;
+			}
+			sibling = childCosts[0] < childCosts[1] ? children[0] : children[1];
+		}
+
+		const int oldParent = myNodes[sibling].myParent;
+		Node& newParent = myNodes[parent];
+		newParent.myParent = oldParent;
+		newParent.myLeft = sibling;
+		newParent.myRight = aLeaf;
+		newParent.myHeight = myNodes[sibling].myHeight + 1;
+		SetUnion(newParent, myNodes[sibling], leaf);
+		myNodes[sibling].myParent = parent;
+		myNodes[aLeaf].myParent = parent;
+		if (oldParent == ourNull)
+		{
+			myRoot = parent;
+		}
+		else if (myNodes[oldParent].myLeft == sibling)
+		{
+			myNodes[oldParent].myLeft = parent;
+		}
+		else
+		{
+			myNodes[oldParent].myRight = parent;
+		}
+		RefitUpwards(oldParent);
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::RemoveLeaf(const int aLeaf)
+	{
+		if (aLeaf == myRoot)
+		{
+			myRoot = ourNull;
+			return;
+		}
+
+		const int parent = myNodes[aLeaf].myParent;
+		const int grandParent = myNodes[parent].myParent;
+		const int sibling = myNodes[parent].myLeft == aLeaf ? myNodes[parent].myRight : myNodes[parent].myLeft;
+		myNodes[sibling].myParent = grandParent;
+		if (grandParent == ourNull)
+		{
+			myRoot = sibling;
+		}
+		else if (myNodes[grandParent].myLeft == parent)
+		{
+			myNodes[grandParent].myLeft = sibling;
+		}
+		else
+		{
+			myNodes[grandParent].myRight = sibling;
+		}
+		FreeNode(parent);
+		RefitUpwards(grandParent);
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::RefitUpwards(int aNode)
+	{
+		while (aNode != ourNull)
+		{
+			aNode = Balance(aNode);
+			Node& node = myNodes[aNode];
+			const Node& left = myNodes[node.myLeft];
+			const Node& right = myNodes[node.myRight];
+			node.myHeight = 1 + (left.myHeight > right.myHeight ? left.myHeight : right.myHeight);
+			SetUnion(node, left, right);
+			aNode = node.myParent;
+		}
+	}
+
+	template<class VectorType>
+	inline int DynamicAABBTree<VectorType>::Balance(const int aNode)
+	{
+		Node& node = myNodes[aNode];
+		if (node.IsLeaf() || node.myHeight < 2)
+		{
+			return aNode;
+		}
+
+		const int left = node.myLeft;
+		const int right = node.myRight;
+		const int balance = myNodes[right].myHeight - myNodes[left].myHeight;
+		if (balance >= -1 && balance <= 1)
+		{
+			return aNode;
+		}
+
+		// The taller child takes aNode's place, aNode keeps its shorter child and the shorter of the taller
+		// child's children, and the taller child keeps its own taller child
+		const bool rightIsTaller = balance > 1;
+		const int risen = rightIsTaller ? right : left;
+		const int kept = rightIsTaller ? left : right;
+		Node& up = myNodes[risen];
+		const int first = up.myLeft;
+		const int second = up.myRight;
+		const int taller = myNodes[first].myHeight > myNodes[second].myHeight ? first : second;
+		const int shorter = taller == first ? second : first;
+
+		up.myLeft = aNode;
+		up.myRight = taller;
+		up.myParent = node.myParent;
+		node.myParent = risen;
+		if (up.myParent == ourNull)
+		{
+			myRoot = risen;
+		}
+		else if (myNodes[up.myParent].myLeft == aNode)
+		{
+			myNodes[up.myParent].myLeft = risen;
+		}
+		else
+		{
+			myNodes[up.myParent].myRight = risen;
+		}
+
+		node.myLeft = kept;
+		node.myRight = shorter;
+		myNodes[shorter].myParent = aNode;
+		SetUnion(node, myNodes[kept], myNodes[shorter]);
+		node.myHeight = 1 + (myNodes[kept].myHeight > myNodes[shorter].myHeight ? myNodes[kept].myHeight : myNodes[shorter].myHeight);
+		SetUnion(up, node, myNodes[taller]);
+		up.myHeight = 1 + (node.myHeight > myNodes[taller].myHeight ? node.myHeight : myNodes[taller].myHeight);
+		return risen;
+	}
+
+	template<class VectorType>
+	inline void DynamicAABBTree<VectorType>::MarkMoved(const int aProxy)
+	{
+		if (myNodes[aProxy].myMovedIndex == ourNull)
+		{
+			myNodes[aProxy].myMovedIndex = myMovedProxies.Size();
+			myMovedProxies.Add(aProxy);
+		}
+	}
+
+	template<class VectorType>
+	template<class Callback>
+	inline void DynamicAABBTree<VectorType>::VisitOverlaps(const VectorType& aMin, const VectorType& aMax, Callback aCallback) const
+	{
+		if (myRoot == ourNull)
+		{
+			return;
+		}
+		int stack[ourStackSize];
+		int stackSize = 0;
+		stack[stackSize++] = myRoot;
+		while (stackSize > 0)
+		{
+			const Node& node = myNodes[stack[--stackSize]];
+			if (!Overlaps(node, aMin, aMax))
+			{
+				continue;
+			}
+			if (node.IsLeaf())
+			{
+				aCallback(static_cast<int>(&node - myNodes.GetData()));
+			}
+			else
+			{
+				assert(stackSize + 2 <= ourStackSize && "Tree is too deep!");
+				stack[stackSize++] = node.myRight;
+				stack[stackSize++] = node.myLeft;
+			}
+		}
+	}
+}
@@ -0,0 +1,381 @@
+#pragma once
+#include <assert.h>
+#include <cstdint>
+#include <string.h>
+#include <utility>
+#include "AlignedAllocation.hpp"
+#include "BitsetKernels.hpp"
+
+namespace CommonUtilities
+{
+	// Bitset sized at runtime, for masks over all entities or objects. The set operations and PopCount run
+	// on the SIMD kernels in BitsetKernels and need both bitsets to have the same size. Bits past Size()
+	// are always 0. The words are cache line aligned.
+	template<class Allocator = AlignedAllocator>
+	class DynamicBitset
+	{
+	public:
+		static const int FoundNone = -1;
+
+		DynamicBitset(const int aSize = 0, const Allocator& anAllocator = Allocator());
+		DynamicBitset(const DynamicBitset& aBitset);
+		DynamicBitset(DynamicBitset&& aBitset);
+		~DynamicBitset();
+
+		DynamicBitset& operator=(const DynamicBitset& aBitset);
+		DynamicBitset& operator=(DynamicBitset&& aBitset);
+
+		inline bool operator[](const int anIndex) const;
+		inline bool Test(const int anIndex) const;
+		inline void Set(const int anIndex);
+		inline void Set(const int anIndex, const bool aValue);
+		inline void Reset(const int anIndex);
+		inline void Flip(const int anIndex);
+
+		inline void SetAll();
+		inline void ResetAll();
+		inline void FlipAll();
+
+		inline DynamicBitset& operator&=(const DynamicBitset& aBitset);
+		inline DynamicBitset& operator|=(const DynamicBitset& aBitset);
+		inline DynamicBitset& operator^=(const DynamicBitset& aBitset);
+		// Clears the bits that are set in aBitset
+		inline DynamicBitset& AndNot(const DynamicBitset& aBitset);
+
+		inline bool operator==(const DynamicBitset& aBitset) const;
+		inline bool operator!=(const DynamicBitset& aBitset) const;
+
+		inline int PopCount() const;
+		inline bool Any() const;
+		inline bool None() const;
+		inline bool All() const;
+		// Index of the first set bit, or FoundNone
+		inline int FindFirst() const;
+		// Index of the first set bit after anIndex, or FoundNone
+		inline int FindNext(const int anIndex) const;
+		inline SetBitRange GetSetBits() const;
+
+		// New bits are 0
+		void Resize(const int aSize);
+		inline int Size() const;
+		inline int GetWordCount() const;
+		inline uint64_t* GetWords();
+		inline const uint64_t* GetWords() const;
+
+	private:
+		inline uint64_t GetLastWordMask() const;
+		inline int FindFrom(const int aWordIndex, const uint64_t aWord) const;
+
+		uint64_t* myWords;
+		int mySize;
+		int myWordCount;
+		Allocator myAllocator;
+	};
+
+	template<class Allocator>
+	const int DynamicBitset<Allocator>::FoundNone;
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>::DynamicBitset(const int aSize, const Allocator& anAllocator) : myWords(nullptr), mySize(0), myWordCount(0), myAllocator(anAllocator)
+	{
+		Resize(aSize);
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>::DynamicBitset(const DynamicBitset& aBitset) : DynamicBitset(0, aBitset.myAllocator)
+	{
+		(*this) = aBitset;
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>::DynamicBitset(DynamicBitset&& aBitset) : DynamicBitset(0, aBitset.myAllocator)
+	{
+		(*this) = std::move(aBitset);
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>::~DynamicBitset()
+	{
+		if (myWords != nullptr)
+		{
+			myAllocator.Free(myWords);
+		}
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>& DynamicBitset<Allocator>::operator=(const DynamicBitset& aBitset)
+	{
+		if (this != &aBitset)
+		{
+			Resize(aBitset.mySize);
+			if (myWordCount > 0)
+			{
+				memcpy(myWords, aBitset.myWords, sizeof(uint64_t) * myWordCount);
+			}
+		}
+		return (*this);
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>& DynamicBitset<Allocator>::operator=(DynamicBitset&& aBitset)
+	{
+		std::swap(myWords, aBitset.myWords);
+		std::swap(mySize, aBitset.mySize);
+		std::swap(myWordCount, aBitset.myWordCount);
+		std::swap(myAllocator, aBitset.myAllocator);
+		return (*this);
+	}
+
+	template<class Allocator>
+	inline bool DynamicBitset<Allocator>::operator[](const int anIndex) const
+	{
+		return Test(anIndex);
+	}
+
+	template<class Allocator>
+	inline bool DynamicBitset<Allocator>::Test(const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		return (myWords[anIndex / 64] >> (anIndex % 64) & 1) != 0;
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::Set(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		myWords[anIndex / 64] |= 1ull << (anIndex % 64);
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::Set(const int anIndex, const bool aValue)
+	{
+		if (aValue)
+		{
+			Set(anIndex);
+		}
+		else
+		{
+			Reset(anIndex);
+		}
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::Reset(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		myWords[anIndex / 64] &= ~(1ull << (anIndex % 64));
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::Flip(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		myWords[anIndex / 64] ^= 1ull << (anIndex % 64);
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::SetAll()
+	{
+		if (myWordCount > 0)
+		{
+			memset(myWords, 0xFF, sizeof(uint64_t) * myWordCount);
+			myWords[myWordCount - 1] &= GetLastWordMask();
+		}
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::ResetAll()
+	{
+		if (myWordCount > 0)
+		{
+			memset(myWords, 0, sizeof(uint64_t) * myWordCount);
+		}
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::FlipAll()
+	{
+		for (int index = 0; index < myWordCount; ++index)
+		{
+			myWords[index] = ~myWords[index];
+		}
+		if (myWordCount > 0)
+		{
+			myWords[myWordCount - 1] &= GetLastWordMask();
+		}
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>& DynamicBitset<Allocator>::operator&=(const DynamicBitset& aBitset)
+	{
+		assert(mySize == aBitset.mySize && "Bitsets differ in size!");
+		BitsetKernels::And(myWords, aBitset.myWords, myWordCount);
+		return (*this);
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>& DynamicBitset<Allocator>::operator|=(const DynamicBitset& aBitset)
+	{
+		assert(mySize == aBitset.mySize && "Bitsets differ in size!");
+		BitsetKernels::Or(myWords, aBitset.myWords, myWordCount);
+		return (*this);
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>& DynamicBitset<Allocator>::operator^=(const DynamicBitset& aBitset)
+	{
+		assert(mySize == aBitset.mySize && "Bitsets differ in size!");
+		BitsetKernels::Xor(myWords, aBitset.myWords, myWordCount);
+		return (*this);
+	}
+
+	template<class Allocator>
+	inline DynamicBitset<Allocator>& DynamicBitset<Allocator>::AndNot(const DynamicBitset& aBitset)
+	{
+		assert(mySize == aBitset.mySize && "Bitsets differ in size!");
+		BitsetKernels::AndNot(myWords, aBitset.myWords, myWordCount);
+		return (*this);
+	}
+
+	template<class Allocator>
+	inline bool DynamicBitset<Allocator>::operator==(const DynamicBitset& aBitset) const
+	{
+		return mySize == aBitset.mySize && (myWordCount == 0 || memcmp(myWords, aBitset.myWords, sizeof(uint64_t) * myWordCount) == 0);
+	}
+
+	template<class Allocator>
+	inline bool DynamicBitset<Allocator>::operator!=(const DynamicBitset& aBitset) const
+	{
+		return !((*this) == aBitset);
+	}
+
+	template<class Allocator>
+	inline int DynamicBitset<Allocator>::PopCount() const
+	{
+		return BitsetKernels::PopCount(myWords, myWordCount);
+	}
+
+	template<class Allocator>
+	inline bool DynamicBitset<Allocator>::Any() const
+	{
+		return FindFirst() != FoundNone;
+	}
+
+	template<class Allocator>
+	inline bool DynamicBitset<Allocator>::None() const
+	{
+		return !Any();
+	}
+
+	template<class Allocator>
+	inline bool DynamicBitset<Allocator>::All() const
+	{
+		return PopCount() == mySize;
+	}
+
+	template<class Allocator>
+	inline int DynamicBitset<Allocator>::FindFirst() const
+	{
+		return myWordCount > 0 ? FindFrom(0, myWords[0]) : FoundNone;
+	}
+
+	template<class Allocator>
+	inline int DynamicBitset<Allocator>::FindNext(const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		const int next = anIndex + 1;
+		if (next == mySize)
+		{
+			return FoundNone;
+		}
+		return FindFrom(next / 64, myWords[next / 64] & (~0ull << (next % 64)));
+	}
+
+	template<class Allocator>
+	inline SetBitRange DynamicBitset<Allocator>::GetSetBits() const
+	{
+		return SetBitRange(myWords, myWordCount);
+	}
+
+	template<class Allocator>
+	inline void DynamicBitset<Allocator>::Resize(const int aSize)
+	{
+		assert(aSize >= 0 && "Size can't be negative!");
+		const int wordCount = (aSize + 63) / 64;
+		if (wordCount != myWordCount)
+		{
+			uint64_t* words = nullptr;
+			if (wordCount > 0)
+			{
+				words = static_cast<uint64_t*>(myAllocator.Allocate(sizeof(uint64_t) * wordCount, CacheLineSize));
+				const int keptCount = wordCount < myWordCount ? wordCount : myWordCount;
+				if (keptCount > 0)
+				{
+					memcpy(words, myWords, sizeof(uint64_t) * keptCount);
+				}
+				if (wordCount > keptCount)
+				{
+					memset(words + keptCount, 0, sizeof(uint64_t) * (wordCount - keptCount));
+				}
+			}
+			if (myWords != nullptr)
+			{
+				myAllocator.Free(myWords);
+			}
+			myWords = words;
+			myWordCount = wordCount;
+		}
+		mySize = aSize;
+		if (myWordCount > 0)
+		{
+			// Bits cut off by a smaller size must not come back when it grows again
+			myWords[myWordCount - 1] &= GetLastWordMask();
+		}
+	}
+
+	template<class Allocator>
+	inline int DynamicBitset<Allocator>::Size() const
+	{
+		return mySize;
+	}
+
+	template<class Allocator>
+	inline int DynamicBitset<Allocator>::GetWordCount() const
+	{
+		return myWordCount;
+	}
+
+	template<class Allocator>
+	inline uint64_t* DynamicBitset<Allocator>::GetWords()
+	{
+		return myWords;
+	}
+
+	template<class Allocator>
+	inline const uint64_t* DynamicBitset<Allocator>::GetWords() const
+	{
+		return myWords;
+	}
+
+	template<class Allocator>
+	inline uint64_t DynamicBitset<Allocator>::GetLastWordMask() const
+	{
+		return mySize % 64 == 0 ? ~0ull : (1ull << (mySize % 64)) - 1;
+	}
+
+	template<class Allocator>
+	inline int DynamicBitset<Allocator>::FindFrom(const int aWordIndex, const uint64_t aWord) const
+	{
+		uint64_t word = aWord;
+		for (int index = aWordIndex; index < myWordCount; )
+		{
+			if (word != 0)
+			{
+				return index * 64 + CountTrailingZeros(word);
+			}
+			++index;
+			word = index < myWordCount ? myWords[index] : 0;
+		}
+		return FoundNone;
+	}
+}
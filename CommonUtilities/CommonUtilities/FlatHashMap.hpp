@@ -0,0 +1,202 @@
+#pragma once
+#include <functional>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+#include "FlatHashTable.hpp"
+
+namespace CommonUtilities
+{
+	// Hash map that stores its entries in one flat array instead of one node per entry, see FlatHashTable.
+	// Pointers to values stay valid until the next insert, Reserve or Rehash. Find, Contains and Erase
+	// also take other key types (a const char* for std::string keys) when Hash and KeyEqual are transparent.
+	template<class Key, class Value, class Hash = FlatHasher<Key>, class KeyEqual = std::equal_to<>, class Allocator = AlignedAllocator>
+	class FlatHashMap
+	{
+	public:
+		typedef std::pair<Key, Value> Entry;
+		typedef FlatHashTable<Key, Entry, FlatHash::KeyOfPair, Hash, KeyEqual, Allocator> Table;
+
+		FlatHashMap(const Hash& aHash = Hash(), const KeyEqual& anEqual = KeyEqual(), const Allocator& anAllocator = Allocator());
+		FlatHashMap(const std::initializer_list<Entry>& aInitList);
+
+		// Returns false and leaves the old value if aKey is already in the map
+		inline bool Insert(const Key& aKey, const Value& aValue);
+		inline bool Insert(const Key& aKey, Value&& aValue);
+		// Inserts or overwrites
+		inline void Set(const Key& aKey, const Value& aValue);
+		// Constructs the value from someArguments if aKey is new, returns the value and whether it was inserted
+		template<class... Arguments>
+		inline std::pair<Value*, bool> Emplace(const Key& aKey, Arguments&&... someArguments);
+		// Inserts a default constructed value if aKey is new
+		inline Value& operator[](const Key& aKey);
+
+		// Returns nullptr if aKey isn't in the map
+		template<class LookupKey, class = FlatHash::EnableLookup<Hash, KeyEqual, LookupKey, Key>>
+		inline Value* Find(const LookupKey& aKey);
+		template<class LookupKey, class = FlatHash::EnableLookup<Hash, KeyEqual, LookupKey, Key>>
+		inline const Value* Find(const LookupKey& aKey) const;
+		template<class LookupKey, class = FlatHash::EnableLookup<Hash, KeyEqual, LookupKey, Key>>
+		inline bool Contains(const LookupKey& aKey) const;
+		template<class LookupKey, class = FlatHash::EnableLookup<Hash, KeyEqual, LookupKey, Key>>
+		inline bool Erase(const LookupKey& aKey);
+		inline void Clear();
+
+		inline void Reserve(const int aCount);
+		inline void Rehash(const int aCapacity);
+
+		inline int Count() const;
+		inline int Capacity() const;
+		inline bool IsEmpty() const;
+
+		// Entries in slot order, the key must not be changed
+		inline typename Table::template Iterator<Entry> begin();
+		inline typename Table::template Iterator<Entry> end();
+		inline typename Table::template Iterator<const Entry> begin() const;
+		inline typename Table::template Iterator<const Entry> end() const;
+
+	private:
+		Table myTable;
+	};
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::FlatHashMap(const Hash& aHash, const KeyEqual& anEqual, const Allocator& anAllocator) : myTable(aHash, anEqual, anAllocator)
+	{
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::FlatHashMap(const std::initializer_list<Entry>& aInitList)
+	{
+		myTable.Reserve(static_cast<int>(aInitList.size()));
+		for (const Entry& entry : aInitList)
+		{
+			Insert(entry.first, entry.second);
+		}
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline bool FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Insert(const Key& aKey, const Value& aValue)
+	{
+		return myTable.Emplace(aKey, aKey, aValue).second;
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline bool FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Insert(const Key& aKey, Value&& aValue)
+	{
+		return myTable.Emplace(aKey, aKey, std::move(aValue)).second;
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Set(const Key& aKey, const Value& aValue)
+	{
+		std::pair<Entry*, bool> result = myTable.Emplace(aKey, aKey, aValue);
+		if (!result.second)
+		{
+			result.first->second = aValue;
+		}
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	template<class... Arguments>
+	inline std::pair<Value*, bool> FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Emplace(const Key& aKey, Arguments&&... someArguments)
+	{
+		std::pair<Entry*, bool> result = myTable.Emplace(aKey, std::piecewise_construct, std::forward_as_tuple(aKey), std::forward_as_tuple(std::forward<Arguments>(someArguments)...));
+		return std::make_pair(&result.first->second, result.second);
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline Value& FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::operator[](const Key& aKey)
+	{
+		return *Emplace(aKey).first;
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey, class>
+	inline Value* FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Find(const LookupKey& aKey)
+	{
+		Entry* entry = myTable.Find(aKey);
+		return entry != nullptr ? &entry->second : nullptr;
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey, class>
+	inline const Value* FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Find(const LookupKey& aKey) const
+	{
+		const Entry* entry = myTable.Find(aKey);
+		return entry != nullptr ? &entry->second : nullptr;
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey, class>
+	inline bool FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Contains(const LookupKey& aKey) const
+	{
+		return myTable.Find(aKey) != nullptr;
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey, class>
+	inline bool FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Erase(const LookupKey& aKey)
+	{
+		return myTable.Erase(aKey);
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Clear()
+	{
+		myTable.Clear();
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Reserve(const int aCount)
+	{
+		myTable.Reserve(aCount);
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Rehash(const int aCapacity)
+	{
+		myTable.Rehash(aCapacity);
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Count() const
+	{
+		return myTable.Count();
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Capacity() const
+	{
+		return myTable.Capacity();
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline bool FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::IsEmpty() const
+	{
+		return myTable.IsEmpty();
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Table::template Iterator<std::pair<Key, Value>> FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::begin()
+	{
+		return myTable.begin();
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Table::template Iterator<std::pair<Key, Value>> FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::end()
+	{
+		return myTable.end();
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Table::template Iterator<const std::pair<Key, Value>> FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::begin() const
+	{
+		return myTable.begin();
+	}
+
+	template<class Key, class Value, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::Table::template Iterator<const std::pair<Key, Value>> FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::end() const
+	{
+		return myTable.end();
+	}
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <functional>
+#include <initializer_list>
+#include "FlatHashTable.hpp"
+
+namespace CommonUtilities
+{
+	// Hash set on the same flat table as FlatHashMap
+	template<class Key, class Hash = FlatHasher<Key>, class KeyEqual = std::equal_to<>, class Allocator = AlignedAllocator>
+	class FlatHashSet
+	{
+	public:
+		typedef FlatHashTable<Key, Key, FlatHash::KeyOfKey, Hash, KeyEqual, Allocator> Table;
+
+		FlatHashSet(const Hash& aHash = Hash(), const KeyEqual& anEqual = KeyEqual(), const Allocator& anAllocator = Allocator());
+		FlatHashSet(const std::initializer_list<Key>& aInitList);
+
+		// Returns false if aKey is already in the set
+		inline bool Insert(const Key& aKey);
+
+		template<class LookupKey, class = FlatHash::EnableLookup<Hash, KeyEqual, LookupKey, Key>>
+		inline bool Contains(const LookupKey& aKey) const;
+		template<class LookupKey, class = FlatHash::EnableLookup<Hash, KeyEqual, LookupKey, Key>>
+		inline bool Erase(const LookupKey& aKey);
+		inline void Clear();
+
+		inline void Reserve(const int aCount);
+		inline void Rehash(const int aCapacity);
+
+		inline int Count() const;
+		inline int Capacity() const;
+		inline bool IsEmpty() const;
+
+		inline typename Table::template Iterator<const Key> begin() const;
+		inline typename Table::template Iterator<const Key> end() const;
+
+	private:
+		Table myTable;
+	};
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashSet<Key, Hash, KeyEqual, Allocator>::FlatHashSet(const Hash& aHash, const KeyEqual& anEqual, const Allocator& anAllocator) : myTable(aHash, anEqual, anAllocator)
+	{
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashSet<Key, Hash, KeyEqual, Allocator>::FlatHashSet(const std::initializer_list<Key>& aInitList)
+	{
+		myTable.Reserve(static_cast<int>(aInitList.size()));
+		for (const Key& key : aInitList)
+		{
+			Insert(key);
+		}
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline bool FlatHashSet<Key, Hash, KeyEqual, Allocator>::Insert(const Key& aKey)
+	{
+		return myTable.Emplace(aKey, aKey).second;
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey, class>
+	inline bool FlatHashSet<Key, Hash, KeyEqual, Allocator>::Contains(const LookupKey& aKey) const
+	{
+		return myTable.Find(aKey) != nullptr;
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey, class>
+	inline bool FlatHashSet<Key, Hash, KeyEqual, Allocator>::Erase(const LookupKey& aKey)
+	{
+		return myTable.Erase(aKey);
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashSet<Key, Hash, KeyEqual, Allocator>::Clear()
+	{
+		myTable.Clear();
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashSet<Key, Hash, KeyEqual, Allocator>::Reserve(const int aCount)
+	{
+		myTable.Reserve(aCount);
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashSet<Key, Hash, KeyEqual, Allocator>::Rehash(const int aCapacity)
+	{
+		myTable.Rehash(aCapacity);
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashSet<Key, Hash, KeyEqual, Allocator>::Count() const
+	{
+		return myTable.Count();
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashSet<Key, Hash, KeyEqual, Allocator>::Capacity() const
+	{
+		return myTable.Capacity();
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline bool FlatHashSet<Key, Hash, KeyEqual, Allocator>::IsEmpty() const
+	{
+		return myTable.IsEmpty();
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashSet<Key, Hash, KeyEqual, Allocator>::Table::template Iterator<const Key> FlatHashSet<Key, Hash, KeyEqual, Allocator>::begin() const
+	{
+		return myTable.begin();
+	}
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashSet<Key, Hash, KeyEqual, Allocator>::Table::template Iterator<const Key> FlatHashSet<Key, Hash, KeyEqual, Allocator>::end() const
+	{
+		return myTable.end();
+	}
+}
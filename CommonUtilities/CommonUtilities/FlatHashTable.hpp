@@ -0,0 +1,610 @@
+#pragma once
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <string>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "AlignedAllocation.hpp"
+#include "Bits.hpp"
+#include "Simd.hpp"
+
+namespace CommonUtilities
+{
+	namespace FlatHash
+	{
+		// Control byte of each slot: empty, deleted, or the low 7 bits of the hash of a full slot
+		static const signed char ourEmpty = -128;
+		static const signed char ourDeleted = -2;
+
+		// Spreads the bits of a hash so that both the low bits (group) and the high bits (control byte) vary
+		inline size_t Mix(const size_t aHash)
+		{
+			const uint64_t mixed = static_cast<uint64_t>(aHash) * 0x9E3779B97F4A7C15ull;
+			return static_cast<size_t>(mixed ^ (mixed >> 32));
+		}
+
+		inline size_t HashBytes(const char* someBytes, const size_t aLength)
+		{
+			uint64_t hash = 0xCBF29CE484222325ull;
+			for (size_t index = 0; index < aLength; ++index)
+			{
+				hash = (hash ^ static_cast<unsigned char>(someBytes[index])) * 0x100000001B3ull;
+			}
+			return Mix(static_cast<size_t>(hash));
+		}
+
+		// The control bytes of 16 slots, compared all at once with SSE2
+		class Group
+		{
+		public:
+			static const int ourWidth = 16;
+
+			explicit Group(const signed char* aControl);
+
+			// Bit i is set if slot i of the group holds aHash
+			inline unsigned int Match(const signed char aHash) const;
+			inline unsigned int MatchEmpty() const;
+			inline unsigned int MatchEmptyOrDeleted() const;
+
+		private:
+#ifdef CU_SIMD_SSE
+			__m128i myControl;
+#else
+			const signed char* myControl;
+#endif
+		};
+
+#ifdef CU_SIMD_SSE
+		inline Group::Group(const signed char* aControl) : myControl(_mm_load_si128(reinterpret_cast<const __m128i*>(aControl)))
+		{
+		}
+
+		inline unsigned int Group::Match(const signed char aHash) const
+		{
+			return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(myControl, _mm_set1_epi8(aHash))));
+		}
+
+		inline unsigned int Group::MatchEmpty() const
+		{
+			return Match(ourEmpty);
+		}
+
+		inline unsigned int Group::MatchEmptyOrDeleted() const
+		{
+			// Both have the sign bit set, full slots don't
+			return static_cast<unsigned int>(_mm_movemask_epi8(myControl));
+		}
+#else
+		inline Group::Group(const signed char* aControl) : myControl(aControl)
+		{
+		}
+
+		inline unsigned int Group::Match(const signed char aHash) const
+		{
+			unsigned int mask = 0;
+			for (int index = 0; index < ourWidth; ++index)
+			{
+				mask |= static_cast<unsigned int>(myControl[index] == aHash) << index;
+			}
+			return mask;
+		}
+
+		inline unsigned int Group::MatchEmpty() const
+		{
+			return Match(ourEmpty);
+		}
+
+		inline unsigned int Group::MatchEmptyOrDeleted() const
+		{
+			unsigned int mask = 0;
+			for (int index = 0; index < ourWidth; ++index)
+			{
+				mask |= static_cast<unsigned int>(myControl[index] < 0) << index;
+			}
+			return mask;
+		}
+#endif
+
+		// Used by FlatHashMap and FlatHashSet to pick the key out of an entry
+		struct KeyOfPair
+		{
+			template<class Pair>
+			const typename Pair::first_type& operator()(const Pair& aPair) const
+			{
+				return aPair.first;
+			}
+		};
+
+		struct KeyOfKey
+		{
+			template<class Key>
+			const Key& operator()(const Key& aKey) const
+			{
+				return aKey;
+			}
+		};
+
+		template<class... Types>
+		struct MakeVoid
+		{
+			typedef void Type;
+		};
+
+		template<class Hash, class KeyEqual, class = void>
+		struct IsTransparent : std::false_type
+		{
+		};
+
+		template<class Hash, class KeyEqual>
+		struct IsTransparent<Hash, KeyEqual, typename MakeVoid<typename Hash::is_transparent, typename KeyEqual::is_transparent>::Type> : std::true_type
+		{
+		};
+
+		// Lookups take other key types than Key only when both Hash and KeyEqual are transparent
+		template<class Hash, class KeyEqual, class LookupKey, class Key>
+		using EnableLookup = typename std::enable_if<IsTransparent<Hash, KeyEqual>::value || std::is_convertible<const LookupKey&, const Key&>::value>::type;
+	}
+
+	// Default hash of the flat containers; std::hash with its bits mixed, since std::hash of an
+	// integer is often the integer itself
+	template<class Key>
+	struct FlatHasher
+	{
+		size_t operator()(const Key& aKey) const
+		{
+			return FlatHash::Mix(std::hash<Key>()(aKey));
+		}
+	};
+
+	// Strings hash their characters, so a std::string key can be looked up with a const char*
+	template<>
+	struct FlatHasher<std::string>
+	{
+		typedef void is_transparent;
+
+		size_t operator()(const std::string& aKey) const
+		{
+			return FlatHash::HashBytes(aKey.data(), aKey.size());
+		}
+
+		size_t operator()(const char* aKey) const
+		{
+			return FlatHash::HashBytes(aKey, strlen(aKey));
+		}
+	};
+
+	// Open addressing table with Swiss table style control bytes, shared by FlatHashMap and FlatHashSet.
+	// The slots come in groups of 16 whose control bytes are probed with one SSE2 compare. A lookup
+	// visits groups in triangular order and stops at the first group with an empty slot.
+	// Entries live in one block from Allocator, so every insert or rehash may move them.
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	class FlatHashTable
+	{
+	public:
+		template<class EntryType>
+		class Iterator
+		{
+		public:
+			Iterator(const signed char* aControl, EntryType* anEntry, EntryType* anEnd) : myControl(aControl), myEntry(anEntry), myEnd(anEnd)
+			{
+				SkipFree();
+			}
+
+			EntryType& operator*() const { return *myEntry; }
+			EntryType* operator->() const { return myEntry; }
+			Iterator& operator++() { ++myControl; ++myEntry; SkipFree(); return (*this); }
+			bool operator==(const Iterator& anIterator) const { return myEntry == anIterator.myEntry; }
+			bool operator!=(const Iterator& anIterator) const { return myEntry != anIterator.myEntry; }
+
+		private:
+			void SkipFree()
+			{
+				while (myEntry != myEnd && *myControl < 0)
+				{
+					++myControl;
+					++myEntry;
+				}
+			}
+
+			const signed char* myControl;
+			EntryType* myEntry;
+			EntryType* myEnd;
+		};
+
+		FlatHashTable(const Hash& aHash = Hash(), const KeyEqual& anEqual = KeyEqual(), const Allocator& anAllocator = Allocator());
+		FlatHashTable(const FlatHashTable& aTable);
+		FlatHashTable(FlatHashTable&& aTable);
+		~FlatHashTable();
+
+		FlatHashTable& operator=(const FlatHashTable& aTable);
+		FlatHashTable& operator=(FlatHashTable&& aTable);
+
+		// Constructs an entry from someArguments unless aKey is already there. Returns the entry and
+		// whether it was inserted.
+		template<class... Arguments>
+		std::pair<Entry*, bool> Emplace(const Key& aKey, Arguments&&... someArguments);
+
+		template<class LookupKey>
+		Entry* Find(const LookupKey& aKey);
+		template<class LookupKey>
+		const Entry* Find(const LookupKey& aKey) const;
+		template<class LookupKey>
+		bool Erase(const LookupKey& aKey);
+		void Clear();
+
+		// Makes room for aCount entries without rehashing
+		void Reserve(const int aCount);
+		// Rebuilds the table with at least aCapacity slots (rounded up to a power of two and to fit
+		// Count()). Also removes the tombstones left by Erase.
+		void Rehash(const int aCapacity);
+
+		inline int Count() const;
+		inline int Capacity() const;
+		inline bool IsEmpty() const;
+
+		Iterator<Entry> begin();
+		Iterator<Entry> end();
+		Iterator<const Entry> begin() const;
+		Iterator<const Entry> end() const;
+
+	private:
+		template<class LookupKey>
+		int FindIndex(const LookupKey& aKey, const size_t aHash) const;
+		int FindFreeIndex(const size_t aHash) const;
+		void SetControl(const int anIndex, const signed char aValue);
+		void Allocate(const int aCapacity);
+		void Swap(FlatHashTable& aTable);
+
+		static int CapacityFor(const int aCount);
+		static int GrowthFor(const int aCapacity);
+
+		signed char* myControl;
+		Entry* myEntries;
+		int myCapacity;
+		int myCount;
+		// Inserts into empty slots left before the table is over 7/8 full
+		int myGrowthLeft;
+		Hash myHash;
+		KeyEqual myEqual;
+		Allocator myAllocator;
+	};
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::FlatHashTable(const Hash& aHash, const KeyEqual& anEqual, const Allocator& anAllocator)
+		: myControl(nullptr), myEntries(nullptr), myCapacity(0), myCount(0), myGrowthLeft(0), myHash(aHash), myEqual(anEqual), myAllocator(anAllocator)
+	{
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::FlatHashTable(const FlatHashTable& aTable)
+		: FlatHashTable(aTable.myHash, aTable.myEqual, aTable.myAllocator)
+	{
+		(*this) = aTable;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::FlatHashTable(FlatHashTable&& aTable)
+		: FlatHashTable(aTable.myHash, aTable.myEqual, aTable.myAllocator)
+	{
+		Swap(aTable);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::~FlatHashTable()
+	{
+		Clear();
+		if (myControl != nullptr)
+		{
+			myAllocator.Free(myControl);
+		}
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>& FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::operator=(const FlatHashTable& aTable)
+	{
+		if (this != &aTable)
+		{
+			Clear();
+			Reserve(aTable.myCount);
+			for (const Entry& entry : aTable)
+			{
+				const size_t hash = myHash(KeyOf()(entry));
+				const int index = FindFreeIndex(hash);
+				new (myEntries + index) Entry(entry);
+				SetControl(index, static_cast<signed char>(hash & 0x7F));
+				--myGrowthLeft;
+				++myCount;
+			}
+		}
+		return (*this);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>& FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::operator=(FlatHashTable&& aTable)
+	{
+		Swap(aTable);
+		return (*this);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	template<class... Arguments>
+	inline std::pair<Entry*, bool> FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Emplace(const Key& aKey, Arguments&&... someArguments)
+	{
+		const size_t hash = myHash(aKey);
+		if (myCapacity > 0)
+		{
+			const int found = FindIndex(aKey, hash);
+			if (found >= 0)
+			{
+				return std::make_pair(myEntries + found, false);
+			}
+		}
+
+		int index = myCapacity > 0 ? FindFreeIndex(hash) : -1;
+		if (index < 0 || (myControl[index] == FlatHash::ourEmpty && myGrowthLeft == 0))
+		{
+			// The arguments may refer to one of our entries, so they are used before the entries move
+			Entry entry(std::forward<Arguments>(someArguments)...);
+			// Grows when most slots are full, otherwise rehashes in place to clear the tombstones
+			Rehash(myCount + 1 > GrowthFor(myCapacity) / 2 ? myCapacity * 2 : myCapacity);
+			index = FindFreeIndex(hash);
+			new (myEntries + index) Entry(std::move(entry));
+		}
+		else
+		{
+			new (myEntries + index) Entry(std::forward<Arguments>(someArguments)...);
+		}
+		if (myControl[index] == FlatHash::ourEmpty)
+		{
+			--myGrowthLeft;
+		}
+		SetControl(index, static_cast<signed char>(hash & 0x7F));
+		++myCount;
+		return std::make_pair(myEntries + index, true);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey>
+	inline Entry* FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Find(const LookupKey& aKey)
+	{
+		if (myCount == 0)
+		{
+			return nullptr;
+		}
+		const int index = FindIndex(aKey, myHash(aKey));
+		return index >= 0 ? myEntries + index : nullptr;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey>
+	inline const Entry* FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Find(const LookupKey& aKey) const
+	{
+		return const_cast<FlatHashTable*>(this)->Find(aKey);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey>
+	inline bool FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Erase(const LookupKey& aKey)
+	{
+		Entry* entry = Find(aKey);
+		if (entry == nullptr)
+		{
+			return false;
+		}
+
+		const int index = static_cast<int>(entry - myEntries);
+		entry->~Entry();
+		--myCount;
+		// A lookup that reached this group stops here if it has an empty slot, so the slot can be empty again
+		const int groupStart = index & ~(FlatHash::Group::ourWidth - 1);
+		if (FlatHash::Group(myControl + groupStart).MatchEmpty() != 0)
+		{
+			SetControl(index, FlatHash::ourEmpty);
+			++myGrowthLeft;
+		}
+		else
+		{
+			SetControl(index, FlatHash::ourDeleted);
+		}
+		return true;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Clear()
+	{
+		for (int index = 0; index < myCapacity; ++index)
+		{
+			if (myControl[index] >= 0)
+			{
+				myEntries[index].~Entry();
+			}
+			myControl[index] = FlatHash::ourEmpty;
+		}
+		myCount = 0;
+		myGrowthLeft = GrowthFor(myCapacity);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Reserve(const int aCount)
+	{
+		if (aCount > myCount + myGrowthLeft)
+		{
+			Rehash(CapacityFor(aCount));
+		}
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Rehash(const int aCapacity)
+	{
+		const int needed = CapacityFor(myCount);
+		int capacity = FlatHash::Group::ourWidth;
+		while (capacity < aCapacity || capacity < needed)
+		{
+			capacity *= 2;
+		}
+
+		signed char* oldControl = myControl;
+		Entry* oldEntries = myEntries;
+		const int oldCapacity = myCapacity;
+		Allocate(capacity);
+
+		for (int index = 0; index < oldCapacity; ++index)
+		{
+			if (oldControl[index] >= 0)
+			{
+				const size_t hash = myHash(KeyOf()(oldEntries[index]));
+				const int newIndex = FindFreeIndex(hash);
+				new (myEntries + newIndex) Entry(std::move(oldEntries[index]));
+				oldEntries[index].~Entry();
+				SetControl(newIndex, static_cast<signed char>(hash & 0x7F));
+				--myGrowthLeft;
+			}
+		}
+		if (oldControl != nullptr)
+		{
+			myAllocator.Free(oldControl);
+		}
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Count() const
+	{
+		return myCount;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Capacity() const
+	{
+		return myCapacity;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline bool FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::IsEmpty() const
+	{
+		return myCount == 0;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::template Iterator<Entry> FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::begin()
+	{
+		return Iterator<Entry>(myControl, myEntries, myEntries + myCapacity);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::template Iterator<Entry> FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::end()
+	{
+		return Iterator<Entry>(myControl + myCapacity, myEntries + myCapacity, myEntries + myCapacity);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::template Iterator<const Entry> FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::begin() const
+	{
+		return Iterator<const Entry>(myControl, myEntries, myEntries + myCapacity);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline typename FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::template Iterator<const Entry> FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::end() const
+	{
+		return Iterator<const Entry>(myControl + myCapacity, myEntries + myCapacity, myEntries + myCapacity);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	template<class LookupKey>
+	inline int FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::FindIndex(const LookupKey& aKey, const size_t aHash) const
+	{
+		const int groupMask = myCapacity / FlatHash::Group::ourWidth - 1;
+		const signed char control = static_cast<signed char>(aHash & 0x7F);
+		int group = static_cast<int>((aHash >> 7) & static_cast<size_t>(groupMask));
+		for (int step = 1; step <= groupMask + 1; ++step)
+		{
+			const int groupStart = group * FlatHash::Group::ourWidth;
+			const FlatHash::Group controls(myControl + groupStart);
+			for (unsigned int matches = controls.Match(control); matches != 0; matches &= matches - 1)
+			{
+				const int index = groupStart + CountTrailingZeros(matches);
+				if (myEqual(KeyOf()(myEntries[index]), aKey))
+				{
+					return index;
+				}
+			}
+			if (controls.MatchEmpty() != 0)
+			{
+				return -1;
+			}
+			group = (group + step) & groupMask;
+		}
+		return -1;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::FindFreeIndex(const size_t aHash) const
+	{
+		const int groupMask = myCapacity / FlatHash::Group::ourWidth - 1;
+		int group = static_cast<int>((aHash >> 7) & static_cast<size_t>(groupMask));
+		for (int step = 1; step <= groupMask + 1; ++step)
+		{
+			const int groupStart = group * FlatHash::Group::ourWidth;
+			const unsigned int free = FlatHash::Group(myControl + groupStart).MatchEmptyOrDeleted();
+			if (free != 0)
+			{
+				return groupStart + CountTrailingZeros(free);
+			}
+			group = (group + step) & groupMask;
+		}
+		return -1;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::SetControl(const int anIndex, const signed char aValue)
+	{
+		myControl[anIndex] = aValue;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Allocate(const int aCapacity)
+	{
+		// Control bytes first, then the entries, in one block
+		const size_t alignment = alignof(Entry) > 16 ? alignof(Entry) : 16;
+		const size_t entryOffset = (aCapacity + alignment - 1) / alignment * alignment;
+		char* memory = static_cast<char*>(myAllocator.Allocate(entryOffset + sizeof(Entry) * aCapacity, alignment));
+		myControl = reinterpret_cast<signed char*>(memory);
+		myEntries = reinterpret_cast<Entry*>(memory + entryOffset);
+		myCapacity = aCapacity;
+		myGrowthLeft = GrowthFor(aCapacity);
+		memset(myControl, FlatHash::ourEmpty, aCapacity);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline void FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::Swap(FlatHashTable& aTable)
+	{
+		std::swap(myControl, aTable.myControl);
+		std::swap(myEntries, aTable.myEntries);
+		std::swap(myCapacity, aTable.myCapacity);
+		std::swap(myCount, aTable.myCount);
+		std::swap(myGrowthLeft, aTable.myGrowthLeft);
+		std::swap(myHash, aTable.myHash);
+		std::swap(myEqual, aTable.myEqual);
+		std::swap(myAllocator, aTable.myAllocator);
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::CapacityFor(const int aCount)
+	{
+		int capacity = FlatHash::Group::ourWidth;
+		while (GrowthFor(capacity) < aCount)
+		{
+			capacity *= 2;
+		}
+		return capacity;
+	}
+
+	template<class Key, class Entry, class KeyOf, class Hash, class KeyEqual, class Allocator>
+	inline int FlatHashTable<Key, Entry, KeyOf, Hash, KeyEqual, Allocator>::GrowthFor(const int aCapacity)
+	{
+		return aCapacity - aCapacity / 8;
+	}
+}
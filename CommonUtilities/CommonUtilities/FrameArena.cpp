@@ -0,0 +1,115 @@
+#include "FrameArena.hpp"
+#include "AlignedAllocation.hpp"
+
+namespace CommonUtilities
+{
+	FrameArena::FrameArena(const size_t aCapacity, const int aBufferCount) : myUsed(0), myFrameIndex(0)
+	{
+		assert(aBufferCount >= 1 && "FrameArena needs at least one buffer!");
+		// Whole cache lines per buffer so every buffer starts aligned
+		myCapacity = (aCapacity + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+		myBufferCount = aBufferCount;
+		myBufferIndex = 0;
+		myMemory = static_cast<char*>(AlignedAllocate(myCapacity * myBufferCount, CacheLineSize));
+		myBuffer = myMemory;
+		myHighWaterMark = 0;
+		myPeakHighWaterMark = 0;
+	}
+
+	FrameArena::~FrameArena()
+	{
+		AlignedFree(myMemory);
+	}
+
+	void* FrameArena::Allocate(const size_t aSize, const size_t anAlignment)
+	{
+		assert(anAlignment > 0 && (anAlignment & (anAlignment - 1)) == 0 && "Alignment must be a power of two!");
+		assert(anAlignment <= CacheLineSize && "FrameArena aligns to at most a cache line!");
+		size_t used = myUsed.load(std::memory_order_relaxed);
+		size_t start;
+		do
+		{
+			start = (used + anAlignment - 1) & ~(anAlignment - 1);
+			// Compared against the room left so a huge aSize can't wrap around
+			if (start < used || start > myCapacity || aSize > myCapacity - start)
+			{
+				throw std::bad_alloc();
+			}
+		} while (!myUsed.compare_exchange_weak(used, start + aSize, std::memory_order_relaxed));
+		return myBuffer + start;
+	}
+
+	void FrameArena::BeginFrame()
+	{
+		myHighWaterMark = myUsed.load(std::memory_order_relaxed);
+		myPeakHighWaterMark = myHighWaterMark > myPeakHighWaterMark ? myHighWaterMark : myPeakHighWaterMark;
+
+		myBufferIndex = (myBufferIndex + 1) % myBufferCount;
+		myBuffer = myMemory + myCapacity * myBufferIndex;
+		myUsed.store(0, std::memory_order_relaxed);
+		myFrameIndex.fetch_add(1, std::memory_order_release);
+	}
+
+	size_t FrameArena::GetUsed() const
+	{
+		return myUsed.load(std::memory_order_relaxed);
+	}
+
+	size_t FrameArena::GetCapacity() const
+	{
+		return myCapacity;
+	}
+
+	size_t FrameArena::GetHighWaterMark() const
+	{
+		return myHighWaterMark;
+	}
+
+	size_t FrameArena::GetPeakHighWaterMark() const
+	{
+		return myPeakHighWaterMark;
+	}
+
+	unsigned int FrameArena::GetFrameIndex() const
+	{
+		return myFrameIndex.load(std::memory_order_acquire);
+	}
+
+	FrameArena::SubArena::SubArena(FrameArena& anArena, const size_t aBlockSize) : myArena(anArena)
+	{
+		myCursor = nullptr;
+		myEnd = nullptr;
+		myBlockSize = aBlockSize;
+		myFrame = anArena.GetFrameIndex();
+	}
+
+	void* FrameArena::SubArena::Allocate(const size_t aSize, const size_t anAlignment)
+	{
+		assert(anAlignment > 0 && (anAlignment & (anAlignment - 1)) == 0 && "Alignment must be a power of two!");
+		const unsigned int frame = myArena.GetFrameIndex();
+		if (frame != myFrame)
+		{
+			// The block belonged to an earlier frame
+			myCursor = nullptr;
+			myEnd = nullptr;
+			myFrame = frame;
+		}
+
+		if (aSize > static_cast<size_t>(-1) - anAlignment)
+		{
+			throw std::bad_alloc();
+		}
+		const size_t misalignment = reinterpret_cast<size_t>(myCursor) & (anAlignment - 1);
+		char* start = myCursor + (misalignment != 0 ? anAlignment - misalignment : 0);
+		if (myCursor == nullptr || start > myEnd || aSize > static_cast<size_t>(myEnd - start))
+		{
+			const size_t blockSize = aSize + anAlignment > myBlockSize ? aSize + anAlignment : myBlockSize;
+			myCursor = static_cast<char*>(myArena.Allocate(blockSize, CacheLineSize));
+			myEnd = myCursor + blockSize;
+			const size_t blockMisalignment = reinterpret_cast<size_t>(myCursor) & (anAlignment - 1);
+			start = myCursor + (blockMisalignment != 0 ? anAlignment - blockMisalignment : 0);
+		}
+		myCursor = start + aSize;
+		return start;
+	}
+}
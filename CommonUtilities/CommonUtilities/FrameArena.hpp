@@ -0,0 +1,142 @@
+#pragma once
+#include <assert.h>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace CommonUtilities
+{
+	// Bump allocator for memory that lives for one frame. Nothing is freed on its own; BeginFrame
+	// (called by Timer::Update when attached with Timer::SetFrameArena) makes the whole frame's memory
+	// free again at once. With aBufferCount 2 or 3 the arena cycles through that many buffers, so memory
+	// from a frame stays valid until BeginFrame has been called aBufferCount times, for work that finishes
+	// a frame or two late. Allocate is thread-safe; workers with many small allocations use a SubArena.
+	class FrameArena
+	{
+	public:
+		// Carves blocks out of the arena for one thread and bump allocates from them without atomics.
+		// Picks up the new frame on its own.
+		class SubArena
+		{
+		public:
+			explicit SubArena(FrameArena& anArena, const size_t aBlockSize = 64 * 1024);
+
+			void* Allocate(const size_t aSize, const size_t anAlignment = alignof(std::max_align_t));
+
+		private:
+			FrameArena& myArena;
+			char* myCursor;
+			char* myEnd;
+			size_t myBlockSize;
+			unsigned int myFrame;
+		};
+
+		FrameArena(const size_t aCapacity, const int aBufferCount = 1);
+		FrameArena(const FrameArena& anArena) = delete;
+		FrameArena& operator=(const FrameArena& anArena) = delete;
+		~FrameArena();
+
+		// Throws std::bad_alloc when the frame's buffer is full
+		void* Allocate(const size_t aSize, const size_t anAlignment = alignof(std::max_align_t));
+		// Uninitialized room for aCount objects
+		template<class T>
+		T* AllocateArray(const int aCount);
+		// Destructors never run, so only for trivially destructible types
+		template<class T, class... Arguments>
+		T* New(Arguments&&... someArguments);
+
+		// Moves on to the next buffer and records the finished frame's high-water mark
+		void BeginFrame();
+
+		size_t GetUsed() const;
+		size_t GetCapacity() const;
+		// Bytes used by the last finished frame, and the most any frame has used
+		size_t GetHighWaterMark() const;
+		size_t GetPeakHighWaterMark() const;
+		unsigned int GetFrameIndex() const;
+
+	private:
+		char* myMemory;
+		char* myBuffer;
+		size_t myCapacity;
+		int myBufferCount;
+		int myBufferIndex;
+		std::atomic<size_t> myUsed;
+		std::atomic<unsigned int> myFrameIndex;
+		size_t myHighWaterMark;
+		size_t myPeakHighWaterMark;
+	};
+
+	// Adapter for GrowingArray and the other CommonUtilities containers. Free does nothing, the memory
+	// comes back at the next frame, so containers should Reserve up front rather than grow.
+	struct FrameArenaAllocator
+	{
+		FrameArena* myArena;
+
+		void* Allocate(const size_t aSize, const size_t anAlignment)
+		{
+			return myArena->Allocate(aSize, anAlignment);
+		}
+
+		void Free(void*)
+		{
+		}
+	};
+
+	// Standard library allocator on a FrameArena, for std::vector<T, FrameAllocator<T>> and the like
+	template<class T>
+	class FrameAllocator
+	{
+	public:
+		typedef T value_type;
+
+		FrameAllocator(FrameArena& anArena) : myArena(&anArena) {}
+		template<class U>
+		FrameAllocator(const FrameAllocator<U>& anAllocator) : myArena(anAllocator.GetArena()) {}
+
+		T* allocate(const size_t aCount)
+		{
+			return static_cast<T*>(myArena->Allocate(sizeof(T) * aCount, alignof(T)));
+		}
+
+		void deallocate(T*, const size_t)
+		{
+		}
+
+		FrameArena* GetArena() const
+		{
+			return myArena;
+		}
+
+	private:
+		FrameArena* myArena;
+	};
+
+	template<class T, class U>
+	inline bool operator==(const FrameAllocator<T>& aLeft, const FrameAllocator<U>& aRight)
+	{
+		return aLeft.GetArena() == aRight.GetArena();
+	}
+
+	template<class T, class U>
+	inline bool operator!=(const FrameAllocator<T>& aLeft, const FrameAllocator<U>& aRight)
+	{
+		return !(aLeft == aRight);
+	}
+
+	template<class T>
+	inline T* FrameArena::AllocateArray(const int aCount)
+	{
+		assert(aCount >= 0 && "Count can't be negative!");
+		return static_cast<T*>(Allocate(sizeof(T) * aCount, alignof(T)));
+	}
+
+	template<class T, class... Arguments>
+	inline T* FrameArena::New(Arguments&&... someArguments)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors!");
+		return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Arguments>(someArguments)...);
+	}
+}
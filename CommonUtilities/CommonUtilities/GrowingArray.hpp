@@ -0,0 +1,524 @@
+#pragma once
+#include <assert.h>
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "AlignedAllocation.hpp"
+
+namespace CommonUtilities
+{
+	// Contiguous array that grows by its growth factor when full. Trivially copyable elements are
+	// relocated with memcpy/memmove, everything else is moved. Memory comes from Allocator (AlignedAllocation.hpp).
+	template<class T, class SizeType = int, class Allocator = AlignedAllocator>
+	class GrowingArray
+	{
+	public:
+		static_assert(std::is_integral<SizeType>::value, "SizeType must be an integer type!");
+		static const SizeType FoundNone = static_cast<SizeType>(-1);
+
+		GrowingArray(const Allocator& anAllocator = Allocator());
+		explicit GrowingArray(const SizeType aCapacity, const Allocator& anAllocator = Allocator());
+		GrowingArray(const std::initializer_list<T>& aInitList);
+		GrowingArray(const GrowingArray& aGrowingArray);
+		GrowingArray(GrowingArray&& aGrowingArray);
+		~GrowingArray();
+
+		GrowingArray& operator=(const GrowingArray& aGrowingArray);
+		GrowingArray& operator=(GrowingArray&& aGrowingArray);
+
+		inline T& operator[](const SizeType anIndex);
+		inline const T& operator[](const SizeType anIndex) const;
+
+		inline void Add(const T& anObject);
+		inline void Add(T&& anObject);
+		template<class... Arguments>
+		inline T& Emplace(Arguments&&... someArguments);
+		inline void Insert(const SizeType anIndex, const T& anObject);
+
+		// Swaps with the last element and pops it, so the order isn't kept. Returns false if anObject isn't found.
+		inline bool RemoveCyclic(const T& anObject);
+		inline void RemoveCyclicAtIndex(const SizeType anIndex);
+		// Keeps the order by shifting everything after anIndex down
+		inline void RemoveAtIndex(const SizeType anIndex);
+		inline void RemoveAll();
+		// Deletes every element and empties the array, pointer elements only
+		inline void DeleteAll();
+
+		inline SizeType Find(const T& anObject) const;
+		inline T& GetLast();
+		inline const T& GetLast() const;
+
+		void Reserve(const SizeType aCapacity);
+		// New elements are value-initialized
+		void Resize(const SizeType aCount);
+		// Shrinks the capacity to the element count
+		void Optimize();
+
+		// Capacity is multiplied by aGrowthFactor (greater than 1) when the array is full
+		void SetGrowthFactor(const float aGrowthFactor);
+		float GetGrowthFactor() const;
+
+		inline SizeType Size() const;
+		inline SizeType Capacity() const;
+		inline bool IsEmpty() const;
+
+		inline T* GetData();
+		inline const T* GetData() const;
+		inline T* begin();
+		inline T* end();
+		inline const T* begin() const;
+		inline const T* end() const;
+
+	private:
+		typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value> IsTriviallyCopyable;
+
+		SizeType GetGrownCapacity() const;
+		T* AllocateData(const SizeType aCapacity);
+		void Reallocate(const SizeType aCapacity);
+		void Release();
+
+		static void Relocate(T* aDestination, T* aSource, const SizeType aCount, std::true_type);
+		static void Relocate(T* aDestination, T* aSource, const SizeType aCount, std::false_type);
+		void CopyFrom(const GrowingArray& aGrowingArray, std::true_type);
+		void CopyFrom(const GrowingArray& aGrowingArray, std::false_type);
+		void ShiftUp(const SizeType anIndex, std::true_type);
+		void ShiftUp(const SizeType anIndex, std::false_type);
+		void ShiftDown(const SizeType anIndex, std::true_type);
+		void ShiftDown(const SizeType anIndex, std::false_type);
+
+		T* myData;
+		SizeType mySize;
+		SizeType myCapacity;
+		float myGrowthFactor;
+		Allocator myAllocator;
+	};
+
+	template<class T, class SizeType, class Allocator>
+	const SizeType GrowingArray<T, SizeType, Allocator>::FoundNone;
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>::GrowingArray(const Allocator& anAllocator) : myAllocator(anAllocator)
+	{
+		myData = nullptr;
+		mySize = 0;
+		myCapacity = 0;
+		myGrowthFactor = 2.f;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>::GrowingArray(const SizeType aCapacity, const Allocator& anAllocator) : GrowingArray(anAllocator)
+	{
+		Reserve(aCapacity);
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>::GrowingArray(const std::initializer_list<T>& aInitList) : GrowingArray()
+	{
+		Reserve(static_cast<SizeType>(aInitList.size()));
+		for (const T& element : aInitList)
+		{
+			Add(element);
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>::GrowingArray(const GrowingArray& aGrowingArray) : GrowingArray(aGrowingArray.myAllocator)
+	{
+		(*this) = aGrowingArray;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>::GrowingArray(GrowingArray&& aGrowingArray) : GrowingArray(aGrowingArray.myAllocator)
+	{
+		(*this) = std::move(aGrowingArray);
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>::~GrowingArray()
+	{
+		Release();
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>& GrowingArray<T, SizeType, Allocator>::operator=(const GrowingArray& aGrowingArray)
+	{
+		if (this != &aGrowingArray)
+		{
+			RemoveAll();
+			Reserve(aGrowingArray.mySize);
+			CopyFrom(aGrowingArray, IsTriviallyCopyable{});
+			mySize = aGrowingArray.mySize;
+			myGrowthFactor = aGrowingArray.myGrowthFactor;
+		}
+		return (*this);
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline GrowingArray<T, SizeType, Allocator>& GrowingArray<T, SizeType, Allocator>::operator=(GrowingArray&& aGrowingArray)
+	{
+		// The allocator goes with the memory it handed out
+		std::swap(myData, aGrowingArray.myData);
+		std::swap(mySize, aGrowingArray.mySize);
+		std::swap(myCapacity, aGrowingArray.myCapacity);
+		std::swap(myGrowthFactor, aGrowingArray.myGrowthFactor);
+		std::swap(myAllocator, aGrowingArray.myAllocator);
+		return (*this);
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline T& GrowingArray<T, SizeType, Allocator>::operator[](const SizeType anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		return myData[anIndex];
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline const T& GrowingArray<T, SizeType, Allocator>::operator[](const SizeType anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		return myData[anIndex];
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Add(const T& anObject)
+	{
+		Emplace(anObject);
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Add(T&& anObject)
+	{
+		Emplace(std::move(anObject));
+	}
+
+	template<class T, class SizeType, class Allocator>
+	template<class... Arguments>
+	inline T& GrowingArray<T, SizeType, Allocator>::Emplace(Arguments&&... someArguments)
+	{
+		if (mySize == myCapacity)
+		{
+			// The new element is constructed before the old ones move, the arguments may refer to one of them
+			const SizeType capacity = GetGrownCapacity();
+			T* data = AllocateData(capacity);
+			new (data + mySize) T(std::forward<Arguments>(someArguments)...);
+			Relocate(data, myData, mySize, IsTriviallyCopyable{});
+			if (myData != nullptr)
+			{
+				myAllocator.Free(myData);
+			}
+			myData = data;
+			myCapacity = capacity;
+		}
+		else
+		{
+			new (myData + mySize) T(std::forward<Arguments>(someArguments)...);
+		}
+		return myData[mySize++];
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Insert(const SizeType anIndex, const T& anObject)
+	{
+		assert(anIndex >= 0 && anIndex <= mySize && "Index out of range!");
+		Add(anObject);
+		if (anIndex < mySize - 1)
+		{
+			T object(std::move(myData[mySize - 1]));
+			ShiftUp(anIndex, IsTriviallyCopyable{});
+			myData[anIndex] = std::move(object);
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline bool GrowingArray<T, SizeType, Allocator>::RemoveCyclic(const T& anObject)
+	{
+		const SizeType index = Find(anObject);
+		if (index == FoundNone)
+		{
+			return false;
+		}
+		RemoveCyclicAtIndex(index);
+		return true;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::RemoveCyclicAtIndex(const SizeType anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		--mySize;
+		if (anIndex != mySize)
+		{
+			myData[anIndex] = std::move(myData[mySize]);
+		}
+		myData[mySize].~T();
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::RemoveAtIndex(const SizeType anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < mySize && "Index out of range!");
+		ShiftDown(anIndex, IsTriviallyCopyable{});
+		--mySize;
+		myData[mySize].~T();
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::RemoveAll()
+	{
+		for (SizeType index = 0; index < mySize; ++index)
+		{
+			myData[index].~T();
+		}
+		mySize = 0;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::DeleteAll()
+	{
+		static_assert(std::is_pointer<T>::value, "DeleteAll is only for arrays of pointers!");
+		for (SizeType index = 0; index < mySize; ++index)
+		{
+			delete myData[index];
+		}
+		mySize = 0;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline SizeType GrowingArray<T, SizeType, Allocator>::Find(const T& anObject) const
+	{
+		for (SizeType index = 0; index < mySize; ++index)
+		{
+			if (myData[index] == anObject)
+			{
+				return index;
+			}
+		}
+		return FoundNone;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline T& GrowingArray<T, SizeType, Allocator>::GetLast()
+	{
+		assert(mySize > 0 && "Array is empty!");
+		return myData[mySize - 1];
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline const T& GrowingArray<T, SizeType, Allocator>::GetLast() const
+	{
+		assert(mySize > 0 && "Array is empty!");
+		return myData[mySize - 1];
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Reserve(const SizeType aCapacity)
+	{
+		if (aCapacity > myCapacity)
+		{
+			Reallocate(aCapacity);
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Resize(const SizeType aCount)
+	{
+		assert(aCount >= 0 && "Count can't be negative!");
+		Reserve(aCount);
+		while (mySize > aCount)
+		{
+			myData[--mySize].~T();
+		}
+		for (; mySize < aCount; ++mySize)
+		{
+			new (myData + mySize) T();
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Optimize()
+	{
+		if (mySize == 0)
+		{
+			Release();
+		}
+		else if (mySize < myCapacity)
+		{
+			Reallocate(mySize);
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::SetGrowthFactor(const float aGrowthFactor)
+	{
+		assert(aGrowthFactor > 1.f && "Growth factor must be greater than 1!");
+		myGrowthFactor = aGrowthFactor;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline float GrowingArray<T, SizeType, Allocator>::GetGrowthFactor() const
+	{
+		return myGrowthFactor;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline SizeType GrowingArray<T, SizeType, Allocator>::Size() const
+	{
+		return mySize;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline SizeType GrowingArray<T, SizeType, Allocator>::Capacity() const
+	{
+		return myCapacity;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline bool GrowingArray<T, SizeType, Allocator>::IsEmpty() const
+	{
+		return mySize == 0;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline T* GrowingArray<T, SizeType, Allocator>::GetData()
+	{
+		return myData;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline const T* GrowingArray<T, SizeType, Allocator>::GetData() const
+	{
+		return myData;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline T* GrowingArray<T, SizeType, Allocator>::begin()
+	{
+		return myData;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline T* GrowingArray<T, SizeType, Allocator>::end()
+	{
+		return myData + mySize;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline const T* GrowingArray<T, SizeType, Allocator>::begin() const
+	{
+		return myData;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline const T* GrowingArray<T, SizeType, Allocator>::end() const
+	{
+		return myData + mySize;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline SizeType GrowingArray<T, SizeType, Allocator>::GetGrownCapacity() const
+	{
+		const SizeType maximum = std::numeric_limits<SizeType>::max();
+		assert(myCapacity < maximum && "GrowingArray can't grow past the range of SizeType!");
+		const double grown = static_cast<double>(myCapacity) * myGrowthFactor;
+		const SizeType capacity = grown < static_cast<double>(maximum) ? static_cast<SizeType>(grown) : maximum;
+		return capacity > myCapacity ? capacity : static_cast<SizeType>(myCapacity + 1);
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline T* GrowingArray<T, SizeType, Allocator>::AllocateData(const SizeType aCapacity)
+	{
+		return static_cast<T*>(myAllocator.Allocate(sizeof(T) * static_cast<size_t>(aCapacity), alignof(T)));
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Reallocate(const SizeType aCapacity)
+	{
+		T* data = AllocateData(aCapacity);
+		Relocate(data, myData, mySize, IsTriviallyCopyable{});
+		if (myData != nullptr)
+		{
+			myAllocator.Free(myData);
+		}
+		myData = data;
+		myCapacity = aCapacity;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Release()
+	{
+		RemoveAll();
+		if (myData != nullptr)
+		{
+			myAllocator.Free(myData);
+		}
+		myData = nullptr;
+		myCapacity = 0;
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Relocate(T* aDestination, T* aSource, const SizeType aCount, std::true_type)
+	{
+		if (aCount > 0)
+		{
+			memcpy(aDestination, aSource, sizeof(T) * static_cast<size_t>(aCount));
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::Relocate(T* aDestination, T* aSource, const SizeType aCount, std::false_type)
+	{
+		for (SizeType index = 0; index < aCount; ++index)
+		{
+			new (aDestination + index) T(std::move(aSource[index]));
+			aSource[index].~T();
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::CopyFrom(const GrowingArray& aGrowingArray, std::true_type)
+	{
+		if (aGrowingArray.mySize > 0)
+		{
+			memcpy(myData, aGrowingArray.myData, sizeof(T) * static_cast<size_t>(aGrowingArray.mySize));
+		}
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::CopyFrom(const GrowingArray& aGrowingArray, std::false_type)
+	{
+		for (SizeType index = 0; index < aGrowingArray.mySize; ++index)
+		{
+			new (myData + index) T(aGrowingArray.myData[index]);
+		}
+	}
+
+	// Moves [anIndex, mySize - 1) one step up, overwriting the last element
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::ShiftUp(const SizeType anIndex, std::true_type)
+	{
+		memmove(myData + anIndex + 1, myData + anIndex, sizeof(T) * static_cast<size_t>(mySize - 1 - anIndex));
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::ShiftUp(const SizeType anIndex, std::false_type)
+	{
+		std::move_backward(myData + anIndex, myData + mySize - 1, myData + mySize);
+	}
+
+	// Moves (anIndex, mySize) one step down, overwriting the element at anIndex
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::ShiftDown(const SizeType anIndex, std::true_type)
+	{
+		memmove(myData + anIndex, myData + anIndex + 1, sizeof(T) * static_cast<size_t>(mySize - 1 - anIndex));
+	}
+
+	template<class T, class SizeType, class Allocator>
+	inline void GrowingArray<T, SizeType, Allocator>::ShiftDown(const SizeType anIndex, std::false_type)
+	{
+		std::move(myData + anIndex + 1, myData + mySize, myData + anIndex);
+	}
+}
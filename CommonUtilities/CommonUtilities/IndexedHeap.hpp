@@ -0,0 +1,275 @@
+#pragma once
+#include <assert.h>
+#include <functional>
+#include <utility>
+#include "GrowingArray.hpp"
+
+namespace CommonUtilities
+{
+	// DaryHeap whose elements can be changed or removed after they were pushed, through the handle
+	// Push returns. A position table follows every element as it moves, so DecreaseKey, Update and
+	// Remove are O(log n) and the heap never holds duplicates. A handle is reused once its element
+	// has been popped or removed.
+	template<class T, int arity = 4, class Compare = std::less<T>, class Allocator = AlignedAllocator>
+	class IndexedHeap
+	{
+	public:
+		static_assert(arity >= 2, "A heap node needs at least two children!");
+		typedef int Handle;
+
+		IndexedHeap(const Compare& aCompare = Compare(), const Allocator& anAllocator = Allocator());
+
+		inline Handle Push(const T& anObject);
+		// Removes and returns the top
+		inline T Pop();
+
+		inline const T& GetTop() const;
+		inline Handle GetTopHandle() const;
+
+		// False once the element has been popped or removed
+		inline bool Contains(const Handle aHandle) const;
+		inline const T& Get(const Handle aHandle) const;
+		// aValue must not compare less than the current value to move the element toward the top
+		inline void DecreaseKey(const Handle aHandle, const T& aValue);
+		// Changes the value either way
+		inline void Update(const Handle aHandle, const T& aValue);
+		inline void Remove(const Handle aHandle);
+
+		inline int Count() const;
+		inline bool IsEmpty() const;
+		// Invalidates every handle
+		inline void Clear();
+		inline void Reserve(const int aCapacity);
+
+	private:
+		static const int ourNotInHeap = -1;
+
+		struct Node
+		{
+			T myValue;
+			Handle myHandle;
+		};
+
+		inline void Place(const int anIndex, Node&& aNode);
+		void SiftUp(int anIndex);
+		void SiftDown(int anIndex);
+		void RemoveAt(const int anIndex);
+
+		GrowingArray<Node, int, Allocator> myNodes;
+		// Heap index of each handle, ourNotInHeap for free handles
+		GrowingArray<int, int, Allocator> myPositions;
+		GrowingArray<Handle, int, Allocator> myFreeHandles;
+		Compare myCompare;
+	};
+
+	template<class T, int arity, class Compare, class Allocator>
+	const int IndexedHeap<T, arity, Compare, Allocator>::ourNotInHeap;
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline IndexedHeap<T, arity, Compare, Allocator>::IndexedHeap(const Compare& aCompare, const Allocator& anAllocator)
+		: myNodes(anAllocator), myPositions(anAllocator), myFreeHandles(anAllocator), myCompare(aCompare)
+	{
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline typename IndexedHeap<T, arity, Compare, Allocator>::Handle IndexedHeap<T, arity, Compare, Allocator>::Push(const T& anObject)
+	{
+		Handle handle;
+		if (myFreeHandles.IsEmpty())
+		{
+			handle = myPositions.Size();
+			myPositions.Add(ourNotInHeap);
+		}
+		else
+		{
+			handle = myFreeHandles.GetLast();
+			myFreeHandles.RemoveCyclicAtIndex(myFreeHandles.Size() - 1);
+		}
+
+		myNodes.Add(Node{ anObject, handle });
+		myPositions[handle] = myNodes.Size() - 1;
+		SiftUp(myNodes.Size() - 1);
+		return handle;
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline T IndexedHeap<T, arity, Compare, Allocator>::Pop()
+	{
+		assert(!myNodes.IsEmpty() && "Heap is empty!");
+		T top = std::move(myNodes[0].myValue);
+		RemoveAt(0);
+		return top;
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline const T& IndexedHeap<T, arity, Compare, Allocator>::GetTop() const
+	{
+		assert(!myNodes.IsEmpty() && "Heap is empty!");
+		return myNodes[0].myValue;
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline typename IndexedHeap<T, arity, Compare, Allocator>::Handle IndexedHeap<T, arity, Compare, Allocator>::GetTopHandle() const
+	{
+		assert(!myNodes.IsEmpty() && "Heap is empty!");
+		return myNodes[0].myHandle;
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline bool IndexedHeap<T, arity, Compare, Allocator>::Contains(const Handle aHandle) const
+	{
+		return aHandle >= 0 && aHandle < myPositions.Size() && myPositions[aHandle] != ourNotInHeap;
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline const T& IndexedHeap<T, arity, Compare, Allocator>::Get(const Handle aHandle) const
+	{
+		assert(Contains(aHandle) && "Handle isn't in the heap!");
+		return myNodes[myPositions[aHandle]].myValue;
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::DecreaseKey(const Handle aHandle, const T& aValue)
+	{
+		assert(Contains(aHandle) && "Handle isn't in the heap!");
+		const int index = myPositions[aHandle];
+		assert(!myCompare(myNodes[index].myValue, aValue) && "DecreaseKey can't move an element away from the top!");
+		myNodes[index].myValue = aValue;
+		SiftUp(index);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::Update(const Handle aHandle, const T& aValue)
+	{
+		assert(Contains(aHandle) && "Handle isn't in the heap!");
+		const int index = myPositions[aHandle];
+		const bool towardTop = myCompare(aValue, myNodes[index].myValue);
+		myNodes[index].myValue = aValue;
+		if (towardTop)
+		{
+			SiftUp(index);
+		}
+		else
+		{
+			SiftDown(index);
+		}
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::Remove(const Handle aHandle)
+	{
+		assert(Contains(aHandle) && "Handle isn't in the heap!");
+		RemoveAt(myPositions[aHandle]);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline int IndexedHeap<T, arity, Compare, Allocator>::Count() const
+	{
+		return myNodes.Size();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline bool IndexedHeap<T, arity, Compare, Allocator>::IsEmpty() const
+	{
+		return myNodes.IsEmpty();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::Clear()
+	{
+		myNodes.RemoveAll();
+		myPositions.RemoveAll();
+		myFreeHandles.RemoveAll();
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::Reserve(const int aCapacity)
+	{
+		myNodes.Reserve(aCapacity);
+		myPositions.Reserve(aCapacity);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::Place(const int anIndex, Node&& aNode)
+	{
+		myPositions[aNode.myHandle] = anIndex;
+		myNodes[anIndex] = std::move(aNode);
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::SiftUp(int anIndex)
+	{
+		Node node = std::move(myNodes[anIndex]);
+		while (anIndex > 0)
+		{
+			const int parent = (anIndex - 1) / arity;
+			if (!myCompare(node.myValue, myNodes[parent].myValue))
+			{
+				break;
+			}
+			Place(anIndex, std::move(myNodes[parent]));
+			anIndex = parent;
+		}
+		Place(anIndex, std::move(node));
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::SiftDown(int anIndex)
+	{
+		const int count = myNodes.Size();
+		Node node = std::move(myNodes[anIndex]);
+		for (;;)
+		{
+			const int firstChild = anIndex * arity + 1;
+			if (firstChild >= count)
+			{
+				break;
+			}
+			const int lastChild = firstChild + arity < count ? firstChild + arity : count;
+			int best = firstChild;
+			for (int child = firstChild + 1; child < lastChild; ++child)
+			{
+				if (myCompare(myNodes[child].myValue, myNodes[best].myValue))
+				{
+					best = child;
+				}
+			}
+			if (!myCompare(myNodes[best].myValue, node.myValue))
+			{
+				break;
+			}
+			Place(anIndex, std::move(myNodes[best]));
+			anIndex = best;
+		}
+		Place(anIndex, std::move(node));
+	}
+
+	template<class T, int arity, class Compare, class Allocator>
+	inline void IndexedHeap<T, arity, Compare, Allocator>::RemoveAt(const int anIndex)
+	{
+		const Handle handle = myNodes[anIndex].myHandle;
+		myPositions[handle] = ourNotInHeap;
+		myFreeHandles.Add(handle);
+
+		const int last = myNodes.Size() - 1;
+		if (anIndex != last)
+		{
+			// The last node fills the hole and may belong above or below it
+			const bool towardTop = anIndex > 0 && myCompare(myNodes[last].myValue, myNodes[anIndex].myValue);
+			Place(anIndex, std::move(myNodes[last]));
+			myNodes.RemoveCyclicAtIndex(last);
+			if (towardTop)
+			{
+				SiftUp(anIndex);
+			}
+			else
+			{
+				SiftDown(anIndex);
+			}
+		}
+		else
+		{
+			myNodes.RemoveCyclicAtIndex(last);
+		}
+	}
+}
@@ -0,0 +1,64 @@
+#include "Intersection.hpp"
+#include "SimdLevel.hpp"
+#include "SimdPack.hpp"
+
+namespace CU = CommonUtilities;
+
+namespace
+{
+	namespace Scalar
+	{
+		typedef CU::Simd::PackScalar WidePack;
+#include "IntersectionKernels.inl"
+	}
+
+#ifdef CU_SIMD_SSE
+	namespace Sse
+	{
+		typedef CU::Simd::PackSSE WidePack;
+#include "IntersectionKernels.inl"
+	}
+
+CU_SIMD_AVX2_BEGIN
+	namespace Avx2
+	{
+		typedef CU::Simd::PackAVX2 WidePack;
+#include "IntersectionKernels.inl"
+	}
+CU_SIMD_AVX2_END
+
+CU_SIMD_AVX512_BEGIN
+	namespace Avx512
+	{
+		typedef CU::Simd::PackAVX512 WidePack;
+#include "IntersectionKernels.inl"
+	}
+CU_SIMD_AVX512_END
+#endif
+}
+
+namespace CommonUtilities
+{
+	namespace IntersectionKernels
+	{
+		void Intersect(const RayArrays<float>& someRays, const AABBArrays<float>& someAABBs, float* someDistances, uint64_t* someHitWords)
+		{
+			CU_SIMD_DISPATCH(Intersect(someRays, someAABBs, someDistances, someHitWords));
+		}
+
+		void Intersect(const RayArrays<float>& someRays, const SphereArrays<float>& someSpheres, float* someDistances, uint64_t* someHitWords)
+		{
+			CU_SIMD_DISPATCH(Intersect(someRays, someSpheres, someDistances, someHitWords));
+		}
+
+		void Intersect(const RayArrays<float>& someRays, const PlaneArrays<float>& somePlanes, float* someDistances, uint64_t* someHitWords)
+		{
+			CU_SIMD_DISPATCH(Intersect(someRays, somePlanes, someDistances, someHitWords));
+		}
+
+		void Intersect(const RayArrays<float>& someRays, const TriangleArrays<float>& someTriangles, float* someDistances, uint64_t* someHitWords)
+		{
+			CU_SIMD_DISPATCH(Intersect(someRays, someTriangles, someDistances, someHitWords));
+		}
+	}
+}
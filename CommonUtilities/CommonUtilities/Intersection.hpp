@@ -0,0 +1,328 @@
+#pragma once
+#include <assert.h>
+#include <cstdint>
+#include <limits>
+#include <math.h>
+#include <string.h>
+#include "AABB3D.hpp"
+#include "Plane.hpp"
+#include "Ray.hpp"
+#include "Sphere.hpp"
+#include "Vector3Stream.hpp"
+
+namespace CommonUtilities
+{
+	// Ray against one shape. On a hit aDistance is where along the ray it enters the shape, in lengths of
+	// the ray direction, or 0 if the ray starts inside; on a miss it's left as it was.
+	// Planes are hit from both sides, triangles too (no backface culling).
+
+	template<class T>
+	inline bool IntersectionAABBRay(const AABB3D<T>& anAABB, const Ray<T>& aRay, T& aDistance)
+	{
+		// Slab test: the ray is inside the box where it is between the two planes of every axis
+		T nearest = 0;
+		T farthest = 0;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const T inverse = static_cast<T>(1) / aRay.GetDirection()[axis];
+			const T entry = (anAABB.GetMin()[axis] - aRay.GetOrigin()[axis]) * inverse;
+			const T exit = (anAABB.GetMax()[axis] - aRay.GetOrigin()[axis]) * inverse;
+			const T axisNear = entry < exit ? entry : exit;
+			const T axisFar = entry > exit ? entry : exit;
+			nearest = axis == 0 || axisNear > nearest ? axisNear : nearest;
+			farthest = axis == 0 || axisFar < farthest ? axisFar : farthest;
+		}
+		if (farthest < nearest || farthest < 0)
+		{
+			return false;
+		}
+		aDistance = nearest > 0 ? nearest : 0;
+		return true;
+	}
+
+	template<class T>
+	inline bool IntersectionSphereRay(const Sphere<T>& aSphere, const Ray<T>& aRay, T& aDistance)
+	{
+		const Vector3<T>& direction = aRay.GetDirection();
+		const Vector3<T> offset = aRay.GetOrigin() - aSphere.GetCenter();
+		const T a = direction.Dot(direction);
+		const T b = offset.Dot(direction);
+		const T c = offset.Dot(offset) - aSphere.GetRadius() * aSphere.GetRadius();
+		const T discriminant = b * b - a * c;
+		if (discriminant < 0)
+		{
+			return false;
+		}
+		const T root = sqrt(discriminant);
+		if ((root - b) / a < 0)
+		{
+			return false;
+		}
+		const T nearest = (0 - (b + root)) / a;
+		aDistance = nearest > 0 ? nearest : 0;
+		return true;
+	}
+
+	template<class T>
+	inline bool IntersectionPlaneRay(const Plane<T>& aPlane, const Ray<T>& aRay, T& aDistance)
+	{
+		// A ray parallel to the plane gets an infinite or NaN distance and misses
+		const T distance = (aPlane.GetOffset() - aPlane.GetNormal().Dot(aRay.GetOrigin())) / aPlane.GetNormal().Dot(aRay.GetDirection());
+		if (!(distance >= 0 && distance < std::numeric_limits<T>::infinity()))
+		{
+			return false;
+		}
+		aDistance = distance;
+		return true;
+	}
+
+	// Moller-Trumbore: solves for the barycentric coordinates of the hit without the triangle's plane
+	template<class T>
+	inline bool IntersectionTriangleRay(const Vector3<T>& aCorner0, const Vector3<T>& aCorner1, const Vector3<T>& aCorner2, const Ray<T>& aRay, T& aDistance)
+	{
+		const Vector3<T> edge0 = aCorner1 - aCorner0;
+		const Vector3<T> edge1 = aCorner2 - aCorner0;
+		const Vector3<T> p = aRay.GetDirection().Cross(edge1);
+		const T determinant = edge0.Dot(p);
+		if (determinant == 0)
+		{
+			return false;
+		}
+		const T inverse = static_cast<T>(1) / determinant;
+		const Vector3<T> toOrigin = aRay.GetOrigin() - aCorner0;
+		const T u = toOrigin.Dot(p) * inverse;
+		if (u < 0)
+		{
+			return false;
+		}
+		const Vector3<T> q = toOrigin.Cross(edge0);
+		const T v = aRay.GetDirection().Dot(q) * inverse;
+		if (v < 0 || 1 < u + v)
+		{
+			return false;
+		}
+		const T distance = edge1.Dot(q) * inverse;
+		if (distance < 0)
+		{
+			return false;
+		}
+		aDistance = distance;
+		return true;
+	}
+
+	// Many rays against one shape or one ray against many shapes, given as separate arrays; the side
+	// with more than one gives the count. Bit n of someHitWords is set if pair n hits, with its distance
+	// in someDistances[n] (misses are unspecified); (count + 63) / 64 words are written.
+	// The templates are the scalar reference built on the tests above, the float overloads are SIMD
+	// kernels chosen at runtime (SimdLevel.hpp) that run one pair per lane.
+	namespace IntersectionKernels
+	{
+		template<class T>
+		struct RayArrays
+		{
+			const T* myOriginX;
+			const T* myOriginY;
+			const T* myOriginZ;
+			const T* myDirectionX;
+			const T* myDirectionY;
+			const T* myDirectionZ;
+			int myCount;
+		};
+
+		template<class T>
+		struct AABBArrays
+		{
+			const T* myMinX;
+			const T* myMinY;
+			const T* myMinZ;
+			const T* myMaxX;
+			const T* myMaxY;
+			const T* myMaxZ;
+			int myCount;
+		};
+
+		template<class T>
+		struct SphereArrays
+		{
+			const T* myCenterX;
+			const T* myCenterY;
+			const T* myCenterZ;
+			const T* myRadius;
+			int myCount;
+		};
+
+		template<class T>
+		struct PlaneArrays
+		{
+			const T* myNormalX;
+			const T* myNormalY;
+			const T* myNormalZ;
+			const T* myOffset;
+			int myCount;
+		};
+
+		template<class T>
+		struct TriangleArrays
+		{
+			const T* myCorner0X;
+			const T* myCorner0Y;
+			const T* myCorner0Z;
+			const T* myCorner1X;
+			const T* myCorner1Y;
+			const T* myCorner1Z;
+			const T* myCorner2X;
+			const T* myCorner2Y;
+			const T* myCorner2Z;
+			int myCount;
+		};
+
+		// Runs aTest(ray, shapeIndex, distance) for every pair
+		template<class T, class Test>
+		void IntersectEach(const RayArrays<T>& someRays, const int aShapeCount, T* someDistances, uint64_t* someHitWords, Test aTest)
+		{
+			assert((someRays.myCount == 1 || aShapeCount == 1) && "Either the rays or the shapes must be one!");
+			const int count = someRays.myCount != 1 ? someRays.myCount : aShapeCount;
+			if (count == 0)
+			{
+				return;
+			}
+			const int rayStep = someRays.myCount > 1 ? 1 : 0;
+			const int shapeStep = aShapeCount > 1 ? 1 : 0;
+			memset(someHitWords, 0, sizeof(uint64_t) * ((count + 63) / 64));
+			for (int index = 0; index < count; ++index)
+			{
+				const int ray = index * rayStep;
+				const Ray<T> rayToTest(Vector3<T>(someRays.myOriginX[ray], someRays.myOriginY[ray], someRays.myOriginZ[ray]), Vector3<T>(someRays.myDirectionX[ray], someRays.myDirectionY[ray], someRays.myDirectionZ[ray]));
+				if (aTest(rayToTest, index * shapeStep, someDistances[index]))
+				{
+					someHitWords[index / 64] |= 1ull << (index % 64);
+				}
+			}
+		}
+
+		template<class T>
+		void Intersect(const RayArrays<T>& someRays, const AABBArrays<T>& someAABBs, T* someDistances, uint64_t* someHitWords)
+		{
+			IntersectEach(someRays, someAABBs.myCount, someDistances, someHitWords, [&someAABBs](const Ray<T>& aRay, const int aShape, T& aDistance)
+			{
+				const AABB3D<T> aabb(Vector3<T>(someAABBs.myMinX[aShape], someAABBs.myMinY[aShape], someAABBs.myMinZ[aShape]), Vector3<T>(someAABBs.myMaxX[aShape], someAABBs.myMaxY[aShape], someAABBs.myMaxZ[aShape]));
+				return IntersectionAABBRay(aabb, aRay, aDistance);
+			});
+		}
+
+		template<class T>
+		void Intersect(const RayArrays<T>& someRays, const SphereArrays<T>& someSpheres, T* someDistances, uint64_t* someHitWords)
+		{
+			IntersectEach(someRays, someSpheres.myCount, someDistances, someHitWords, [&someSpheres](const Ray<T>& aRay, const int aShape, T& aDistance)
+			{
+				const Sphere<T> sphere(Vector3<T>(someSpheres.myCenterX[aShape], someSpheres.myCenterY[aShape], someSpheres.myCenterZ[aShape]), someSpheres.myRadius[aShape]);
+				return IntersectionSphereRay(sphere, aRay, aDistance);
+			});
+		}
+
+		template<class T>
+		void Intersect(const RayArrays<T>& someRays, const PlaneArrays<T>& somePlanes, T* someDistances, uint64_t* someHitWords)
+		{
+			IntersectEach(someRays, somePlanes.myCount, someDistances, someHitWords, [&somePlanes](const Ray<T>& aRay, const int aShape, T& aDistance)
+			{
+				Plane<T> plane;
+				plane.InitWithNormalAndOffset(Vector3<T>(somePlanes.myNormalX[aShape], somePlanes.myNormalY[aShape], somePlanes.myNormalZ[aShape]), somePlanes.myOffset[aShape]);
+				return IntersectionPlaneRay(plane, aRay, aDistance);
+			});
+		}
+
+		template<class T>
+		void Intersect(const RayArrays<T>& someRays, const TriangleArrays<T>& someTriangles, T* someDistances, uint64_t* someHitWords)
+		{
+			IntersectEach(someRays, someTriangles.myCount, someDistances, someHitWords, [&someTriangles](const Ray<T>& aRay, const int aShape, T& aDistance)
+			{
+				return IntersectionTriangleRay(Vector3<T>(someTriangles.myCorner0X[aShape], someTriangles.myCorner0Y[aShape], someTriangles.myCorner0Z[aShape]),
+					Vector3<T>(someTriangles.myCorner1X[aShape], someTriangles.myCorner1Y[aShape], someTriangles.myCorner1Z[aShape]),
+					Vector3<T>(someTriangles.myCorner2X[aShape], someTriangles.myCorner2Y[aShape], someTriangles.myCorner2Z[aShape]), aRay, aDistance);
+			});
+		}
+
+		void Intersect(const RayArrays<float>& someRays, const AABBArrays<float>& someAABBs, float* someDistances, uint64_t* someHitWords);
+		void Intersect(const RayArrays<float>& someRays, const SphereArrays<float>& someSpheres, float* someDistances, uint64_t* someHitWords);
+		void Intersect(const RayArrays<float>& someRays, const PlaneArrays<float>& somePlanes, float* someDistances, uint64_t* someHitWords);
+		void Intersect(const RayArrays<float>& someRays, const TriangleArrays<float>& someTriangles, float* someDistances, uint64_t* someHitWords);
+
+		template<class T>
+		inline RayArrays<T> GetRayArrays(const Ray<T>& aRay)
+		{
+			return { &aRay.GetOrigin().x, &aRay.GetOrigin().y, &aRay.GetOrigin().z, &aRay.GetDirection().x, &aRay.GetDirection().y, &aRay.GetDirection().z, 1 };
+		}
+
+		template<class T>
+		inline RayArrays<T> GetRayArrays(const Vector3Stream<T>& someOrigins, const Vector3Stream<T>& someDirections)
+		{
+			assert(someOrigins.Count() == someDirections.Count() && "Origins and directions differ in count!");
+			return { someOrigins.GetX(), someOrigins.GetY(), someOrigins.GetZ(), someDirections.GetX(), someDirections.GetY(), someDirections.GetZ(), someOrigins.Count() };
+		}
+	}
+
+	// Ray packets: the rays in someOrigins and someDirections against one shape
+
+	template<class T>
+	inline void IntersectionAABBRays(const AABB3D<T>& anAABB, const Vector3Stream<T>& someOrigins, const Vector3Stream<T>& someDirections, T* someDistances, uint64_t* someHitWords)
+	{
+		const IntersectionKernels::AABBArrays<T> aabb = { &anAABB.GetMin().x, &anAABB.GetMin().y, &anAABB.GetMin().z, &anAABB.GetMax().x, &anAABB.GetMax().y, &anAABB.GetMax().z, 1 };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(someOrigins, someDirections), aabb, someDistances, someHitWords);
+	}
+
+	template<class T>
+	inline void IntersectionSphereRays(const Sphere<T>& aSphere, const Vector3Stream<T>& someOrigins, const Vector3Stream<T>& someDirections, T* someDistances, uint64_t* someHitWords)
+	{
+		const T radius = aSphere.GetRadius();
+		const IntersectionKernels::SphereArrays<T> sphere = { &aSphere.GetCenter().x, &aSphere.GetCenter().y, &aSphere.GetCenter().z, &radius, 1 };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(someOrigins, someDirections), sphere, someDistances, someHitWords);
+	}
+
+	template<class T>
+	inline void IntersectionPlaneRays(const Plane<T>& aPlane, const Vector3Stream<T>& someOrigins, const Vector3Stream<T>& someDirections, T* someDistances, uint64_t* someHitWords)
+	{
+		const T offset = aPlane.GetOffset();
+		const IntersectionKernels::PlaneArrays<T> plane = { &aPlane.GetNormal().x, &aPlane.GetNormal().y, &aPlane.GetNormal().z, &offset, 1 };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(someOrigins, someDirections), plane, someDistances, someHitWords);
+	}
+
+	template<class T>
+	inline void IntersectionTriangleRays(const Vector3<T>& aCorner0, const Vector3<T>& aCorner1, const Vector3<T>& aCorner2, const Vector3Stream<T>& someOrigins, const Vector3Stream<T>& someDirections, T* someDistances, uint64_t* someHitWords)
+	{
+		const IntersectionKernels::TriangleArrays<T> triangle = { &aCorner0.x, &aCorner0.y, &aCorner0.z, &aCorner1.x, &aCorner1.y, &aCorner1.z, &aCorner2.x, &aCorner2.y, &aCorner2.z, 1 };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(someOrigins, someDirections), triangle, someDistances, someHitWords);
+	}
+
+	// Shape packets: one ray against every shape in the streams
+
+	template<class T>
+	inline void IntersectionAABBsRay(const Vector3Stream<T>& someMins, const Vector3Stream<T>& someMaxs, const Ray<T>& aRay, T* someDistances, uint64_t* someHitWords)
+	{
+		assert(someMins.Count() == someMaxs.Count() && "Mins and maxs differ in count!");
+		const IntersectionKernels::AABBArrays<T> aabbs = { someMins.GetX(), someMins.GetY(), someMins.GetZ(), someMaxs.GetX(), someMaxs.GetY(), someMaxs.GetZ(), someMins.Count() };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(aRay), aabbs, someDistances, someHitWords);
+	}
+
+	template<class T>
+	inline void IntersectionSpheresRay(const Vector3Stream<T>& someCenters, const T* someRadii, const Ray<T>& aRay, T* someDistances, uint64_t* someHitWords)
+	{
+		const IntersectionKernels::SphereArrays<T> spheres = { someCenters.GetX(), someCenters.GetY(), someCenters.GetZ(), someRadii, someCenters.Count() };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(aRay), spheres, someDistances, someHitWords);
+	}
+
+	template<class T>
+	inline void IntersectionPlanesRay(const Vector3Stream<T>& someNormals, const T* someOffsets, const Ray<T>& aRay, T* someDistances, uint64_t* someHitWords)
+	{
+		const IntersectionKernels::PlaneArrays<T> planes = { someNormals.GetX(), someNormals.GetY(), someNormals.GetZ(), someOffsets, someNormals.Count() };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(aRay), planes, someDistances, someHitWords);
+	}
+
+	template<class T>
+	inline void IntersectionTrianglesRay(const Vector3Stream<T>& someCorners0, const Vector3Stream<T>& someCorners1, const Vector3Stream<T>& someCorners2, const Ray<T>& aRay, T* someDistances, uint64_t* someHitWords)
+	{
+		assert(someCorners0.Count() == someCorners1.Count() && someCorners0.Count() == someCorners2.Count() && "Corners differ in count!");
+		const IntersectionKernels::TriangleArrays<T> triangles = { someCorners0.GetX(), someCorners0.GetY(), someCorners0.GetZ(), someCorners1.GetX(), someCorners1.GetY(), someCorners1.GetZ(),
+			someCorners2.GetX(), someCorners2.GetY(), someCorners2.GetZ(), someCorners0.Count() };
+		IntersectionKernels::Intersect(IntersectionKernels::GetRayArrays(aRay), triangles, someDistances, someHitWords);
+	}
+}
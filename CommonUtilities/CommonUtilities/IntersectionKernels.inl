@@ -0,0 +1,189 @@
+// Intersection kernels written once over a Pack (SimdPack.hpp).
+// Included by Intersection.cpp once per instruction set, inside a namespace that defines WidePack.
+// Each kernel runs pairs [aBegin, anEnd) where the range is a multiple of Pack::ourWidth. Either the
+// rays are loaded a pack at a time and the one shape is broadcast (isRayStream) or the other way around.
+// The math follows the single tests in Intersection.hpp step by step so the results agree with them.
+
+template<class Pack, bool isStream>
+typename Pack::Type Fetch(const float* someValues, const int anIndex)
+{
+	return isStream ? Pack::Load(someValues + anIndex) : Pack::Set(*someValues);
+}
+
+template<class Pack>
+typename Pack::Type Dot(const typename Pack::Type aX0, const typename Pack::Type aY0, const typename Pack::Type aZ0, const typename Pack::Type aX1, const typename Pack::Type aY1, const typename Pack::Type aZ1)
+{
+	return Pack::MulAdd(aZ0, aZ1, Pack::MulAdd(aY0, aY1, Pack::Mul(aX0, aX1)));
+}
+
+template<class Pack>
+void WriteHits(float* someDistances, uint64_t* someHitWords, const int anIndex, const typename Pack::Type aDistance, const unsigned int aMissMask)
+{
+	const unsigned int allLanes = static_cast<unsigned int>((1ull << Pack::ourWidth) - 1);
+	Pack::Store(someDistances + anIndex, aDistance);
+	someHitWords[anIndex / 64] |= static_cast<uint64_t>(~aMissMask & allLanes) << (anIndex % 64);
+}
+
+template<class Pack, bool isRayStream>
+void IntersectKernel(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::AABBArrays<float>& someAABBs, float* someDistances, uint64_t* someHitWords, const int aBegin, const int anEnd)
+{
+	typedef typename Pack::Type Type;
+	const float* const origins[3] = { someRays.myOriginX, someRays.myOriginY, someRays.myOriginZ };
+	const float* const directions[3] = { someRays.myDirectionX, someRays.myDirectionY, someRays.myDirectionZ };
+	const float* const mins[3] = { someAABBs.myMinX, someAABBs.myMinY, someAABBs.myMinZ };
+	const float* const maxs[3] = { someAABBs.myMaxX, someAABBs.myMaxY, someAABBs.myMaxZ };
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		Type nearest = Pack::Set(0.f);
+		Type farthest = Pack::Set(0.f);
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			const Type origin = Fetch<Pack, isRayStream>(origins[axis], index);
+			const Type inverse = Pack::Div(Pack::Set(1.f), Fetch<Pack, isRayStream>(directions[axis], index));
+			const Type entry = Pack::Mul(Pack::Sub(Fetch<Pack, !isRayStream>(mins[axis], index), origin), inverse);
+			const Type exit = Pack::Mul(Pack::Sub(Fetch<Pack, !isRayStream>(maxs[axis], index), origin), inverse);
+			const Type axisNear = Pack::Min(entry, exit);
+			const Type axisFar = Pack::Max(entry, exit);
+			nearest = axis == 0 ? axisNear : Pack::Max(axisNear, nearest);
+			farthest = axis == 0 ? axisFar : Pack::Min(axisFar, farthest);
+		}
+		const unsigned int miss = Pack::LessMask(farthest, nearest) | Pack::LessMask(farthest, Pack::Set(0.f));
+		WriteHits<Pack>(someDistances, someHitWords, index, Pack::Max(nearest, Pack::Set(0.f)), miss);
+	}
+}
+
+template<class Pack, bool isRayStream>
+void IntersectKernel(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::SphereArrays<float>& someSpheres, float* someDistances, uint64_t* someHitWords, const int aBegin, const int anEnd)
+{
+	typedef typename Pack::Type Type;
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		const Type directionX = Fetch<Pack, isRayStream>(someRays.myDirectionX, index);
+		const Type directionY = Fetch<Pack, isRayStream>(someRays.myDirectionY, index);
+		const Type directionZ = Fetch<Pack, isRayStream>(someRays.myDirectionZ, index);
+		const Type offsetX = Pack::Sub(Fetch<Pack, isRayStream>(someRays.myOriginX, index), Fetch<Pack, !isRayStream>(someSpheres.myCenterX, index));
+		const Type offsetY = Pack::Sub(Fetch<Pack, isRayStream>(someRays.myOriginY, index), Fetch<Pack, !isRayStream>(someSpheres.myCenterY, index));
+		const Type offsetZ = Pack::Sub(Fetch<Pack, isRayStream>(someRays.myOriginZ, index), Fetch<Pack, !isRayStream>(someSpheres.myCenterZ, index));
+		const Type radius = Fetch<Pack, !isRayStream>(someSpheres.myRadius, index);
+
+		const Type a = Dot<Pack>(directionX, directionY, directionZ, directionX, directionY, directionZ);
+		const Type b = Dot<Pack>(offsetX, offsetY, offsetZ, directionX, directionY, directionZ);
+		const Type c = Pack::Sub(Dot<Pack>(offsetX, offsetY, offsetZ, offsetX, offsetY, offsetZ), Pack::Mul(radius, radius));
+		const Type discriminant = Pack::Sub(Pack::Mul(b, b), Pack::Mul(a, c));
+		const Type root = Pack::Sqrt(discriminant);
+		const Type farthest = Pack::Div(Pack::Sub(root, b), a);
+		const Type nearest = Pack::Div(Pack::Sub(Pack::Set(0.f), Pack::Add(b, root)), a);
+		const unsigned int miss = Pack::LessMask(discriminant, Pack::Set(0.f)) | Pack::LessMask(farthest, Pack::Set(0.f));
+		WriteHits<Pack>(someDistances, someHitWords, index, Pack::Max(nearest, Pack::Set(0.f)), miss);
+	}
+}
+
+template<class Pack, bool isRayStream>
+void IntersectKernel(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::PlaneArrays<float>& somePlanes, float* someDistances, uint64_t* someHitWords, const int aBegin, const int anEnd)
+{
+	typedef typename Pack::Type Type;
+	const Type infinity = Pack::Set(std::numeric_limits<float>::infinity());
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		const Type normalX = Fetch<Pack, !isRayStream>(somePlanes.myNormalX, index);
+		const Type normalY = Fetch<Pack, !isRayStream>(somePlanes.myNormalY, index);
+		const Type normalZ = Fetch<Pack, !isRayStream>(somePlanes.myNormalZ, index);
+		const Type originDistance = Dot<Pack>(normalX, normalY, normalZ,
+			Fetch<Pack, isRayStream>(someRays.myOriginX, index), Fetch<Pack, isRayStream>(someRays.myOriginY, index), Fetch<Pack, isRayStream>(someRays.myOriginZ, index));
+		const Type approach = Dot<Pack>(normalX, normalY, normalZ,
+			Fetch<Pack, isRayStream>(someRays.myDirectionX, index), Fetch<Pack, isRayStream>(someRays.myDirectionY, index), Fetch<Pack, isRayStream>(someRays.myDirectionZ, index));
+		const Type distance = Pack::Div(Pack::Sub(Fetch<Pack, !isRayStream>(somePlanes.myOffset, index), originDistance), approach);
+		// NaN fails both compares, so it lands in the miss mask through the second
+		const unsigned int miss = Pack::LessMask(distance, Pack::Set(0.f)) | ~Pack::LessMask(distance, infinity);
+		WriteHits<Pack>(someDistances, someHitWords, index, distance, miss);
+	}
+}
+
+template<class Pack, bool isRayStream>
+void IntersectKernel(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::TriangleArrays<float>& someTriangles, float* someDistances, uint64_t* someHitWords, const int aBegin, const int anEnd)
+{
+	typedef typename Pack::Type Type;
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		const Type corner0X = Fetch<Pack, !isRayStream>(someTriangles.myCorner0X, index);
+		const Type corner0Y = Fetch<Pack, !isRayStream>(someTriangles.myCorner0Y, index);
+		const Type corner0Z = Fetch<Pack, !isRayStream>(someTriangles.myCorner0Z, index);
+		const Type edge0X = Pack::Sub(Fetch<Pack, !isRayStream>(someTriangles.myCorner1X, index), corner0X);
+		const Type edge0Y = Pack::Sub(Fetch<Pack, !isRayStream>(someTriangles.myCorner1Y, index), corner0Y);
+		const Type edge0Z = Pack::Sub(Fetch<Pack, !isRayStream>(someTriangles.myCorner1Z, index), corner0Z);
+		const Type edge1X = Pack::Sub(Fetch<Pack, !isRayStream>(someTriangles.myCorner2X, index), corner0X);
+		const Type edge1Y = Pack::Sub(Fetch<Pack, !isRayStream>(someTriangles.myCorner2Y, index), corner0Y);
+		const Type edge1Z = Pack::Sub(Fetch<Pack, !isRayStream>(someTriangles.myCorner2Z, index), corner0Z);
+		const Type directionX = Fetch<Pack, isRayStream>(someRays.myDirectionX, index);
+		const Type directionY = Fetch<Pack, isRayStream>(someRays.myDirectionY, index);
+		const Type directionZ = Fetch<Pack, isRayStream>(someRays.myDirectionZ, index);
+
+		// p = direction x edge1, written out like Vector3::Cross
+		const Type pX = Pack::Sub(Pack::Mul(directionY, edge1Z), Pack::Mul(directionZ, edge1Y));
+		const Type pY = Pack::Sub(Pack::Mul(directionZ, edge1X), Pack::Mul(directionX, edge1Z));
+		const Type pZ = Pack::Sub(Pack::Mul(directionX, edge1Y), Pack::Mul(directionY, edge1X));
+		const Type determinant = Dot<Pack>(edge0X, edge0Y, edge0Z, pX, pY, pZ);
+		const Type inverse = Pack::Div(Pack::Set(1.f), determinant);
+
+		const Type toOriginX = Pack::Sub(Fetch<Pack, isRayStream>(someRays.myOriginX, index), corner0X);
+		const Type toOriginY = Pack::Sub(Fetch<Pack, isRayStream>(someRays.myOriginY, index), corner0Y);
+		const Type toOriginZ = Pack::Sub(Fetch<Pack, isRayStream>(someRays.myOriginZ, index), corner0Z);
+		const Type u = Pack::Mul(Dot<Pack>(toOriginX, toOriginY, toOriginZ, pX, pY, pZ), inverse);
+
+		// q = toOrigin x edge0
+		const Type qX = Pack::Sub(Pack::Mul(toOriginY, edge0Z), Pack::Mul(toOriginZ, edge0Y));
+		const Type qY = Pack::Sub(Pack::Mul(toOriginZ, edge0X), Pack::Mul(toOriginX, edge0Z));
+		const Type qZ = Pack::Sub(Pack::Mul(toOriginX, edge0Y), Pack::Mul(toOriginY, edge0X));
+		const Type v = Pack::Mul(Dot<Pack>(directionX, directionY, directionZ, qX, qY, qZ), inverse);
+		const Type distance = Pack::Mul(Dot<Pack>(edge1X, edge1Y, edge1Z, qX, qY, qZ), inverse);
+
+		const Type zero = Pack::Set(0.f);
+		const unsigned int parallel = ~(Pack::LessMask(determinant, zero) | Pack::LessMask(zero, determinant));
+		const unsigned int outside = Pack::LessMask(u, zero) | Pack::LessMask(v, zero) | Pack::LessMask(Pack::Set(1.f), Pack::Add(u, v));
+		WriteHits<Pack>(someDistances, someHitWords, index, distance, parallel | outside | Pack::LessMask(distance, zero));
+	}
+}
+
+// Runs the wide kernel over whole packs and the scalar one over the rest
+template<class Shapes>
+void IntersectAll(const CU::IntersectionKernels::RayArrays<float>& someRays, const Shapes& someShapes, float* someDistances, uint64_t* someHitWords)
+{
+	// The side that isn't a single broadcast ray or shape sets the count, so an empty one writes nothing
+	const int count = someRays.myCount != 1 ? someRays.myCount : someShapes.myCount;
+	if (count == 0)
+	{
+		return;
+	}
+	const int packedEnd = count - count % WidePack::ourWidth;
+	memset(someHitWords, 0, sizeof(uint64_t) * ((count + 63) / 64));
+	if (someRays.myCount > 1)
+	{
+		IntersectKernel<WidePack, true>(someRays, someShapes, someDistances, someHitWords, 0, packedEnd);
+		IntersectKernel<CU::Simd::PackScalar, true>(someRays, someShapes, someDistances, someHitWords, packedEnd, count);
+	}
+	else
+	{
+		IntersectKernel<WidePack, false>(someRays, someShapes, someDistances, someHitWords, 0, packedEnd);
+		IntersectKernel<CU::Simd::PackScalar, false>(someRays, someShapes, someDistances, someHitWords, packedEnd, count);
+	}
+}
+
+void Intersect(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::AABBArrays<float>& someAABBs, float* someDistances, uint64_t* someHitWords)
+{
+	IntersectAll(someRays, someAABBs, someDistances, someHitWords);
+}
+
+void Intersect(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::SphereArrays<float>& someSpheres, float* someDistances, uint64_t* someHitWords)
+{
+	IntersectAll(someRays, someSpheres, someDistances, someHitWords);
+}
+
+void Intersect(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::PlaneArrays<float>& somePlanes, float* someDistances, uint64_t* someHitWords)
+{
+	IntersectAll(someRays, somePlanes, someDistances, someHitWords);
+}
+
+void Intersect(const CU::IntersectionKernels::RayArrays<float>& someRays, const CU::IntersectionKernels::TriangleArrays<float>& someTriangles, float* someDistances, uint64_t* someHitWords)
+{
+	IntersectAll(someRays, someTriangles, someDistances, someHitWords);
+}
@@ -3,6 +3,9 @@
 
 namespace CommonUtilities
 {
+	// A line through myPoint along myDirection. The normal is the direction turned a quarter, (-y, x),
+	// and is kept with its offset, so Inside is one dot product and a compare.
+	// The normal isn't unit length until Normalize is called, which keeps Line<int> exact.
 	template <class T>
 	class Line
 	{
@@ -10,42 +13,94 @@ namespace CommonUtilities
 		Line();
 		Line(const Vector2<T>& aPoint, const Vector2<T>& aPoint1);
 		void InitWith2Points(const Vector2<T>& aPoint, const Vector2<T>& aPoint1);
+		void InitWithPointAndDirection(const Vector2<T>& aPoint, const Vector2<T>& aDirection);
+		// True if aPosition is on the side opposite the normal
 		bool Inside(const Vector2<T>& aPosition) const;
+		// Signed distance along the normal, only a true distance after Normalize
+		T GetDistance(const Vector2<T>& aPosition) const;
+		// Makes the direction and normal unit length
 		void Normalize();
 
+		const Vector2<T>& GetPoint() const;
+		const Vector2<T>& GetDirection() const;
+		const Vector2<T>& GetNormal() const;
+		// The normal dotted with any point on the line
+		T GetOffset() const;
+
 	private:
 		Vector2<T> myPoint;
 		Vector2<T> myDirection;
+		Vector2<T> myNormal;
+		T myOffset;
 	};
 
 	template <class T>
-	inline Line<T>::Line()
+	inline Line<T>::Line() : myOffset(0)
 	{
-		
 	}
 
 	template<class T>
 	inline Line<T>::Line(const Vector2<T>& aPoint, const Vector2<T>& aPoint1)
 	{
-		myDirection = aPoint1 - aPoint;
-		myPoint = aPoint1;
+		InitWith2Points(aPoint, aPoint1);
 	}
 
 	template<class T>
 	inline void Line<T>::InitWith2Points(const Vector2<T>& aPoint, const Vector2<T>& aPoint1)
 	{
+		InitWithPointAndDirection(aPoint, aPoint1 - aPoint);
+	}
 
+	template<class T>
+	inline void Line<T>::InitWithPointAndDirection(const Vector2<T>& aPoint, const Vector2<T>& aDirection)
+	{
+		myPoint = aPoint;
+		myDirection = aDirection;
+		myNormal = Vector2<T>(-aDirection.y, aDirection.x);
+		myOffset = myNormal.Dot(myPoint);
 	}
 
 	template<class T>
 	inline bool Line<T>::Inside(const Vector2<T>& aPosition) const
 	{
-		return false;
+		return myNormal.Dot(aPosition) < myOffset;
+	}
+
+	template<class T>
+	inline T Line<T>::GetDistance(const Vector2<T>& aPosition) const
+	{
+		return myNormal.Dot(aPosition) - myOffset;
 	}
 
 	template<class T>
 	inline void Line<T>::Normalize()
 	{
+		myDirection.Normalize();
+		myNormal = Vector2<T>(-myDirection.y, myDirection.x);
+		myOffset = myNormal.Dot(myPoint);
+	}
 
+	template<class T>
+	inline const Vector2<T>& Line<T>::GetPoint() const
+	{
+		return myPoint;
+	}
+
+	template<class T>
+	inline const Vector2<T>& Line<T>::GetDirection() const
+	{
+		return myDirection;
+	}
+
+	template<class T>
+	inline const Vector2<T>& Line<T>::GetNormal() const
+	{
+		return myNormal;
+	}
+
+	template<class T>
+	inline T Line<T>::GetOffset() const
+	{
+		return myOffset;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,49 @@
+#include "LineVolume.hpp"
+#include "SimdLevel.hpp"
+#include "SimdPack.hpp"
+
+namespace CU = CommonUtilities;
+
+namespace
+{
+	namespace Scalar
+	{
+		typedef CU::Simd::PackScalar WidePack;
+#include "LineVolumeKernels.inl"
+	}
+
+#ifdef CU_SIMD_SSE
+	namespace Sse
+	{
+		typedef CU::Simd::PackSSE WidePack;
+#include "LineVolumeKernels.inl"
+	}
+
+CU_SIMD_AVX2_BEGIN
+	namespace Avx2
+	{
+		typedef CU::Simd::PackAVX2 WidePack;
+#include "LineVolumeKernels.inl"
+	}
+CU_SIMD_AVX2_END
+
+CU_SIMD_AVX512_BEGIN
+	namespace Avx512
+	{
+		typedef CU::Simd::PackAVX512 WidePack;
+#include "LineVolumeKernels.inl"
+	}
+CU_SIMD_AVX512_END
+#endif
+}
+
+namespace CommonUtilities
+{
+	namespace LineVolumeKernels
+	{
+		void Inside(const float* someNormalsX, const float* someNormalsY, const float* someOffsets, const int aLineCount, const float* somePointsXY, const int aPointCount, uint64_t* someMaskWords)
+		{
+			CU_SIMD_DISPATCH(Inside(someNormalsX, someNormalsY, someOffsets, aLineCount, somePointsXY, aPointCount, someMaskWords));
+		}
+	}
+}
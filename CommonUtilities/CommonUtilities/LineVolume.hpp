@@ -1 +1,164 @@
 #pragma once
+#include <assert.h>
+#include <cstdint>
+#include <initializer_list>
+#include <string.h>
+#include <vector>
+#include "BitsetKernels.hpp"
+#include "GrowingArray.hpp"
+#include "Line.hpp"
+
+namespace CommonUtilities
+{
+	// Tests packed xy points against lines given as separate normal x, normal y and offset arrays.
+	// Bit n of someMaskWords is set if point n is inside every line; (aPointCount + 63) / 64 words are written.
+	// The template is the scalar reference, the float overload is a SIMD kernel chosen at runtime (SimdLevel.hpp).
+	namespace LineVolumeKernels
+	{
+		template<class T>
+		void Inside(const T* someNormalsX, const T* someNormalsY, const T* someOffsets, const int aLineCount, const T* somePointsXY, const int aPointCount, uint64_t* someMaskWords)
+		{
+			memset(someMaskWords, 0, sizeof(uint64_t) * ((aPointCount + 63) / 64));
+			for (int point = 0; point < aPointCount; ++point)
+			{
+				const T x = somePointsXY[point * 2];
+				const T y = somePointsXY[point * 2 + 1];
+				bool inside = true;
+				for (int line = 0; line < aLineCount && inside; ++line)
+				{
+					inside = someNormalsX[line] * x + someNormalsY[line] * y < someOffsets[line];
+				}
+				if (inside)
+				{
+					someMaskWords[point / 64] |= 1ull << (point % 64);
+				}
+			}
+		}
+
+		void Inside(const float* someNormalsX, const float* someNormalsY, const float* someOffsets, const int aLineCount, const float* somePointsXY, const int aPointCount, uint64_t* someMaskWords);
+	}
+
+	// Convex area bounded by lines, a point is inside if it is inside all of them. Lines made from a
+	// clockwise loop of points (with y up) have their normals pointing out.
+	// The normals and offsets are also kept as separate arrays so a whole span of points can be
+	// tested in one call, several points per SIMD register.
+	template <class T>
+	class LineVolume
+	{
+	public:
+		LineVolume();
+		LineVolume(const std::vector<Line<T>>& aLineList);
+		LineVolume(const std::initializer_list<Line<T>>& aLineList);
+
+		void AddLine(const Line<T>& aLine);
+		void RemoveAll();
+		int GetLineCount() const;
+		const Line<T>& GetLine(const int anIndex) const;
+
+		bool Inside(const Vector2<T>& aPosition) const;
+		// Sets bit n of someMaskWords if somePositions[n] is inside, writing (aCount + 63) / 64 words.
+		// DynamicBitset::GetWords can be passed straight in.
+		void Inside(const Vector2<T>* somePositions, const int aCount, uint64_t* someMaskWords) const;
+		// Adds the indices of the positions that are inside to someIndices, lowest first
+		void Inside(const Vector2<T>* somePositions, const int aCount, GrowingArray<int>& someIndices) const;
+
+	private:
+		static_assert(sizeof(Vector2<T>) == sizeof(T) * 2, "Vector2 must be two packed T for the batch kernels!");
+
+		GrowingArray<Line<T>> myLines;
+		GrowingArray<T> myNormalsX;
+		GrowingArray<T> myNormalsY;
+		GrowingArray<T> myOffsets;
+	};
+
+	template<class T>
+	inline LineVolume<T>::LineVolume()
+	{
+	}
+
+	template<class T>
+	inline LineVolume<T>::LineVolume(const std::vector<Line<T>>& aLineList)
+	{
+		for (const Line<T>& line : aLineList)
+		{
+			AddLine(line);
+		}
+	}
+
+	template<class T>
+	inline LineVolume<T>::LineVolume(const std::initializer_list<Line<T>>& aLineList)
+	{
+		for (const Line<T>& line : aLineList)
+		{
+			AddLine(line);
+		}
+	}
+
+	template<class T>
+	inline void LineVolume<T>::AddLine(const Line<T>& aLine)
+	{
+		myLines.Add(aLine);
+		myNormalsX.Add(aLine.GetNormal().x);
+		myNormalsY.Add(aLine.GetNormal().y);
+		myOffsets.Add(aLine.GetOffset());
+	}
+
+	template<class T>
+	inline void LineVolume<T>::RemoveAll()
+	{
+		myLines.RemoveAll();
+		myNormalsX.RemoveAll();
+		myNormalsY.RemoveAll();
+		myOffsets.RemoveAll();
+	}
+
+	template<class T>
+	inline int LineVolume<T>::GetLineCount() const
+	{
+		return myLines.Size();
+	}
+
+	template<class T>
+	inline const Line<T>& LineVolume<T>::GetLine(const int anIndex) const
+	{
+		return myLines[anIndex];
+	}
+
+	template<class T>
+	inline bool LineVolume<T>::Inside(const Vector2<T>& aPosition) const
+	{
+		for (const Line<T>& line : myLines)
+		{
+			if (!line.Inside(aPosition))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class T>
+	inline void LineVolume<T>::Inside(const Vector2<T>* somePositions, const int aCount, uint64_t* someMaskWords) const
+	{
+		assert(aCount >= 0 && "Count can't be negative!");
+		LineVolumeKernels::Inside(myNormalsX.GetData(), myNormalsY.GetData(), myOffsets.GetData(), myLines.Size(), reinterpret_cast<const T*>(somePositions), aCount, someMaskWords);
+	}
+
+	template<class T>
+	inline void LineVolume<T>::Inside(const Vector2<T>* somePositions, const int aCount, GrowingArray<int>& someIndices) const
+	{
+		assert(aCount >= 0 && "Count can't be negative!");
+		// Blocks small enough for their mask to stay on the stack
+		const int blockSize = 4096;
+		uint64_t maskWords[blockSize / 64];
+		for (int begin = 0; begin < aCount; begin += blockSize)
+		{
+			const int count = aCount - begin < blockSize ? aCount - begin : blockSize;
+			Inside(somePositions + begin, count, maskWords);
+			for (const int index : SetBitRange(maskWords, (count + 63) / 64))
+			{
+				someIndices.Add(begin + index);
+			}
+		}
+	}
+}
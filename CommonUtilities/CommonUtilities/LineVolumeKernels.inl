@@ -0,0 +1,31 @@
+// LineVolume kernels written once over a Pack (SimdPack.hpp).
+// Included by LineVolume.cpp once per instruction set, inside a namespace that defines WidePack.
+// The kernel runs points [aBegin, anEnd) where the range is a multiple of Pack::ourWidth, and every
+// width divides 64 so a pack's mask never straddles two words.
+
+template<class Pack>
+void InsideKernel(const float* someNormalsX, const float* someNormalsY, const float* someOffsets, const int aLineCount, const float* somePointsXY, uint64_t* someMaskWords, const int aBegin, const int anEnd)
+{
+	const unsigned int allLanes = static_cast<unsigned int>((1ull << Pack::ourWidth) - 1);
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		typename Pack::Type x, y;
+		Pack::LoadXY(somePointsXY + index * 2, x, y);
+		unsigned int inside = allLanes;
+		// Stops at the first line every point in the pack is outside of
+		for (int line = 0; line < aLineCount && inside != 0; ++line)
+		{
+			const typename Pack::Type distance = Pack::MulAdd(y, Pack::Set(someNormalsY[line]), Pack::Mul(x, Pack::Set(someNormalsX[line])));
+			inside &= Pack::LessMask(distance, Pack::Set(someOffsets[line]));
+		}
+		someMaskWords[index / 64] |= static_cast<uint64_t>(inside) << (index % 64);
+	}
+}
+
+void Inside(const float* someNormalsX, const float* someNormalsY, const float* someOffsets, const int aLineCount, const float* somePointsXY, const int aPointCount, uint64_t* someMaskWords)
+{
+	memset(someMaskWords, 0, sizeof(uint64_t) * ((aPointCount + 63) / 64));
+	const int packedEnd = aPointCount - aPointCount % WidePack::ourWidth;
+	InsideKernel<WidePack>(someNormalsX, someNormalsY, someOffsets, aLineCount, somePointsXY, someMaskWords, 0, packedEnd);
+	InsideKernel<CU::Simd::PackScalar>(someNormalsX, someNormalsY, someOffsets, aLineCount, somePointsXY, someMaskWords, packedEnd, aPointCount);
+}
@@ -1,5 +1,7 @@
 #pragma once
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <cassert>
 #define MAX(a, b) ((a) > (b)) ? (a) : (b);
 
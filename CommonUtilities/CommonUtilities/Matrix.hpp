@@ -0,0 +1,336 @@
+#pragma once
+#include <array>
+#include <assert.h>
+#include <type_traits>
+#include <utility>
+#include "Simd.hpp"
+
+namespace CommonUtilities
+{
+	enum class MatrixLayout
+	{
+		RowMajor,
+		ColumnMajor
+	};
+
+	// Fixed size matrix, the common base of Matrix3x3 and Matrix4x4. Elements are addressed (row, column)
+	// counted from 1 whatever the storage layout. Every operation is constexpr and expanded over the
+	// elements through index sequences, so there are no runtime loops left to unroll and constant
+	// matrices can be built by the compiler.
+	template<class T, int Rows, int Columns, MatrixLayout Layout = MatrixLayout::RowMajor>
+	class Matrix
+	{
+	public:
+		typedef T ValueType;
+		static const int ourRows = Rows;
+		static const int ourColumns = Columns;
+		static const MatrixLayout ourLayout = Layout;
+
+		// Creates the identity matrix, ones on the diagonal for non-square sizes
+		constexpr Matrix();
+
+		// Elements in reading order, row by row, whatever the storage layout
+		template<class... Elements, class = typename std::enable_if<sizeof...(Elements) == Rows * Columns>::type>
+		constexpr Matrix(const Elements... anElements);
+
+		static constexpr Matrix Identity();
+
+		T& operator()(const int aRow, const int aColumn);
+		constexpr const T& operator()(const int aRow, const int aColumn) const;
+
+		// Element (Row, Column) with the indices checked at compile time
+		template<int Row, int Column>
+		T& Get();
+		template<int Row, int Column>
+		constexpr const T& Get() const;
+
+		// Elements in storage order, rows of Columns elements for RowMajor and columns of Rows elements for ColumnMajor
+		T* GetData();
+		constexpr const T* GetData() const;
+
+		constexpr Matrix<T, Columns, Rows, Layout> GetTransposed() const;
+
+		static constexpr Matrix Add(const Matrix& aLeftMatrix, const Matrix& aRightMatrix);
+		static constexpr Matrix Subtract(const Matrix& aLeftMatrix, const Matrix& aRightMatrix);
+		static constexpr Matrix Scale(const Matrix& aMatrix, const T& aScalar);
+		static constexpr bool Equal(const Matrix& aLeftMatrix, const Matrix& aRightMatrix);
+
+		template<int OtherColumns>
+		static constexpr Matrix<T, Rows, OtherColumns, Layout> Multiply(const Matrix& aLeftMatrix, const Matrix<T, Columns, OtherColumns, Layout>& aRightMatrix);
+
+		// Position of element (aRow, aColumn), counted from 0, in GetData()
+		static constexpr int StorageIndex(const int aRow, const int aColumn);
+
+	private:
+		template<class, int, int, MatrixLayout>
+		friend class Matrix;
+
+		typedef std::make_index_sequence<Rows * Columns> ElementSequence;
+		struct IdentityTag {};
+		struct StorageOrderTag {};
+
+		template<size_t... Indices>
+		constexpr Matrix(IdentityTag, std::index_sequence<Indices...>);
+		template<size_t... Indices>
+		constexpr Matrix(const std::array<T, Rows * Columns>& aReadingOrder, std::index_sequence<Indices...>);
+		template<class... Elements>
+		constexpr Matrix(StorageOrderTag, const Elements... anElements);
+
+		static constexpr int RowOf(const int aStorageIndex);
+		static constexpr int ColumnOf(const int aStorageIndex);
+
+		static constexpr T Sum(const T& aValue);
+		template<class... Values>
+		static constexpr T Sum(const T& aValue, const Values&... aValues);
+
+		template<size_t... Indices>
+		constexpr Matrix<T, Columns, Rows, Layout> GetTransposed(std::index_sequence<Indices...>) const;
+		template<size_t... Indices>
+		static constexpr Matrix Add(const Matrix& aLeftMatrix, const Matrix& aRightMatrix, std::index_sequence<Indices...>);
+		template<size_t... Indices>
+		static constexpr Matrix Subtract(const Matrix& aLeftMatrix, const Matrix& aRightMatrix, std::index_sequence<Indices...>);
+		template<size_t... Indices>
+		static constexpr Matrix Scale(const Matrix& aMatrix, const T& aScalar, std::index_sequence<Indices...>);
+		template<int OtherColumns, size_t... Indices>
+		static constexpr Matrix<T, Rows, OtherColumns, Layout> Multiply(const Matrix& aLeftMatrix, const Matrix<T, Columns, OtherColumns, Layout>& aRightMatrix, std::index_sequence<Indices...>);
+		template<int OtherColumns, size_t... Indices>
+		static constexpr T RowTimesColumn(const Matrix& aLeftMatrix, const Matrix<T, Columns, OtherColumns, Layout>& aRightMatrix, const int aRow, const int aColumn, std::index_sequence<Indices...>);
+
+		alignas(SimdAlignment<T, Layout == MatrixLayout::RowMajor ? Columns : Rows>::value) T myElements[Rows * Columns];
+	};
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout>::Matrix() : Matrix(IdentityTag(), ElementSequence())
+	{
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<class... Elements, class>
+	inline constexpr Matrix<T, Rows, Columns, Layout>::Matrix(const Elements... anElements) : Matrix(std::array<T, Rows * Columns>{ { static_cast<T>(anElements)... } }, ElementSequence())
+	{
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<size_t... Indices>
+	inline constexpr Matrix<T, Rows, Columns, Layout>::Matrix(IdentityTag, std::index_sequence<Indices...>)
+		: myElements{ (RowOf(Indices) == ColumnOf(Indices) ? T(1) : T(0))... }
+	{
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<size_t... Indices>
+	inline constexpr Matrix<T, Rows, Columns, Layout>::Matrix(const std::array<T, Rows * Columns>& aReadingOrder, std::index_sequence<Indices...>)
+		: myElements{ aReadingOrder[RowOf(Indices) * Columns + ColumnOf(Indices)]... }
+	{
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<class... Elements>
+	inline constexpr Matrix<T, Rows, Columns, Layout>::Matrix(StorageOrderTag, const Elements... anElements) : myElements{ anElements... }
+	{
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> Matrix<T, Rows, Columns, Layout>::Identity()
+	{
+		return Matrix();
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline T& Matrix<T, Rows, Columns, Layout>::operator()(const int aRow, const int aColumn)
+	{
+		assert(aRow >= 1 && aRow <= Rows && aColumn >= 1 && aColumn <= Columns && "Index out of range!");
+		return myElements[StorageIndex(aRow - 1, aColumn - 1)];
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr const T& Matrix<T, Rows, Columns, Layout>::operator()(const int aRow, const int aColumn) const
+	{
+		assert(aRow >= 1 && aRow <= Rows && aColumn >= 1 && aColumn <= Columns && "Index out of range!");
+		return myElements[StorageIndex(aRow - 1, aColumn - 1)];
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<int Row, int Column>
+	inline T& Matrix<T, Rows, Columns, Layout>::Get()
+	{
+		static_assert(Row >= 1 && Row <= Rows && Column >= 1 && Column <= Columns, "Index out of range!");
+		return myElements[StorageIndex(Row - 1, Column - 1)];
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<int Row, int Column>
+	inline constexpr const T& Matrix<T, Rows, Columns, Layout>::Get() const
+	{
+		static_assert(Row >= 1 && Row <= Rows && Column >= 1 && Column <= Columns, "Index out of range!");
+		return myElements[StorageIndex(Row - 1, Column - 1)];
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline T* Matrix<T, Rows, Columns, Layout>::GetData()
+	{
+		return myElements;
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr const T* Matrix<T, Rows, Columns, Layout>::GetData() const
+	{
+		return myElements;
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Columns, Rows, Layout> Matrix<T, Rows, Columns, Layout>::GetTransposed() const
+	{
+		return GetTransposed(ElementSequence());
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> Matrix<T, Rows, Columns, Layout>::Add(const Matrix& aLeftMatrix, const Matrix& aRightMatrix)
+	{
+		return Add(aLeftMatrix, aRightMatrix, ElementSequence());
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> Matrix<T, Rows, Columns, Layout>::Subtract(const Matrix& aLeftMatrix, const Matrix& aRightMatrix)
+	{
+		return Subtract(aLeftMatrix, aRightMatrix, ElementSequence());
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> Matrix<T, Rows, Columns, Layout>::Scale(const Matrix& aMatrix, const T& aScalar)
+	{
+		return Scale(aMatrix, aScalar, ElementSequence());
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr bool Matrix<T, Rows, Columns, Layout>::Equal(const Matrix& aLeftMatrix, const Matrix& aRightMatrix)
+	{
+		for (int index = 0; index < Rows * Columns; ++index)
+		{
+			if (aLeftMatrix.myElements[index] != aRightMatrix.myElements[index])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<int OtherColumns>
+	inline constexpr Matrix<T, Rows, OtherColumns, Layout> Matrix<T, Rows, Columns, Layout>::Multiply(const Matrix& aLeftMatrix, const Matrix<T, Columns, OtherColumns, Layout>& aRightMatrix)
+	{
+		return Multiply(aLeftMatrix, aRightMatrix, std::make_index_sequence<Rows * OtherColumns>());
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr int Matrix<T, Rows, Columns, Layout>::StorageIndex(const int aRow, const int aColumn)
+	{
+		return Layout == MatrixLayout::RowMajor ? aRow * Columns + aColumn : aColumn * Rows + aRow;
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr int Matrix<T, Rows, Columns, Layout>::RowOf(const int aStorageIndex)
+	{
+		return Layout == MatrixLayout::RowMajor ? aStorageIndex / Columns : aStorageIndex % Rows;
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr int Matrix<T, Rows, Columns, Layout>::ColumnOf(const int aStorageIndex)
+	{
+		return Layout == MatrixLayout::RowMajor ? aStorageIndex % Columns : aStorageIndex / Rows;
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr T Matrix<T, Rows, Columns, Layout>::Sum(const T& aValue)
+	{
+		return aValue;
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<class... Values>
+	inline constexpr T Matrix<T, Rows, Columns, Layout>::Sum(const T& aValue, const Values&... aValues)
+	{
+		return aValue + Sum(aValues...);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<size_t... Indices>
+	inline constexpr Matrix<T, Columns, Rows, Layout> Matrix<T, Rows, Columns, Layout>::GetTransposed(std::index_sequence<Indices...>) const
+	{
+		typedef Matrix<T, Columns, Rows, Layout> Transposed;
+		return Transposed(typename Transposed::StorageOrderTag(), myElements[StorageIndex(Transposed::ColumnOf(Indices), Transposed::RowOf(Indices))]...);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<size_t... Indices>
+	inline constexpr Matrix<T, Rows, Columns, Layout> Matrix<T, Rows, Columns, Layout>::Add(const Matrix& aLeftMatrix, const Matrix& aRightMatrix, std::index_sequence<Indices...>)
+	{
+		return Matrix(StorageOrderTag(), (aLeftMatrix.myElements[Indices] + aRightMatrix.myElements[Indices])...);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<size_t... Indices>
+	inline constexpr Matrix<T, Rows, Columns, Layout> Matrix<T, Rows, Columns, Layout>::Subtract(const Matrix& aLeftMatrix, const Matrix& aRightMatrix, std::index_sequence<Indices...>)
+	{
+		return Matrix(StorageOrderTag(), (aLeftMatrix.myElements[Indices] - aRightMatrix.myElements[Indices])...);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<size_t... Indices>
+	inline constexpr Matrix<T, Rows, Columns, Layout> Matrix<T, Rows, Columns, Layout>::Scale(const Matrix& aMatrix, const T& aScalar, std::index_sequence<Indices...>)
+	{
+		return Matrix(StorageOrderTag(), (aScalar * aMatrix.myElements[Indices])...);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<int OtherColumns, size_t... Indices>
+	inline constexpr Matrix<T, Rows, OtherColumns, Layout> Matrix<T, Rows, Columns, Layout>::Multiply(const Matrix& aLeftMatrix, const Matrix<T, Columns, OtherColumns, Layout>& aRightMatrix, std::index_sequence<Indices...>)
+	{
+		typedef Matrix<T, Rows, OtherColumns, Layout> Product;
+		return Product(typename Product::StorageOrderTag(),
+			RowTimesColumn(aLeftMatrix, aRightMatrix, Product::RowOf(Indices), Product::ColumnOf(Indices), std::make_index_sequence<Columns>())...);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	template<int OtherColumns, size_t... Indices>
+	inline constexpr T Matrix<T, Rows, Columns, Layout>::RowTimesColumn(const Matrix& aLeftMatrix, const Matrix<T, Columns, OtherColumns, Layout>& aRightMatrix, const int aRow, const int aColumn, std::index_sequence<Indices...>)
+	{
+		return Sum((aLeftMatrix.myElements[StorageIndex(aRow, Indices)] * aRightMatrix.myElements[Matrix<T, Columns, OtherColumns, Layout>::StorageIndex(Indices, aColumn)])...);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> operator+(const Matrix<T, Rows, Columns, Layout>& aLeftMatrix, const Matrix<T, Rows, Columns, Layout>& aRightMatrix)
+	{
+		return Matrix<T, Rows, Columns, Layout>::Add(aLeftMatrix, aRightMatrix);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> operator-(const Matrix<T, Rows, Columns, Layout>& aLeftMatrix, const Matrix<T, Rows, Columns, Layout>& aRightMatrix)
+	{
+		return Matrix<T, Rows, Columns, Layout>::Subtract(aLeftMatrix, aRightMatrix);
+	}
+
+	template<class T, int Rows, int Inner, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> operator*(const Matrix<T, Rows, Inner, Layout>& aLeftMatrix, const Matrix<T, Inner, Columns, Layout>& aRightMatrix)
+	{
+		return Matrix<T, Rows, Inner, Layout>::Multiply(aLeftMatrix, aRightMatrix);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr Matrix<T, Rows, Columns, Layout> operator*(const T& aScalar, const Matrix<T, Rows, Columns, Layout>& aMatrix)
+	{
+		return Matrix<T, Rows, Columns, Layout>::Scale(aMatrix, aScalar);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr bool operator==(const Matrix<T, Rows, Columns, Layout>& aLeftMatrix, const Matrix<T, Rows, Columns, Layout>& aRightMatrix)
+	{
+		return Matrix<T, Rows, Columns, Layout>::Equal(aLeftMatrix, aRightMatrix);
+	}
+
+	template<class T, int Rows, int Columns, MatrixLayout Layout>
+	inline constexpr bool operator!=(const Matrix<T, Rows, Columns, Layout>& aLeftMatrix, const Matrix<T, Rows, Columns, Layout>& aRightMatrix)
+	{
+		return !Matrix<T, Rows, Columns, Layout>::Equal(aLeftMatrix, aRightMatrix);
+	}
+}
@@ -1,28 +1,29 @@
 #pragma once
-#include <array>
+#include <assert.h>
+#include "Matrix.hpp"
 #include "Vector3.hpp"
 #include "Matrix4x4.hpp"
 
 namespace CommonUtilities
 {
+	// Row-major 3x3 matrix on top of Matrix<T, 3, 3>, see Matrix4x4
 	template<class T>
-	class Matrix3x3
+	class Matrix3x3 : public Matrix<T, 3, 3>
 	{
 	public:
 		// Creates the identity matrix
-		Matrix3x3<T>();
+		constexpr Matrix3x3<T>();
 
 		// Copy Constructor
-		Matrix3x3<T>(const Matrix3x3<T>& aMatrix);
+		constexpr Matrix3x3<T>(const Matrix3x3<T>& aMatrix) = default;
 
-		Matrix3x3<T>(const T aXX, const T aXY, const T aXZ, const T aYX, const T aYY, const T aYZ, const T aZX, const T aZY, const T aZZ);
+		constexpr Matrix3x3<T>(const T aXX, const T aXY, const T aXZ, const T aYX, const T aYY, const T aYZ, const T aZX, const T aZY, const T aZZ);
 
-		// Copies top left3x3 part of the Matrix4x4
-		Matrix3x3<T>(const Matrix4x4<T>& aMatrix);
+		// Wraps the result of the generic Matrix operations
+		constexpr Matrix3x3<T>(const Matrix<T, 3, 3>& aMatrix);
 
-		// () operator for accessing element (row, column) for read/write or read, respectively
-		T& operator()(const T row, const T column);
-		const T& operator()(const T row, const T column) const;
+		// Copies top left3x3 part of the Matrix4x4
+		constexpr Matrix3x3<T>(const Matrix4x4<T>& aMatrix);
 
 		// Static functions for creating rotation matrices
 		static Matrix3x3<T> CreateRotationAroundX(T anAngleInRadians);
@@ -32,68 +33,35 @@ namespace CommonUtilities
 		// Static function for creating a transpose of a matrix
 		static Matrix3x3<T> Transpose(const Matrix3x3<T>& aMatrixToTranspose);
 
-		Matrix3x3<T> operator=(const Matrix3x3<T> & aRightMatrix);
-		bool operator==(const Matrix3x3<T> & aRightMatrix) const;
+		// Static function for creating an inverse of an invertible matrix
+		static Matrix3x3<T> Inverse(const Matrix3x3<T>& aMatrixToInverse);
 
-	private:
-		std::array<std::array<T, 3>, 3> myContainer;
+		Matrix3x3<T>& operator=(const Matrix3x3<T> & aRightMatrix) = default;
+		constexpr bool operator==(const Matrix3x3<T> & aRightMatrix) const;
 	};
 
 	template<class T>
-	inline Matrix3x3<T>::Matrix3x3()
+	inline constexpr Matrix3x3<T>::Matrix3x3() : Matrix<T, 3, 3>()
 	{
-		for (int row = 0; row < myContainer.size(); row++)
-		{
-			for (int column = 0; column < myContainer.size(); column++)
-			{
-				myContainer[row][column] = 0;
-			}
-		}
-
-		for (int index = 0; index < myContainer.size(); index++)
-		{
-			myContainer[index][index] = 1;
-		}
 	}
 
 	template<class T>
-	inline Matrix3x3<T>::Matrix3x3(const Matrix3x3<T>& aMatrix)
+	inline constexpr Matrix3x3<T>::Matrix3x3(const T aXX, const T aXY, const T aXZ, const T aYX, const T aYY, const T aYZ, const T aZX, const T aZY, const T aZZ)
+		: Matrix<T, 3, 3>(aXX, aXY, aXZ, aYX, aYY, aYZ, aZX, aZY, aZZ)
 	{
-		myContainer = aMatrix.myContainer;
-	}
-
-	template<class T>
-	inline Matrix3x3<T>::Matrix3x3(const T aXX, const T aXY, const T aXZ, const T aYX, const T aYY, const T aYZ, const T aZX, const T aZY, const T aZZ)
-	{
-		myContainer[0][0] = aXX;
-		myContainer[0][1] = aXY;
-		myContainer[0][2] = aXZ;
-
-		myContainer[1][0] = aYX;
-		myContainer[1][1] = aYY;
-		myContainer[1][2] = aYZ;
-
-		myContainer[2][0] = aZX;
-		myContainer[2][1] = aZY;
-		myContainer[2][2] = aZZ;
 	}
 
 	template<class T>
-	inline Matrix3x3<T>::Matrix3x3(const Matrix4x4<T>& aMatrix)
+	inline constexpr Matrix3x3<T>::Matrix3x3(const Matrix<T, 3, 3>& aMatrix) : Matrix<T, 3, 3>(aMatrix)
 	{
-		for (int row = 0; row < myContainer.size(); row++)
-		{
-			for (int column = 0; column < myContainer.size(); column++)
-			{
-				myContainer[row][column] = aMatrix(row + 1, column +  1);
-			}
-		}
 	}
 
 	template<class T>
-	inline const T & Matrix3x3<T>::operator()(const T row, const T column) const
+	inline constexpr Matrix3x3<T>::Matrix3x3(const Matrix4x4<T>& aMatrix)
+		: Matrix<T, 3, 3>(aMatrix(1, 1), aMatrix(1, 2), aMatrix(1, 3),
+						  aMatrix(2, 1), aMatrix(2, 2), aMatrix(2, 3),
+						  aMatrix(3, 1), aMatrix(3, 2), aMatrix(3, 3))
 	{
-		return myContainer[row - 1][column - 1];
 	}
 
 	template<class T>
@@ -121,85 +89,58 @@ namespace CommonUtilities
 	}
 
 	template<class T>
-	inline T & Matrix3x3<T>::operator()(const T row, const T column)
+	inline Matrix3x3<T> Matrix3x3<T>::Transpose(const Matrix3x3<T>& aMatrixToTranspose)
 	{
-		return myContainer[row - 1][column - 1];
+		return Matrix3x3<T>(aMatrixToTranspose.GetTransposed());
 	}
 
 	template<class T>
-	inline Matrix3x3<T> Matrix3x3<T>::Transpose(const Matrix3x3<T>& aMatrixToTranspose)
+	inline Matrix3x3<T> Matrix3x3<T>::Inverse(const Matrix3x3<T>& aMatrixToInverse)
 	{
-		Matrix3x3<T> transposedMatrix = Matrix3x3<T>();
+		const T (*m)[3] = reinterpret_cast<const T (*)[3]>(aMatrixToInverse.GetData());
 
-		for (int row = 0; row < 3; row++)
-		{
-			for (int column = 0; column < 3; column++)
-			{
-				transposedMatrix.myContainer[row][column] = aMatrixToTranspose.myContainer[column][row];
-			}
-		}
-		return transposedMatrix;
-	}
+		// Adjugate divided by the determinant
+		const T a00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+		const T a01 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+		const T a02 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+		const T a10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+		const T a11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+		const T a12 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+		const T a20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+		const T a21 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+		const T a22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
 
-	template<class T>
-	inline Matrix3x3<T> Matrix3x3<T>::operator=(const Matrix3x3<T>& aRightMatrix)
-	{
-		return Matrix3x3<T>(myContainer[0][0] = aRightMatrix(1,1),
-			myContainer[1][0] = aRightMatrix(2,1),
-			myContainer[2][0] = aRightMatrix(3,1),
-			myContainer[0][1] = aRightMatrix(1,2),
-			myContainer[1][1] = aRightMatrix(2,2),
-			myContainer[2][1] = aRightMatrix(3,2),
-			myContainer[0][2] = aRightMatrix(1,3),
-			myContainer[1][2] = aRightMatrix(2,3),
-			myContainer[2][2] = aRightMatrix(3,3));
+		const T determinant = m[0][0] * a00 + m[0][1] * a10 + m[0][2] * a20;
+		assert(determinant != 0 && "Matrix can't be inverted!");
+		const T inverseDeterminant = 1 / determinant;
+
+		return Matrix3x3<T>(a00 * inverseDeterminant, a01 * inverseDeterminant, a02 * inverseDeterminant,
+							a10 * inverseDeterminant, a11 * inverseDeterminant, a12 * inverseDeterminant,
+							a20 * inverseDeterminant, a21 * inverseDeterminant, a22 * inverseDeterminant);
 	}
 
 	template<class T>
-	inline bool Matrix3x3<T>::operator==(const Matrix3x3<T>& aRightMatrix) const
+	inline constexpr bool Matrix3x3<T>::operator==(const Matrix3x3<T>& aRightMatrix) const
 	{
-		return myContainer[0][0] == aRightMatrix(1,1) &&
-			myContainer[1][0] == aRightMatrix(2,1) &&
-			myContainer[2][0] == aRightMatrix(3,1) &&
-			myContainer[0][1] == aRightMatrix(1,2) &&
-			myContainer[1][1] == aRightMatrix(2,2) &&
-			myContainer[2][1] == aRightMatrix(3,2) &&
-			myContainer[0][2] == aRightMatrix(1,3) &&
-			myContainer[1][2] == aRightMatrix(2,3) &&
-			myContainer[2][2] == aRightMatrix(3,3);
+		return Matrix<T, 3, 3>::Equal(*this, aRightMatrix);
 	}
 
 	template<class T>
 	inline Matrix3x3<T> operator+(const Matrix3x3<T>& aLeftMatrix, const Matrix3x3<T>& aRightMatrix)
 	{
-		return Matrix3x3<T>(aLeftMatrix(1,1) + aRightMatrix(1,1), aLeftMatrix(1,2) + aRightMatrix(1,2), aLeftMatrix(1,3) + aRightMatrix(1,3),
-			aLeftMatrix(2,1) + aRightMatrix(2,1), aLeftMatrix(2,2) + aRightMatrix(2,2), aLeftMatrix(2,3) + aRightMatrix(2,3),
-			aLeftMatrix(3,1) + aRightMatrix(3,1), aLeftMatrix(3,2) + aRightMatrix(3,2), aLeftMatrix(3,3) + aRightMatrix(3,3));
+		return Matrix3x3<T>(Matrix<T, 3, 3>::Add(aLeftMatrix, aRightMatrix));
 	}
 
 	template<class T>
 	inline Matrix3x3<T> operator-(const Matrix3x3<T>& aLeftMatrix, const Matrix3x3<T>& aRightMatrix)
 	{
-		return Matrix3x3<T>(aLeftMatrix(1,1) - aRightMatrix(1,1), aLeftMatrix(1,2) - aRightMatrix(1,2), aLeftMatrix(1,3) - aRightMatrix(1,3),
-			aLeftMatrix(2,1) - aRightMatrix(2,1), aLeftMatrix(2,2) - aRightMatrix(2,2), aLeftMatrix(2,3) - aRightMatrix(2,3),
-			aLeftMatrix(3,1) - aRightMatrix(3,1), aLeftMatrix(3,2) - aRightMatrix(3,2), aLeftMatrix(3,3) - aRightMatrix(3,3));
-
+		return Matrix3x3<T>(Matrix<T, 3, 3>::Subtract(aLeftMatrix, aRightMatrix));
 	}
 
 	template<class T>
 	inline Matrix3x3<T> operator*(const Matrix3x3<T>& aLeftMatrix, const Matrix3x3<T>& aRightMatrix)
 	{
-		return Matrix3x3<T>(aLeftMatrix(1,1) * aRightMatrix(1,1) + aLeftMatrix(1,2) * aRightMatrix(2,1) + aLeftMatrix(1,3) * aRightMatrix(3,1),
-			aLeftMatrix(1,1) * aRightMatrix(1,2) + aLeftMatrix(1,2) * aRightMatrix(2,2) + aLeftMatrix(1,3) * aRightMatrix(3,2),
-			aLeftMatrix(1,1) * aRightMatrix(1,3) + aLeftMatrix(1,2) * aRightMatrix(2,3) + aLeftMatrix(1,3) * aRightMatrix(3,3),
-
-			aLeftMatrix(2,1) * aRightMatrix(1,1) + aLeftMatrix(2,2) * aRightMatrix(2,1) + aLeftMatrix(2,3) * aRightMatrix(3,1),
-			aLeftMatrix(2,1) * aRightMatrix(1,2) + aLeftMatrix(2,2) * aRightMatrix(2,2) + aLeftMatrix(2,3) * aRightMatrix(3,2),
-			aLeftMatrix(2,1) * aRightMatrix(1,3) + aLeftMatrix(2,2) * aRightMatrix(2,3) + aLeftMatrix(2,3) * aRightMatrix(3,3),
-
-			aLeftMatrix(3,1) * aRightMatrix(1,1) + aLeftMatrix(3,2) * aRightMatrix(2,1) + aLeftMatrix(3,3) * aRightMatrix(3,1),
-			aLeftMatrix(3,1) * aRightMatrix(1,2) + aLeftMatrix(3,2) * aRightMatrix(2,2) + aLeftMatrix(3,3) * aRightMatrix(3,2),
-			aLeftMatrix(3,1) * aRightMatrix(1,3) + aLeftMatrix(3,2) * aRightMatrix(2,3) + aLeftMatrix(3,3) * aRightMatrix(3,3));
+		return Matrix3x3<T>(Matrix<T, 3, 3>::Multiply(aLeftMatrix, aRightMatrix));
 	}
 
 	template<class T>
@@ -211,11 +152,9 @@ namespace CommonUtilities
 	}
 
 	template<class T>
-	inline Vector3<T> operator*(const T& aScalar, const Matrix3x3<T>& aMatrix)
+	inline Matrix3x3<T> operator*(const T& aScalar, const Matrix3x3<T>& aMatrix)
 	{
-		return Vector3<T>(aScalar * aMatrix(1,1), aScalar * aMatrix(1,2), aScalar * aMatrix(1,3),
-			aScalar * aMatrix(2,1), aScalar * aMatrix(2,2), aScalar * aMatrix(2,3),
-			aScalar * aMatrix(3,1), aScalar * aMatrix(3,2), aScalar * aMatrix(3,3));
+		return Matrix3x3<T>(Matrix<T, 3, 3>::Scale(aMatrix, aScalar));
 	}
 
 	template<class T>
@@ -237,14 +176,14 @@ namespace CommonUtilities
 	}
 
 	template<class T>
-	inline Matrix3x3<T>& operator*=(const Vector3<T>& aVector, const Matrix3x3<T>& aRightMatrix)
+	inline Vector3<T>& operator*=(Vector3<T>& aVector, const Matrix3x3<T>& aRightMatrix)
 	{
 		return aVector = aVector * aRightMatrix;
 	}
 
 	template<class T>
-	inline Matrix3x3<T>& operator*=(const T& aScalar, const Matrix3x3<T>& aRightMatrix)
+	inline Matrix3x3<T>& operator*=(Matrix3x3<T>& aLeftMatrix, const T& aScalar)
 	{
-		return (*this) = aScalar * aRightMatrix;
+		return aLeftMatrix = aScalar * aLeftMatrix;
 	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
-#include <array>
+#include <assert.h>
+#include "Matrix.hpp"
+#include "Vector3.hpp"
 #include "Vector4.hpp"
 
 namespace CommonUtilities
@@ -8,118 +10,91 @@ namespace CommonUtilities
 	class Matrix3x3;
 
 	template<class T>
-	class Matrix4x4
+	class Matrix4x4;
+
+	template<class T>
+	class Quaternion;
+
+#ifdef CU_SIMD_SSE
+	// float overloads backed by SSE/AVX, picked over the generic templates below
+	inline Matrix4x4<float> operator*(const Matrix4x4<float>& aLeftMatrix, const Matrix4x4<float>& aRightMatrix);
+	inline Vector4<float> operator*(const Vector4<float>& aVector, const Matrix4x4<float>& aMatrix);
+#endif
+
+	// Row-major 4x4 matrix on top of Matrix<T, 4, 4>, which provides element access through
+	// operator()(row, column) and Get<Row, Column>(), and the constexpr arithmetic
+	template<class T>
+	class Matrix4x4 : public Matrix<T, 4, 4>
 	{
 	public:
 		// Creates the identity matrix
-		Matrix4x4<T>();
+		constexpr Matrix4x4<T>();
 
 		// Copy Constructor
-		Matrix4x4<T>(const Matrix4x4<T>& aMatrix);
+		constexpr Matrix4x4<T>(const Matrix4x4<T>& aMatrix) = default;
 
+		constexpr Matrix4x4<T>(const T aXX, const T aXY, const T aXZ, const T aXW,
+							   const T aYX, const T aYY, const T aYZ, const T aYW,
+							   const T aZX, const T aZY, const T aZZ, const T aZW,
+							   const T aWX, const T aWY, const T aWZ, const T aWW);
 
-		Matrix4x4<T>(const T aXX, const T aXY, const T aXZ, const T aXW,
-					 const T aYX, const T aYY, const T aYZ, const T aYW, 
-					 const T aZX, const T aZY, const T aZZ, const T aZW, 
-					 const T aWX, const T aWY, const T aWZ, const T aWW);
+		// Wraps the result of the generic Matrix operations
+		constexpr Matrix4x4<T>(const Matrix<T, 4, 4>& aMatrix);
 
 		// Copies top left3x3 part of the Matrix4x4
-		Matrix4x4<T>(const Matrix3x3<T>& aMatrix);
-
-		// () operator for accessing element (row, column) for read/write or read, respectively
-		T& operator()(const T row, const T column);
-		const T& operator()(const T row, const T column) const;
+		constexpr Matrix4x4<T>(const Matrix3x3<T>& aMatrix);
 
 		// Static functions for creating rotation matrices
 		static Matrix4x4<T> CreateRotationAroundX(T anAngleInRadians);
 		static Matrix4x4<T> CreateRotationAroundY(T anAngleInRadians);
 		static Matrix4x4<T> CreateRotationAroundZ(T anAngleInRadians);
 
+		// Static functions for creating a scale, then rotate, then translate transform directly, with one
+		// sin and cos per axis. The Euler version is the same as CreateRotationAroundX(angles.x) *
+		// CreateRotationAroundY(angles.y) * CreateRotationAroundZ(angles.z), the Quaternion one is defined in Quaternion.hpp
+		static Matrix4x4<T> CreateTRS(const Vector3<T>& aTranslation, const Vector3<T>& anEulerAnglesInRadians, const Vector3<T>& aScale);
+		static Matrix4x4<T> CreateTRS(const Vector3<T>& aTranslation, const Quaternion<T>& aRotation, const Vector3<T>& aScale);
+
 		// Static function for creating a transpose of a matrix
 		static Matrix4x4<T> Transpose(const Matrix4x4<T>& aMatrixToTranspose);
 
-		Matrix4x4<T> operator=(const Matrix4x4<T> & aRightMatrix);
-		bool operator==(const Matrix4x4<T> & aRightMatrix) const;
+		// Static functions for creating an inverse of a matrix. Inverse handles any invertible matrix,
+		// InverseAffine needs the last column to be (0, 0, 0, 1), FastInverse also needs the top left
+		// 3x3 part to be a pure rotation (translation and rotation only)
+		static Matrix4x4<T> Inverse(const Matrix4x4<T>& aMatrixToInverse);
+		static Matrix4x4<T> InverseAffine(const Matrix4x4<T>& aMatrixToInverse);
+		static Matrix4x4<T> FastInverse(const Matrix4x4<T>& aMatrixToInverse);
 
-	private:
-		std::array<std::array<T, 4>, 4> myContainer;
+		Matrix4x4<T>& operator=(const Matrix4x4<T> & aRightMatrix) = default;
+		constexpr bool operator==(const Matrix4x4<T> & aRightMatrix) const;
 	};
 
 	template<class T>
-	inline Matrix4x4<T>::Matrix4x4()
+	inline constexpr Matrix4x4<T>::Matrix4x4() : Matrix<T, 4, 4>()
 	{
-		for (int row = 0; row < myContainer.size(); row++)
-		{
-			for (int column = 0; column < myContainer.size(); column++)
-			{
-				myContainer[row][column] = 0;
-			}
-		}
-
-		for (int lineNumber = 0; lineNumber < myContainer.size(); ++lineNumber)
-		{
-			myContainer[lineNumber][lineNumber] = 1;
-		}
 	}
 
 	template<class T>
-	inline Matrix4x4<T>::Matrix4x4(const Matrix4x4<T>& aMatrix)
+	inline constexpr Matrix4x4<T>::Matrix4x4(const T aXX, const T aXY, const T aXZ, const T aXW,
+											 const T aYX, const T aYY, const T aYZ, const T aYW,
+											 const T aZX, const T aZY, const T aZZ, const T aZW,
+											 const T aWX, const T aWY, const T aWZ, const T aWW)
+		: Matrix<T, 4, 4>(aXX, aXY, aXZ, aXW, aYX, aYY, aYZ, aYW, aZX, aZY, aZZ, aZW, aWX, aWY, aWZ, aWW)
 	{
-		myContainer = aMatrix.myContainer;
 	}
 
 	template<class T>
-	inline Matrix4x4<T>::Matrix4x4(const T aXX, const T aXY, const T aXZ, const T aXW,
-								   const T aYX, const T aYY, const T aYZ, const T aYW,
-								   const T aZX, const T aZY, const T aZZ, const T aZW,
-								   const T aWX, const T aWY, const T aWZ, const T aWW)
+	inline constexpr Matrix4x4<T>::Matrix4x4(const Matrix<T, 4, 4>& aMatrix) : Matrix<T, 4, 4>(aMatrix)
 	{
-		myContainer[0][0] = aXX;
-		myContainer[0][1] = aXY;
-		myContainer[0][2] = aXZ;
-		myContainer[0][3] = aXW;
-
-		myContainer[1][0] = aYX;
-		myContainer[1][1] = aYY;
-		myContainer[1][2] = aYZ;
-		myContainer[1][3] = aYW;
-
-		myContainer[2][0] = aZX;
-		myContainer[2][1] = aZY;
-		myContainer[2][2] = aZZ;
-		myContainer[2][3] = aZW;
-
-		myContainer[3][0] = aWX;
-		myContainer[3][1] = aWY;
-		myContainer[3][2] = aWZ;
-		myContainer[3][3] = aWW;
 	}
 
-
 	template<class T>
-	inline Matrix4x4<T>::Matrix4x4(const Matrix3x3<T>& aMatrix)
+	inline constexpr Matrix4x4<T>::Matrix4x4(const Matrix3x3<T>& aMatrix)
+		: Matrix<T, 4, 4>(aMatrix(1, 1), aMatrix(1, 2), aMatrix(1, 3), 0,
+						  aMatrix(2, 1), aMatrix(2, 2), aMatrix(2, 3), 0,
+						  aMatrix(3, 1), aMatrix(3, 2), aMatrix(3, 3), 0,
+						  0, 0, 0, 1)
 	{
-		for (int row = 0; row < myContainer.size(); row++)
-		{
-			for (int column = 0; column < myContainer.size(); column++)
-			{
-				myContainer[row][column] = 0;
-			}
-		}
-
-		for (int row = 0; row < aMatrix.myContainer.size(); row++)
-		{
-			for (int column = 0; column < aMatrix.myContainer.size(); column++)
-			{
-				myContainer[row][column] = aMatrix.myContainer[row][column];
-			}
-		}
-	}
-
-	template<class T>
-	inline const T & Matrix4x4<T>::operator()(const T row, const T column) const
-	{
-		return myContainer[row - 1][column - 1];
 	}
 
 	template<class T>
@@ -150,108 +125,144 @@ namespace CommonUtilities
 	}
 
 	template<class T>
-	inline T & Matrix4x4<T>::operator()(const T row, const T column)
+	inline Matrix4x4<T> Matrix4x4<T>::CreateTRS(const Vector3<T>& aTranslation, const Vector3<T>& anEulerAnglesInRadians, const Vector3<T>& aScale)
 	{
-		return myContainer[row - 1][column - 1];
+		const T sinX = sin(anEulerAnglesInRadians.x);
+		const T cosX = cos(anEulerAnglesInRadians.x);
+		const T sinY = sin(anEulerAnglesInRadians.y);
+		const T cosY = cos(anEulerAnglesInRadians.y);
+		const T sinZ = sin(anEulerAnglesInRadians.z);
+		const T cosZ = cos(anEulerAnglesInRadians.z);
+		const T sinXSinY = sinX * sinY;
+		const T cosXSinY = cosX * sinY;
+
+		return Matrix4x4<T>(aScale.x * (cosY * cosZ), aScale.x * (cosY * sinZ), aScale.x * -sinY, 0,
+			aScale.y * (sinXSinY * cosZ - cosX * sinZ), aScale.y * (sinXSinY * sinZ + cosX * cosZ), aScale.y * (sinX * cosY), 0,
+			aScale.z * (cosXSinY * cosZ + sinX * sinZ), aScale.z * (cosXSinY * sinZ - sinX * cosZ), aScale.z * (cosX * cosY), 0,
+			aTranslation.x, aTranslation.y, aTranslation.z, 1);
 	}
 
 	template<class T>
 	inline Matrix4x4<T> Matrix4x4<T>::Transpose(const Matrix4x4<T>& aMatrixToTranspose)
 	{
-			Matrix4x4<T> transposedMatrix = Matrix4x4<T>();
-
-			for (int row = 0; row < aMatrixToTranspose.myContainer.size(); row++)
-			{
-				for (int column = 0; column < aMatrixToTranspose.myContainer.size(); column++)
-				{
-					transposedMatrix.myContainer[row][column] = aMatrixToTranspose.myContainer[column][row];
-				}
-			}
-			return transposedMatrix;
+		return Matrix4x4<T>(aMatrixToTranspose.GetTransposed());
+	}
+
+	template<class T>
+	inline Matrix4x4<T> Matrix4x4<T>::Inverse(const Matrix4x4<T>& aMatrixToInverse)
+	{
+		const T (*m)[4] = reinterpret_cast<const T (*)[4]>(aMatrixToInverse.GetData());
+
+		// 2x2 determinants of the top two and the bottom two rows
+		const T s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+		const T s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+		const T s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+		const T s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+		const T s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+		const T s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+		const T c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+		const T c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+		const T c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+		const T c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+		const T c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+		const T c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+		const T determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		assert(determinant != 0 && "Matrix can't be inverted!");
+		const T inverseDeterminant = 1 / determinant;
+
+		return Matrix4x4<T>(( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * inverseDeterminant,
+							(-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * inverseDeterminant,
+							( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * inverseDeterminant,
+							(-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * inverseDeterminant,
+
+							(-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * inverseDeterminant,
+							( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * inverseDeterminant,
+							(-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * inverseDeterminant,
+							( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * inverseDeterminant,
+
+							( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * inverseDeterminant,
+							(-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * inverseDeterminant,
+							( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * inverseDeterminant,
+							(-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * inverseDeterminant,
+
+							(-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * inverseDeterminant,
+							( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * inverseDeterminant,
+							(-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * inverseDeterminant,
+							( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * inverseDeterminant);
+	}
+
+	template<class T>
+	inline Matrix4x4<T> Matrix4x4<T>::InverseAffine(const Matrix4x4<T>& aMatrixToInverse)
+	{
+		const T (*m)[4] = reinterpret_cast<const T (*)[4]>(aMatrixToInverse.GetData());
+
+		// Inverse of the top left 3x3 part through its adjugate
+		const T a00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+		const T a01 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+		const T a02 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+		const T a10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+		const T a11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+		const T a12 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+		const T a20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+		const T a21 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+		const T a22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+		const T determinant = m[0][0] * a00 + m[0][1] * a10 + m[0][2] * a20;
+		assert(determinant != 0 && "Matrix can't be inverted!");
+		const T inverseDeterminant = 1 / determinant;
+
+		Matrix4x4<T> inverse(a00 * inverseDeterminant, a01 * inverseDeterminant, a02 * inverseDeterminant, 0,
+							 a10 * inverseDeterminant, a11 * inverseDeterminant, a12 * inverseDeterminant, 0,
+							 a20 * inverseDeterminant, a21 * inverseDeterminant, a22 * inverseDeterminant, 0,
+							 0, 0, 0, 1);
+
+		// The translation is moved back through the inverted 3x3 part
+		for (int column = 0; column < 3; ++column)
+		{
+			inverse(4, column + 1) = -(m[3][0] * inverse(1, column + 1) + m[3][1] * inverse(2, column + 1) + m[3][2] * inverse(3, column + 1));
+		}
+		return inverse;
 	}
 
 	template<class T>
-	inline Matrix4x4<T> Matrix4x4<T>::operator=(const Matrix4x4<T>& aRightMatrix)
+	inline Matrix4x4<T> Matrix4x4<T>::FastInverse(const Matrix4x4<T>& aMatrixToInverse)
 	{
-		return Matrix4x4<T>(myContainer[0][0] = aRightMatrix(1,1),
-							myContainer[1][0] = aRightMatrix(2,1),
-							myContainer[2][0] = aRightMatrix(3,1),
-							myContainer[3][0] = aRightMatrix(4,1),
-							myContainer[0][1] = aRightMatrix(1,2),
-							myContainer[1][1] = aRightMatrix(2,2),
-							myContainer[2][1] = aRightMatrix(3,2),
-							myContainer[3][1] = aRightMatrix(4,2),
-							myContainer[0][2] = aRightMatrix(1,3),
-							myContainer[1][2] = aRightMatrix(2,3),
-							myContainer[2][2] = aRightMatrix(3,3),
-							myContainer[3][2] = aRightMatrix(4,3),
-							myContainer[0][3] = aRightMatrix(1,4),
-							myContainer[1][3] = aRightMatrix(2,4),
-							myContainer[2][3] = aRightMatrix(3,4),
-							myContainer[3][3] = aRightMatrix(4,4));
+		const T (*m)[4] = reinterpret_cast<const T (*)[4]>(aMatrixToInverse.GetData());
+
+		// A rotation is inverted by its transpose, the translation is moved back through it
+		return Matrix4x4<T>(m[0][0], m[1][0], m[2][0], 0,
+							m[0][1], m[1][1], m[2][1], 0,
+							m[0][2], m[1][2], m[2][2], 0,
+							-(m[3][0] * m[0][0] + m[3][1] * m[0][1] + m[3][2] * m[0][2]),
+							-(m[3][0] * m[1][0] + m[3][1] * m[1][1] + m[3][2] * m[1][2]),
+							-(m[3][0] * m[2][0] + m[3][1] * m[2][1] + m[3][2] * m[2][2]),
+							1);
 	}
 
 	template<class T>
-	inline bool Matrix4x4<T>::operator==(const Matrix4x4<T>& aRightMatrix) const
+	inline constexpr bool Matrix4x4<T>::operator==(const Matrix4x4<T>& aRightMatrix) const
 	{
-		return myContainer[0][0] == aRightMatrix(1,1) &&
-			   myContainer[1][0] == aRightMatrix(2,1) &&
-			   myContainer[2][0] == aRightMatrix(3,1) &&
-			   myContainer[3][0] == aRightMatrix(4,1) &&
-			   myContainer[0][1] == aRightMatrix(1,2) &&
-			   myContainer[1][1] == aRightMatrix(2,2) &&
-			   myContainer[2][1] == aRightMatrix(3,2) &&
-			   myContainer[3][1] == aRightMatrix(4,2) &&
-			   myContainer[0][2] == aRightMatrix(1,3) &&
-			   myContainer[1][2] == aRightMatrix(2,3) &&
-			   myContainer[2][2] == aRightMatrix(3,3) &&
-			   myContainer[3][2] == aRightMatrix(4,3) &&
-			   myContainer[0][3] == aRightMatrix(1,4) &&
-			   myContainer[1][3] == aRightMatrix(2,4) &&
-			   myContainer[2][3] == aRightMatrix(3,4) &&
-			   myContainer[3][3] == aRightMatrix(4,4);
+		return Matrix<T, 4, 4>::Equal(*this, aRightMatrix);
 	}
 
 	template<class T>
 	inline Matrix4x4<T> operator+(const Matrix4x4<T>& aLeftMatrix, const Matrix4x4<T>& aRightMatrix)
 	{
-		return Matrix4x4<T>(aLeftMatrix(1,1) + aRightMatrix(1,1), aLeftMatrix(1,2) + aRightMatrix(1,2), aLeftMatrix(1,3) + aRightMatrix(1,3), aLeftMatrix(1,4) + aRightMatrix(1,4),
-							aLeftMatrix(2,1) + aRightMatrix(2,1), aLeftMatrix(2,2) + aRightMatrix(2,2), aLeftMatrix(2,3) + aRightMatrix(2,3), aLeftMatrix(2,4) + aRightMatrix(2,4),
-							aLeftMatrix(3,1) + aRightMatrix(3,1), aLeftMatrix(3,2) + aRightMatrix(3,2), aLeftMatrix(3,3) + aRightMatrix(3,3), aLeftMatrix(3,4) + aRightMatrix(3,4),
-							aLeftMatrix(4,1) + aRightMatrix(4,1), aLeftMatrix(4,2) + aRightMatrix(4,2), aLeftMatrix(4,3) + aRightMatrix(4,3), aLeftMatrix(4,4) + aRightMatrix(4,4));
+		return Matrix4x4<T>(Matrix<T, 4, 4>::Add(aLeftMatrix, aRightMatrix));
 	}
 
 	template<class T>
 	inline Matrix4x4<T> operator-(const Matrix4x4<T>& aLeftMatrix, const Matrix4x4<T>& aRightMatrix)
 	{
-		return Matrix4x4<T>(aLeftMatrix(1,1) - aRightMatrix(1,1), aLeftMatrix(1,2) - aRightMatrix(1,2), aLeftMatrix(1,3) - aRightMatrix(1,3), aLeftMatrix(1,4) - aRightMatrix(1,4),
-							aLeftMatrix(2,1) - aRightMatrix(2,1), aLeftMatrix(2,2) - aRightMatrix(2,2), aLeftMatrix(2,3) - aRightMatrix(2,3), aLeftMatrix(2,4) - aRightMatrix(2,4),
-							aLeftMatrix(3,1) - aRightMatrix(3,1), aLeftMatrix(3,2) - aRightMatrix(3,2), aLeftMatrix(3,3) - aRightMatrix(3,3), aLeftMatrix(3,4) - aRightMatrix(3,4),
-							aLeftMatrix(4,1) - aRightMatrix(4,1), aLeftMatrix(4,2) - aRightMatrix(4,2), aLeftMatrix(4,3) - aRightMatrix(4,3), aLeftMatrix(4,4) - aRightMatrix(4,4));
+		return Matrix4x4<T>(Matrix<T, 4, 4>::Subtract(aLeftMatrix, aRightMatrix));
 	}
 
 	template<class T>
 	inline Matrix4x4<T> operator*(const Matrix4x4<T>& aLeftMatrix, const Matrix4x4<T>& aRightMatrix)
 	{
-		return Matrix4x4<T>(aLeftMatrix(1,1) * aRightMatrix(1,1) + aLeftMatrix(1,2) * aRightMatrix(2,1) + aLeftMatrix(1,3) * aRightMatrix(3,1) + aLeftMatrix(1,4) * aRightMatrix(4,1),
-							aLeftMatrix(1,1) * aRightMatrix(1,2) + aLeftMatrix(1,2) * aRightMatrix(2,2) + aLeftMatrix(1,3) * aRightMatrix(3,2) + aLeftMatrix(1,4) * aRightMatrix(4,2),
-							aLeftMatrix(1,1) * aRightMatrix(1,3) + aLeftMatrix(1,2) * aRightMatrix(2,3) + aLeftMatrix(1,3) * aRightMatrix(3,3) + aLeftMatrix(1,4) * aRightMatrix(4,3),
-							aLeftMatrix(1,1) * aRightMatrix(1,4) + aLeftMatrix(1,2) * aRightMatrix(2,4) + aLeftMatrix(1,3) * aRightMatrix(3,4) + aLeftMatrix(1,4) * aRightMatrix(4,4),
-
-							aLeftMatrix(2,1) * aRightMatrix(1,1) + aLeftMatrix(2,2) * aRightMatrix(2,1) + aLeftMatrix(2,3) * aRightMatrix(3,1) + aLeftMatrix(2,4) * aRightMatrix(4,1),
-							aLeftMatrix(2,1) * aRightMatrix(1,2) + aLeftMatrix(2,2) * aRightMatrix(2,2) + aLeftMatrix(2,3) * aRightMatrix(3,2) + aLeftMatrix(2,4) * aRightMatrix(4,2),
-							aLeftMatrix(2,1) * aRightMatrix(1,3) + aLeftMatrix(2,2) * aRightMatrix(2,3) + aLeftMatrix(2,3) * aRightMatrix(3,3) + aLeftMatrix(2,4) * aRightMatrix(4,3),
-							aLeftMatrix(2,1) * aRightMatrix(1,4) + aLeftMatrix(2,2) * aRightMatrix(2,4) + aLeftMatrix(2,3) * aRightMatrix(3,4) + aLeftMatrix(2,4) * aRightMatrix(4,4),
-
-							aLeftMatrix(3,1) * aRightMatrix(1,1) + aLeftMatrix(3,2) * aRightMatrix(2,1) + aLeftMatrix(3,3) * aRightMatrix(3,1) + aLeftMatrix(3,4) * aRightMatrix(4,1),
-							aLeftMatrix(3,1) * aRightMatrix(1,2) + aLeftMatrix(3,2) * aRightMatrix(2,2) + aLeftMatrix(3,3) * aRightMatrix(3,2) + aLeftMatrix(3,4) * aRightMatrix(4,2),
-							aLeftMatrix(3,1) * aRightMatrix(1,3) + aLeftMatrix(3,2) * aRightMatrix(2,3) + aLeftMatrix(3,3) * aRightMatrix(3,3) + aLeftMatrix(3,4) * aRightMatrix(4,3),
-							aLeftMatrix(3,1) * aRightMatrix(1,4) + aLeftMatrix(3,2) * aRightMatrix(2,4) + aLeftMatrix(3,3) * aRightMatrix(3,4) + aLeftMatrix(3,4) * aRightMatrix(4,4),
-
-							aLeftMatrix(4,1) * aRightMatrix(1,1) + aLeftMatrix(4,2) * aRightMatrix(2,1) + aLeftMatrix(4,3) * aRightMatrix(3,1) + aLeftMatrix(4,4) * aRightMatrix(4,1),
-							aLeftMatrix(4,1) * aRightMatrix(1,2) + aLeftMatrix(4,2) * aRightMatrix(2,2) + aLeftMatrix(4,3) * aRightMatrix(3,2) + aLeftMatrix(4,4) * aRightMatrix(4,2),
-							aLeftMatrix(4,1) * aRightMatrix(1,3) + aLeftMatrix(4,2) * aRightMatrix(2,3) + aLeftMatrix(4,3) * aRightMatrix(3,3) + aLeftMatrix(4,4) * aRightMatrix(4,3),
-							aLeftMatrix(4,1) * aRightMatrix(1,4) + aLeftMatrix(4,2) * aRightMatrix(2,4) + aLeftMatrix(4,3) * aRightMatrix(3,4) + aLeftMatrix(4,4) * aRightMatrix(4,4));
+		return Matrix4x4<T>(Matrix<T, 4, 4>::Multiply(aLeftMatrix, aRightMatrix));
 	}
 
 	template<class T>
@@ -264,12 +275,9 @@ namespace CommonUtilities
 	}
 
 	template<class T>
-	inline Vector4<T> operator*(const T& aScalar, const Matrix4x4<T>& aMatrix)
+	inline Matrix4x4<T> operator*(const T& aScalar, const Matrix4x4<T>& aMatrix)
 	{
-		return Vector4<T>(aScalar * aMatrix(1,1), aScalar * aMatrix(1,2), aScalar * aMatrix(1,3), aScalar * aMatrix(1,4),
-						  aScalar * aMatrix(2,1), aScalar * aMatrix(2,2), aScalar * aMatrix(2,3), aScalar * aMatrix(2,4),
-						  aScalar * aMatrix(3,1), aScalar * aMatrix(3,2), aScalar * aMatrix(3,3), aScalar * aMatrix(3,4),
-						  aScalar * aMatrix(4,1), aScalar * aMatrix(4,2), aScalar * aMatrix(4,3), aScalar * aMatrix(4,4));
+		return Matrix4x4<T>(Matrix<T, 4, 4>::Scale(aMatrix, aScalar));
 	}
 
 	template<class T>
@@ -291,14 +299,212 @@ namespace CommonUtilities
 	}
 
 	template<class T>
-	inline Matrix4x4<T>& operator*=(const Vector4<T>& aVector, const Matrix4x4<T>& aRightMatrix)
+	inline Vector4<T>& operator*=(Vector4<T>& aVector, const Matrix4x4<T>& aRightMatrix)
 	{
 		return aVector = aVector * aRightMatrix;
 	}
 
 	template<class T>
-	inline Matrix4x4<T>& operator*=(const T& aScalar, const Matrix4x4<T>& aRightMatrix)
+	inline Matrix4x4<T>& operator*=(Matrix4x4<T>& aLeftMatrix, const T& aScalar)
+	{
+		return aLeftMatrix = aScalar * aLeftMatrix;
+	}
+
+#ifdef CU_SIMD_SSE
+	inline Matrix4x4<float> operator*(const Matrix4x4<float>& aLeftMatrix, const Matrix4x4<float>& aRightMatrix)
+	{
+		Matrix4x4<float> result;
+		const float* left = aLeftMatrix.GetData();
+		const float* right = aRightMatrix.GetData();
+		float* out = result.GetData();
+
+#ifdef CU_SIMD_AVX
+		// Two result rows per 256-bit register, each half broadcasting its own left-hand element
+		const __m256 rightRow0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right));
+		const __m256 rightRow1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right + 4));
+		const __m256 rightRow2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right + 8));
+		const __m256 rightRow3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(right + 12));
+
+		for (int row = 0; row < 4; row += 2)
+		{
+			const __m256 leftRows = _mm256_loadu_ps(left + row * 4);
+			__m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(leftRows, leftRows, _MM_SHUFFLE(0, 0, 0, 0)), rightRow0);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(leftRows, leftRows, _MM_SHUFFLE(1, 1, 1, 1)), rightRow1));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(leftRows, leftRows, _MM_SHUFFLE(2, 2, 2, 2)), rightRow2));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(leftRows, leftRows, _MM_SHUFFLE(3, 3, 3, 3)), rightRow3));
+			_mm256_storeu_ps(out + row * 4, sum);
+		}
+#else
+		const __m128 rightRow0 = _mm_load_ps(right);
+		const __m128 rightRow1 = _mm_load_ps(right + 4);
+		const __m128 rightRow2 = _mm_load_ps(right + 8);
+		const __m128 rightRow3 = _mm_load_ps(right + 12);
+
+		for (int row = 0; row < 4; ++row)
+		{
+			const __m128 leftRow = _mm_load_ps(left + row * 4);
+			__m128 sum = _mm_mul_ps(_mm_shuffle_ps(leftRow, leftRow, _MM_SHUFFLE(0, 0, 0, 0)), rightRow0);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(leftRow, leftRow, _MM_SHUFFLE(1, 1, 1, 1)), rightRow1));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(leftRow, leftRow, _MM_SHUFFLE(2, 2, 2, 2)), rightRow2));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(leftRow, leftRow, _MM_SHUFFLE(3, 3, 3, 3)), rightRow3));
+			_mm_store_ps(out + row * 4, sum);
+		}
+#endif
+		return result;
+	}
+
+	inline Vector4<float> operator*(const Vector4<float>& aVector, const Matrix4x4<float>& aMatrix)
+	{
+		const float* matrix = aMatrix.GetData();
+
+		// Broadcasting each component instead of one 16-byte load avoids a store-forwarding
+		// stall when the vector was just written element by element
+		__m128 sum = _mm_mul_ps(_mm_set1_ps(aVector.x), _mm_load_ps(matrix));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(aVector.y), _mm_load_ps(matrix + 4)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(aVector.z), _mm_load_ps(matrix + 8)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(aVector.w), _mm_load_ps(matrix + 12)));
+
+		Vector4<float> result;
+		_mm_store_ps(&result.x, sum);
+		return result;
+	}
+	// Block-wise inverse: the matrix is split into the 2x2 blocks A B / C D, each held in one register,
+	// and the inverse is assembled from their adjugates and determinants
+	template<>
+	inline Matrix4x4<float> Matrix4x4<float>::Inverse(const Matrix4x4<float>& aMatrixToInverse)
+	{
+		const float* matrix = aMatrixToInverse.GetData();
+		const __m128 row0 = _mm_load_ps(matrix);
+		const __m128 row1 = _mm_load_ps(matrix + 4);
+		const __m128 row2 = _mm_load_ps(matrix + 8);
+		const __m128 row3 = _mm_load_ps(matrix + 12);
+
+		const __m128 a = _mm_movelh_ps(row0, row1);
+		const __m128 b = _mm_movehl_ps(row1, row0);
+		const __m128 c = _mm_movelh_ps(row2, row3);
+		const __m128 d = _mm_movehl_ps(row3, row2);
+
+		// (|A|, |B|, |C|, |D|)
+		const __m128 blockDeterminants = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+		const __m128 determinantA = _mm_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 determinantB = _mm_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 determinantC = _mm_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 determinantD = _mm_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(3, 3, 3, 3));
+
+		// adj(D) * C and adj(A) * B
+		const __m128 adjugateDC = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(0, 0, 3, 3)), c),
+			_mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 0, 3, 2))));
+		const __m128 adjugateAB = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+
+		// X = |D|A - B adj(D)C, W = |A|D - C adj(A)B
+		__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), _mm_add_ps(
+			_mm_mul_ps(b, _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(1, 2, 1, 2)))));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), _mm_add_ps(
+			_mm_mul_ps(c, _mm_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(1, 2, 1, 2)))));
+
+		// Y = |B|C - D adj(adj(A)B), Z = |C|B - A adj(adj(D)C)
+		__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), _mm_sub_ps(
+			_mm_mul_ps(d, _mm_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(1, 2, 1, 2)))));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), _mm_sub_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(1, 2, 1, 2)))));
+
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		__m128 trace = _mm_mul_ps(adjugateAB, _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(3, 1, 2, 0)));
+		trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+		trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+		const __m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+		assert(_mm_cvtss_f32(determinant) != 0.f && "Matrix can't be inverted!");
+
+		const __m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), determinant);
+		x = _mm_mul_ps(x, inverseDeterminant);
+		y = _mm_mul_ps(y, inverseDeterminant);
+		z = _mm_mul_ps(z, inverseDeterminant);
+		w = _mm_mul_ps(w, inverseDeterminant);
+
+		// The adjugate of each block is folded into the shuffle back to rows
+		Matrix4x4<float> result;
+		float* out = result.GetData();
+		_mm_store_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_store_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_store_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_store_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+		return result;
+	}
+	// The inverse of the 3x3 part is the transpose of the cross products of its rows over the determinant
+	template<>
+	inline Matrix4x4<float> Matrix4x4<float>::InverseAffine(const Matrix4x4<float>& aMatrixToInverse)
+	{
+		const float* matrix = aMatrixToInverse.GetData();
+		const __m128 row0 = _mm_load_ps(matrix);
+		const __m128 row1 = _mm_load_ps(matrix + 4);
+		const __m128 row2 = _mm_load_ps(matrix + 8);
+		const __m128 translation = _mm_load_ps(matrix + 12);
+
+		const __m128 row0YZX = _mm_shuffle_ps(row0, row0, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 row1YZX = _mm_shuffle_ps(row1, row1, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 row2YZX = _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 cross12 = _mm_sub_ps(_mm_mul_ps(row1, row2YZX), _mm_mul_ps(row1YZX, row2));
+		const __m128 cross20 = _mm_sub_ps(_mm_mul_ps(row2, row0YZX), _mm_mul_ps(row2YZX, row0));
+		const __m128 cross01 = _mm_sub_ps(_mm_mul_ps(row0, row1YZX), _mm_mul_ps(row0YZX, row1));
+		__m128 adjugate0 = _mm_shuffle_ps(cross12, cross12, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 adjugate1 = _mm_shuffle_ps(cross20, cross20, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 adjugate2 = _mm_shuffle_ps(cross01, cross01, _MM_SHUFFLE(3, 0, 2, 1));
+
+		__m128 determinant = _mm_mul_ps(row0, adjugate0);
+		determinant = _mm_add_ps(determinant, _mm_shuffle_ps(determinant, determinant, _MM_SHUFFLE(2, 3, 0, 1)));
+		determinant = _mm_add_ps(determinant, _mm_shuffle_ps(determinant, determinant, _MM_SHUFFLE(1, 0, 3, 2)));
+		assert(_mm_cvtss_f32(determinant) != 0.f && "Matrix can't be inverted!");
+
+		__m128 zero = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(adjugate0, adjugate1, adjugate2, zero);
+		const __m128 inverseDeterminant = _mm_div_ps(_mm_set1_ps(1.f), determinant);
+		const __m128 inverse0 = _mm_mul_ps(adjugate0, inverseDeterminant);
+		const __m128 inverse1 = _mm_mul_ps(adjugate1, inverseDeterminant);
+		const __m128 inverse2 = _mm_mul_ps(adjugate2, inverseDeterminant);
+
+		__m128 inverseTranslation = _mm_mul_ps(_mm_shuffle_ps(translation, translation, _MM_SHUFFLE(0, 0, 0, 0)), inverse0);
+		inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(_mm_shuffle_ps(translation, translation, _MM_SHUFFLE(1, 1, 1, 1)), inverse1));
+		inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(_mm_shuffle_ps(translation, translation, _MM_SHUFFLE(2, 2, 2, 2)), inverse2));
+
+		Matrix4x4<float> result;
+		float* out = result.GetData();
+		_mm_store_ps(out, inverse0);
+		_mm_store_ps(out + 4, inverse1);
+		_mm_store_ps(out + 8, inverse2);
+		_mm_store_ps(out + 12, _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), inverseTranslation));
+		return result;
+	}
+
+	template<>
+	inline Matrix4x4<float> Matrix4x4<float>::FastInverse(const Matrix4x4<float>& aMatrixToInverse)
 	{
-		return (*this) = aScalar * aRightMatrix;
+		const float* matrix = aMatrixToInverse.GetData();
+		__m128 row0 = _mm_load_ps(matrix);
+		__m128 row1 = _mm_load_ps(matrix + 4);
+		__m128 row2 = _mm_load_ps(matrix + 8);
+		const __m128 translation = _mm_load_ps(matrix + 12);
+
+		__m128 zero = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(row0, row1, row2, zero);
+
+		__m128 inverseTranslation = _mm_mul_ps(_mm_shuffle_ps(translation, translation, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+		inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(_mm_shuffle_ps(translation, translation, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+		inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(_mm_shuffle_ps(translation, translation, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+
+		Matrix4x4<float> result;
+		float* out = result.GetData();
+		_mm_store_ps(out, row0);
+		_mm_store_ps(out + 4, row1);
+		_mm_store_ps(out + 8, row2);
+		_mm_store_ps(out + 12, _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), inverseTranslation));
+		return result;
 	}
-}
\ No newline at end of file
+#endif
+}
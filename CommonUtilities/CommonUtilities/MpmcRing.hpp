@@ -0,0 +1,200 @@
+#pragma once
+#include <atomic>
+#include <utility>
+#include "AlignedAllocation.hpp"
+#include "StaticArray.hpp"
+
+namespace CommonUtilities
+{
+	// Lock-free bounded ring buffer for any number of producer and consumer threads.
+	// Every cell carries a sequence number that tells whose turn it is: a producer may fill the cell
+	// at position p when its sequence is p, a consumer may empty it when the sequence is p + 1.
+	template<class T, int size>
+	class MpmcRing
+	{
+	public:
+		static_assert(size > 1 && (size & (size - 1)) == 0, "MpmcRing size must be a power of two!");
+
+		MpmcRing();
+		MpmcRing(const MpmcRing& aRing) = delete;
+		MpmcRing& operator=(const MpmcRing& aRing) = delete;
+
+		// False if the ring is full
+		inline bool Push(const T& anObject);
+		inline bool Push(T&& anObject);
+		// Pushes objects until the ring is full and returns how many it pushed. Each object is
+		// claimed on its own, so other producers' objects may end up in between.
+		inline int PushBatch(const T* someObjects, const int aCount);
+
+		// False if the ring is empty
+		inline bool Pop(T& anObject);
+		inline int PopBatch(T* anOutput, const int aMaxCount);
+
+		// Only a snapshot while other threads are pushing or popping
+		inline int Count() const;
+		static constexpr int Capacity();
+
+	private:
+		static const unsigned int ourMask = static_cast<unsigned int>(size - 1);
+
+		struct Cell
+		{
+			std::atomic<unsigned int> mySequence;
+			T myValue;
+		};
+
+		// Claims a cell for a producer, nullptr if the ring is full
+		inline Cell* ClaimForPush(unsigned int& aPosition);
+		inline Cell* ClaimForPop(unsigned int& aPosition);
+
+		char myFrontPadding[CacheLineSize];
+		std::atomic<unsigned int> myPushPosition;
+		char myPushPadding[CacheLineSize - sizeof(std::atomic<unsigned int>)];
+		std::atomic<unsigned int> myPopPosition;
+		char myPopPadding[CacheLineSize - sizeof(std::atomic<unsigned int>)];
+
+		StaticArray<Cell, size> myCells;
+	};
+
+	template<class T, int size>
+	inline MpmcRing<T, size>::MpmcRing() : myPushPosition(0), myPopPosition(0)
+	{
+		for (int index = 0; index < size; ++index)
+		{
+			myCells[index].mySequence.store(static_cast<unsigned int>(index), std::memory_order_relaxed);
+		}
+	}
+
+	template<class T, int size>
+	inline typename MpmcRing<T, size>::Cell* MpmcRing<T, size>::ClaimForPush(unsigned int& aPosition)
+	{
+		aPosition = myPushPosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Cell& cell = myCells[aPosition & ourMask];
+			const int difference = static_cast<int>(cell.mySequence.load(std::memory_order_acquire) - aPosition);
+			if (difference == 0)
+			{
+				if (myPushPosition.compare_exchange_weak(aPosition, aPosition + 1, std::memory_order_relaxed))
+				{
+					return &cell;
+				}
+			}
+			else if (difference < 0)
+			{
+				// Still holds the value pushed one lap ago
+				return nullptr;
+			}
+			else
+			{
+				aPosition = myPushPosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<class T, int size>
+	inline typename MpmcRing<T, size>::Cell* MpmcRing<T, size>::ClaimForPop(unsigned int& aPosition)
+	{
+		aPosition = myPopPosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Cell& cell = myCells[aPosition & ourMask];
+			const int difference = static_cast<int>(cell.mySequence.load(std::memory_order_acquire) - (aPosition + 1));
+			if (difference == 0)
+			{
+				if (myPopPosition.compare_exchange_weak(aPosition, aPosition + 1, std::memory_order_relaxed))
+				{
+					return &cell;
+				}
+			}
+			else if (difference < 0)
+			{
+				// Not pushed yet
+				return nullptr;
+			}
+			else
+			{
+				aPosition = myPopPosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<class T, int size>
+	inline bool MpmcRing<T, size>::Push(const T& anObject)
+	{
+		unsigned int position;
+		Cell* cell = ClaimForPush(position);
+		if (cell == nullptr)
+		{
+			return false;
+		}
+		cell->myValue = anObject;
+		cell->mySequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<class T, int size>
+	inline bool MpmcRing<T, size>::Push(T&& anObject)
+	{
+		unsigned int position;
+		Cell* cell = ClaimForPush(position);
+		if (cell == nullptr)
+		{
+			return false;
+		}
+		cell->myValue = std::move(anObject);
+		cell->mySequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<class T, int size>
+	inline int MpmcRing<T, size>::PushBatch(const T* someObjects, const int aCount)
+	{
+		int count = 0;
+		while (count < aCount && Push(someObjects[count]))
+		{
+			++count;
+		}
+		return count;
+	}
+
+	template<class T, int size>
+	inline bool MpmcRing<T, size>::Pop(T& anObject)
+	{
+		unsigned int position;
+		Cell* cell = ClaimForPop(position);
+		if (cell == nullptr)
+		{
+			return false;
+		}
+		anObject = std::move(cell->myValue);
+		// Free for the producer one lap later
+		cell->mySequence.store(position + size, std::memory_order_release);
+		return true;
+	}
+
+	template<class T, int size>
+	inline int MpmcRing<T, size>::PopBatch(T* anOutput, const int aMaxCount)
+	{
+		int count = 0;
+		while (count < aMaxCount && Pop(anOutput[count]))
+		{
+			++count;
+		}
+		return count;
+	}
+
+	template<class T, int size>
+	inline int MpmcRing<T, size>::Count() const
+	{
+		const unsigned int popPosition = myPopPosition.load(std::memory_order_acquire);
+		const int count = static_cast<int>(myPushPosition.load(std::memory_order_acquire) - popPosition);
+		return count < 0 ? 0 : (count > size ? size : count);
+	}
+
+	template<class T, int size>
+	constexpr int MpmcRing<T, size>::Capacity()
+	{
+		return size;
+	}
+}
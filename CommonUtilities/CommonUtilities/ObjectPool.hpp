@@ -0,0 +1,358 @@
+#pragma once
+#include <assert.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "AlignedAllocation.hpp"
+#include "GrowingArray.hpp"
+
+namespace CommonUtilities
+{
+	// Hands out objects from chunks of memory allocated anObjectsPerChunk at a time. Released objects go on
+	// an intrusive free list kept in their own memory, so Acquire and Release are O(1) and stop touching
+	// the heap once the pool has grown to its working size. Objects never move while they are alive.
+	// The pool itself isn't thread-safe; threads that share one each go through a LocalCache.
+	template<class T, class Allocator = AlignedAllocator>
+	class ObjectPool
+	{
+		union Node
+		{
+			Node* myNext;
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type myStorage;
+		};
+
+	public:
+		class LocalCache;
+
+		// Deleter that releases into the pool, or into the cache it came from, so owning containers can
+		// hold UniquePointers instead of raw pointers
+		class Releaser
+		{
+		public:
+			Releaser(ObjectPool* aPool = nullptr) : myPool(aPool), myCache(nullptr) {}
+			Releaser(LocalCache* aCache) : myPool(nullptr), myCache(aCache) {}
+			void operator()(T* anObject) const { myCache != nullptr ? myCache->Release(anObject) : myPool->Release(anObject); }
+		private:
+			ObjectPool* myPool;
+			LocalCache* myCache;
+		};
+		typedef std::unique_ptr<T, Releaser> UniquePointer;
+
+		// Keeps a thread's own free list and trades objects with the pool aBatchSize at a time, so the
+		// pool's lock is taken once per batch. Once caches are in use, every thread goes through one.
+		class LocalCache
+		{
+		public:
+			explicit LocalCache(ObjectPool& aPool, const int aBatchSize = 32);
+			~LocalCache();
+			LocalCache(const LocalCache& aCache) = delete;
+			LocalCache& operator=(const LocalCache& aCache) = delete;
+
+			template<class... Arguments>
+			T* Acquire(Arguments&&... someArguments);
+			void Release(T* anObject);
+			// Releases into this cache, so it must outlive the pointer and stay on this thread
+			template<class... Arguments>
+			UniquePointer MakeUnique(Arguments&&... someArguments);
+			// Hands every cached free object back to the pool
+			void Flush();
+
+		private:
+			ObjectPool& myPool;
+			Node* myFreeList;
+			int myFreeCount;
+			int myBatchSize;
+		};
+
+		explicit ObjectPool(const int anObjectsPerChunk = 256, const Allocator& anAllocator = Allocator());
+		ObjectPool(const ObjectPool& aPool) = delete;
+		ObjectPool& operator=(const ObjectPool& aPool) = delete;
+		// Destroys the objects that are still alive
+		~ObjectPool();
+
+		template<class... Arguments>
+		inline T* Acquire(Arguments&&... someArguments);
+		inline void Release(T* anObject);
+		// Releases straight into the pool, so only while no LocalCaches are in use; threads use LocalCache::MakeUnique
+		template<class... Arguments>
+		inline UniquePointer MakeUnique(Arguments&&... someArguments);
+
+		// Destroys every live object at once and keeps the chunks for reuse. Flush all caches first.
+		void Reset();
+
+		// Objects out of the pool: the live ones and those held by caches
+		inline int Count() const;
+		inline int Capacity() const;
+
+	private:
+		inline Node* AcquireNode();
+		inline void ReleaseNode(Node* aNode);
+		// Batch transfers for LocalCache, under myMutex
+		Node* AcquireNodes(const int aCount);
+		void ReleaseNodes(Node* aFirst, Node* aLast, const int aCount);
+
+		void DestroyLive(std::true_type);
+		void DestroyLive(std::false_type);
+
+		GrowingArray<Node*> myChunks;
+		Node* myFreeList;
+		int myObjectsPerChunk;
+		// Chunks are carved front to back before the free list is needed
+		int myChunkIndex;
+		int myCarvedCount;
+		int myCount;
+		std::mutex myMutex;
+		Allocator myAllocator;
+	};
+
+	template<class T, class Allocator>
+	inline ObjectPool<T, Allocator>::ObjectPool(const int anObjectsPerChunk, const Allocator& anAllocator) : myAllocator(anAllocator)
+	{
+		assert(anObjectsPerChunk > 0 && "A chunk needs room for at least one object!");
+		myFreeList = nullptr;
+		myObjectsPerChunk = anObjectsPerChunk;
+		myChunkIndex = 0;
+		myCarvedCount = 0;
+		myCount = 0;
+	}
+
+	template<class T, class Allocator>
+	inline ObjectPool<T, Allocator>::~ObjectPool()
+	{
+		Reset();
+		for (Node* chunk : myChunks)
+		{
+			myAllocator.Free(chunk);
+		}
+	}
+
+	template<class T, class Allocator>
+	template<class... Arguments>
+	inline T* ObjectPool<T, Allocator>::Acquire(Arguments&&... someArguments)
+	{
+		Node* node = AcquireNode();
+		return new (&node->myStorage) T(std::forward<Arguments>(someArguments)...);
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::Release(T* anObject)
+	{
+		assert(anObject != nullptr && "Can't release nullptr!");
+		anObject->~T();
+		ReleaseNode(reinterpret_cast<Node*>(anObject));
+	}
+
+	template<class T, class Allocator>
+	template<class... Arguments>
+	inline typename ObjectPool<T, Allocator>::UniquePointer ObjectPool<T, Allocator>::MakeUnique(Arguments&&... someArguments)
+	{
+		return UniquePointer(Acquire(std::forward<Arguments>(someArguments)...), Releaser(this));
+	}
+
+	template<class T, class Allocator>
+	inline typename ObjectPool<T, Allocator>::Node* ObjectPool<T, Allocator>::AcquireNode()
+	{
+		++myCount;
+		if (myFreeList != nullptr)
+		{
+			Node* node = myFreeList;
+			myFreeList = node->myNext;
+			return node;
+		}
+
+		if (myChunkIndex < myChunks.Size() && myCarvedCount == myObjectsPerChunk)
+		{
+			++myChunkIndex;
+			myCarvedCount = 0;
+		}
+		if (myChunkIndex == myChunks.Size())
+		{
+			myChunks.Add(static_cast<Node*>(myAllocator.Allocate(sizeof(Node) * myObjectsPerChunk, alignof(Node))));
+		}
+		return myChunks[myChunkIndex] + myCarvedCount++;
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::ReleaseNode(Node* aNode)
+	{
+		--myCount;
+		aNode->myNext = myFreeList;
+		myFreeList = aNode;
+	}
+
+	template<class T, class Allocator>
+	inline typename ObjectPool<T, Allocator>::Node* ObjectPool<T, Allocator>::AcquireNodes(const int aCount)
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		Node* first = nullptr;
+		for (int index = 0; index < aCount; ++index)
+		{
+			Node* node = AcquireNode();
+			node->myNext = first;
+			first = node;
+		}
+		return first;
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::ReleaseNodes(Node* aFirst, Node* aLast, const int aCount)
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		aLast->myNext = myFreeList;
+		myFreeList = aFirst;
+		myCount -= aCount;
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::Reset()
+	{
+		DestroyLive(std::integral_constant<bool, std::is_trivially_destructible<T>::value>{});
+		myFreeList = nullptr;
+		myChunkIndex = 0;
+		myCarvedCount = 0;
+		myCount = 0;
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::DestroyLive(std::true_type)
+	{
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::DestroyLive(std::false_type)
+	{
+		if (myCount == 0)
+		{
+			return;
+		}
+
+		// Every carved node is live unless it is on the free list. Chunks are found by address.
+		GrowingArray<std::pair<Node*, int>> chunksByAddress(myChunks.Size());
+		for (int index = 0; index < myChunks.Size(); ++index)
+		{
+			chunksByAddress.Add(std::make_pair(myChunks[index], index));
+		}
+		std::sort(chunksByAddress.begin(), chunksByAddress.end(), [](const std::pair<Node*, int>& aLeft, const std::pair<Node*, int>& aRight)
+		{
+			return std::less<Node*>()(aLeft.first, aRight.first);
+		});
+
+		GrowingArray<bool> isFree;
+		isFree.Resize(myChunks.Size() * myObjectsPerChunk);
+		for (Node* node = myFreeList; node != nullptr; node = node->myNext)
+		{
+			const std::pair<Node*, int>* chunk = std::upper_bound(chunksByAddress.begin(), chunksByAddress.end(), node, [](Node* aNode, const std::pair<Node*, int>& aChunk)
+			{
+				return std::less<Node*>()(aNode, aChunk.first);
+			}) - 1;
+			isFree[chunk->second * myObjectsPerChunk + static_cast<int>(node - chunk->first)] = true;
+		}
+
+		for (int chunk = 0; chunk <= myChunkIndex && chunk < myChunks.Size(); ++chunk)
+		{
+			const int carvedCount = chunk < myChunkIndex ? myObjectsPerChunk : myCarvedCount;
+			for (int index = 0; index < carvedCount; ++index)
+			{
+				if (!isFree[chunk * myObjectsPerChunk + index])
+				{
+					reinterpret_cast<T*>(&myChunks[chunk][index].myStorage)->~T();
+				}
+			}
+		}
+	}
+
+	template<class T, class Allocator>
+	inline int ObjectPool<T, Allocator>::Count() const
+	{
+		return myCount;
+	}
+
+	template<class T, class Allocator>
+	inline int ObjectPool<T, Allocator>::Capacity() const
+	{
+		return myChunks.Size() * myObjectsPerChunk;
+	}
+
+	template<class T, class Allocator>
+	inline ObjectPool<T, Allocator>::LocalCache::LocalCache(ObjectPool& aPool, const int aBatchSize) : myPool(aPool)
+	{
+		assert(aBatchSize > 0 && "Batch size must be positive!");
+		myFreeList = nullptr;
+		myFreeCount = 0;
+		myBatchSize = aBatchSize;
+	}
+
+	template<class T, class Allocator>
+	inline ObjectPool<T, Allocator>::LocalCache::~LocalCache()
+	{
+		Flush();
+	}
+
+	template<class T, class Allocator>
+	template<class... Arguments>
+	inline T* ObjectPool<T, Allocator>::LocalCache::Acquire(Arguments&&... someArguments)
+	{
+		if (myFreeList == nullptr)
+		{
+			myFreeList = myPool.AcquireNodes(myBatchSize);
+			myFreeCount = myBatchSize;
+		}
+		Node* node = myFreeList;
+		myFreeList = node->myNext;
+		--myFreeCount;
+		return new (&node->myStorage) T(std::forward<Arguments>(someArguments)...);
+	}
+
+	template<class T, class Allocator>
+	template<class... Arguments>
+	inline typename ObjectPool<T, Allocator>::UniquePointer ObjectPool<T, Allocator>::LocalCache::MakeUnique(Arguments&&... someArguments)
+	{
+		return UniquePointer(Acquire(std::forward<Arguments>(someArguments)...), Releaser(this));
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::LocalCache::Release(T* anObject)
+	{
+		assert(anObject != nullptr && "Can't release nullptr!");
+		anObject->~T();
+		Node* node = reinterpret_cast<Node*>(anObject);
+		node->myNext = myFreeList;
+		myFreeList = node;
+		++myFreeCount;
+
+		// Keeps one batch for the next acquires and hands the rest back
+		if (myFreeCount >= myBatchSize * 2)
+		{
+			Node* last = myFreeList;
+			for (int index = 1; index < myBatchSize; ++index)
+			{
+				last = last->myNext;
+			}
+			Node* kept = last->myNext;
+			myPool.ReleaseNodes(myFreeList, last, myBatchSize);
+			myFreeList = kept;
+			myFreeCount -= myBatchSize;
+		}
+	}
+
+	template<class T, class Allocator>
+	inline void ObjectPool<T, Allocator>::LocalCache::Flush()
+	{
+		if (myFreeList == nullptr)
+		{
+			return;
+		}
+		Node* last = myFreeList;
+		while (last->myNext != nullptr)
+		{
+			last = last->myNext;
+		}
+		myPool.ReleaseNodes(myFreeList, last, myFreeCount);
+		myFreeList = nullptr;
+		myFreeCount = 0;
+	}
+}
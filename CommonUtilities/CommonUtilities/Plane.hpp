@@ -1 +1,114 @@
 #pragma once
+#include "Vector3.hpp"
+
+namespace CommonUtilities
+{
+	// A plane through myPoint with myNormal, kept with its offset (the normal dotted with the point)
+	// so Inside and GetDistance are one dot product. Made from three points, the normal is
+	// (aPoint1 - aPoint0) x (aPoint2 - aPoint0). The normal isn't made unit length until Normalize is called.
+	template <class T>
+	class Plane
+	{
+	public:
+		Plane();
+		Plane(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1, const Vector3<T>& aPoint2);
+		Plane(const Vector3<T>& aPoint0, const Vector3<T>& aNormal);
+		void InitWith3Points(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1, const Vector3<T>& aPoint2);
+		void InitWithPointAndNormal(const Vector3<T>& aPoint, const Vector3<T>& aNormal);
+		// The plane of every point p where aNormal.Dot(p) == anOffset
+		void InitWithNormalAndOffset(const Vector3<T>& aNormal, const T anOffset);
+		// True if aPosition is behind the plane, on the side opposite the normal
+		bool Inside(const Vector3<T>& aPosition) const;
+		// Signed distance along the normal, only a true distance after Normalize
+		T GetDistance(const Vector3<T>& aPosition) const;
+		void Normalize();
+
+		const Vector3<T>& GetPoint() const;
+		const Vector3<T>& GetNormal() const;
+		T GetOffset() const;
+
+	private:
+		Vector3<T> myPoint;
+		Vector3<T> myNormal;
+		T myOffset;
+	};
+
+	template <class T>
+	inline Plane<T>::Plane() : myOffset(0)
+	{
+	}
+
+	template <class T>
+	inline Plane<T>::Plane(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1, const Vector3<T>& aPoint2)
+	{
+		InitWith3Points(aPoint0, aPoint1, aPoint2);
+	}
+
+	template <class T>
+	inline Plane<T>::Plane(const Vector3<T>& aPoint0, const Vector3<T>& aNormal)
+	{
+		InitWithPointAndNormal(aPoint0, aNormal);
+	}
+
+	template <class T>
+	inline void Plane<T>::InitWith3Points(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1, const Vector3<T>& aPoint2)
+	{
+		const Vector3<T> edge0 = aPoint1 - aPoint0;
+		const Vector3<T> edge1 = aPoint2 - aPoint0;
+		InitWithPointAndNormal(aPoint0, edge0.Cross(edge1));
+	}
+
+	template <class T>
+	inline void Plane<T>::InitWithPointAndNormal(const Vector3<T>& aPoint, const Vector3<T>& aNormal)
+	{
+		myPoint = aPoint;
+		myNormal = aNormal;
+		myOffset = myNormal.Dot(myPoint);
+	}
+
+	template <class T>
+	inline void Plane<T>::InitWithNormalAndOffset(const Vector3<T>& aNormal, const T anOffset)
+	{
+		// The point of the plane closest to the origin
+		myPoint = aNormal * (anOffset / aNormal.LengthSqr());
+		myNormal = aNormal;
+		myOffset = anOffset;
+	}
+
+	template <class T>
+	inline bool Plane<T>::Inside(const Vector3<T>& aPosition) const
+	{
+		return myNormal.Dot(aPosition) < myOffset;
+	}
+
+	template <class T>
+	inline T Plane<T>::GetDistance(const Vector3<T>& aPosition) const
+	{
+		return myNormal.Dot(aPosition) - myOffset;
+	}
+
+	template <class T>
+	inline void Plane<T>::Normalize()
+	{
+		myNormal.Normalize();
+		myOffset = myNormal.Dot(myPoint);
+	}
+
+	template <class T>
+	inline const Vector3<T>& Plane<T>::GetPoint() const
+	{
+		return myPoint;
+	}
+
+	template <class T>
+	inline const Vector3<T>& Plane<T>::GetNormal() const
+	{
+		return myNormal;
+	}
+
+	template <class T>
+	inline T Plane<T>::GetOffset() const
+	{
+		return myOffset;
+	}
+}
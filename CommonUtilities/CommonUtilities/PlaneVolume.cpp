@@ -0,0 +1,50 @@
+#include "PlaneVolume.hpp"
+#include "Bits.hpp"
+#include "SimdLevel.hpp"
+#include "SimdPack.hpp"
+
+namespace CU = CommonUtilities;
+
+namespace
+{
+	namespace Scalar
+	{
+		typedef CU::Simd::PackScalar WidePack;
+#include "PlaneVolumeKernels.inl"
+	}
+
+#ifdef CU_SIMD_SSE
+	namespace Sse
+	{
+		typedef CU::Simd::PackSSE WidePack;
+#include "PlaneVolumeKernels.inl"
+	}
+
+CU_SIMD_AVX2_BEGIN
+	namespace Avx2
+	{
+		typedef CU::Simd::PackAVX2 WidePack;
+#include "PlaneVolumeKernels.inl"
+	}
+CU_SIMD_AVX2_END
+
+CU_SIMD_AVX512_BEGIN
+	namespace Avx512
+	{
+		typedef CU::Simd::PackAVX512 WidePack;
+#include "PlaneVolumeKernels.inl"
+	}
+CU_SIMD_AVX512_END
+#endif
+}
+
+namespace CommonUtilities
+{
+	namespace PlaneVolumeKernels
+	{
+		void Classify(const PlaneArrays<float>& somePlanes, const BoundsArrays<float>& someBounds, uint64_t* someVisibleWords, uint64_t* someInsideWords, unsigned char* somePlaneCache)
+		{
+			CU_SIMD_DISPATCH(Classify(somePlanes, someBounds, someVisibleWords, someInsideWords, somePlaneCache));
+		}
+	}
+}
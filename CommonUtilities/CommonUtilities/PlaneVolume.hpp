@@ -1 +1,328 @@
 #pragma once
+#include <assert.h>
+#include <cstdint>
+#include <initializer_list>
+#include <math.h>
+#include <string.h>
+#include <vector>
+#include "GrowingArray.hpp"
+#include "Matrix4x4.hpp"
+#include "Plane.hpp"
+#include "Vector3Stream.hpp"
+
+namespace CommonUtilities
+{
+	// Where a bounding volume lies relative to a PlaneVolume
+	enum class Containment
+	{
+		Outside,
+		Intersecting,
+		Inside
+	};
+
+	// Classifies spheres or boxes given as separate arrays against planes given as separate arrays of
+	// unit normals and offsets. Bit n of someVisibleWords is set unless bounds n is entirely in front of
+	// a plane, bit n of someInsideWords (may be nullptr) if it's entirely behind all of them;
+	// (myCount + 63) / 64 words of each are written.
+	// somePlaneCache (may be nullptr) holds a plane index per PlaneCacheGroupSize bounds, the plane that
+	// rejected the whole group last time. That plane is tried first, so groups that stay outside from frame
+	// to frame are rejected with one test. Groups rather than single bounds, so the SIMD kernels read one
+	// byte per register; it pays off when neighbouring bounds are near each other in the world.
+	// The template is the scalar reference, the float overload is a SIMD kernel chosen at runtime (SimdLevel.hpp).
+	namespace PlaneVolumeKernels
+	{
+		const int PlaneCacheGroupSize = 16;
+
+		template<class T>
+		struct PlaneArrays
+		{
+			const T* myNormalsX;
+			const T* myNormalsY;
+			const T* myNormalsZ;
+			const T* myOffsets;
+			int myCount;
+		};
+
+		// Spheres have their radii in myExtentsX and nullptr in myExtentsY and myExtentsZ,
+		// boxes are centers and half sizes
+		template<class T>
+		struct BoundsArrays
+		{
+			const T* myX;
+			const T* myY;
+			const T* myZ;
+			const T* myExtentsX;
+			const T* myExtentsY;
+			const T* myExtentsZ;
+			int myCount;
+		};
+
+		template<class T>
+		void Classify(const PlaneArrays<T>& somePlanes, const BoundsArrays<T>& someBounds, uint64_t* someVisibleWords, uint64_t* someInsideWords, unsigned char* somePlaneCache)
+		{
+			const int wordCount = (someBounds.myCount + 63) / 64;
+			memset(someVisibleWords, 0, sizeof(uint64_t) * wordCount);
+			if (someInsideWords != nullptr)
+			{
+				memset(someInsideWords, 0, sizeof(uint64_t) * wordCount);
+			}
+
+			const bool isBox = someBounds.myExtentsY != nullptr;
+			for (int index = 0; index < someBounds.myCount; ++index)
+			{
+				auto getDistanceAndRadius = [&](const int aPlane, T& aDistance, T& aRadius)
+				{
+					aDistance = somePlanes.myNormalsX[aPlane] * someBounds.myX[index] + somePlanes.myNormalsY[aPlane] * someBounds.myY[index] + somePlanes.myNormalsZ[aPlane] * someBounds.myZ[index] - somePlanes.myOffsets[aPlane];
+					aRadius = someBounds.myExtentsX[index];
+					if (isBox)
+					{
+						aRadius = someBounds.myExtentsX[index] * fabs(somePlanes.myNormalsX[aPlane]) + someBounds.myExtentsY[index] * fabs(somePlanes.myNormalsY[aPlane]) + someBounds.myExtentsZ[index] * fabs(somePlanes.myNormalsZ[aPlane]);
+					}
+				};
+
+				T distance;
+				T radius;
+				unsigned char* cachedPlane = somePlaneCache != nullptr && somePlanes.myCount > 0 ? somePlaneCache + index / PlaneCacheGroupSize : nullptr;
+				if (cachedPlane != nullptr)
+				{
+					// The cache may have been filled before planes were removed
+					if (*cachedPlane >= somePlanes.myCount)
+					{
+						*cachedPlane = 0;
+					}
+					getDistanceAndRadius(*cachedPlane, distance, radius);
+					if (radius < distance)
+					{
+						continue;
+					}
+				}
+
+				bool outside = false;
+				bool intersecting = false;
+				for (int plane = 0; plane < somePlanes.myCount && !outside; ++plane)
+				{
+					getDistanceAndRadius(plane, distance, radius);
+					outside = radius < distance;
+					intersecting = intersecting || -radius < distance;
+					if (outside && cachedPlane != nullptr)
+					{
+						*cachedPlane = static_cast<unsigned char>(plane);
+					}
+				}
+				if (!outside)
+				{
+					someVisibleWords[index / 64] |= 1ull << (index % 64);
+					if (!intersecting && someInsideWords != nullptr)
+					{
+						someInsideWords[index / 64] |= 1ull << (index % 64);
+					}
+				}
+			}
+		}
+
+		void Classify(const PlaneArrays<float>& somePlanes, const BoundsArrays<float>& someBounds, uint64_t* someVisibleWords, uint64_t* someInsideWords, unsigned char* somePlaneCache);
+	}
+
+	// Convex volume bounded by planes with their normals pointing out, such as a view frustum.
+	// The unit normals and offsets are also kept as separate arrays so whole streams of spheres or
+	// boxes are classified in one call, several per SIMD register.
+	template <class T>
+	class PlaneVolume
+	{
+	public:
+		// Plane caches store plane indices in bytes
+		static const int MaxPlaneCount = 256;
+
+		PlaneVolume();
+		PlaneVolume(const std::vector<Plane<T>>& aPlaneList);
+		PlaneVolume(const std::initializer_list<Plane<T>>& aPlaneList);
+
+		// The left, right, bottom, top, near and far planes of the clip space of aViewProjection.
+		// Row vectors times the matrix, as everywhere in CommonUtilities, with depth from 0 to 1.
+		static PlaneVolume<T> CreateFrustum(const Matrix4x4<T>& aViewProjection);
+
+		void AddPlane(const Plane<T>& aPlane);
+		void RemoveAll();
+		int GetPlaneCount() const;
+		const Plane<T>& GetPlane(const int anIndex) const;
+
+		bool Inside(const Vector3<T>& aPosition) const;
+		Containment ClassifySphere(const Vector3<T>& aCenter, const T aRadius) const;
+		// The box is given by its center and half its size along each axis
+		Containment ClassifyAABB(const Vector3<T>& aCenter, const Vector3<T>& anExtents) const;
+
+		// Bit n of someVisibleWords is set unless sphere n is outside, bit n of someInsideWords (optional)
+		// if it's entirely inside; (Count() + 63) / 64 words are written to each. somePlaneCache (optional)
+		// holds GetPlaneCacheSize(Count()) bytes, zeroed before the first call and kept between calls.
+		void ClassifySpheres(const Vector3Stream<T>& someCenters, const T* someRadii, uint64_t* someVisibleWords, uint64_t* someInsideWords = nullptr, unsigned char* somePlaneCache = nullptr) const;
+		void ClassifyAABBs(const Vector3Stream<T>& someCenters, const Vector3Stream<T>& someExtents, uint64_t* someVisibleWords, uint64_t* someInsideWords = nullptr, unsigned char* somePlaneCache = nullptr) const;
+		static int GetPlaneCacheSize(const int aCount);
+
+	private:
+		Containment Classify(const Vector3<T>& aCenter, const Vector3<T>& anExtents, const bool anIsBox) const;
+		PlaneVolumeKernels::PlaneArrays<T> GetPlaneArrays() const;
+
+		GrowingArray<Plane<T>> myPlanes;
+		// Unit length copies of the planes
+		GrowingArray<T> myNormalsX;
+		GrowingArray<T> myNormalsY;
+		GrowingArray<T> myNormalsZ;
+		GrowingArray<T> myOffsets;
+	};
+
+	template<class T>
+	const int PlaneVolume<T>::MaxPlaneCount;
+
+	template<class T>
+	inline PlaneVolume<T>::PlaneVolume()
+	{
+	}
+
+	template<class T>
+	inline PlaneVolume<T>::PlaneVolume(const std::vector<Plane<T>>& aPlaneList)
+	{
+		for (const Plane<T>& plane : aPlaneList)
+		{
+			AddPlane(plane);
+		}
+	}
+
+	template<class T>
+	inline PlaneVolume<T>::PlaneVolume(const std::initializer_list<Plane<T>>& aPlaneList)
+	{
+		for (const Plane<T>& plane : aPlaneList)
+		{
+			AddPlane(plane);
+		}
+	}
+
+	template<class T>
+	inline PlaneVolume<T> PlaneVolume<T>::CreateFrustum(const Matrix4x4<T>& aViewProjection)
+	{
+		// Clip space coordinate n of a point is the point dotted with column n, so each bound is
+		// a combination of two columns (Gribb and Hartmann)
+		const Matrix4x4<T>& m = aViewProjection;
+		auto makePlane = [&m](const int aColumn, const T aSign, const T aWSign)
+		{
+			const Vector3<T> normal(aSign * m(1, aColumn) + aWSign * m(1, 4), aSign * m(2, aColumn) + aWSign * m(2, 4), aSign * m(3, aColumn) + aWSign * m(3, 4));
+			Plane<T> plane;
+			plane.InitWithNormalAndOffset(normal, -(aSign * m(4, aColumn) + aWSign * m(4, 4)));
+			return plane;
+		};
+
+		PlaneVolume<T> frustum;
+		frustum.AddPlane(makePlane(1, -1, -1));
+		frustum.AddPlane(makePlane(1, 1, -1));
+		frustum.AddPlane(makePlane(2, -1, -1));
+		frustum.AddPlane(makePlane(2, 1, -1));
+		frustum.AddPlane(makePlane(3, -1, 0));
+		frustum.AddPlane(makePlane(3, 1, -1));
+		return frustum;
+	}
+
+	template<class T>
+	inline void PlaneVolume<T>::AddPlane(const Plane<T>& aPlane)
+	{
+		assert(myPlanes.Size() < MaxPlaneCount && "Too many planes!");
+		myPlanes.Add(aPlane);
+		const T length = aPlane.GetNormal().Length();
+		myNormalsX.Add(aPlane.GetNormal().x / length);
+		myNormalsY.Add(aPlane.GetNormal().y / length);
+		myNormalsZ.Add(aPlane.GetNormal().z / length);
+		myOffsets.Add(aPlane.GetOffset() / length);
+	}
+
+	template<class T>
+	inline void PlaneVolume<T>::RemoveAll()
+	{
+		myPlanes.RemoveAll();
+		myNormalsX.RemoveAll();
+		myNormalsY.RemoveAll();
+		myNormalsZ.RemoveAll();
+		myOffsets.RemoveAll();
+	}
+
+	template<class T>
+	inline int PlaneVolume<T>::GetPlaneCount() const
+	{
+		return myPlanes.Size();
+	}
+
+	template<class T>
+	inline const Plane<T>& PlaneVolume<T>::GetPlane(const int anIndex) const
+	{
+		return myPlanes[anIndex];
+	}
+
+	template<class T>
+	inline bool PlaneVolume<T>::Inside(const Vector3<T>& aPosition) const
+	{
+		for (const Plane<T>& plane : myPlanes)
+		{
+			if (!plane.Inside(aPosition))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class T>
+	inline Containment PlaneVolume<T>::ClassifySphere(const Vector3<T>& aCenter, const T aRadius) const
+	{
+		return Classify(aCenter, Vector3<T>(aRadius, 0, 0), false);
+	}
+
+	template<class T>
+	inline Containment PlaneVolume<T>::ClassifyAABB(const Vector3<T>& aCenter, const Vector3<T>& anExtents) const
+	{
+		return Classify(aCenter, anExtents, true);
+	}
+
+	template<class T>
+	inline void PlaneVolume<T>::ClassifySpheres(const Vector3Stream<T>& someCenters, const T* someRadii, uint64_t* someVisibleWords, uint64_t* someInsideWords, unsigned char* somePlaneCache) const
+	{
+		const PlaneVolumeKernels::BoundsArrays<T> bounds = { someCenters.GetX(), someCenters.GetY(), someCenters.GetZ(), someRadii, nullptr, nullptr, someCenters.Count() };
+		PlaneVolumeKernels::Classify(GetPlaneArrays(), bounds, someVisibleWords, someInsideWords, somePlaneCache);
+	}
+
+	template<class T>
+	inline void PlaneVolume<T>::ClassifyAABBs(const Vector3Stream<T>& someCenters, const Vector3Stream<T>& someExtents, uint64_t* someVisibleWords, uint64_t* someInsideWords, unsigned char* somePlaneCache) const
+	{
+		assert(someCenters.Count() == someExtents.Count() && "Centers and extents differ in count!");
+		const PlaneVolumeKernels::BoundsArrays<T> bounds = { someCenters.GetX(), someCenters.GetY(), someCenters.GetZ(), someExtents.GetX(), someExtents.GetY(), someExtents.GetZ(), someCenters.Count() };
+		PlaneVolumeKernels::Classify(GetPlaneArrays(), bounds, someVisibleWords, someInsideWords, somePlaneCache);
+	}
+
+	template<class T>
+	inline int PlaneVolume<T>::GetPlaneCacheSize(const int aCount)
+	{
+		return (aCount + PlaneVolumeKernels::PlaneCacheGroupSize - 1) / PlaneVolumeKernels::PlaneCacheGroupSize;
+	}
+
+	template<class T>
+	inline Containment PlaneVolume<T>::Classify(const Vector3<T>& aCenter, const Vector3<T>& anExtents, const bool anIsBox) const
+	{
+		Containment result = Containment::Inside;
+		for (int plane = 0; plane < myPlanes.Size(); ++plane)
+		{
+			const T distance = myNormalsX[plane] * aCenter.x + myNormalsY[plane] * aCenter.y + myNormalsZ[plane] * aCenter.z - myOffsets[plane];
+			const T radius = anIsBox ? anExtents.x * fabs(myNormalsX[plane]) + anExtents.y * fabs(myNormalsY[plane]) + anExtents.z * fabs(myNormalsZ[plane]) : anExtents.x;
+			if (radius < distance)
+			{
+				return Containment::Outside;
+			}
+			if (-radius < distance)
+			{
+				result = Containment::Intersecting;
+			}
+		}
+		return result;
+	}
+
+	template<class T>
+	inline PlaneVolumeKernels::PlaneArrays<T> PlaneVolume<T>::GetPlaneArrays() const
+	{
+		return { myNormalsX.GetData(), myNormalsY.GetData(), myNormalsZ.GetData(), myOffsets.GetData(), myPlanes.Size() };
+	}
+}
@@ -0,0 +1,97 @@
+// PlaneVolume kernels written once over a Pack (SimdPack.hpp).
+// Included by PlaneVolume.cpp once per instruction set, inside a namespace that defines WidePack.
+// The kernel runs bounds [aBegin, anEnd) where the range is a multiple of Pack::ourWidth, and every
+// width divides 64 so a pack's masks never straddle two words.
+
+template<class Pack, bool isBox>
+void ClassifyKernel(const CU::PlaneVolumeKernels::PlaneArrays<float>& somePlanes, const CU::PlaneVolumeKernels::BoundsArrays<float>& someBounds, uint64_t* someVisibleWords, uint64_t* someInsideWords, unsigned char* somePlaneCache, const int aBegin, const int anEnd)
+{
+	typedef typename Pack::Type Type;
+	const unsigned int allLanes = static_cast<unsigned int>((1ull << Pack::ourWidth) - 1);
+	const Type zero = Pack::Set(0.f);
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		const Type x = Pack::Load(someBounds.myX + index);
+		const Type y = Pack::Load(someBounds.myY + index);
+		const Type z = Pack::Load(someBounds.myZ + index);
+		const Type extentX = Pack::Load(someBounds.myExtentsX + index);
+		const Type extentY = isBox ? Pack::Load(someBounds.myExtentsY + index) : zero;
+		const Type extentZ = isBox ? Pack::Load(someBounds.myExtentsZ + index) : zero;
+
+		auto getDistanceAndRadius = [&](const int aPlane, Type& aDistance, Type& aRadius)
+		{
+			aDistance = Pack::Sub(Pack::MulAdd(z, Pack::Set(somePlanes.myNormalsZ[aPlane]), Pack::MulAdd(y, Pack::Set(somePlanes.myNormalsY[aPlane]), Pack::Mul(x, Pack::Set(somePlanes.myNormalsX[aPlane])))), Pack::Set(somePlanes.myOffsets[aPlane]));
+			aRadius = extentX;
+			if (isBox)
+			{
+				aRadius = Pack::Mul(extentX, Pack::Set(fabsf(somePlanes.myNormalsX[aPlane])));
+				aRadius = Pack::MulAdd(extentY, Pack::Set(fabsf(somePlanes.myNormalsY[aPlane])), aRadius);
+				aRadius = Pack::MulAdd(extentZ, Pack::Set(fabsf(somePlanes.myNormalsZ[aPlane])), aRadius);
+			}
+		};
+
+		Type distance;
+		Type radius;
+		unsigned int outside = 0;
+		unsigned char* cachedPlane = somePlaneCache != nullptr && somePlanes.myCount > 0 ? somePlaneCache + index / CU::PlaneVolumeKernels::PlaneCacheGroupSize : nullptr;
+		if (cachedPlane != nullptr)
+		{
+			// The cache may have been filled before planes were removed
+			if (*cachedPlane >= somePlanes.myCount)
+			{
+				*cachedPlane = 0;
+			}
+			getDistanceAndRadius(*cachedPlane, distance, radius);
+			if (Pack::LessMask(radius, distance) == allLanes)
+			{
+				continue;
+			}
+		}
+
+		unsigned int intersecting = 0;
+		for (int plane = 0; plane < somePlanes.myCount; ++plane)
+		{
+			getDistanceAndRadius(plane, distance, radius);
+			intersecting |= Pack::LessMask(Pack::Sub(zero, radius), distance);
+			outside |= Pack::LessMask(radius, distance);
+			if (outside == allLanes)
+			{
+				if (cachedPlane != nullptr)
+				{
+					*cachedPlane = static_cast<unsigned char>(plane);
+				}
+				break;
+			}
+		}
+
+		const unsigned int visible = allLanes & ~outside;
+		someVisibleWords[index / 64] |= static_cast<uint64_t>(visible) << (index % 64);
+		if (someInsideWords != nullptr)
+		{
+			someInsideWords[index / 64] |= static_cast<uint64_t>(visible & ~intersecting) << (index % 64);
+		}
+	}
+}
+
+void Classify(const CU::PlaneVolumeKernels::PlaneArrays<float>& somePlanes, const CU::PlaneVolumeKernels::BoundsArrays<float>& someBounds, uint64_t* someVisibleWords, uint64_t* someInsideWords, unsigned char* somePlaneCache)
+{
+	const int count = someBounds.myCount;
+	const int wordCount = (count + 63) / 64;
+	memset(someVisibleWords, 0, sizeof(uint64_t) * wordCount);
+	if (someInsideWords != nullptr)
+	{
+		memset(someInsideWords, 0, sizeof(uint64_t) * wordCount);
+	}
+
+	const int packedEnd = count - count % WidePack::ourWidth;
+	if (someBounds.myExtentsY != nullptr)
+	{
+		ClassifyKernel<WidePack, true>(somePlanes, someBounds, someVisibleWords, someInsideWords, somePlaneCache, 0, packedEnd);
+		ClassifyKernel<CU::Simd::PackScalar, true>(somePlanes, someBounds, someVisibleWords, someInsideWords, somePlaneCache, packedEnd, count);
+	}
+	else
+	{
+		ClassifyKernel<WidePack, false>(somePlanes, someBounds, someVisibleWords, someInsideWords, somePlaneCache, 0, packedEnd);
+		ClassifyKernel<CU::Simd::PackScalar, false>(somePlanes, someBounds, someVisibleWords, someInsideWords, somePlaneCache, packedEnd, count);
+	}
+}
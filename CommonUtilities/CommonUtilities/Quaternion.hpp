@@ -0,0 +1,332 @@
+#pragma once
+#include <math.h>
+#include "Simd.hpp"
+#include "Vector3.hpp"
+#include "Matrix3x3.hpp"
+#include "Matrix4x4.hpp"
+
+namespace CommonUtilities
+{
+	// Rotation stored as x, y, z = axis * sin(angle / 2) and w = cos(angle / 2).
+	// Products follow the same order as the matrices: a * b rotates by a first and then by b,
+	// so (a * b).GetRotationMatrix4x4() equals a.GetRotationMatrix4x4() * b.GetRotationMatrix4x4().
+	template <class T>
+	class alignas(SimdAlignment<T, 4>::value) Quaternion
+	{
+	public:
+		T x;
+		T y;
+		T z;
+		T w;
+
+		// Creates the identity rotation
+		Quaternion<T>();
+
+		Quaternion<T>(const T& aX, const T& aY, const T& aZ, const T& aW);
+
+		// Rotation of anAngleInRadians around a normalized axis
+		Quaternion<T>(const Vector3<T>& anAxis, const T anAngleInRadians);
+
+		// Rotation around X, then Y, then Z, the same as
+		// CreateRotationAroundX(angles.x) * CreateRotationAroundY(angles.y) * CreateRotationAroundZ(angles.z)
+		explicit Quaternion<T>(const Vector3<T>& anEulerAnglesInRadians);
+
+		Quaternion<T>(const Quaternion<T>& aQuaternion) = default;
+
+		~Quaternion<T>() = default;
+
+		T LengthSqr() const;
+
+		T Length() const;
+
+		Quaternion<T> GetNormalized() const;
+
+		void Normalize();
+
+		T Dot(const Quaternion<T>& aQuaternion) const;
+
+		// The inverse rotation of a normalized quaternion
+		Quaternion<T> GetConjugate() const;
+
+		Vector3<T> RotateVector(const Vector3<T>& aVector) const;
+
+		Matrix3x3<T> GetRotationMatrix3x3() const;
+
+		Matrix4x4<T> GetRotationMatrix4x4() const;
+
+		// Interpolation along the shortest path, aFrom and aTo must be normalized.
+		// Nlerp is cheaper but does not move at constant angular speed.
+		static Quaternion<T> Nlerp(const Quaternion<T>& aFrom, const Quaternion<T>& aTo, const T aT);
+		static Quaternion<T> Slerp(const Quaternion<T>& aFrom, const Quaternion<T>& aTo, const T aT);
+	};
+
+	template <class T>
+	inline Quaternion<T>::Quaternion()
+	{
+		x = 0;
+		y = 0;
+		z = 0;
+		w = 1;
+	}
+
+	template <class T>
+	inline Quaternion<T>::Quaternion(const T& aX, const T& aY, const T& aZ, const T& aW)
+	{
+		x = aX;
+		y = aY;
+		z = aZ;
+		w = aW;
+	}
+
+	template <class T>
+	inline Quaternion<T>::Quaternion(const Vector3<T>& anAxis, const T anAngleInRadians)
+	{
+		const T halfSin = sin(anAngleInRadians / 2);
+		x = anAxis.x * halfSin;
+		y = anAxis.y * halfSin;
+		z = anAxis.z * halfSin;
+		w = cos(anAngleInRadians / 2);
+	}
+
+	template <class T>
+	inline Quaternion<T>::Quaternion(const Vector3<T>& anEulerAnglesInRadians)
+	{
+		const T sinX = sin(anEulerAnglesInRadians.x / 2);
+		const T cosX = cos(anEulerAnglesInRadians.x / 2);
+		const T sinY = sin(anEulerAnglesInRadians.y / 2);
+		const T cosY = cos(anEulerAnglesInRadians.y / 2);
+		const T sinZ = sin(anEulerAnglesInRadians.z / 2);
+		const T cosZ = cos(anEulerAnglesInRadians.z / 2);
+
+		x = sinX * cosY * cosZ - cosX * sinY * sinZ;
+		y = cosX * sinY * cosZ + sinX * cosY * sinZ;
+		z = cosX * cosY * sinZ - sinX * sinY * cosZ;
+		w = cosX * cosY * cosZ + sinX * sinY * sinZ;
+	}
+
+	template <class T>
+	inline T Quaternion<T>::LengthSqr() const
+	{
+		return (x * x) + (y * y) + (z * z) + (w * w);
+	}
+
+	template <class T>
+	inline T Quaternion<T>::Length() const
+	{
+		return sqrt((x * x) + (y * y) + (z * z) + (w * w));
+	}
+
+	template <class T>
+	inline Quaternion<T> Quaternion<T>::GetNormalized() const
+	{
+		const T length = Length();
+		return Quaternion<T>(x / length, y / length, z / length, w / length);
+	}
+
+	template <class T>
+	inline void Quaternion<T>::Normalize()
+	{
+		const T length = Length();
+		x /= length;
+		y /= length;
+		z /= length;
+		w /= length;
+	}
+
+	template <class T>
+	inline T Quaternion<T>::Dot(const Quaternion<T>& aQuaternion) const
+	{
+		return T(x * aQuaternion.x + y * aQuaternion.y + z * aQuaternion.z + w * aQuaternion.w);
+	}
+
+	template <class T>
+	inline Quaternion<T> Quaternion<T>::GetConjugate() const
+	{
+		return Quaternion<T>(-x, -y, -z, w);
+	}
+
+	template <class T>
+	inline Vector3<T> Quaternion<T>::RotateVector(const Vector3<T>& aVector) const
+	{
+		// v + 2w(u x v) + 2u x (u x v), with u the vector part
+		const Vector3<T> axis(x, y, z);
+		const Vector3<T> twiceCross = axis.Cross(aVector) * T(2);
+		return aVector + twiceCross * w + axis.Cross(twiceCross);
+	}
+
+	template <class T>
+	inline Matrix3x3<T> Quaternion<T>::GetRotationMatrix3x3() const
+	{
+		const T xx = x * x;
+		const T yy = y * y;
+		const T zz = z * z;
+		const T xy = x * y;
+		const T xz = x * z;
+		const T yz = y * z;
+		const T wx = w * x;
+		const T wy = w * y;
+		const T wz = w * z;
+
+		return Matrix3x3<T>(1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy),
+							2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx),
+							2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy));
+	}
+
+	template <class T>
+	inline Matrix4x4<T> Quaternion<T>::GetRotationMatrix4x4() const
+	{
+		return Matrix4x4<T>(GetRotationMatrix3x3());
+	}
+
+	template <class T>
+	inline Quaternion<T> Quaternion<T>::Nlerp(const Quaternion<T>& aFrom, const Quaternion<T>& aTo, const T aT)
+	{
+		// q and -q are the same rotation, blending towards the closer one takes the short way
+		const T toWeight = aFrom.Dot(aTo) < 0 ? -aT : aT;
+		const T fromWeight = 1 - aT;
+		Quaternion<T> result(aFrom.x * fromWeight + aTo.x * toWeight,
+							 aFrom.y * fromWeight + aTo.y * toWeight,
+							 aFrom.z * fromWeight + aTo.z * toWeight,
+							 aFrom.w * fromWeight + aTo.w * toWeight);
+		result.Normalize();
+		return result;
+	}
+
+	template <class T>
+	inline Quaternion<T> Quaternion<T>::Slerp(const Quaternion<T>& aFrom, const Quaternion<T>& aTo, const T aT)
+	{
+		T cosAngle = aFrom.Dot(aTo);
+		T sign = 1;
+		if (cosAngle < 0)
+		{
+			cosAngle = -cosAngle;
+			sign = -1;
+		}
+
+		// Nearly parallel, sin(angle) is too small to divide by
+		if (cosAngle > T(0.9995))
+		{
+			return Nlerp(aFrom, aTo, aT);
+		}
+
+		const T angle = acos(cosAngle);
+		const T inverseSin = 1 / sin(angle);
+		const T fromWeight = sin((1 - aT) * angle) * inverseSin;
+		const T toWeight = sin(aT * angle) * inverseSin * sign;
+		return Quaternion<T>(aFrom.x * fromWeight + aTo.x * toWeight,
+							 aFrom.y * fromWeight + aTo.y * toWeight,
+							 aFrom.z * fromWeight + aTo.z * toWeight,
+							 aFrom.w * fromWeight + aTo.w * toWeight);
+	}
+
+	template <class T>
+	inline Matrix4x4<T> Matrix4x4<T>::CreateTRS(const Vector3<T>& aTranslation, const Quaternion<T>& aRotation, const Vector3<T>& aScale)
+	{
+		const T xx = aRotation.x * aRotation.x;
+		const T yy = aRotation.y * aRotation.y;
+		const T zz = aRotation.z * aRotation.z;
+		const T xy = aRotation.x * aRotation.y;
+		const T xz = aRotation.x * aRotation.z;
+		const T yz = aRotation.y * aRotation.z;
+		const T wx = aRotation.w * aRotation.x;
+		const T wy = aRotation.w * aRotation.y;
+		const T wz = aRotation.w * aRotation.z;
+
+		return Matrix4x4<T>(aScale.x * (1 - 2 * (yy + zz)), aScale.x * (2 * (xy + wz)), aScale.x * (2 * (xz - wy)), 0,
+			aScale.y * (2 * (xy - wz)), aScale.y * (1 - 2 * (xx + zz)), aScale.y * (2 * (yz + wx)), 0,
+			aScale.z * (2 * (xz + wy)), aScale.z * (2 * (yz - wx)), aScale.z * (1 - 2 * (xx + yy)), 0,
+			aTranslation.x, aTranslation.y, aTranslation.z, 1);
+	}
+
+	template <class T>
+	inline bool operator==(const Quaternion<T>& aQuaternion, const Quaternion<T>& aSecondQuaternion)
+	{
+		return aQuaternion.x == aSecondQuaternion.x && aQuaternion.y == aSecondQuaternion.y &&
+			   aQuaternion.z == aSecondQuaternion.z && aQuaternion.w == aSecondQuaternion.w;
+	}
+
+	// aQuaternion first, then aSecondQuaternion
+	template <class T>
+	inline Quaternion<T> operator*(const Quaternion<T>& aQuaternion, const Quaternion<T>& aSecondQuaternion)
+	{
+		const Quaternion<T>& a = aSecondQuaternion;
+		const Quaternion<T>& b = aQuaternion;
+		return Quaternion<T>(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+							 a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+							 a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+							 a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+	}
+
+	template <class T>
+	inline Quaternion<T>& operator*=(Quaternion<T>& aQuaternion, const Quaternion<T>& aSecondQuaternion)
+	{
+		return aQuaternion = aQuaternion * aSecondQuaternion;
+	}
+
+	template <class T>
+	inline Vector3<T> operator*(const Vector3<T>& aVector, const Quaternion<T>& aQuaternion)
+	{
+		return aQuaternion.RotateVector(aVector);
+	}
+
+#ifdef CU_SIMD_SSE
+	inline Quaternion<float> operator*(const Quaternion<float>& aQuaternion, const Quaternion<float>& aSecondQuaternion)
+	{
+		// Each component of the second quaternion times a signed swizzle of the first
+		const __m128 a = _mm_load_ps(&aSecondQuaternion.x);
+		const __m128 b = _mm_load_ps(&aQuaternion.x);
+		__m128 result = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3))), _mm_setr_ps(1.f, -1.f, 1.f, -1.f)));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))), _mm_setr_ps(1.f, 1.f, -1.f, -1.f)));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1))), _mm_setr_ps(-1.f, 1.f, 1.f, -1.f)));
+
+		Quaternion<float> quaternion;
+		_mm_store_ps(&quaternion.x, result);
+		return quaternion;
+	}
+
+	// Blends all four components in one register, the caller has already picked the weights
+	inline Quaternion<float> BlendQuaternions(const Quaternion<float>& aFrom, const Quaternion<float>& aTo, const float aFromWeight, const float aToWeight, const bool aNormalize)
+	{
+		__m128 result = _mm_add_ps(_mm_mul_ps(_mm_load_ps(&aFrom.x), _mm_set1_ps(aFromWeight)), _mm_mul_ps(_mm_load_ps(&aTo.x), _mm_set1_ps(aToWeight)));
+		if (aNormalize)
+		{
+			__m128 lengthSqr = _mm_mul_ps(result, result);
+			lengthSqr = _mm_add_ps(lengthSqr, _mm_shuffle_ps(lengthSqr, lengthSqr, _MM_SHUFFLE(2, 3, 0, 1)));
+			lengthSqr = _mm_add_ps(lengthSqr, _mm_shuffle_ps(lengthSqr, lengthSqr, _MM_SHUFFLE(1, 0, 3, 2)));
+			result = _mm_div_ps(result, _mm_sqrt_ps(lengthSqr));
+		}
+
+		Quaternion<float> quaternion;
+		_mm_store_ps(&quaternion.x, result);
+		return quaternion;
+	}
+
+	template<>
+	inline Quaternion<float> Quaternion<float>::Nlerp(const Quaternion<float>& aFrom, const Quaternion<float>& aTo, const float aT)
+	{
+		return BlendQuaternions(aFrom, aTo, 1.f - aT, aFrom.Dot(aTo) < 0.f ? -aT : aT, true);
+	}
+
+	template<>
+	inline Quaternion<float> Quaternion<float>::Slerp(const Quaternion<float>& aFrom, const Quaternion<float>& aTo, const float aT)
+	{
+		float cosAngle = aFrom.Dot(aTo);
+		float sign = 1.f;
+		if (cosAngle < 0.f)
+		{
+			cosAngle = -cosAngle;
+			sign = -1.f;
+		}
+
+		if (cosAngle > 0.9995f)
+		{
+			return Nlerp(aFrom, aTo, aT);
+		}
+
+		const float angle = acosf(cosAngle);
+		const float inverseSin = 1.f / sinf(angle);
+		return BlendQuaternions(aFrom, aTo, sinf((1.f - aT) * angle) * inverseSin, sinf(aT * angle) * inverseSin * sign, false);
+	}
+#endif
+}
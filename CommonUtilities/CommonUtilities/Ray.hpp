@@ -0,0 +1,68 @@
+#pragma once
+#include "Vector3.hpp"
+
+namespace CommonUtilities
+{
+	// A half-line from myOrigin along myDirection. Hit distances are measured in lengths of the
+	// direction, so they are only world distances when it's unit length.
+	template <class T>
+	class Ray
+	{
+	public:
+		Ray();
+		Ray(const Vector3<T>& anOrigin, const Vector3<T>& aDirection);
+		// The ray from aPoint0 through aPoint1, with aPoint1 at distance 1
+		void InitWith2Points(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1);
+		void InitWithOriginAndDirection(const Vector3<T>& anOrigin, const Vector3<T>& aDirection);
+
+		Vector3<T> GetPoint(const T aDistance) const;
+		const Vector3<T>& GetOrigin() const;
+		const Vector3<T>& GetDirection() const;
+
+	private:
+		Vector3<T> myOrigin;
+		Vector3<T> myDirection;
+	};
+
+	template <class T>
+	inline Ray<T>::Ray()
+	{
+	}
+
+	template <class T>
+	inline Ray<T>::Ray(const Vector3<T>& anOrigin, const Vector3<T>& aDirection) : myOrigin(anOrigin), myDirection(aDirection)
+	{
+	}
+
+	template <class T>
+	inline void Ray<T>::InitWith2Points(const Vector3<T>& aPoint0, const Vector3<T>& aPoint1)
+	{
+		myOrigin = aPoint0;
+		myDirection = aPoint1 - aPoint0;
+	}
+
+	template <class T>
+	inline void Ray<T>::InitWithOriginAndDirection(const Vector3<T>& anOrigin, const Vector3<T>& aDirection)
+	{
+		myOrigin = anOrigin;
+		myDirection = aDirection;
+	}
+
+	template <class T>
+	inline Vector3<T> Ray<T>::GetPoint(const T aDistance) const
+	{
+		return myOrigin + myDirection * aDistance;
+	}
+
+	template <class T>
+	inline const Vector3<T>& Ray<T>::GetOrigin() const
+	{
+		return myOrigin;
+	}
+
+	template <class T>
+	inline const Vector3<T>& Ray<T>::GetDirection() const
+	{
+		return myDirection;
+	}
+}
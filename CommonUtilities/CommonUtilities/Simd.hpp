@@ -0,0 +1,61 @@
+#pragma once
+
+// Selects the SIMD instruction sets the math types are allowed to use.
+// Define CU_SIMD_DISABLE to force the scalar templates everywhere.
+#if !defined(CU_SIMD_DISABLE) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define CU_SIMD_SSE 1
+#include <immintrin.h>
+#endif
+
+#if defined(CU_SIMD_SSE) && defined(__AVX__)
+#define CU_SIMD_AVX 1
+#endif
+
+#if defined(CU_SIMD_AVX) && defined(__AVX2__)
+#define CU_SIMD_AVX2 1
+#endif
+
+// Marks a function that uses AVX2/FMA (or AVX-512F) intrinsics without compiling the whole file for AVX2.
+// Callers must check GetSimdLevel (SimdLevel.hpp) before calling such a function.
+#if defined(CU_SIMD_SSE) && (defined(__GNUC__) || defined(__clang__))
+#define CU_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define CU_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define CU_TARGET_AVX2
+#define CU_TARGET_AVX512
+#endif
+
+// Everything between these two compiles with AVX2/FMA enabled, including templates that are
+// instantiated later. Used to build a second copy of a kernel set next to the SSE one.
+#if defined(CU_SIMD_SSE) && defined(__clang__)
+#define CU_SIMD_AVX2_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx2,fma\"))), apply_to = function)")
+#define CU_SIMD_AVX2_END _Pragma("clang attribute pop")
+#elif defined(CU_SIMD_SSE) && defined(__GNUC__)
+#define CU_SIMD_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma\")")
+#define CU_SIMD_AVX2_END _Pragma("GCC pop_options")
+#else
+#define CU_SIMD_AVX2_BEGIN
+#define CU_SIMD_AVX2_END
+#endif
+
+// The same for a third copy built for AVX-512F
+#if defined(CU_SIMD_SSE) && defined(__clang__)
+#define CU_SIMD_AVX512_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx512f,avx2,fma\"))), apply_to = function)")
+#define CU_SIMD_AVX512_END _Pragma("clang attribute pop")
+#elif defined(CU_SIMD_SSE) && defined(__GNUC__)
+#define CU_SIMD_AVX512_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx2,fma\")")
+#define CU_SIMD_AVX512_END _Pragma("GCC pop_options")
+#else
+#define CU_SIMD_AVX512_BEGIN
+#define CU_SIMD_AVX512_END
+#endif
+
+namespace CommonUtilities
+{
+	// Alignment used for the float types that are loaded straight into SSE registers
+	template<class T, int count>
+	struct SimdAlignment
+	{
+		static constexpr int value = (sizeof(T) == 4 && count == 4) ? 16 : alignof(T);
+	};
+}
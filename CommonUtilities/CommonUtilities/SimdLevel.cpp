@@ -0,0 +1,105 @@
+#include "SimdLevel.hpp"
+#include "CpuFeatures.hpp"
+#include <cstdlib>
+#include <string>
+
+namespace CU = CommonUtilities;
+
+namespace
+{
+	CU::SimdLevel DetectSupportedLevel()
+	{
+#ifdef CU_SIMD_SSE
+		const CU::CpuFeatures& features = CU::CpuFeatures::Get();
+		if (features.HasAVX512F())
+		{
+			return CU::SimdLevel::AVX512;
+		}
+		if (features.HasAVX2() && features.HasFMA())
+		{
+			return CU::SimdLevel::AVX2;
+		}
+		return CU::SimdLevel::SSE2;
+#else
+		return CU::SimdLevel::Scalar;
+#endif
+	}
+
+	std::string ReadEnvironmentVariable(const char* aName)
+	{
+#if defined(_MSC_VER)
+		char* value = nullptr;
+		size_t length = 0;
+		std::string result;
+		if (_dupenv_s(&value, &length, aName) == 0 && value != nullptr)
+		{
+			result = value;
+		}
+		free(value);
+		return result;
+#else
+		const char* value = std::getenv(aName);
+		return value != nullptr ? value : "";
+#endif
+	}
+
+	CU::SimdLevel Clamp(const CU::SimdLevel aLevel)
+	{
+		const CU::SimdLevel supported = CU::GetSupportedSimdLevel();
+		return aLevel < supported ? aLevel : supported;
+	}
+
+	CU::SimdLevel DetectStartLevel()
+	{
+		const std::string requested = ReadEnvironmentVariable("CU_SIMD_LEVEL");
+		for (int level = static_cast<int>(CU::SimdLevel::Scalar); level <= static_cast<int>(CU::SimdLevel::AVX512); ++level)
+		{
+			if (requested == CU::GetSimdLevelName(static_cast<CU::SimdLevel>(level)))
+			{
+				return Clamp(static_cast<CU::SimdLevel>(level));
+			}
+		}
+		return CU::GetSupportedSimdLevel();
+	}
+
+	CU::SimdLevel& ActiveLevel()
+	{
+		static CU::SimdLevel ourLevel = DetectStartLevel();
+		return ourLevel;
+	}
+}
+
+namespace CommonUtilities
+{
+	SimdLevel GetSupportedSimdLevel()
+	{
+		static const SimdLevel ourSupportedLevel = DetectSupportedLevel();
+		return ourSupportedLevel;
+	}
+
+	SimdLevel GetSimdLevel()
+	{
+		return ActiveLevel();
+	}
+
+	SimdLevel SetSimdLevel(const SimdLevel aLevel)
+	{
+		ActiveLevel() = Clamp(aLevel);
+		return ActiveLevel();
+	}
+
+	const char* GetSimdLevelName(const SimdLevel aLevel)
+	{
+		switch (aLevel)
+		{
+		case SimdLevel::SSE2:
+			return "sse2";
+		case SimdLevel::AVX2:
+			return "avx2";
+		case SimdLevel::AVX512:
+			return "avx512";
+		default:
+			return "scalar";
+		}
+	}
+}
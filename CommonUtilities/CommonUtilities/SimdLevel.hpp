@@ -0,0 +1,50 @@
+#pragma once
+#include "Simd.hpp"
+
+namespace CommonUtilities
+{
+	// Kernel sets the batch functions (TransformBatch, Vector3Stream) are built in, narrowest first
+	enum class SimdLevel
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		AVX512
+	};
+
+	// The widest level both this build and the CPU support
+	SimdLevel GetSupportedSimdLevel();
+
+	// The level the batch functions run at. Chosen on first use: the supported level, or the one named
+	// by the CU_SIMD_LEVEL environment variable (scalar, sse2, avx2 or avx512) if that is lower.
+	SimdLevel GetSimdLevel();
+
+	// Forces a level for tests and benchmarks, clamped to the supported one, and returns the level
+	// now in use. Not synchronized; call it while no batch function is running.
+	SimdLevel SetSimdLevel(const SimdLevel aLevel);
+
+	const char* GetSimdLevelName(const SimdLevel aLevel);
+}
+
+// Calls the kernel set for the current level. Expects namespaces Avx512, Avx2, Sse and Scalar
+// (only Scalar without CU_SIMD_SSE) that each declare the called function.
+#ifdef CU_SIMD_SSE
+#define CU_SIMD_DISPATCH(...) \
+	switch (CommonUtilities::GetSimdLevel()) \
+	{ \
+	case CommonUtilities::SimdLevel::AVX512: \
+		Avx512::__VA_ARGS__; \
+		break; \
+	case CommonUtilities::SimdLevel::AVX2: \
+		Avx2::__VA_ARGS__; \
+		break; \
+	case CommonUtilities::SimdLevel::SSE2: \
+		Sse::__VA_ARGS__; \
+		break; \
+	default: \
+		Scalar::__VA_ARGS__; \
+		break; \
+	}
+#else
+#define CU_SIMD_DISPATCH(...) Scalar::__VA_ARGS__;
+#endif
@@ -0,0 +1,328 @@
+#pragma once
+#include <math.h>
+#include "Simd.hpp"
+
+namespace CommonUtilities
+{
+	namespace Simd
+	{
+		// Packs wrap one register of floats behind the same static interface, so a kernel written
+		// as a template over Pack runs one float at a time (PackScalar), four (PackSSE), eight (PackAVX2)
+		// or sixteen (PackAVX512).
+
+		struct PackScalar
+		{
+			typedef float Type;
+			static const int ourWidth = 1;
+
+			static Type Load(const float* aSource) { return *aSource; }
+			static void Store(float* aDestination, const Type aValue) { *aDestination = aValue; }
+			static Type Set(const float aValue) { return aValue; }
+			static Type Add(const Type aLeft, const Type aRight) { return aLeft + aRight; }
+			static Type Sub(const Type aLeft, const Type aRight) { return aLeft - aRight; }
+			static Type Mul(const Type aLeft, const Type aRight) { return aLeft * aRight; }
+			static Type Div(const Type aLeft, const Type aRight) { return aLeft / aRight; }
+			static Type MulAdd(const Type aLeft, const Type aRight, const Type anAddend) { return aLeft * aRight + anAddend; }
+			static Type Sqrt(const Type aValue) { return sqrtf(aValue); }
+			static Type Min(const Type aLeft, const Type aRight) { return aLeft < aRight ? aLeft : aRight; }
+			static Type Max(const Type aLeft, const Type aRight) { return aLeft > aRight ? aLeft : aRight; }
+			static Type Round(const Type aValue) { return floorf(aValue + 0.5f); }
+			static unsigned int LessMask(const Type aLeft, const Type aRight) { return aLeft < aRight ? 1u : 0u; }
+
+			static void LoadXY(const float* aSource, Type& aX, Type& aY)
+			{
+				aX = aSource[0];
+				aY = aSource[1];
+			}
+
+			static void LoadXYZ(const float* aSource, Type& aX, Type& aY, Type& aZ)
+			{
+				aX = aSource[0];
+				aY = aSource[1];
+				aZ = aSource[2];
+			}
+
+			static void StoreXYZ(float* aDestination, const Type aX, const Type aY, const Type aZ)
+			{
+				aDestination[0] = aX;
+				aDestination[1] = aY;
+				aDestination[2] = aZ;
+			}
+
+			static void LoadTransposed4(const float* aSource, const int, Type& aX, Type& aY, Type& aZ, Type& aW)
+			{
+				aX = aSource[0];
+				aY = aSource[1];
+				aZ = aSource[2];
+				aW = aSource[3];
+			}
+
+			static void StoreTransposed4(float* aDestination, const int, const Type aX, const Type aY, const Type aZ, const Type aW)
+			{
+				aDestination[0] = aX;
+				aDestination[1] = aY;
+				aDestination[2] = aZ;
+				aDestination[3] = aW;
+			}
+		};
+
+#ifdef CU_SIMD_SSE
+		struct PackSSE
+		{
+			typedef __m128 Type;
+			static const int ourWidth = 4;
+
+			static Type Load(const float* aSource) { return _mm_loadu_ps(aSource); }
+			static void Store(float* aDestination, const Type aValue) { _mm_storeu_ps(aDestination, aValue); }
+			static Type Set(const float aValue) { return _mm_set1_ps(aValue); }
+			static Type Add(const Type aLeft, const Type aRight) { return _mm_add_ps(aLeft, aRight); }
+			static Type Sub(const Type aLeft, const Type aRight) { return _mm_sub_ps(aLeft, aRight); }
+			static Type Mul(const Type aLeft, const Type aRight) { return _mm_mul_ps(aLeft, aRight); }
+			static Type Div(const Type aLeft, const Type aRight) { return _mm_div_ps(aLeft, aRight); }
+			static Type MulAdd(const Type aLeft, const Type aRight, const Type anAddend) { return _mm_add_ps(_mm_mul_ps(aLeft, aRight), anAddend); }
+			static Type Sqrt(const Type aValue) { return _mm_sqrt_ps(aValue); }
+			static Type Min(const Type aLeft, const Type aRight) { return _mm_min_ps(aLeft, aRight); }
+			static Type Max(const Type aLeft, const Type aRight) { return _mm_max_ps(aLeft, aRight); }
+			static Type Round(const Type aValue) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(aValue)); }
+			// Bit n is set if lane n of aLeft is less than lane n of aRight
+			static unsigned int LessMask(const Type aLeft, const Type aRight) { return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(aLeft, aRight))); }
+
+			// Four packed xy pairs (8 floats) to separate x and y registers
+			static void LoadXY(const float* aSource, Type& aX, Type& aY)
+			{
+				const __m128 a = _mm_loadu_ps(aSource);
+				const __m128 b = _mm_loadu_ps(aSource + 4);
+				aX = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+				aY = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+			}
+
+			// Four packed xyz triplets (12 floats) to and from separate x, y and z registers
+			static void LoadXYZ(const float* aSource, Type& aX, Type& aY, Type& aZ)
+			{
+				const __m128 a = _mm_loadu_ps(aSource);
+				const __m128 b = _mm_loadu_ps(aSource + 4);
+				const __m128 c = _mm_loadu_ps(aSource + 8);
+				aX = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+				aY = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				aZ = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+			}
+
+			static void StoreXYZ(float* aDestination, const Type aX, const Type aY, const Type aZ)
+			{
+				_mm_storeu_ps(aDestination, _mm_shuffle_ps(_mm_shuffle_ps(aX, aY, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(aZ, aX, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(aDestination + 4, _mm_shuffle_ps(_mm_shuffle_ps(aY, aZ, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(aX, aY, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(aDestination + 8, _mm_shuffle_ps(_mm_shuffle_ps(aZ, aX, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(aY, aZ, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+			}
+
+			// Four records of four floats, aStride floats apart, to and from one register per record member
+			static void LoadTransposed4(const float* aSource, const int aStride, Type& aX, Type& aY, Type& aZ, Type& aW)
+			{
+				aX = _mm_loadu_ps(aSource);
+				aY = _mm_loadu_ps(aSource + aStride);
+				aZ = _mm_loadu_ps(aSource + aStride * 2);
+				aW = _mm_loadu_ps(aSource + aStride * 3);
+				_MM_TRANSPOSE4_PS(aX, aY, aZ, aW);
+			}
+
+			static void StoreTransposed4(float* aDestination, const int aStride, Type aX, Type aY, Type aZ, Type aW)
+			{
+				_MM_TRANSPOSE4_PS(aX, aY, aZ, aW);
+				_mm_storeu_ps(aDestination, aX);
+				_mm_storeu_ps(aDestination + aStride, aY);
+				_mm_storeu_ps(aDestination + aStride * 2, aZ);
+				_mm_storeu_ps(aDestination + aStride * 3, aW);
+			}
+		};
+
+CU_SIMD_AVX2_BEGIN
+		struct PackAVX2
+		{
+			typedef __m256 Type;
+			static const int ourWidth = 8;
+
+			static Type Load(const float* aSource) { return _mm256_loadu_ps(aSource); }
+			static void Store(float* aDestination, const Type aValue) { _mm256_storeu_ps(aDestination, aValue); }
+			static Type Set(const float aValue) { return _mm256_set1_ps(aValue); }
+			static Type Add(const Type aLeft, const Type aRight) { return _mm256_add_ps(aLeft, aRight); }
+			static Type Sub(const Type aLeft, const Type aRight) { return _mm256_sub_ps(aLeft, aRight); }
+			static Type Mul(const Type aLeft, const Type aRight) { return _mm256_mul_ps(aLeft, aRight); }
+			static Type Div(const Type aLeft, const Type aRight) { return _mm256_div_ps(aLeft, aRight); }
+			static Type MulAdd(const Type aLeft, const Type aRight, const Type anAddend) { return _mm256_fmadd_ps(aLeft, aRight, anAddend); }
+			static Type Sqrt(const Type aValue) { return _mm256_sqrt_ps(aValue); }
+			static Type Min(const Type aLeft, const Type aRight) { return _mm256_min_ps(aLeft, aRight); }
+			static Type Max(const Type aLeft, const Type aRight) { return _mm256_max_ps(aLeft, aRight); }
+			static Type Round(const Type aValue) { return _mm256_round_ps(aValue, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+			static unsigned int LessMask(const Type aLeft, const Type aRight) { return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(aLeft, aRight, _CMP_LT_OQ))); }
+
+			// Eight packed xy pairs (16 floats). The in-lane shuffle leaves the 64-bit halves as 0, 2, 1, 3.
+			static void LoadXY(const float* aSource, Type& aX, Type& aY)
+			{
+				const __m256 a = _mm256_loadu_ps(aSource);
+				const __m256 b = _mm256_loadu_ps(aSource + 8);
+				aX = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+				aY = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+			}
+
+			// Eight packed xyz triplets (24 floats). Every third float belongs to the same axis, so each
+			// axis is gathered with two blends and put in order with one lane-crossing permute.
+			static void LoadXYZ(const float* aSource, Type& aX, Type& aY, Type& aZ)
+			{
+				const __m256 a = _mm256_loadu_ps(aSource);
+				const __m256 b = _mm256_loadu_ps(aSource + 8);
+				const __m256 c = _mm256_loadu_ps(aSource + 16);
+				aX = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x92), c, 0x24), _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+				aY = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x24), c, 0x49), _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6));
+				aZ = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x49), c, 0x92), _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+			}
+
+			static void StoreXYZ(float* aDestination, const Type aX, const Type aY, const Type aZ)
+			{
+				// The x and z permutations are their own inverses
+				const __m256 x = _mm256_permutevar8x32_ps(aX, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+				const __m256 y = _mm256_permutevar8x32_ps(aY, _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2));
+				const __m256 z = _mm256_permutevar8x32_ps(aZ, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+				_mm256_storeu_ps(aDestination, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x92), z, 0x24));
+				_mm256_storeu_ps(aDestination + 8, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x24), z, 0x49));
+				_mm256_storeu_ps(aDestination + 16, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x49), z, 0x92));
+			}
+
+			// Records 0-3 go through the low 128-bit lanes and records 4-7 through the high ones,
+			// so the transpose never has to cross lanes
+			static void LoadTransposed4(const float* aSource, const int aStride, Type& aX, Type& aY, Type& aZ, Type& aW)
+			{
+				const __m256 record0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(aSource)), _mm_loadu_ps(aSource + aStride * 4), 1);
+				const __m256 record1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(aSource + aStride)), _mm_loadu_ps(aSource + aStride * 5), 1);
+				const __m256 record2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(aSource + aStride * 2)), _mm_loadu_ps(aSource + aStride * 6), 1);
+				const __m256 record3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(aSource + aStride * 3)), _mm_loadu_ps(aSource + aStride * 7), 1);
+				Transpose4(record0, record1, record2, record3, aX, aY, aZ, aW);
+			}
+
+			static void StoreTransposed4(float* aDestination, const int aStride, const Type aX, const Type aY, const Type aZ, const Type aW)
+			{
+				__m256 record0, record1, record2, record3;
+				Transpose4(aX, aY, aZ, aW, record0, record1, record2, record3);
+				_mm_storeu_ps(aDestination, _mm256_castps256_ps128(record0));
+				_mm_storeu_ps(aDestination + aStride, _mm256_castps256_ps128(record1));
+				_mm_storeu_ps(aDestination + aStride * 2, _mm256_castps256_ps128(record2));
+				_mm_storeu_ps(aDestination + aStride * 3, _mm256_castps256_ps128(record3));
+				_mm_storeu_ps(aDestination + aStride * 4, _mm256_extractf128_ps(record0, 1));
+				_mm_storeu_ps(aDestination + aStride * 5, _mm256_extractf128_ps(record1, 1));
+				_mm_storeu_ps(aDestination + aStride * 6, _mm256_extractf128_ps(record2, 1));
+				_mm_storeu_ps(aDestination + aStride * 7, _mm256_extractf128_ps(record3, 1));
+			}
+
+			// _MM_TRANSPOSE4_PS within each 128-bit lane
+			static void Transpose4(const Type aRow0, const Type aRow1, const Type aRow2, const Type aRow3, Type& aColumn0, Type& aColumn1, Type& aColumn2, Type& aColumn3)
+			{
+				const __m256 low01 = _mm256_unpacklo_ps(aRow0, aRow1);
+				const __m256 high01 = _mm256_unpackhi_ps(aRow0, aRow1);
+				const __m256 low23 = _mm256_unpacklo_ps(aRow2, aRow3);
+				const __m256 high23 = _mm256_unpackhi_ps(aRow2, aRow3);
+				aColumn0 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+				aColumn1 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+				aColumn2 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+				aColumn3 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+			}
+		};
+CU_SIMD_AVX2_END
+
+CU_SIMD_AVX512_BEGIN
+		struct PackAVX512
+		{
+			typedef __m512 Type;
+			static const int ourWidth = 16;
+
+			static Type Load(const float* aSource) { return _mm512_loadu_ps(aSource); }
+			static void Store(float* aDestination, const Type aValue) { _mm512_storeu_ps(aDestination, aValue); }
+			static Type Set(const float aValue) { return _mm512_set1_ps(aValue); }
+			static Type Add(const Type aLeft, const Type aRight) { return _mm512_add_ps(aLeft, aRight); }
+			static Type Sub(const Type aLeft, const Type aRight) { return _mm512_sub_ps(aLeft, aRight); }
+			static Type Mul(const Type aLeft, const Type aRight) { return _mm512_mul_ps(aLeft, aRight); }
+			static Type Div(const Type aLeft, const Type aRight) { return _mm512_div_ps(aLeft, aRight); }
+			static Type MulAdd(const Type aLeft, const Type aRight, const Type anAddend) { return _mm512_fmadd_ps(aLeft, aRight, anAddend); }
+			static Type Sqrt(const Type aValue) { return _mm512_sqrt_ps(aValue); }
+			static Type Min(const Type aLeft, const Type aRight) { return _mm512_min_ps(aLeft, aRight); }
+			static Type Max(const Type aLeft, const Type aRight) { return _mm512_max_ps(aLeft, aRight); }
+			static Type Round(const Type aValue) { return _mm512_roundscale_ps(aValue, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+			static unsigned int LessMask(const Type aLeft, const Type aRight) { return static_cast<unsigned int>(_mm512_cmp_ps_mask(aLeft, aRight, _CMP_LT_OQ)); }
+
+			// Sixteen packed xy pairs (32 floats), the even and odd floats picked with one two-source permute each
+			static void LoadXY(const float* aSource, Type& aX, Type& aY)
+			{
+				const __m512 a = _mm512_loadu_ps(aSource);
+				const __m512 b = _mm512_loadu_ps(aSource + 16);
+				aX = _mm512_permutex2var_ps(a, _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30), b);
+				aY = _mm512_permutex2var_ps(a, _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31), b);
+			}
+
+			// Sixteen packed xyz triplets (48 floats). Each axis takes what it can from the first 32 floats
+			// with one two-source permute, and the rest from the last 16 with a second one.
+			static void LoadXYZ(const float* aSource, Type& aX, Type& aY, Type& aZ)
+			{
+				const __m512 a = _mm512_loadu_ps(aSource);
+				const __m512 b = _mm512_loadu_ps(aSource + 16);
+				const __m512 c = _mm512_loadu_ps(aSource + 32);
+				aX = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0), b),
+					_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29), c);
+				aY = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0), b),
+					_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30), c);
+				aZ = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0), b),
+					_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31), c);
+			}
+
+			// Each output block takes its x and y floats with one permute and slots in z with a second
+			static void StoreXYZ(float* aDestination, const Type aX, const Type aY, const Type aZ)
+			{
+				_mm512_storeu_ps(aDestination, _mm512_permutex2var_ps(_mm512_permutex2var_ps(aX, _mm512_setr_epi32(0, 16, 0, 1, 17, 0, 2, 18, 0, 3, 19, 0, 4, 20, 0, 5), aY),
+					_mm512_setr_epi32(0, 1, 16, 3, 4, 17, 6, 7, 18, 9, 10, 19, 12, 13, 20, 15), aZ));
+				_mm512_storeu_ps(aDestination + 16, _mm512_permutex2var_ps(_mm512_permutex2var_ps(aX, _mm512_setr_epi32(21, 0, 6, 22, 0, 7, 23, 0, 8, 24, 0, 9, 25, 0, 10, 26), aY),
+					_mm512_setr_epi32(0, 21, 2, 3, 22, 5, 6, 23, 8, 9, 24, 11, 12, 25, 14, 15), aZ));
+				_mm512_storeu_ps(aDestination + 32, _mm512_permutex2var_ps(_mm512_permutex2var_ps(aX, _mm512_setr_epi32(0, 11, 27, 0, 12, 28, 0, 13, 29, 0, 14, 30, 0, 15, 31, 0), aY),
+					_mm512_setr_epi32(26, 1, 2, 27, 4, 5, 28, 7, 8, 29, 10, 11, 30, 13, 14, 31), aZ));
+			}
+
+			// Like PackAVX2, record n goes through 128-bit lane n / 4 so the transpose stays within lanes
+			static void LoadTransposed4(const float* aSource, const int aStride, Type& aX, Type& aY, Type& aZ, Type& aW)
+			{
+				Type records[4];
+				for (int record = 0; record < 4; ++record)
+				{
+					const float* source = aSource + aStride * record;
+					records[record] = _mm512_castps128_ps512(_mm_loadu_ps(source));
+					records[record] = _mm512_insertf32x4(records[record], _mm_loadu_ps(source + aStride * 4), 1);
+					records[record] = _mm512_insertf32x4(records[record], _mm_loadu_ps(source + aStride * 8), 2);
+					records[record] = _mm512_insertf32x4(records[record], _mm_loadu_ps(source + aStride * 12), 3);
+				}
+				Transpose4(records[0], records[1], records[2], records[3], aX, aY, aZ, aW);
+			}
+
+			static void StoreTransposed4(float* aDestination, const int aStride, const Type aX, const Type aY, const Type aZ, const Type aW)
+			{
+				Type records[4];
+				Transpose4(aX, aY, aZ, aW, records[0], records[1], records[2], records[3]);
+				for (int record = 0; record < 4; ++record)
+				{
+					float* destination = aDestination + aStride * record;
+					_mm_storeu_ps(destination, _mm512_castps512_ps128(records[record]));
+					_mm_storeu_ps(destination + aStride * 4, _mm512_extractf32x4_ps(records[record], 1));
+					_mm_storeu_ps(destination + aStride * 8, _mm512_extractf32x4_ps(records[record], 2));
+					_mm_storeu_ps(destination + aStride * 12, _mm512_extractf32x4_ps(records[record], 3));
+				}
+			}
+
+			static void Transpose4(const Type aRow0, const Type aRow1, const Type aRow2, const Type aRow3, Type& aColumn0, Type& aColumn1, Type& aColumn2, Type& aColumn3)
+			{
+				const __m512 low01 = _mm512_unpacklo_ps(aRow0, aRow1);
+				const __m512 high01 = _mm512_unpackhi_ps(aRow0, aRow1);
+				const __m512 low23 = _mm512_unpacklo_ps(aRow2, aRow3);
+				const __m512 high23 = _mm512_unpackhi_ps(aRow2, aRow3);
+				aColumn0 = _mm512_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+				aColumn1 = _mm512_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+				aColumn2 = _mm512_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+				aColumn3 = _mm512_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+			}
+		};
+CU_SIMD_AVX512_END
+#endif
+	}
+}
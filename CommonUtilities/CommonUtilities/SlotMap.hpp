@@ -0,0 +1,256 @@
+#pragma once
+#include <assert.h>
+#include <utility>
+#include "GrowingArray.hpp"
+
+namespace CommonUtilities
+{
+	// Stays valid until its element is erased; a handle to an erased element never matches again.
+	// The default handle is never valid.
+	struct SlotMapHandle
+	{
+		unsigned int myIndex = 0;
+		unsigned int myGeneration = 0;
+
+		bool operator==(const SlotMapHandle& aHandle) const
+		{
+			return myIndex == aHandle.myIndex && myGeneration == aHandle.myGeneration;
+		}
+
+		bool operator!=(const SlotMapHandle& aHandle) const
+		{
+			return !((*this) == aHandle);
+		}
+	};
+
+	// Values are kept densely packed and erased with a swap and pop, so iterating is a linear scan.
+	// Handles go through a slot table that follows the values as they move and counts a generation
+	// per slot, which makes insert, erase, lookup and the stale handle check O(1).
+	template<class T>
+	class SlotMap
+	{
+	public:
+		SlotMap();
+
+		SlotMapHandle Insert(const T& anObject);
+		SlotMapHandle Insert(T&& anObject);
+		template<class... Arguments>
+		SlotMapHandle Emplace(Arguments&&... someArguments);
+
+		// Returns false if aHandle is stale
+		bool Erase(const SlotMapHandle& aHandle);
+		// Invalidates every handle
+		void Clear();
+
+		inline bool Contains(const SlotMapHandle& aHandle) const;
+		// nullptr if aHandle is stale
+		inline T* Get(const SlotMapHandle& aHandle);
+		inline const T* Get(const SlotMapHandle& aHandle) const;
+		inline T& operator[](const SlotMapHandle& aHandle);
+		inline const T& operator[](const SlotMapHandle& aHandle) const;
+
+		inline int Count() const;
+		void Reserve(const int aCapacity);
+
+		// Dense access: anIndex is in [0, Count()) and changes when elements are erased
+		inline T& GetAt(const int anIndex);
+		inline const T& GetAt(const int anIndex) const;
+		inline SlotMapHandle GetHandleAt(const int anIndex) const;
+
+		inline T* begin();
+		inline T* end();
+		inline const T* begin() const;
+		inline const T* end() const;
+
+	private:
+		static const unsigned int ourFreeListEnd = static_cast<unsigned int>(-1);
+
+		struct Slot
+		{
+			// Index into myValues while in use, the next free slot otherwise
+			unsigned int myIndex;
+			unsigned int myGeneration;
+		};
+
+		SlotMapHandle AddSlot();
+
+		GrowingArray<T> myValues;
+		GrowingArray<unsigned int> mySlotOfValue;
+		GrowingArray<Slot> mySlots;
+		unsigned int myFreeSlot;
+	};
+
+	template<class T>
+	inline SlotMap<T>::SlotMap()
+	{
+		myFreeSlot = ourFreeListEnd;
+	}
+
+	template<class T>
+	inline SlotMapHandle SlotMap<T>::Insert(const T& anObject)
+	{
+		return Emplace(anObject);
+	}
+
+	template<class T>
+	inline SlotMapHandle SlotMap<T>::Insert(T&& anObject)
+	{
+		return Emplace(std::move(anObject));
+	}
+
+	template<class T>
+	template<class... Arguments>
+	inline SlotMapHandle SlotMap<T>::Emplace(Arguments&&... someArguments)
+	{
+		myValues.Emplace(std::forward<Arguments>(someArguments)...);
+		return AddSlot();
+	}
+
+	template<class T>
+	inline SlotMapHandle SlotMap<T>::AddSlot()
+	{
+		unsigned int slotIndex = myFreeSlot;
+		if (slotIndex == ourFreeListEnd)
+		{
+			slotIndex = static_cast<unsigned int>(mySlots.Size());
+			mySlots.Add(Slot{ 0, 1 });
+		}
+		else
+		{
+			myFreeSlot = mySlots[slotIndex].myIndex;
+		}
+
+		Slot& slot = mySlots[slotIndex];
+		slot.myIndex = static_cast<unsigned int>(mySlotOfValue.Size());
+		mySlotOfValue.Add(slotIndex);
+
+		SlotMapHandle handle;
+		handle.myIndex = slotIndex;
+		handle.myGeneration = slot.myGeneration;
+		return handle;
+	}
+
+	template<class T>
+	inline bool SlotMap<T>::Erase(const SlotMapHandle& aHandle)
+	{
+		if (!Contains(aHandle))
+		{
+			return false;
+		}
+
+		Slot& slot = mySlots[aHandle.myIndex];
+		const int valueIndex = static_cast<int>(slot.myIndex);
+		myValues.RemoveCyclicAtIndex(valueIndex);
+		mySlotOfValue.RemoveCyclicAtIndex(valueIndex);
+		if (valueIndex < myValues.Size())
+		{
+			mySlots[mySlotOfValue[valueIndex]].myIndex = static_cast<unsigned int>(valueIndex);
+		}
+
+		// Generation 0 is left for the default handle
+		slot.myGeneration = slot.myGeneration + 1 != 0 ? slot.myGeneration + 1 : 1;
+		slot.myIndex = myFreeSlot;
+		myFreeSlot = aHandle.myIndex;
+		return true;
+	}
+
+	template<class T>
+	inline void SlotMap<T>::Clear()
+	{
+		for (int index = myValues.Size() - 1; index >= 0; --index)
+		{
+			Erase(GetHandleAt(index));
+		}
+	}
+
+	template<class T>
+	inline bool SlotMap<T>::Contains(const SlotMapHandle& aHandle) const
+	{
+		return aHandle.myIndex < static_cast<unsigned int>(mySlots.Size()) && mySlots[aHandle.myIndex].myGeneration == aHandle.myGeneration;
+	}
+
+	template<class T>
+	inline T* SlotMap<T>::Get(const SlotMapHandle& aHandle)
+	{
+		return Contains(aHandle) ? &myValues[mySlots[aHandle.myIndex].myIndex] : nullptr;
+	}
+
+	template<class T>
+	inline const T* SlotMap<T>::Get(const SlotMapHandle& aHandle) const
+	{
+		return Contains(aHandle) ? &myValues[mySlots[aHandle.myIndex].myIndex] : nullptr;
+	}
+
+	template<class T>
+	inline T& SlotMap<T>::operator[](const SlotMapHandle& aHandle)
+	{
+		assert(Contains(aHandle) && "Handle is stale!");
+		return myValues[mySlots[aHandle.myIndex].myIndex];
+	}
+
+	template<class T>
+	inline const T& SlotMap<T>::operator[](const SlotMapHandle& aHandle) const
+	{
+		assert(Contains(aHandle) && "Handle is stale!");
+		return myValues[mySlots[aHandle.myIndex].myIndex];
+	}
+
+	template<class T>
+	inline int SlotMap<T>::Count() const
+	{
+		return myValues.Size();
+	}
+
+	template<class T>
+	inline void SlotMap<T>::Reserve(const int aCapacity)
+	{
+		myValues.Reserve(aCapacity);
+		mySlotOfValue.Reserve(aCapacity);
+		mySlots.Reserve(aCapacity);
+	}
+
+	template<class T>
+	inline T& SlotMap<T>::GetAt(const int anIndex)
+	{
+		return myValues[anIndex];
+	}
+
+	template<class T>
+	inline const T& SlotMap<T>::GetAt(const int anIndex) const
+	{
+		return myValues[anIndex];
+	}
+
+	template<class T>
+	inline SlotMapHandle SlotMap<T>::GetHandleAt(const int anIndex) const
+	{
+		SlotMapHandle handle;
+		handle.myIndex = mySlotOfValue[anIndex];
+		handle.myGeneration = mySlots[handle.myIndex].myGeneration;
+		return handle;
+	}
+
+	template<class T>
+	inline T* SlotMap<T>::begin()
+	{
+		return myValues.begin();
+	}
+
+	template<class T>
+	inline T* SlotMap<T>::end()
+	{
+		return myValues.end();
+	}
+
+	template<class T>
+	inline const T* SlotMap<T>::begin() const
+	{
+		return myValues.begin();
+	}
+
+	template<class T>
+	inline const T* SlotMap<T>::end() const
+	{
+		return myValues.end();
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "Vector3.hpp"
+
+namespace CommonUtilities
+{
+	template <class T>
+	class Sphere
+	{
+	public:
+		Sphere();
+		Sphere(const Vector3<T>& aCenter, const T aRadius);
+		void InitWithCenterAndRadius(const Vector3<T>& aCenter, const T aRadius);
+
+		bool IsInside(const Vector3<T>& aPosition) const;
+
+		const Vector3<T>& GetCenter() const;
+		T GetRadius() const;
+
+	private:
+		Vector3<T> myCenter;
+		T myRadius;
+	};
+
+	template <class T>
+	inline Sphere<T>::Sphere() : myRadius(0)
+	{
+	}
+
+	template <class T>
+	inline Sphere<T>::Sphere(const Vector3<T>& aCenter, const T aRadius) : myCenter(aCenter), myRadius(aRadius)
+	{
+	}
+
+	template <class T>
+	inline void Sphere<T>::InitWithCenterAndRadius(const Vector3<T>& aCenter, const T aRadius)
+	{
+		myCenter = aCenter;
+		myRadius = aRadius;
+	}
+
+	template <class T>
+	inline bool Sphere<T>::IsInside(const Vector3<T>& aPosition) const
+	{
+		const Vector3<T> offset = aPosition - myCenter;
+		return offset.LengthSqr() <= myRadius * myRadius;
+	}
+
+	template <class T>
+	inline const Vector3<T>& Sphere<T>::GetCenter() const
+	{
+		return myCenter;
+	}
+
+	template <class T>
+	inline T Sphere<T>::GetRadius() const
+	{
+		return myRadius;
+	}
+}
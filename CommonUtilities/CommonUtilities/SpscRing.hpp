@@ -0,0 +1,152 @@
+#pragma once
+#include <atomic>
+#include <utility>
+#include "AlignedAllocation.hpp"
+#include "StaticArray.hpp"
+
+namespace CommonUtilities
+{
+	// Lock-free ring buffer for exactly one producer thread and one consumer thread.
+	// Each side keeps its index and a cached copy of the other side's index on its own cache line,
+	// so the shared indices are only read when the cached one says the ring looks full or empty.
+	template<class T, int size>
+	class SpscRing
+	{
+	public:
+		static_assert(size > 0 && (size & (size - 1)) == 0, "SpscRing size must be a power of two!");
+
+		SpscRing();
+		SpscRing(const SpscRing& aRing) = delete;
+		SpscRing& operator=(const SpscRing& aRing) = delete;
+
+		// Producer side, false if the ring is full
+		inline bool Push(const T& anObject);
+		inline bool Push(T&& anObject);
+		// Pushes as many of the objects as fit and returns how many that was
+		inline int PushBatch(const T* someObjects, const int aCount);
+
+		// Consumer side, false if the ring is empty
+		inline bool Pop(T& anObject);
+		// Pops up to aMaxCount objects into anOutput and returns how many that was
+		inline int PopBatch(T* anOutput, const int aMaxCount);
+
+		// Exact only when called from one of the two threads while the other is idle
+		inline int Count() const;
+		static constexpr int Capacity();
+
+	private:
+		static const unsigned int ourMask = static_cast<unsigned int>(size - 1);
+
+		inline unsigned int GetFreeCount(const unsigned int aWriteIndex, const unsigned int aWantedCount);
+		inline unsigned int GetFilledCount(const unsigned int aReadIndex, const unsigned int aWantedCount);
+
+		char myFrontPadding[CacheLineSize];
+		std::atomic<unsigned int> myWriteIndex;
+		unsigned int myCachedReadIndex;
+		char myWritePadding[CacheLineSize - sizeof(std::atomic<unsigned int>) - sizeof(unsigned int)];
+
+		std::atomic<unsigned int> myReadIndex;
+		unsigned int myCachedWriteIndex;
+		char myReadPadding[CacheLineSize - sizeof(std::atomic<unsigned int>) - sizeof(unsigned int)];
+
+		StaticArray<T, size> myBuffer;
+	};
+
+	template<class T, int size>
+	inline SpscRing<T, size>::SpscRing() : myWriteIndex(0), myReadIndex(0)
+	{
+		myCachedReadIndex = 0;
+		myCachedWriteIndex = 0;
+	}
+
+	template<class T, int size>
+	inline unsigned int SpscRing<T, size>::GetFreeCount(const unsigned int aWriteIndex, const unsigned int aWantedCount)
+	{
+		unsigned int freeCount = size - (aWriteIndex - myCachedReadIndex);
+		if (freeCount < aWantedCount)
+		{
+			myCachedReadIndex = myReadIndex.load(std::memory_order_acquire);
+			freeCount = size - (aWriteIndex - myCachedReadIndex);
+		}
+		return freeCount;
+	}
+
+	template<class T, int size>
+	inline unsigned int SpscRing<T, size>::GetFilledCount(const unsigned int aReadIndex, const unsigned int aWantedCount)
+	{
+		unsigned int filledCount = myCachedWriteIndex - aReadIndex;
+		if (filledCount < aWantedCount)
+		{
+			myCachedWriteIndex = myWriteIndex.load(std::memory_order_acquire);
+			filledCount = myCachedWriteIndex - aReadIndex;
+		}
+		return filledCount;
+	}
+
+	template<class T, int size>
+	inline bool SpscRing<T, size>::Push(const T& anObject)
+	{
+		return PushBatch(&anObject, 1) == 1;
+	}
+
+	template<class T, int size>
+	inline bool SpscRing<T, size>::Push(T&& anObject)
+	{
+		const unsigned int writeIndex = myWriteIndex.load(std::memory_order_relaxed);
+		if (GetFreeCount(writeIndex, 1) == 0)
+		{
+			return false;
+		}
+		myBuffer[writeIndex & ourMask] = std::move(anObject);
+		myWriteIndex.store(writeIndex + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<class T, int size>
+	inline int SpscRing<T, size>::PushBatch(const T* someObjects, const int aCount)
+	{
+		const unsigned int writeIndex = myWriteIndex.load(std::memory_order_relaxed);
+		const unsigned int freeCount = GetFreeCount(writeIndex, static_cast<unsigned int>(aCount));
+		const int count = static_cast<unsigned int>(aCount) < freeCount ? aCount : static_cast<int>(freeCount);
+		for (int index = 0; index < count; ++index)
+		{
+			myBuffer[(writeIndex + index) & ourMask] = someObjects[index];
+		}
+		myWriteIndex.store(writeIndex + count, std::memory_order_release);
+		return count;
+	}
+
+	template<class T, int size>
+	inline bool SpscRing<T, size>::Pop(T& anObject)
+	{
+		return PopBatch(&anObject, 1) == 1;
+	}
+
+	template<class T, int size>
+	inline int SpscRing<T, size>::PopBatch(T* anOutput, const int aMaxCount)
+	{
+		const unsigned int readIndex = myReadIndex.load(std::memory_order_relaxed);
+		const unsigned int filledCount = GetFilledCount(readIndex, static_cast<unsigned int>(aMaxCount));
+		const int count = static_cast<unsigned int>(aMaxCount) < filledCount ? aMaxCount : static_cast<int>(filledCount);
+		for (int index = 0; index < count; ++index)
+		{
+			anOutput[index] = std::move(myBuffer[(readIndex + index) & ourMask]);
+		}
+		myReadIndex.store(readIndex + count, std::memory_order_release);
+		return count;
+	}
+
+	template<class T, int size>
+	inline int SpscRing<T, size>::Count() const
+	{
+		// The read index first, the write index can only have moved further since
+		const unsigned int readIndex = myReadIndex.load(std::memory_order_acquire);
+		return static_cast<int>(myWriteIndex.load(std::memory_order_acquire) - readIndex);
+	}
+
+	template<class T, int size>
+	constexpr int SpscRing<T, size>::Capacity()
+	{
+		return size;
+	}
+}
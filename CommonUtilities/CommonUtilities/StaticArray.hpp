@@ -1,49 +1,63 @@
 #pragma once
 #include <initializer_list>
 #include <assert.h>
-#include <new>
+#include <algorithm>
+#include <string.h>
 #include <type_traits>
+#include <utility>
 
 namespace CommonUtilities
 {
+	// Fixed size array whose size only exists at compile time, so sizeof(StaticArray<T, size>) == sizeof(T) * size.
+	// Arithmetic elements are left uninitialized by the default constructor, pointers start as nullptr.
+	// Copies and moves are the compiler's own, so the array is trivially copyable whenever T is.
 	template<typename T, int size>
 	class StaticArray
 	{
 	public:
+		static_assert(size > 0, "StaticArray needs at least one element!");
+
 		StaticArray();
+		// Elements past the end of the list are value-initialized
+		constexpr StaticArray(const std::initializer_list<T>& aInitList);
 
-		StaticArray(const StaticArray& aStaticArray);
-		StaticArray(const std::initializer_list<T>& aInitList);
+		inline constexpr T& operator[](const int aIndex);
+		inline constexpr const T& operator[](const int aIndex) const;
 
-		~StaticArray() = default;
+		// Shifts the elements from aIndex one step up, the last one falls off
+		inline void Insert(const int aIndex, const T& aObject);
+		inline void Insert(const int aIndex, T&& aObject);
+		inline void DeleteAll();
 
-		StaticArray& operator=(const StaticArray& aGrowingArray);
-		inline T& operator[](const int aIndex);
-		inline const T& operator[](const int aIndex) const;
+		static constexpr int Count();
 
-		inline void Insert(const int aIndex, const T& aObject);
-		inline auto DeleteAll();
-		inline auto DeleteAll(std::true_type);
-		inline auto DeleteAll(std::false_type);
+		inline constexpr T* GetData();
+		inline constexpr const T* GetData() const;
+		inline constexpr T* begin();
+		inline constexpr T* end();
+		inline constexpr const T* begin() const;
+		inline constexpr const T* end() const;
 
-		const int Count() const;
 	private:
+		typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value> IsTriviallyCopyable;
+
 		void Init(std::true_type);
 		void Init(std::false_type);
+		void ShiftUp(const int aIndex, std::true_type);
+		void ShiftUp(const int aIndex, std::false_type);
+
 		T myArray[size];
-		int mySize;
 	};
 
 	template<typename T, int size>
 	inline StaticArray<T, size>::StaticArray()
 	{
-		Init(std::conditional_t<std::is_pointer<T>::value, std::true_type, std::false_type>{});
+		Init(std::integral_constant<bool, std::is_pointer<T>::value>{});
 	}
 
 	template<typename T, int size>
 	inline void StaticArray<T, size>::Init(std::true_type)
 	{
-		mySize = size;
 		for (int index = 0; index < size; index++)
 		{
 			myArray[index] = nullptr;
@@ -53,22 +67,15 @@ namespace CommonUtilities
 	template<typename T, int size>
 	inline void StaticArray<T, size>::Init(std::false_type)
 	{
-		mySize = size;
 	}
 
 	template<typename T, int size>
-	StaticArray<T, size>::StaticArray(const StaticArray& aStaticArray)
+	inline constexpr StaticArray<T, size>::StaticArray(const std::initializer_list<T>& aInitList) : myArray{}
 	{
-		(*this) = aStaticArray;
-	}
-
-	template<typename T, int size>
-	StaticArray<T, size>::StaticArray(const std::initializer_list<T>& aInitList)
-	{
-		myArray[size];
+		assert(aInitList.size() <= static_cast<size_t>(size) && "Too many elements in the initializer list!");
 
 		int count = 0;
-		for (auto& element : aInitList)
+		for (const T& element : aInitList)
 		{
 			myArray[count] = element;
 			++count;
@@ -76,73 +83,97 @@ namespace CommonUtilities
 	}
 
 	template<typename T, int size>
-	StaticArray<T, size>& StaticArray<T, size>::operator=(const StaticArray& aGrowingArray)
+	inline constexpr T& StaticArray<T, size>::operator[](const int aIndex)
 	{
-		assert(mySize == aGrowingArray.size && "Array of different size can't be used as argument!");
-		for (int index = 0; index < size; index++)
-		{
-			myArray[index] = aGrowingArray.myArray[index];
-		}
-		size = aGrowingArray.size;
-		return (*this);
+		assert(size > aIndex && aIndex >= 0 && "Index out of range!");
+		return myArray[aIndex];
 	}
 
 	template<typename T, int size>
-	inline T& StaticArray<T, size>::operator[](const int aIndex)
+	inline constexpr const T& StaticArray<T, size>::operator[](const int aIndex) const
 	{
-		assert(size > aIndex && aIndex >= 0);
+		assert(size > aIndex && aIndex >= 0 && "Index out of range!");
 		return myArray[aIndex];
 	}
 
 	template<typename T, int size>
-	inline const T& StaticArray<T, size>::operator[](const int aIndex) const
+	inline void StaticArray<T, size>::Insert(const int aIndex, const T& aObject)
 	{
-		assert(size > aIndex && aIndex >= 0);
-		return myArray[aIndex];
+		// aObject may be one of the elements that are about to move
+		Insert(aIndex, T(aObject));
 	}
 
 	template<typename T, int size>
-	inline void StaticArray<T, size>::Insert(const int aIndex, const T & aObject)
+	inline void StaticArray<T, size>::Insert(const int aIndex, T&& aObject)
 	{
-		assert(aIndex < mySize && aIndex >= 0 && "Index out of range!");
-
-		for (int index = aIndex; index < size - 1; ++index)
-		{
-			myArray[index + 1] = myArray[index];
-		}
+		assert(aIndex < size && aIndex >= 0 && "Index out of range!");
+		T object(std::move(aObject));
+		ShiftUp(aIndex, IsTriviallyCopyable{});
+		myArray[aIndex] = std::move(object);
+	}
 
-		myArray[aIndex] = aObject;
+	template<typename T, int size>
+	inline void StaticArray<T, size>::ShiftUp(const int aIndex, std::true_type)
+	{
+		memmove(myArray + aIndex + 1, myArray + aIndex, sizeof(T) * (size - 1 - aIndex));
 	}
 
 	template<typename T, int size>
-	inline auto StaticArray<T, size>::DeleteAll()
+	inline void StaticArray<T, size>::ShiftUp(const int aIndex, std::false_type)
 	{
-		DeleteAll(std::conditional_t<std::is_pointer<T>::value, std::true_type, std::false_type>{});
+		std::move_backward(myArray + aIndex, myArray + size - 1, myArray + size);
 	}
 
 	template<typename T, int size>
-	inline auto StaticArray<T, size>::DeleteAll(std::true_type)
+	inline void StaticArray<T, size>::DeleteAll()
 	{
+		static_assert(std::is_pointer<T>::value, "DeleteAll is only for arrays of pointers!");
 		for (int index = 0; index < size; ++index)
 		{
-			if (myArray[index] != nullptr)
-			{
-				delete myArray[index];
-			}
-
+			delete myArray[index];
 			myArray[index] = nullptr;
 		}
 	}
 
 	template<typename T, int size>
-	inline auto StaticArray<T, size>::DeleteAll(std::false_type)
+	constexpr int StaticArray<T, size>::Count()
 	{
-		throw std::logic_error("This function is not implemented for non-pointer members.");
+		return size;
 	}
 
 	template<typename T, int size>
-	const int StaticArray<T, size>::Count() const
+	inline constexpr T* StaticArray<T, size>::GetData()
 	{
-		return size;
+		return myArray;
+	}
+
+	template<typename T, int size>
+	inline constexpr const T* StaticArray<T, size>::GetData() const
+	{
+		return myArray;
+	}
+
+	template<typename T, int size>
+	inline constexpr T* StaticArray<T, size>::begin()
+	{
+		return myArray;
+	}
+
+	template<typename T, int size>
+	inline constexpr T* StaticArray<T, size>::end()
+	{
+		return myArray + size;
+	}
+
+	template<typename T, int size>
+	inline constexpr const T* StaticArray<T, size>::begin() const
+	{
+		return myArray;
+	}
+
+	template<typename T, int size>
+	inline constexpr const T* StaticArray<T, size>::end() const
+	{
+		return myArray + size;
 	}
-}
\ No newline at end of file
+}
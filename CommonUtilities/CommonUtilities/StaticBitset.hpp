@@ -0,0 +1,316 @@
+#pragma once
+#include <assert.h>
+#include <cstdint>
+#include "BitsetKernels.hpp"
+
+namespace CommonUtilities
+{
+	// size bits packed into 64-bit words, for masks and flags that would otherwise be a StaticArray<bool, size>.
+	// The word loops are unrolled and vectorized by the compiler. Bits past size are always 0.
+	template<int size>
+	class StaticBitset
+	{
+	public:
+		static_assert(size > 0, "StaticBitset needs at least one bit!");
+		static const int FoundNone = -1;
+		static const int WordCount = (size + 63) / 64;
+
+		StaticBitset();
+
+		inline bool operator[](const int anIndex) const;
+		inline bool Test(const int anIndex) const;
+		inline void Set(const int anIndex);
+		inline void Set(const int anIndex, const bool aValue);
+		inline void Reset(const int anIndex);
+		inline void Flip(const int anIndex);
+
+		inline void SetAll();
+		inline void ResetAll();
+		inline void FlipAll();
+
+		inline StaticBitset& operator&=(const StaticBitset& aBitset);
+		inline StaticBitset& operator|=(const StaticBitset& aBitset);
+		inline StaticBitset& operator^=(const StaticBitset& aBitset);
+		// Clears the bits that are set in aBitset
+		inline StaticBitset& AndNot(const StaticBitset& aBitset);
+
+		inline bool operator==(const StaticBitset& aBitset) const;
+		inline bool operator!=(const StaticBitset& aBitset) const;
+
+		inline int PopCount() const;
+		inline bool Any() const;
+		inline bool None() const;
+		inline bool All() const;
+		// Index of the first set bit, or FoundNone
+		inline int FindFirst() const;
+		// Index of the first set bit after anIndex, or FoundNone
+		inline int FindNext(const int anIndex) const;
+		inline SetBitRange GetSetBits() const;
+
+		static constexpr int Size() { return size; }
+		inline uint64_t* GetWords();
+		inline const uint64_t* GetWords() const;
+
+	private:
+		static constexpr uint64_t GetLastWordMask() { return size % 64 == 0 ? ~0ull : (1ull << (size % 64)) - 1; }
+		inline int FindFrom(const int aWordIndex, const uint64_t aWord) const;
+
+		uint64_t myWords[WordCount];
+	};
+
+	template<int size>
+	const int StaticBitset<size>::FoundNone;
+
+	template<int size>
+	const int StaticBitset<size>::WordCount;
+
+	template<int size>
+	inline StaticBitset<size> operator&(StaticBitset<size> aLeft, const StaticBitset<size>& aRight)
+	{
+		return aLeft &= aRight;
+	}
+
+	template<int size>
+	inline StaticBitset<size> operator|(StaticBitset<size> aLeft, const StaticBitset<size>& aRight)
+	{
+		return aLeft |= aRight;
+	}
+
+	template<int size>
+	inline StaticBitset<size> operator^(StaticBitset<size> aLeft, const StaticBitset<size>& aRight)
+	{
+		return aLeft ^= aRight;
+	}
+
+	template<int size>
+	inline StaticBitset<size> operator~(StaticBitset<size> aBitset)
+	{
+		aBitset.FlipAll();
+		return aBitset;
+	}
+
+	template<int size>
+	inline StaticBitset<size>::StaticBitset()
+	{
+		ResetAll();
+	}
+
+	template<int size>
+	inline bool StaticBitset<size>::operator[](const int anIndex) const
+	{
+		return Test(anIndex);
+	}
+
+	template<int size>
+	inline bool StaticBitset<size>::Test(const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < size && "Index out of range!");
+		return (myWords[anIndex / 64] >> (anIndex % 64) & 1) != 0;
+	}
+
+	template<int size>
+	inline void StaticBitset<size>::Set(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < size && "Index out of range!");
+		myWords[anIndex / 64] |= 1ull << (anIndex % 64);
+	}
+
+	template<int size>
+	inline void StaticBitset<size>::Set(const int anIndex, const bool aValue)
+	{
+		if (aValue)
+		{
+			Set(anIndex);
+		}
+		else
+		{
+			Reset(anIndex);
+		}
+	}
+
+	template<int size>
+	inline void StaticBitset<size>::Reset(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < size && "Index out of range!");
+		myWords[anIndex / 64] &= ~(1ull << (anIndex % 64));
+	}
+
+	template<int size>
+	inline void StaticBitset<size>::Flip(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < size && "Index out of range!");
+		myWords[anIndex / 64] ^= 1ull << (anIndex % 64);
+	}
+
+	template<int size>
+	inline void StaticBitset<size>::SetAll()
+	{
+		for (int index = 0; index < WordCount; ++index)
+		{
+			myWords[index] = ~0ull;
+		}
+		myWords[WordCount - 1] &= GetLastWordMask();
+	}
+
+	template<int size>
+	inline void StaticBitset<size>::ResetAll()
+	{
+		for (int index = 0; index < WordCount; ++index)
+		{
+			myWords[index] = 0;
+		}
+	}
+
+	template<int size>
+	inline void StaticBitset<size>::FlipAll()
+	{
+		for (int index = 0; index < WordCount; ++index)
+		{
+			myWords[index] = ~myWords[index];
+		}
+		myWords[WordCount - 1] &= GetLastWordMask();
+	}
+
+	template<int size>
+	inline StaticBitset<size>& StaticBitset<size>::operator&=(const StaticBitset& aBitset)
+	{
+		for (int index = 0; index < WordCount; ++index)
+		{
+			myWords[index] &= aBitset.myWords[index];
+		}
+		return (*this);
+	}
+
+	template<int size>
+	inline StaticBitset<size>& StaticBitset<size>::operator|=(const StaticBitset& aBitset)
+	{
+		for (int index = 0; index < WordCount; ++index)
+		{
+			myWords[index] |= aBitset.myWords[index];
+		}
+		return (*this);
+	}
+
+	template<int size>
+	inline StaticBitset<size>& StaticBitset<size>::operator^=(const StaticBitset& aBitset)
+	{
+		for (int index = 0; index < WordCount; ++index)
+		{
+			myWords[index] ^= aBitset.myWords[index];
+		}
+		return (*this);
+	}
+
+	template<int size>
+	inline StaticBitset<size>& StaticBitset<size>::AndNot(const StaticBitset& aBitset)
+	{
+		for (int index = 0; index < WordCount; ++index)
+		{
+			myWords[index] &= ~aBitset.myWords[index];
+		}
+		return (*this);
+	}
+
+	template<int size>
+	inline bool StaticBitset<size>::operator==(const StaticBitset& aBitset) const
+	{
+		uint64_t difference = 0;
+		for (int index = 0; index < WordCount; ++index)
+		{
+			difference |= myWords[index] ^ aBitset.myWords[index];
+		}
+		return difference == 0;
+	}
+
+	template<int size>
+	inline bool StaticBitset<size>::operator!=(const StaticBitset& aBitset) const
+	{
+		return !((*this) == aBitset);
+	}
+
+	template<int size>
+	inline int StaticBitset<size>::PopCount() const
+	{
+		int count = 0;
+		for (int index = 0; index < WordCount; ++index)
+		{
+			count += CommonUtilities::PopCount(myWords[index]);
+		}
+		return count;
+	}
+
+	template<int size>
+	inline bool StaticBitset<size>::Any() const
+	{
+		uint64_t any = 0;
+		for (int index = 0; index < WordCount; ++index)
+		{
+			any |= myWords[index];
+		}
+		return any != 0;
+	}
+
+	template<int size>
+	inline bool StaticBitset<size>::None() const
+	{
+		return !Any();
+	}
+
+	template<int size>
+	inline bool StaticBitset<size>::All() const
+	{
+		return PopCount() == size;
+	}
+
+	template<int size>
+	inline int StaticBitset<size>::FindFirst() const
+	{
+		return FindFrom(0, myWords[0]);
+	}
+
+	template<int size>
+	inline int StaticBitset<size>::FindNext(const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < size && "Index out of range!");
+		const int next = anIndex + 1;
+		if (next == size)
+		{
+			return FoundNone;
+		}
+		return FindFrom(next / 64, myWords[next / 64] & (~0ull << (next % 64)));
+	}
+
+	template<int size>
+	inline SetBitRange StaticBitset<size>::GetSetBits() const
+	{
+		return SetBitRange(myWords, WordCount);
+	}
+
+	template<int size>
+	inline uint64_t* StaticBitset<size>::GetWords()
+	{
+		return myWords;
+	}
+
+	template<int size>
+	inline const uint64_t* StaticBitset<size>::GetWords() const
+	{
+		return myWords;
+	}
+
+	template<int size>
+	inline int StaticBitset<size>::FindFrom(const int aWordIndex, const uint64_t aWord) const
+	{
+		uint64_t word = aWord;
+		for (int index = aWordIndex; index < WordCount; )
+		{
+			if (word != 0)
+			{
+				return index * 64 + CountTrailingZeros(word);
+			}
+			++index;
+			word = index < WordCount ? myWords[index] : 0;
+		}
+		return FoundNone;
+	}
+}
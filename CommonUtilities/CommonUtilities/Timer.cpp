@@ -1,4 +1,5 @@
 #include "Timer.hpp"
+#include "FrameArena.hpp"
 
 Timer::Timer()
 {
@@ -12,6 +13,16 @@ void Timer::Update()
 	myLastFrame = myCurrentFrame;
 	myCurrentFrame = myClock.now();
 	myDeltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(myCurrentFrame - myLastFrame).count() / 1000.f;
+
+	if (myFrameArena != nullptr)
+	{
+		myFrameArena->BeginFrame();
+	}
+}
+
+void Timer::SetFrameArena(CommonUtilities::FrameArena* aFrameArena)
+{
+	myFrameArena = aFrameArena;
 }
 
 float Timer::GetDeltaTime() const
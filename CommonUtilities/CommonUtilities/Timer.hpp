@@ -1,6 +1,11 @@
 #pragma once
 #include <chrono>
 
+namespace CommonUtilities
+{
+	class FrameArena;
+}
+
 class Timer
 {
 public:
@@ -8,10 +13,13 @@ public:
 	Timer(const Timer &aTimer) = delete;
 	Timer& operator=(const Timer &aTimer) = delete;
 	void Update();
+	// Makes Update also begin a new frame in aFrameArena, nullptr detaches it
+	void SetFrameArena(CommonUtilities::FrameArena* aFrameArena);
 	float GetDeltaTime() const;
 	double GetTotalTime() const;
 private:
 	float myDeltaTime;
+	CommonUtilities::FrameArena* myFrameArena = nullptr;
 	std::chrono::high_resolution_clock myClock;
 	const std::chrono::high_resolution_clock::time_point myStartTime = myClock.now();
 	std::chrono::high_resolution_clock::time_point myLastFrame;
@@ -0,0 +1,436 @@
+#include "TransformBatch.hpp"
+#include "SimdLevel.hpp"
+#include "SimdPack.hpp"
+
+namespace CU = CommonUtilities;
+
+namespace
+{
+	struct MatrixElements
+	{
+		alignas(16) float myRows[4][4];
+	};
+
+	MatrixElements GetElements(const CU::Matrix4x4<float>& aMatrix)
+	{
+		MatrixElements elements;
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int column = 0; column < 4; ++column)
+			{
+				elements.myRows[row][column] = aMatrix(row + 1, column + 1);
+			}
+		}
+		return elements;
+	}
+
+	// aW is 1 for points and 0 for directions
+	void TransformVector3Scalar(const MatrixElements& aMatrix, const float aW, const CU::Vector3<float>* aInput, CU::Vector3<float>* aOutput, const int aCount)
+	{
+		const float(&m)[4][4] = aMatrix.myRows;
+		for (int index = 0; index < aCount; ++index)
+		{
+			const float x = aInput[index].x;
+			const float y = aInput[index].y;
+			const float z = aInput[index].z;
+			aOutput[index].x = x * m[0][0] + y * m[1][0] + z * m[2][0] + aW * m[3][0];
+			aOutput[index].y = x * m[0][1] + y * m[1][1] + z * m[2][1] + aW * m[3][1];
+			aOutput[index].z = x * m[0][2] + y * m[1][2] + z * m[2][2] + aW * m[3][2];
+		}
+	}
+
+	void TransformVector4Scalar(const MatrixElements& aMatrix, const CU::Vector4<float>* aInput, CU::Vector4<float>* aOutput, const int aCount)
+	{
+		const float(&m)[4][4] = aMatrix.myRows;
+		for (int index = 0; index < aCount; ++index)
+		{
+			const CU::Vector4<float> vector = aInput[index];
+			aOutput[index].x = vector.x * m[0][0] + vector.y * m[1][0] + vector.z * m[2][0] + vector.w * m[3][0];
+			aOutput[index].y = vector.x * m[0][1] + vector.y * m[1][1] + vector.z * m[2][1] + vector.w * m[3][1];
+			aOutput[index].z = vector.x * m[0][2] + vector.y * m[1][2] + vector.z * m[2][2] + vector.w * m[3][2];
+			aOutput[index].w = vector.x * m[0][3] + vector.y * m[1][3] + vector.z * m[2][3] + vector.w * m[3][3];
+		}
+	}
+
+#ifdef CU_SIMD_SSE
+	void TransformVector3SSE(const MatrixElements& aMatrix, const float aW, const CU::Vector3<float>* aInput, CU::Vector3<float>* aOutput, const int aCount)
+	{
+		const float(&m)[4][4] = aMatrix.myRows;
+		const __m128 m00 = _mm_set1_ps(m[0][0]);
+		const __m128 m10 = _mm_set1_ps(m[1][0]);
+		const __m128 m20 = _mm_set1_ps(m[2][0]);
+		const __m128 m01 = _mm_set1_ps(m[0][1]);
+		const __m128 m11 = _mm_set1_ps(m[1][1]);
+		const __m128 m21 = _mm_set1_ps(m[2][1]);
+		const __m128 m02 = _mm_set1_ps(m[0][2]);
+		const __m128 m12 = _mm_set1_ps(m[1][2]);
+		const __m128 m22 = _mm_set1_ps(m[2][2]);
+		const __m128 translation0 = _mm_set1_ps(aW * m[3][0]);
+		const __m128 translation1 = _mm_set1_ps(aW * m[3][1]);
+		const __m128 translation2 = _mm_set1_ps(aW * m[3][2]);
+
+		const float* input = &aInput[0].x;
+		float* output = &aOutput[0].x;
+		const int packedCount = aCount & ~3;
+		for (int index = 0; index < packedCount; index += 4)
+		{
+			__m128 x, y, z;
+			CU::Simd::PackSSE::LoadXYZ(input + index * 3, x, y, z);
+
+			const __m128 result0 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_mul_ps(z, m20)), translation0);
+			const __m128 result1 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_mul_ps(z, m21)), translation1);
+			const __m128 result2 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m02), _mm_mul_ps(y, m12)), _mm_mul_ps(z, m22)), translation2);
+
+			CU::Simd::PackSSE::StoreXYZ(output + index * 3, result0, result1, result2);
+		}
+
+		TransformVector3Scalar(aMatrix, aW, aInput + packedCount, aOutput + packedCount, aCount - packedCount);
+	}
+
+	void TransformVector4SSE(const MatrixElements& aMatrix, const CU::Vector4<float>* aInput, CU::Vector4<float>* aOutput, const int aCount)
+	{
+		const __m128 row0 = _mm_load_ps(aMatrix.myRows[0]);
+		const __m128 row1 = _mm_load_ps(aMatrix.myRows[1]);
+		const __m128 row2 = _mm_load_ps(aMatrix.myRows[2]);
+		const __m128 row3 = _mm_load_ps(aMatrix.myRows[3]);
+
+		for (int index = 0; index < aCount; ++index)
+		{
+			const __m128 vector = _mm_load_ps(&aInput[index].x);
+			__m128 sum = _mm_mul_ps(_mm_shuffle_ps(vector, vector, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(vector, vector, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(vector, vector, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3)), row3));
+			_mm_store_ps(&aOutput[index].x, sum);
+		}
+	}
+
+	// Eight points per iteration
+	CU_TARGET_AVX2 void TransformVector3AVX2(const MatrixElements& aMatrix, const float aW, const CU::Vector3<float>* aInput, CU::Vector3<float>* aOutput, const int aCount)
+	{
+		const float(&m)[4][4] = aMatrix.myRows;
+		const __m256 m00 = _mm256_set1_ps(m[0][0]);
+		const __m256 m10 = _mm256_set1_ps(m[1][0]);
+		const __m256 m20 = _mm256_set1_ps(m[2][0]);
+		const __m256 m01 = _mm256_set1_ps(m[0][1]);
+		const __m256 m11 = _mm256_set1_ps(m[1][1]);
+		const __m256 m21 = _mm256_set1_ps(m[2][1]);
+		const __m256 m02 = _mm256_set1_ps(m[0][2]);
+		const __m256 m12 = _mm256_set1_ps(m[1][2]);
+		const __m256 m22 = _mm256_set1_ps(m[2][2]);
+		const __m256 translation0 = _mm256_set1_ps(aW * m[3][0]);
+		const __m256 translation1 = _mm256_set1_ps(aW * m[3][1]);
+		const __m256 translation2 = _mm256_set1_ps(aW * m[3][2]);
+
+		const float* input = &aInput[0].x;
+		float* output = &aOutput[0].x;
+		const int packedCount = aCount & ~7;
+		for (int index = 0; index < packedCount; index += 8)
+		{
+			__m256 x, y, z;
+			CU::Simd::PackAVX2::LoadXYZ(input + index * 3, x, y, z);
+
+			const __m256 result0 = _mm256_fmadd_ps(z, m20, _mm256_fmadd_ps(y, m10, _mm256_fmadd_ps(x, m00, translation0)));
+			const __m256 result1 = _mm256_fmadd_ps(z, m21, _mm256_fmadd_ps(y, m11, _mm256_fmadd_ps(x, m01, translation1)));
+			const __m256 result2 = _mm256_fmadd_ps(z, m22, _mm256_fmadd_ps(y, m12, _mm256_fmadd_ps(x, m02, translation2)));
+
+			CU::Simd::PackAVX2::StoreXYZ(output + index * 3, result0, result1, result2);
+		}
+
+		TransformVector3SSE(aMatrix, aW, aInput + packedCount, aOutput + packedCount, aCount - packedCount);
+	}
+
+	// Sixteen points per iteration
+	CU_TARGET_AVX512 void TransformVector3AVX512(const MatrixElements& aMatrix, const float aW, const CU::Vector3<float>* aInput, CU::Vector3<float>* aOutput, const int aCount)
+	{
+		const float(&m)[4][4] = aMatrix.myRows;
+		const __m512 m00 = _mm512_set1_ps(m[0][0]);
+		const __m512 m10 = _mm512_set1_ps(m[1][0]);
+		const __m512 m20 = _mm512_set1_ps(m[2][0]);
+		const __m512 m01 = _mm512_set1_ps(m[0][1]);
+		const __m512 m11 = _mm512_set1_ps(m[1][1]);
+		const __m512 m21 = _mm512_set1_ps(m[2][1]);
+		const __m512 m02 = _mm512_set1_ps(m[0][2]);
+		const __m512 m12 = _mm512_set1_ps(m[1][2]);
+		const __m512 m22 = _mm512_set1_ps(m[2][2]);
+		const __m512 translation0 = _mm512_set1_ps(aW * m[3][0]);
+		const __m512 translation1 = _mm512_set1_ps(aW * m[3][1]);
+		const __m512 translation2 = _mm512_set1_ps(aW * m[3][2]);
+
+		const float* input = &aInput[0].x;
+		float* output = &aOutput[0].x;
+		const int packedCount = aCount & ~15;
+		for (int index = 0; index < packedCount; index += 16)
+		{
+			__m512 x, y, z;
+			CU::Simd::PackAVX512::LoadXYZ(input + index * 3, x, y, z);
+
+			const __m512 result0 = _mm512_fmadd_ps(z, m20, _mm512_fmadd_ps(y, m10, _mm512_fmadd_ps(x, m00, translation0)));
+			const __m512 result1 = _mm512_fmadd_ps(z, m21, _mm512_fmadd_ps(y, m11, _mm512_fmadd_ps(x, m01, translation1)));
+			const __m512 result2 = _mm512_fmadd_ps(z, m22, _mm512_fmadd_ps(y, m12, _mm512_fmadd_ps(x, m02, translation2)));
+
+			CU::Simd::PackAVX512::StoreXYZ(output + index * 3, result0, result1, result2);
+		}
+
+		TransformVector3AVX2(aMatrix, aW, aInput + packedCount, aOutput + packedCount, aCount - packedCount);
+	}
+
+	// Two vectors per iteration, the matrix rows are repeated in both lanes
+	CU_TARGET_AVX2 void TransformVector4AVX2(const MatrixElements& aMatrix, const CU::Vector4<float>* aInput, CU::Vector4<float>* aOutput, const int aCount)
+	{
+		const __m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(aMatrix.myRows[0]));
+		const __m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(aMatrix.myRows[1]));
+		const __m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(aMatrix.myRows[2]));
+		const __m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(aMatrix.myRows[3]));
+
+		const int packedCount = aCount & ~1;
+		for (int index = 0; index < packedCount; index += 2)
+		{
+			const __m256 vectors = _mm256_loadu_ps(&aInput[index].x);
+			__m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+			sum = _mm256_fmadd_ps(_mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(1, 1, 1, 1)), row1, sum);
+			sum = _mm256_fmadd_ps(_mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(2, 2, 2, 2)), row2, sum);
+			sum = _mm256_fmadd_ps(_mm256_shuffle_ps(vectors, vectors, _MM_SHUFFLE(3, 3, 3, 3)), row3, sum);
+			_mm256_storeu_ps(&aOutput[index].x, sum);
+		}
+
+		TransformVector4SSE(aMatrix, aInput + packedCount, aOutput + packedCount, aCount - packedCount);
+	}
+
+	// Matrix4x4<float>::Inverse with one matrix in each 128-bit lane
+	CU_TARGET_AVX2 void InverseMatricesAVX2(const CU::Matrix4x4<float>* aInput, CU::Matrix4x4<float>* aOutput, const int aCount)
+	{
+		const int packedCount = aCount & ~1;
+		for (int index = 0; index < packedCount; index += 2)
+		{
+			const float* first = &aInput[index](1, 1);
+			const float* second = &aInput[index + 1](1, 1);
+			const __m256 firstTop = _mm256_loadu_ps(first);
+			const __m256 firstBottom = _mm256_loadu_ps(first + 8);
+			const __m256 secondTop = _mm256_loadu_ps(second);
+			const __m256 secondBottom = _mm256_loadu_ps(second + 8);
+			const __m256 row0 = _mm256_permute2f128_ps(firstTop, secondTop, 0x20);
+			const __m256 row1 = _mm256_permute2f128_ps(firstTop, secondTop, 0x31);
+			const __m256 row2 = _mm256_permute2f128_ps(firstBottom, secondBottom, 0x20);
+			const __m256 row3 = _mm256_permute2f128_ps(firstBottom, secondBottom, 0x31);
+
+			const __m256 a = _mm256_shuffle_ps(row0, row1, _MM_SHUFFLE(1, 0, 1, 0));
+			const __m256 b = _mm256_shuffle_ps(row0, row1, _MM_SHUFFLE(3, 2, 3, 2));
+			const __m256 c = _mm256_shuffle_ps(row2, row3, _MM_SHUFFLE(1, 0, 1, 0));
+			const __m256 d = _mm256_shuffle_ps(row2, row3, _MM_SHUFFLE(3, 2, 3, 2));
+
+			const __m256 blockDeterminants = _mm256_fmsub_ps(_mm256_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm256_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1)),
+				_mm256_mul_ps(_mm256_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm256_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+			const __m256 determinantA = _mm256_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(0, 0, 0, 0));
+			const __m256 determinantB = _mm256_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(1, 1, 1, 1));
+			const __m256 determinantC = _mm256_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(2, 2, 2, 2));
+			const __m256 determinantD = _mm256_shuffle_ps(blockDeterminants, blockDeterminants, _MM_SHUFFLE(3, 3, 3, 3));
+
+			const __m256 adjugateDC = _mm256_fmsub_ps(_mm256_shuffle_ps(d, d, _MM_SHUFFLE(0, 0, 3, 3)), c,
+				_mm256_mul_ps(_mm256_shuffle_ps(d, d, _MM_SHUFFLE(2, 2, 1, 1)), _mm256_shuffle_ps(c, c, _MM_SHUFFLE(1, 0, 3, 2))));
+			const __m256 adjugateAB = _mm256_fmsub_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b,
+				_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm256_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+
+			__m256 x = _mm256_fmsub_ps(determinantD, a, _mm256_fmadd_ps(b, _mm256_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(3, 0, 3, 0)),
+				_mm256_mul_ps(_mm256_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(1, 2, 1, 2)))));
+			__m256 w = _mm256_fmsub_ps(determinantA, d, _mm256_fmadd_ps(c, _mm256_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(3, 0, 3, 0)),
+				_mm256_mul_ps(_mm256_shuffle_ps(c, c, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(1, 2, 1, 2)))));
+			__m256 y = _mm256_fmsub_ps(determinantB, c, _mm256_fmsub_ps(d, _mm256_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(0, 3, 0, 3)),
+				_mm256_mul_ps(_mm256_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_shuffle_ps(adjugateAB, adjugateAB, _MM_SHUFFLE(1, 2, 1, 2)))));
+			__m256 z = _mm256_fmsub_ps(determinantC, b, _mm256_fmsub_ps(a, _mm256_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(0, 3, 0, 3)),
+				_mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(1, 2, 1, 2)))));
+
+			__m256 trace = _mm256_mul_ps(adjugateAB, _mm256_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(3, 1, 2, 0)));
+			trace = _mm256_add_ps(trace, _mm256_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+			trace = _mm256_add_ps(trace, _mm256_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+			const __m256 determinant = _mm256_sub_ps(_mm256_fmadd_ps(determinantA, determinantD, _mm256_mul_ps(determinantB, determinantC)), trace);
+
+			const __m256 inverseDeterminant = _mm256_div_ps(_mm256_setr_ps(1.f, -1.f, -1.f, 1.f, 1.f, -1.f, -1.f, 1.f), determinant);
+			x = _mm256_mul_ps(x, inverseDeterminant);
+			y = _mm256_mul_ps(y, inverseDeterminant);
+			z = _mm256_mul_ps(z, inverseDeterminant);
+			w = _mm256_mul_ps(w, inverseDeterminant);
+
+			const __m256 result0 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3));
+			const __m256 result1 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2));
+			const __m256 result2 = _mm256_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3));
+			const __m256 result3 = _mm256_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2));
+
+			float* firstOutput = &aOutput[index](1, 1);
+			float* secondOutput = &aOutput[index + 1](1, 1);
+			_mm256_storeu_ps(firstOutput, _mm256_permute2f128_ps(result0, result1, 0x20));
+			_mm256_storeu_ps(firstOutput + 8, _mm256_permute2f128_ps(result2, result3, 0x20));
+			_mm256_storeu_ps(secondOutput, _mm256_permute2f128_ps(result0, result1, 0x31));
+			_mm256_storeu_ps(secondOutput + 8, _mm256_permute2f128_ps(result2, result3, 0x31));
+		}
+
+		if (packedCount < aCount)
+		{
+			aOutput[packedCount] = CU::Matrix4x4<float>::Inverse(aInput[packedCount]);
+		}
+	}
+
+#endif
+
+	namespace Scalar
+	{
+		typedef CU::Simd::PackScalar WidePack;
+#include "TransformBatchKernels.inl"
+	}
+
+#ifdef CU_SIMD_SSE
+	namespace Sse
+	{
+		typedef CU::Simd::PackSSE WidePack;
+#include "TransformBatchKernels.inl"
+	}
+
+CU_SIMD_AVX2_BEGIN
+	namespace Avx2
+	{
+		typedef CU::Simd::PackAVX2 WidePack;
+#include "TransformBatchKernels.inl"
+	}
+CU_SIMD_AVX2_END
+
+CU_SIMD_AVX512_BEGIN
+	namespace Avx512
+	{
+		typedef CU::Simd::PackAVX512 WidePack;
+#include "TransformBatchKernels.inl"
+	}
+CU_SIMD_AVX512_END
+#endif
+
+	void TransformVector3(const CU::Matrix4x4<float>& aMatrix, const float aW, const CU::Vector3<float>* aInput, CU::Vector3<float>* aOutput, const int aCount)
+	{
+		if (aCount <= 0)
+		{
+			return;
+		}
+
+		const MatrixElements elements = GetElements(aMatrix);
+		switch (CU::GetSimdLevel())
+		{
+#ifdef CU_SIMD_SSE
+		case CU::SimdLevel::AVX512:
+			TransformVector3AVX512(elements, aW, aInput, aOutput, aCount);
+			break;
+		case CU::SimdLevel::AVX2:
+			TransformVector3AVX2(elements, aW, aInput, aOutput, aCount);
+			break;
+		case CU::SimdLevel::SSE2:
+			TransformVector3SSE(elements, aW, aInput, aOutput, aCount);
+			break;
+#endif
+		default:
+			TransformVector3Scalar(elements, aW, aInput, aOutput, aCount);
+			break;
+		}
+	}
+}
+
+namespace CommonUtilities
+{
+	void TransformPoints(const Matrix4x4<float>& aMatrix, const Vector3<float>* aInput, Vector3<float>* aOutput, const int aCount)
+	{
+		TransformVector3(aMatrix, 1.f, aInput, aOutput, aCount);
+	}
+
+	void TransformPoints(const Matrix4x4<float>& aMatrix, Vector3<float>* aInOut, const int aCount)
+	{
+		TransformVector3(aMatrix, 1.f, aInOut, aInOut, aCount);
+	}
+
+	void TransformDirections(const Matrix4x4<float>& aMatrix, const Vector3<float>* aInput, Vector3<float>* aOutput, const int aCount)
+	{
+		TransformVector3(aMatrix, 0.f, aInput, aOutput, aCount);
+	}
+
+	void TransformDirections(const Matrix4x4<float>& aMatrix, Vector3<float>* aInOut, const int aCount)
+	{
+		TransformVector3(aMatrix, 0.f, aInOut, aInOut, aCount);
+	}
+
+	void TransformVectors(const Matrix4x4<float>& aMatrix, const Vector4<float>* aInput, Vector4<float>* aOutput, const int aCount)
+	{
+		if (aCount <= 0)
+		{
+			return;
+		}
+
+		// Two vectors already fill a ymm register, AVX-512 has nothing to add here
+		const MatrixElements elements = GetElements(aMatrix);
+		switch (GetSimdLevel())
+		{
+#ifdef CU_SIMD_SSE
+		case SimdLevel::AVX512:
+		case SimdLevel::AVX2:
+			TransformVector4AVX2(elements, aInput, aOutput, aCount);
+			break;
+		case SimdLevel::SSE2:
+			TransformVector4SSE(elements, aInput, aOutput, aCount);
+			break;
+#endif
+		default:
+			TransformVector4Scalar(elements, aInput, aOutput, aCount);
+			break;
+		}
+	}
+
+	void TransformVectors(const Matrix4x4<float>& aMatrix, Vector4<float>* aInOut, const int aCount)
+	{
+		TransformVectors(aMatrix, aInOut, aInOut, aCount);
+	}
+
+	void InverseMatrices(const Matrix4x4<float>* aInput, Matrix4x4<float>* aOutput, const int aCount)
+	{
+#ifdef CU_SIMD_SSE
+		if (GetSimdLevel() >= SimdLevel::AVX2)
+		{
+			InverseMatricesAVX2(aInput, aOutput, aCount);
+			return;
+		}
+#endif
+		for (int index = 0; index < aCount; ++index)
+		{
+			aOutput[index] = Matrix4x4<float>::Inverse(aInput[index]);
+		}
+	}
+
+	void QuaternionsToMatrices(const Quaternion<float>* aInput, Matrix4x4<float>* aOutput, const int aCount)
+	{
+		if (aCount <= 0)
+		{
+			return;
+		}
+
+		CU_SIMD_DISPATCH(QuaternionsToMatrices(&aInput[0].x, &aOutput[0](1, 1), aCount));
+	}
+
+	void CreateTRSMatrices(const Vector3Stream<float>& aTranslations, const Vector3Stream<float>& anEulerAnglesInRadians, const Vector3Stream<float>& aScales, Matrix4x4<float>* aOutput)
+	{
+		const int count = aTranslations.Count();
+		assert(anEulerAnglesInRadians.Count() == count && aScales.Count() == count && "Stream sizes differ!");
+		if (count <= 0)
+		{
+			return;
+		}
+
+		CU_SIMD_DISPATCH(EulerTRS(aTranslations.GetX(), aTranslations.GetY(), aTranslations.GetZ(), anEulerAnglesInRadians.GetX(), anEulerAnglesInRadians.GetY(), anEulerAnglesInRadians.GetZ(),
+			aScales.GetX(), aScales.GetY(), aScales.GetZ(), &aOutput[0](1, 1), count));
+	}
+
+	void CreateTRSMatrices(const Vector3Stream<float>& aTranslations, const Quaternion<float>* aRotations, const Vector3Stream<float>& aScales, Matrix4x4<float>* aOutput)
+	{
+		const int count = aTranslations.Count();
+		assert(aScales.Count() == count && "Stream sizes differ!");
+		if (count <= 0)
+		{
+			return;
+		}
+
+		CU_SIMD_DISPATCH(QuaternionTRS(aTranslations.GetX(), aTranslations.GetY(), aTranslations.GetZ(), &aRotations[0].x,
+			aScales.GetX(), aScales.GetY(), aScales.GetZ(), &aOutput[0](1, 1), count));
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Vector3.hpp"
+#include "Vector4.hpp"
+#include "Matrix4x4.hpp"
+#include "Quaternion.hpp"
+#include "Vector3Stream.hpp"
+
+namespace CommonUtilities
+{
+	// Batch transforms of contiguous vector arrays through one matrix, using the same
+	// row-vector convention as operator*(Vector4, Matrix4x4). Input and output may be the same array.
+	// Runs the kernels of the current SimdLevel (SimdLevel.hpp), by default the widest the CPU supports.
+
+	// Transforms positions (w = 1), the resulting w is discarded
+	void TransformPoints(const Matrix4x4<float>& aMatrix, const Vector3<float>* aInput, Vector3<float>* aOutput, const int aCount);
+	void TransformPoints(const Matrix4x4<float>& aMatrix, Vector3<float>* aInOut, const int aCount);
+
+	// Transforms directions (w = 0), translation is ignored
+	void TransformDirections(const Matrix4x4<float>& aMatrix, const Vector3<float>* aInput, Vector3<float>* aOutput, const int aCount);
+	void TransformDirections(const Matrix4x4<float>& aMatrix, Vector3<float>* aInOut, const int aCount);
+
+	void TransformVectors(const Matrix4x4<float>& aMatrix, const Vector4<float>* aInput, Vector4<float>* aOutput, const int aCount);
+	void TransformVectors(const Matrix4x4<float>& aMatrix, Vector4<float>* aInOut, const int aCount);
+
+	// Inverts every matrix with Matrix4x4<float>::Inverse, two at a time on AVX2. Input and output may be the same array.
+	void InverseMatrices(const Matrix4x4<float>* aInput, Matrix4x4<float>* aOutput, const int aCount);
+
+	// Batch form of Quaternion<float>::GetRotationMatrix4x4 for normalized quaternions. Input and output may not overlap.
+	void QuaternionsToMatrices(const Quaternion<float>* aInput, Matrix4x4<float>* aOutput, const int aCount);
+
+	// Batch form of Matrix4x4<float>::CreateTRS, one matrix per element of the streams, which must all have the same count.
+	// The Euler version evaluates sin and cos for a whole register of angles at once.
+	void CreateTRSMatrices(const Vector3Stream<float>& aTranslations, const Vector3Stream<float>& anEulerAnglesInRadians, const Vector3Stream<float>& aScales, Matrix4x4<float>* aOutput);
+	void CreateTRSMatrices(const Vector3Stream<float>& aTranslations, const Quaternion<float>* aRotations, const Vector3Stream<float>& aScales, Matrix4x4<float>* aOutput);
+}
@@ -0,0 +1,165 @@
+// TransformBatch kernels written once over a Pack (SimdPack.hpp).
+// Included by TransformBatch.cpp once per instruction set, inside a namespace that defines WidePack.
+// Each kernel runs [aBegin, anEnd) where the range is a multiple of Pack::ourWidth. Matrices are
+// written as 16 consecutive floats, rows of four.
+
+// sin and cos of every lane from one range reduction, accurate to a few ulp for angles up to a few thousand radians
+template<class Pack>
+void SinCos(const typename Pack::Type anAngle, typename Pack::Type& aSin, typename Pack::Type& aCos)
+{
+	typedef typename Pack::Type Type;
+	const Type one = Pack::Set(1.f);
+
+	// Nearest multiple of pi/2, subtracted in three parts so the remainder in [-pi/4, pi/4] stays exact
+	const Type quadrant = Pack::Round(Pack::Mul(anAngle, Pack::Set(0.636619772f)));
+	Type angle = Pack::MulAdd(quadrant, Pack::Set(-1.5703125f), anAngle);
+	angle = Pack::MulAdd(quadrant, Pack::Set(-4.837512969970703125e-4f), angle);
+	angle = Pack::MulAdd(quadrant, Pack::Set(-7.54978995489188216e-8f), angle);
+	const Type squared = Pack::Mul(angle, angle);
+
+	Type sin = Pack::MulAdd(squared, Pack::Set(-1.9515295891e-4f), Pack::Set(8.3321608736e-3f));
+	sin = Pack::MulAdd(squared, sin, Pack::Set(-1.6666654611e-1f));
+	sin = Pack::MulAdd(Pack::Mul(squared, angle), sin, angle);
+	Type cos = Pack::MulAdd(squared, Pack::Set(2.443315711809948e-5f), Pack::Set(-1.388731625493765e-3f));
+	cos = Pack::MulAdd(squared, cos, Pack::Set(4.166664568298827e-2f));
+	cos = Pack::MulAdd(Pack::Mul(squared, squared), cos, Pack::MulAdd(squared, Pack::Set(-0.5f), one));
+
+	// Quadrants 0-3 give (sin, cos), (cos, -sin), (-sin, -cos) and (-cos, sin). The quadrant bits are
+	// found with Round alone (the offsets keep it away from ties), so every pack can share this.
+	const Type quadrantMod4 = Pack::Sub(quadrant, Pack::Mul(Pack::Set(4.f), Pack::Round(Pack::MulAdd(quadrant, Pack::Set(0.25f), Pack::Set(-0.375f)))));
+	const Type upperHalf = Pack::Round(Pack::MulAdd(quadrantMod4, Pack::Set(0.5f), Pack::Set(-0.25f)));
+	const Type odd = Pack::Sub(quadrantMod4, Pack::Add(upperHalf, upperHalf));
+	const Type cosNegative = Pack::Sub(Pack::Add(odd, upperHalf), Pack::Mul(Pack::Set(2.f), Pack::Mul(odd, upperHalf)));
+	const Type sinSign = Pack::Sub(one, Pack::Add(upperHalf, upperHalf));
+	const Type cosSign = Pack::Sub(one, Pack::Add(cosNegative, cosNegative));
+	aSin = Pack::Mul(sinSign, Pack::MulAdd(odd, Pack::Sub(cos, sin), sin));
+	aCos = Pack::Mul(cosSign, Pack::MulAdd(odd, Pack::Sub(sin, cos), cos));
+}
+
+// Same layout as Matrix4x4<T>::CreateTRS: scaled rotation rows, then the translation row
+template<class Pack>
+void StoreTRS(float* aMatrices, const typename Pack::Type (&aRotation)[9], const float* aScaleX, const float* aScaleY, const float* aScaleZ,
+	const float* aTranslationX, const float* aTranslationY, const float* aTranslationZ, const int anIndex)
+{
+	const typename Pack::Type zero = Pack::Set(0.f);
+	const typename Pack::Type scaleX = Pack::Load(aScaleX + anIndex);
+	const typename Pack::Type scaleY = Pack::Load(aScaleY + anIndex);
+	const typename Pack::Type scaleZ = Pack::Load(aScaleZ + anIndex);
+	float* matrices = aMatrices + anIndex * 16;
+	Pack::StoreTransposed4(matrices, 16, Pack::Mul(aRotation[0], scaleX), Pack::Mul(aRotation[1], scaleX), Pack::Mul(aRotation[2], scaleX), zero);
+	Pack::StoreTransposed4(matrices + 4, 16, Pack::Mul(aRotation[3], scaleY), Pack::Mul(aRotation[4], scaleY), Pack::Mul(aRotation[5], scaleY), zero);
+	Pack::StoreTransposed4(matrices + 8, 16, Pack::Mul(aRotation[6], scaleZ), Pack::Mul(aRotation[7], scaleZ), Pack::Mul(aRotation[8], scaleZ), zero);
+	Pack::StoreTransposed4(matrices + 12, 16, Pack::Load(aTranslationX + anIndex), Pack::Load(aTranslationY + anIndex), Pack::Load(aTranslationZ + anIndex), Pack::Set(1.f));
+}
+
+// Rotation rows of Quaternion<float>::GetRotationMatrix3x3 for Pack::ourWidth quaternions stored as xyzw
+template<class Pack>
+void QuaternionRotation(const float* aQuaternions, typename Pack::Type (&aRotation)[9])
+{
+	typedef typename Pack::Type Type;
+	Type x, y, z, w;
+	Pack::LoadTransposed4(aQuaternions, 4, x, y, z, w);
+
+	const Type one = Pack::Set(1.f);
+	const Type twiceX = Pack::Add(x, x);
+	const Type twiceY = Pack::Add(y, y);
+	const Type twiceZ = Pack::Add(z, z);
+	const Type xx = Pack::Mul(x, twiceX);
+	const Type yy = Pack::Mul(y, twiceY);
+	const Type zz = Pack::Mul(z, twiceZ);
+	const Type xy = Pack::Mul(x, twiceY);
+	const Type xz = Pack::Mul(x, twiceZ);
+	const Type yz = Pack::Mul(y, twiceZ);
+	const Type wx = Pack::Mul(w, twiceX);
+	const Type wy = Pack::Mul(w, twiceY);
+	const Type wz = Pack::Mul(w, twiceZ);
+
+	aRotation[0] = Pack::Sub(one, Pack::Add(yy, zz));
+	aRotation[1] = Pack::Add(xy, wz);
+	aRotation[2] = Pack::Sub(xz, wy);
+	aRotation[3] = Pack::Sub(xy, wz);
+	aRotation[4] = Pack::Sub(one, Pack::Add(xx, zz));
+	aRotation[5] = Pack::Add(yz, wx);
+	aRotation[6] = Pack::Add(xz, wy);
+	aRotation[7] = Pack::Sub(yz, wx);
+	aRotation[8] = Pack::Sub(one, Pack::Add(xx, yy));
+}
+
+template<class Pack>
+void QuaternionsToMatricesKernel(const float* aQuaternions, float* aMatrices, const int aBegin, const int anEnd)
+{
+	const typename Pack::Type zero = Pack::Set(0.f);
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		typename Pack::Type rotation[9];
+		QuaternionRotation<Pack>(aQuaternions + index * 4, rotation);
+		float* matrices = aMatrices + index * 16;
+		Pack::StoreTransposed4(matrices, 16, rotation[0], rotation[1], rotation[2], zero);
+		Pack::StoreTransposed4(matrices + 4, 16, rotation[3], rotation[4], rotation[5], zero);
+		Pack::StoreTransposed4(matrices + 8, 16, rotation[6], rotation[7], rotation[8], zero);
+		Pack::StoreTransposed4(matrices + 12, 16, zero, zero, zero, Pack::Set(1.f));
+	}
+}
+
+template<class Pack>
+void EulerTRSKernel(const float* aTranslationX, const float* aTranslationY, const float* aTranslationZ, const float* anAngleX, const float* anAngleY, const float* anAngleZ,
+	const float* aScaleX, const float* aScaleY, const float* aScaleZ, float* aMatrices, const int aBegin, const int anEnd)
+{
+	typedef typename Pack::Type Type;
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		Type sinX, cosX, sinY, cosY, sinZ, cosZ;
+		SinCos<Pack>(Pack::Load(anAngleX + index), sinX, cosX);
+		SinCos<Pack>(Pack::Load(anAngleY + index), sinY, cosY);
+		SinCos<Pack>(Pack::Load(anAngleZ + index), sinZ, cosZ);
+		const Type sinXSinY = Pack::Mul(sinX, sinY);
+		const Type cosXSinY = Pack::Mul(cosX, sinY);
+
+		const Type rotation[9] =
+		{
+			Pack::Mul(cosY, cosZ), Pack::Mul(cosY, sinZ), Pack::Sub(Pack::Set(0.f), sinY),
+			Pack::Sub(Pack::Mul(sinXSinY, cosZ), Pack::Mul(cosX, sinZ)), Pack::MulAdd(sinXSinY, sinZ, Pack::Mul(cosX, cosZ)), Pack::Mul(sinX, cosY),
+			Pack::MulAdd(cosXSinY, cosZ, Pack::Mul(sinX, sinZ)), Pack::Sub(Pack::Mul(cosXSinY, sinZ), Pack::Mul(sinX, cosZ)), Pack::Mul(cosX, cosY)
+		};
+		StoreTRS<Pack>(aMatrices, rotation, aScaleX, aScaleY, aScaleZ, aTranslationX, aTranslationY, aTranslationZ, index);
+	}
+}
+
+template<class Pack>
+void QuaternionTRSKernel(const float* aTranslationX, const float* aTranslationY, const float* aTranslationZ, const float* aQuaternions,
+	const float* aScaleX, const float* aScaleY, const float* aScaleZ, float* aMatrices, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		typename Pack::Type rotation[9];
+		QuaternionRotation<Pack>(aQuaternions + index * 4, rotation);
+		StoreTRS<Pack>(aMatrices, rotation, aScaleX, aScaleY, aScaleZ, aTranslationX, aTranslationY, aTranslationZ, index);
+	}
+}
+
+// Wide pack over the bulk of the range, one element at a time for the tail
+#define CU_BATCH_KERNEL_RUN(aKernel, aCount, ...) \
+	{ \
+		const int packedEnd = (aCount) - (aCount) % WidePack::ourWidth; \
+		aKernel<WidePack>(__VA_ARGS__, 0, packedEnd); \
+		aKernel<CU::Simd::PackScalar>(__VA_ARGS__, packedEnd, (aCount)); \
+	}
+
+void QuaternionsToMatrices(const float* aQuaternions, float* aMatrices, const int aCount)
+{
+	CU_BATCH_KERNEL_RUN(QuaternionsToMatricesKernel, aCount, aQuaternions, aMatrices);
+}
+
+void EulerTRS(const float* aTranslationX, const float* aTranslationY, const float* aTranslationZ, const float* anAngleX, const float* anAngleY, const float* anAngleZ,
+	const float* aScaleX, const float* aScaleY, const float* aScaleZ, float* aMatrices, const int aCount)
+{
+	CU_BATCH_KERNEL_RUN(EulerTRSKernel, aCount, aTranslationX, aTranslationY, aTranslationZ, anAngleX, anAngleY, anAngleZ, aScaleX, aScaleY, aScaleZ, aMatrices);
+}
+
+void QuaternionTRS(const float* aTranslationX, const float* aTranslationY, const float* aTranslationZ, const float* aQuaternions,
+	const float* aScaleX, const float* aScaleY, const float* aScaleZ, float* aMatrices, const int aCount)
+{
+	CU_BATCH_KERNEL_RUN(QuaternionTRSKernel, aCount, aTranslationX, aTranslationY, aTranslationZ, aQuaternions, aScaleX, aScaleY, aScaleZ, aMatrices);
+}
+
+#undef CU_BATCH_KERNEL_RUN
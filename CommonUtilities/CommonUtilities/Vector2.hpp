@@ -1,10 +1,11 @@
 #pragma once
 #include <math.h>
+#include "VectorExpression.hpp"
 
 namespace CommonUtilities
 {
 	template <class T>
-	class Vector2
+	class Vector2 : public VectorExpression<Vector2<T>, T, 2>
 	{
 	public:
 		T x;
@@ -13,6 +14,12 @@ namespace CommonUtilities
 		Vector2<T>();
 		Vector2<T>(const T& aX, const T& aY);
 		Vector2<T>(const Vector2<T>& aVector) = default;
+		template <class Expression>
+		Vector2<T>(const VectorExpression<Expression, T, 2>& anExpression);
+		template <class Expression>
+		Vector2<T>& operator=(const VectorExpression<Expression, T, 2>& anExpression);
+		T& operator[](const int anIndex);
+		const T& operator[](const int anIndex) const;
 		~Vector2<T>() = default;
 		T LengthSqr() const;
 		T Length() const;
@@ -36,88 +43,100 @@ namespace CommonUtilities
 	}
 
 	template <class T>
-	inline T Vector2<T>::LengthSqr() const
+	template <class Expression>
+	inline Vector2<T>::Vector2(const VectorExpression<Expression, T, 2>& anExpression)
 	{
-		return (x * x) + (y * y);
+		const Expression& expression = static_cast<const Expression&>(anExpression);
+		x = expression[0];
+		y = expression[1];
 	}
 
 	template <class T>
-	inline T Vector2<T>::Length() const
+	template <class Expression>
+	inline Vector2<T>& Vector2<T>::operator=(const VectorExpression<Expression, T, 2>& anExpression)
 	{
-		return sqrt((x * x) + (y * y));
+		const Expression& expression = static_cast<const Expression&>(anExpression);
+		x = expression[0];
+		y = expression[1];
+		return (*this);
 	}
 
 	template <class T>
-	inline Vector2<T> Vector2<T>::GetNormalized() const
-	{
-		return Vector2<T>(x, y) / Length();
-	}
-
-	template<class T>
-	inline void Vector2<T>::Normalize()
+	inline T& Vector2<T>::operator[](const int anIndex)
 	{
-		T vectorLength = Length();
-		x /= vectorLength;
-		y /= vectorLength;
+		assert(anIndex >= 0 && anIndex < 2 && "Index out of range!");
+		return (&x)[anIndex];
 	}
 
-	template<class T>
-	inline T Vector2<T>::Dot(const Vector2<T>& aVector) const
+	template <class T>
+	inline const T& Vector2<T>::operator[](const int anIndex) const
 	{
-		return T(x * aVector.x + y * aVector.y);
+		assert(anIndex >= 0 && anIndex < 2 && "Index out of range!");
+		return (&x)[anIndex];
 	}
 
 	template <class T>
-	inline Vector2<T> operator+(const Vector2<T>& aVector, const Vector2<T>& aSecondVector)
+	inline T Vector2<T>::LengthSqr() const
 	{
-		return Vector2<T>(aVector.x + aSecondVector.x, aVector.y + aSecondVector.y);
+		return (x * x) + (y * y);
 	}
 
 	template <class T>
-	inline Vector2<T> operator-(const Vector2<T>& aVector, const Vector2<T>& aSecondVector)
+	inline T Vector2<T>::Length() const
 	{
-		return Vector2<T>(aVector.x - aSecondVector.x, aVector.y - aSecondVector.y);
+		return sqrt((x * x) + (y * y));
 	}
 
 	template <class T>
-	inline Vector2<T> operator*(const Vector2<T>& aVector, const T& aScalar)
+	inline Vector2<T> Vector2<T>::GetNormalized() const
 	{
-		return Vector2<T>(aVector.x * aScalar, aVector.y * aScalar);
+		return Vector2<T>(x, y) / Length();
 	}
 
-	template <class T>
-	inline Vector2<T> operator*(const T& aScalar, const Vector2<T>& aVector)
+	template<class T>
+	inline void Vector2<T>::Normalize()
 	{
-		return Vector2<T>(aVector.x * aScalar, aVector.y * aScalar);
+		T vectorLength = Length();
+		x /= vectorLength;
+		y /= vectorLength;
 	}
 
-	template <class T>
-	inline Vector2<T> operator/(const Vector2<T>& aVector, const T& aScalar)
+	template<class T>
+	inline T Vector2<T>::Dot(const Vector2<T>& aVector) const
 	{
-		return Vector2<T>(aVector.x / aScalar, aVector.y / aScalar);
+		return T(x * aVector.x + y * aVector.y);
 	}
 
-	template <class T>
-	inline void operator+=(Vector2<T>& aVector, const Vector2<T>& aSecondVector)
+	// Compound operators update the vector in place
+	template <class T, class Expression>
+	inline Vector2<T>& operator+=(Vector2<T>& aVector, const VectorExpression<Expression, T, 2>& aSecondVector)
 	{
-		aVector = aVector + aSecondVector;
+		aVector.x += aSecondVector[0];
+		aVector.y += aSecondVector[1];
+		return aVector;
 	}
 
-	template <class T>
-	inline void operator-=(Vector2<T>& aVector, const Vector2<T>& aSecondVector)
+	template <class T, class Expression>
+	inline Vector2<T>& operator-=(Vector2<T>& aVector, const VectorExpression<Expression, T, 2>& aSecondVector)
 	{
-		aVector = aVector - aSecondVector;
+		aVector.x -= aSecondVector[0];
+		aVector.y -= aSecondVector[1];
+		return aVector;
 	}
 
 	template <class T>
-	inline void operator*=(Vector2<T>& aVector, const T& aScalar)
+	inline Vector2<T>& operator*=(Vector2<T>& aVector, const T& aScalar)
 	{
-		aVector = aVector * aScalar;
+		aVector.x *= aScalar;
+		aVector.y *= aScalar;
+		return aVector;
 	}
 
 	template <class T>
-	inline void operator/=(Vector2<T>& aVector, const T& aScalar)
+	inline Vector2<T>& operator/=(Vector2<T>& aVector, const T& aScalar)
 	{
-		aVector = aVector / aScalar;
+		aVector.x /= aScalar;
+		aVector.y /= aScalar;
+		return aVector;
 	}
-}
\ No newline at end of file
+}
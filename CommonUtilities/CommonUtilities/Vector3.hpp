@@ -1,10 +1,11 @@
 #pragma once
 #include <math.h>
+#include "VectorExpression.hpp"
 
 namespace CommonUtilities
 {
 	template <class T>
-	class Vector3
+	class Vector3 : public VectorExpression<Vector3<T>, T, 3>
 	{
 	public:
 		T x;
@@ -17,6 +18,16 @@ namespace CommonUtilities
 
 		Vector3<T>(const Vector3<T>& aVector) = default;
 
+		template <class Expression>
+		Vector3<T>(const VectorExpression<Expression, T, 3>& anExpression);
+
+		template <class Expression>
+		Vector3<T>& operator=(const VectorExpression<Expression, T, 3>& anExpression);
+
+		T& operator[](const int anIndex);
+
+		const T& operator[](const int anIndex) const;
+
 		~Vector3<T>() = default;
 
 		T LengthSqr() const;
@@ -48,6 +59,41 @@ namespace CommonUtilities
 		z = aZ;
 	}
 
+	template <class T>
+	template <class Expression>
+	inline Vector3<T>::Vector3(const VectorExpression<Expression, T, 3>& anExpression)
+	{
+		const Expression& expression = static_cast<const Expression&>(anExpression);
+		x = expression[0];
+		y = expression[1];
+		z = expression[2];
+	}
+
+	template <class T>
+	template <class Expression>
+	inline Vector3<T>& Vector3<T>::operator=(const VectorExpression<Expression, T, 3>& anExpression)
+	{
+		const Expression& expression = static_cast<const Expression&>(anExpression);
+		x = expression[0];
+		y = expression[1];
+		z = expression[2];
+		return (*this);
+	}
+
+	template <class T>
+	inline T& Vector3<T>::operator[](const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < 3 && "Index out of range!");
+		return (&x)[anIndex];
+	}
+
+	template <class T>
+	inline const T& Vector3<T>::operator[](const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < 3 && "Index out of range!");
+		return (&x)[anIndex];
+	}
+
 	template <class T>
 	inline T Vector3<T>::LengthSqr() const
 	{
@@ -87,69 +133,49 @@ namespace CommonUtilities
 		return Vector3<T>(y * aVector.z - z * aVector.y, z * aVector.x - x * aVector.z, x * aVector.y - y * aVector.x);
 	}
  
-	template <class T>
-	inline Vector3<T> operator+(const Vector3<T>& aVector, const Vector3<T>& aSecondVector) 
-	{
-		return Vector3<T>(aVector.x + aSecondVector.x, aVector.y + aSecondVector.y, aVector.z + aSecondVector.z);
-	}
-
-	template <class T>
-	inline Vector3<T> operator+(const Vector3<T>& aVector, const T& aScalar)
+	// Compound operators update the vector in place
+	template <class T, class Expression>
+	inline Vector3<T>& operator+=(Vector3<T>& aVector, const VectorExpression<Expression, T, 3>& aSecondVector)
 	{
-		return Vector3<T>(aVector.x + aScalar, aVector.y + aScalar, aVector.z + aScalar);
+		aVector.x += aSecondVector[0];
+		aVector.y += aSecondVector[1];
+		aVector.z += aSecondVector[2];
+		return aVector;
 	}
 
 	template <class T>
-	inline Vector3<T> operator-(const Vector3<T>& aVector, const Vector3<T>& aSecondVector) 
+	inline Vector3<T>& operator+=(Vector3<T>& aVector, const T& aScalar)
 	{
-		return Vector3<T>(aVector.x - aSecondVector.x, aVector.y - aSecondVector.y, aVector.z - aSecondVector.z);
+		aVector.x += aScalar;
+		aVector.y += aScalar;
+		aVector.z += aScalar;
+		return aVector;
 	}
 
-	template <class T>
-	inline Vector3<T> operator*(const Vector3<T>& aVector, const T& aScalar) 
-	{
-		return Vector3<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar);
-	}
-
-	template <class T>
-	inline Vector3<T> operator*(const T& aScalar, const Vector3<T>& aVector) 
+	template <class T, class Expression>
+	inline Vector3<T>& operator-=(Vector3<T>& aVector, const VectorExpression<Expression, T, 3>& aSecondVector)
 	{
-		return Vector3<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar);
+		aVector.x -= aSecondVector[0];
+		aVector.y -= aSecondVector[1];
+		aVector.z -= aSecondVector[2];
+		return aVector;
 	}
 
 	template <class T>
-	inline Vector3<T> operator/(const Vector3<T>& aVector, const T& aScalar) 
+	inline Vector3<T>& operator*=(Vector3<T>& aVector, const T& aScalar)
 	{
-		return Vector3<T>(aVector.x / aScalar, aVector.y / aScalar, aVector.z / aScalar);
-	}
-					   
-	template <class T>
-	inline void operator+=(Vector3<T>& aVector, const Vector3<T>& aSecondVector) 
-	{
-		aVector = aVector + aSecondVector;
+		aVector.x *= aScalar;
+		aVector.y *= aScalar;
+		aVector.z *= aScalar;
+		return aVector;
 	}
 
 	template <class T>
-	inline void operator+=(Vector3<T>& aVector, const T& aScalar)
-	{
-		aVector = aVector + aScalar;
-	}
-					   
-	template <class T> 
-	inline void operator-=(Vector3<T>& aVector, const Vector3<T>& aSecondVector) 
-	{
-		aVector = aVector - aSecondVector;
-	}
-					   
-	template <class T> 
-	inline void operator*=(Vector3<T>& aVector, const T& aScalar) 
-	{
-		aVector = aVector * aScalar;
-	}
-
-	template <class T> 
-	inline void operator/=(Vector3<T>& aVector, const T& aScalar) 
+	inline Vector3<T>& operator/=(Vector3<T>& aVector, const T& aScalar)
 	{
-		aVector = aVector / aScalar;
+		aVector.x /= aScalar;
+		aVector.y /= aScalar;
+		aVector.z /= aScalar;
+		return aVector;
 	}
-}
\ No newline at end of file
+}
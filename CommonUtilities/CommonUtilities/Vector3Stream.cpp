@@ -0,0 +1,94 @@
+#include "Vector3Stream.hpp"
+#include "SimdLevel.hpp"
+#include "SimdPack.hpp"
+
+namespace CU = CommonUtilities;
+
+namespace
+{
+	namespace Scalar
+	{
+		typedef CU::Simd::PackScalar WidePack;
+#include "Vector3StreamKernels.inl"
+	}
+
+#ifdef CU_SIMD_SSE
+	namespace Sse
+	{
+		typedef CU::Simd::PackSSE WidePack;
+#include "Vector3StreamKernels.inl"
+	}
+
+CU_SIMD_AVX2_BEGIN
+	namespace Avx2
+	{
+		typedef CU::Simd::PackAVX2 WidePack;
+#include "Vector3StreamKernels.inl"
+	}
+CU_SIMD_AVX2_END
+
+CU_SIMD_AVX512_BEGIN
+	namespace Avx512
+	{
+		typedef CU::Simd::PackAVX512 WidePack;
+#include "Vector3StreamKernels.inl"
+	}
+CU_SIMD_AVX512_END
+#endif
+}
+
+namespace CommonUtilities
+{
+	namespace Vector3StreamKernels
+	{
+		void Dot(const float* aX, const float* aY, const float* aZ, const float aVectorX, const float aVectorY, const float aVectorZ, float* aOutput, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Dot(aX, aY, aZ, aVectorX, aVectorY, aVectorZ, aOutput, aCount));
+		}
+
+		void Dot(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* aOutput, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Dot(aX, aY, aZ, aSecondX, aSecondY, aSecondZ, aOutput, aCount));
+		}
+
+		void LengthSqr(const float* aX, const float* aY, const float* aZ, float* aOutput, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Dot(aX, aY, aZ, aX, aY, aZ, aOutput, aCount));
+		}
+
+		void Length(const float* aX, const float* aY, const float* aZ, float* aOutput, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Length(aX, aY, aZ, aOutput, aCount));
+		}
+
+		void Normalize(float* aX, float* aY, float* aZ, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Normalize(aX, aY, aZ, aCount));
+		}
+
+		void Cross(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* anOutputX, float* anOutputY, float* anOutputZ, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Cross(aX, aY, aZ, aSecondX, aSecondY, aSecondZ, anOutputX, anOutputY, anOutputZ, aCount));
+		}
+
+		void AddScaled(float* aX, float* aY, float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, const float aScale, const int aCount)
+		{
+			CU_SIMD_DISPATCH(AddScaled(aX, aY, aZ, aSecondX, aSecondY, aSecondZ, aScale, aCount));
+		}
+
+		void Scale(float* aX, float* aY, float* aZ, const float aScale, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Scale(aX, aY, aZ, aScale, aCount));
+		}
+
+		void Deinterleave(const float* aXYZ, float* aX, float* aY, float* aZ, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Deinterleave(aXYZ, aX, aY, aZ, aCount));
+		}
+
+		void Interleave(const float* aX, const float* aY, const float* aZ, float* aXYZ, const int aCount)
+		{
+			CU_SIMD_DISPATCH(Interleave(aX, aY, aZ, aXYZ, aCount));
+		}
+	}
+}
@@ -0,0 +1,505 @@
+#pragma once
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+#include "AlignedAllocation.hpp"
+#include "Vector3.hpp"
+
+namespace CommonUtilities
+{
+	// Bulk operations on separate x, y and z arrays. The templates are the scalar reference,
+	// the float overloads are SIMD kernels chosen at runtime (SimdLevel.hpp).
+	namespace Vector3StreamKernels
+	{
+		template<class T>
+		void Dot(const T* aX, const T* aY, const T* aZ, const T aVectorX, const T aVectorY, const T aVectorZ, T* aOutput, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				aOutput[index] = aX[index] * aVectorX + aY[index] * aVectorY + aZ[index] * aVectorZ;
+			}
+		}
+
+		template<class T>
+		void Dot(const T* aX, const T* aY, const T* aZ, const T* aSecondX, const T* aSecondY, const T* aSecondZ, T* aOutput, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				aOutput[index] = aX[index] * aSecondX[index] + aY[index] * aSecondY[index] + aZ[index] * aSecondZ[index];
+			}
+		}
+
+		template<class T>
+		void LengthSqr(const T* aX, const T* aY, const T* aZ, T* aOutput, const int aCount)
+		{
+			Dot(aX, aY, aZ, aX, aY, aZ, aOutput, aCount);
+		}
+
+		template<class T>
+		void Length(const T* aX, const T* aY, const T* aZ, T* aOutput, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				aOutput[index] = sqrt(aX[index] * aX[index] + aY[index] * aY[index] + aZ[index] * aZ[index]);
+			}
+		}
+
+		template<class T>
+		void Normalize(T* aX, T* aY, T* aZ, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				const T length = sqrt(aX[index] * aX[index] + aY[index] * aY[index] + aZ[index] * aZ[index]);
+				aX[index] /= length;
+				aY[index] /= length;
+				aZ[index] /= length;
+			}
+		}
+
+		// Output may be either of the inputs
+		template<class T>
+		void Cross(const T* aX, const T* aY, const T* aZ, const T* aSecondX, const T* aSecondY, const T* aSecondZ, T* anOutputX, T* anOutputY, T* anOutputZ, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				const T x = aY[index] * aSecondZ[index] - aZ[index] * aSecondY[index];
+				const T y = aZ[index] * aSecondX[index] - aX[index] * aSecondZ[index];
+				const T z = aX[index] * aSecondY[index] - aY[index] * aSecondX[index];
+				anOutputX[index] = x;
+				anOutputY[index] = y;
+				anOutputZ[index] = z;
+			}
+		}
+
+		// First stream += second stream * aScale
+		template<class T>
+		void AddScaled(T* aX, T* aY, T* aZ, const T* aSecondX, const T* aSecondY, const T* aSecondZ, const T aScale, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				aX[index] += aSecondX[index] * aScale;
+				aY[index] += aSecondY[index] * aScale;
+				aZ[index] += aSecondZ[index] * aScale;
+			}
+		}
+
+		template<class T>
+		void Scale(T* aX, T* aY, T* aZ, const T aScale, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				aX[index] *= aScale;
+				aY[index] *= aScale;
+				aZ[index] *= aScale;
+			}
+		}
+
+		// Packed xyz triplets to separate arrays and back
+		template<class T>
+		void Deinterleave(const T* aXYZ, T* aX, T* aY, T* aZ, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				aX[index] = aXYZ[index * 3];
+				aY[index] = aXYZ[index * 3 + 1];
+				aZ[index] = aXYZ[index * 3 + 2];
+			}
+		}
+
+		template<class T>
+		void Interleave(const T* aX, const T* aY, const T* aZ, T* aXYZ, const int aCount)
+		{
+			for (int index = 0; index < aCount; ++index)
+			{
+				aXYZ[index * 3] = aX[index];
+				aXYZ[index * 3 + 1] = aY[index];
+				aXYZ[index * 3 + 2] = aZ[index];
+			}
+		}
+
+		void Dot(const float* aX, const float* aY, const float* aZ, const float aVectorX, const float aVectorY, const float aVectorZ, float* aOutput, const int aCount);
+		void Dot(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* aOutput, const int aCount);
+		void LengthSqr(const float* aX, const float* aY, const float* aZ, float* aOutput, const int aCount);
+		void Length(const float* aX, const float* aY, const float* aZ, float* aOutput, const int aCount);
+		void Normalize(float* aX, float* aY, float* aZ, const int aCount);
+		void Cross(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* anOutputX, float* anOutputY, float* anOutputZ, const int aCount);
+		void AddScaled(float* aX, float* aY, float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, const float aScale, const int aCount);
+		void Scale(float* aX, float* aY, float* aZ, const float aScale, const int aCount);
+		void Deinterleave(const float* aXYZ, float* aX, float* aY, float* aZ, const int aCount);
+		void Interleave(const float* aX, const float* aY, const float* aZ, float* aXYZ, const int aCount);
+	}
+
+	// Structure-of-arrays storage for many Vector3: x, y and z live in separate 64-byte aligned arrays
+	template<class T>
+	class Vector3Stream
+	{
+	public:
+		Vector3Stream();
+		explicit Vector3Stream(const int aCount);
+		Vector3Stream(const std::vector<Vector3<T>>& aVectors);
+		Vector3Stream(const Vector3Stream& aStream);
+		Vector3Stream(Vector3Stream&& aStream);
+		~Vector3Stream();
+
+		Vector3Stream& operator=(const Vector3Stream& aStream);
+		Vector3Stream& operator=(Vector3Stream&& aStream);
+
+		void Reserve(const int aCapacity);
+		// New elements are zero
+		void Resize(const int aCount);
+		void Clear();
+		void Add(const Vector3<T>& aVector);
+
+		int Count() const;
+		int Capacity() const;
+
+		Vector3<T> Get(const int aIndex) const;
+		void Set(const int aIndex, const Vector3<T>& aVector);
+
+		T* GetX();
+		T* GetY();
+		T* GetZ();
+		const T* GetX() const;
+		const T* GetY() const;
+		const T* GetZ() const;
+
+		// Conversion from and to packed Vector3 arrays
+		void Assign(const Vector3<T>* aVectors, const int aCount);
+		void Assign(const std::vector<Vector3<T>>& aVectors);
+		void CopyTo(Vector3<T>* aVectors) const;
+		void CopyTo(std::vector<Vector3<T>>& aVectors) const;
+		std::vector<Vector3<T>> ToVector() const;
+
+		// Bulk operations, aOutput must hold Count() elements
+		void Dot(const Vector3<T>& aVector, T* aOutput) const;
+		void Dot(const Vector3Stream& aStream, T* aOutput) const;
+		void LengthSqr(T* aOutput) const;
+		void Length(T* aOutput) const;
+		void Normalize();
+		void Cross(const Vector3Stream& aStream, Vector3Stream& aOutput) const;
+		void AddScaled(const Vector3Stream& aStream, const T aScale);
+
+		Vector3Stream& operator+=(const Vector3Stream& aStream);
+		Vector3Stream& operator-=(const Vector3Stream& aStream);
+		Vector3Stream& operator*=(const T aScale);
+
+	private:
+		static const int ourAlignment = 64;
+		static int RoundUpCapacity(const int aCapacity);
+		void Reallocate(const int aCapacity);
+
+		T* myX;
+		T* myY;
+		T* myZ;
+		int myCount;
+		int myCapacity;
+	};
+
+	template<class T>
+	inline Vector3Stream<T>::Vector3Stream()
+	{
+		myX = nullptr;
+		myY = nullptr;
+		myZ = nullptr;
+		myCount = 0;
+		myCapacity = 0;
+	}
+
+	template<class T>
+	inline Vector3Stream<T>::Vector3Stream(const int aCount) : Vector3Stream()
+	{
+		Resize(aCount);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>::Vector3Stream(const std::vector<Vector3<T>>& aVectors) : Vector3Stream()
+	{
+		Assign(aVectors);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>::Vector3Stream(const Vector3Stream& aStream) : Vector3Stream()
+	{
+		(*this) = aStream;
+	}
+
+	template<class T>
+	inline Vector3Stream<T>::Vector3Stream(Vector3Stream&& aStream) : Vector3Stream()
+	{
+		(*this) = std::move(aStream);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>::~Vector3Stream()
+	{
+		AlignedFree(myX);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>& Vector3Stream<T>::operator=(const Vector3Stream& aStream)
+	{
+		if (this != &aStream)
+		{
+			Resize(aStream.myCount);
+			memcpy(myX, aStream.myX, sizeof(T) * myCount);
+			memcpy(myY, aStream.myY, sizeof(T) * myCount);
+			memcpy(myZ, aStream.myZ, sizeof(T) * myCount);
+		}
+		return (*this);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>& Vector3Stream<T>::operator=(Vector3Stream&& aStream)
+	{
+		std::swap(myX, aStream.myX);
+		std::swap(myY, aStream.myY);
+		std::swap(myZ, aStream.myZ);
+		std::swap(myCount, aStream.myCount);
+		std::swap(myCapacity, aStream.myCapacity);
+		return (*this);
+	}
+
+	template<class T>
+	inline int Vector3Stream<T>::RoundUpCapacity(const int aCapacity)
+	{
+		// Keeps every array a whole number of cache lines so y and z stay aligned too
+		const int elementsPerLine = sizeof(T) < ourAlignment ? ourAlignment / static_cast<int>(sizeof(T)) : 1;
+		return (aCapacity + elementsPerLine - 1) / elementsPerLine * elementsPerLine;
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Reallocate(const int aCapacity)
+	{
+		const int capacity = RoundUpCapacity(aCapacity);
+		T* memory = static_cast<T*>(AlignedAllocate(sizeof(T) * capacity * 3, ourAlignment));
+		if (myCount > 0)
+		{
+			memcpy(memory, myX, sizeof(T) * myCount);
+			memcpy(memory + capacity, myY, sizeof(T) * myCount);
+			memcpy(memory + capacity * 2, myZ, sizeof(T) * myCount);
+		}
+		AlignedFree(myX);
+
+		myX = memory;
+		myY = memory + capacity;
+		myZ = memory + capacity * 2;
+		myCapacity = capacity;
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Reserve(const int aCapacity)
+	{
+		if (aCapacity > myCapacity)
+		{
+			Reallocate(aCapacity);
+		}
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Resize(const int aCount)
+	{
+		assert(aCount >= 0 && "Count can't be negative!");
+		Reserve(aCount);
+		for (int index = myCount; index < aCount; ++index)
+		{
+			myX[index] = 0;
+			myY[index] = 0;
+			myZ[index] = 0;
+		}
+		myCount = aCount;
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Clear()
+	{
+		myCount = 0;
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Add(const Vector3<T>& aVector)
+	{
+		if (myCount == myCapacity)
+		{
+			Reallocate(myCapacity > 0 ? myCapacity * 2 : 1);
+		}
+		myX[myCount] = aVector.x;
+		myY[myCount] = aVector.y;
+		myZ[myCount] = aVector.z;
+		++myCount;
+	}
+
+	template<class T>
+	inline int Vector3Stream<T>::Count() const
+	{
+		return myCount;
+	}
+
+	template<class T>
+	inline int Vector3Stream<T>::Capacity() const
+	{
+		return myCapacity;
+	}
+
+	template<class T>
+	inline Vector3<T> Vector3Stream<T>::Get(const int aIndex) const
+	{
+		assert(aIndex >= 0 && aIndex < myCount && "Index out of range!");
+		return Vector3<T>(myX[aIndex], myY[aIndex], myZ[aIndex]);
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Set(const int aIndex, const Vector3<T>& aVector)
+	{
+		assert(aIndex >= 0 && aIndex < myCount && "Index out of range!");
+		myX[aIndex] = aVector.x;
+		myY[aIndex] = aVector.y;
+		myZ[aIndex] = aVector.z;
+	}
+
+	template<class T>
+	inline T* Vector3Stream<T>::GetX()
+	{
+		return myX;
+	}
+
+	template<class T>
+	inline T* Vector3Stream<T>::GetY()
+	{
+		return myY;
+	}
+
+	template<class T>
+	inline T* Vector3Stream<T>::GetZ()
+	{
+		return myZ;
+	}
+
+	template<class T>
+	inline const T* Vector3Stream<T>::GetX() const
+	{
+		return myX;
+	}
+
+	template<class T>
+	inline const T* Vector3Stream<T>::GetY() const
+	{
+		return myY;
+	}
+
+	template<class T>
+	inline const T* Vector3Stream<T>::GetZ() const
+	{
+		return myZ;
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Assign(const Vector3<T>* aVectors, const int aCount)
+	{
+		myCount = 0;
+		Reserve(aCount);
+		myCount = aCount;
+		if (aCount > 0)
+		{
+			Vector3StreamKernels::Deinterleave(&aVectors[0].x, myX, myY, myZ, aCount);
+		}
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Assign(const std::vector<Vector3<T>>& aVectors)
+	{
+		Assign(aVectors.data(), static_cast<int>(aVectors.size()));
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::CopyTo(Vector3<T>* aVectors) const
+	{
+		if (myCount > 0)
+		{
+			Vector3StreamKernels::Interleave(myX, myY, myZ, &aVectors[0].x, myCount);
+		}
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::CopyTo(std::vector<Vector3<T>>& aVectors) const
+	{
+		aVectors.resize(myCount);
+		CopyTo(aVectors.data());
+	}
+
+	template<class T>
+	inline std::vector<Vector3<T>> Vector3Stream<T>::ToVector() const
+	{
+		std::vector<Vector3<T>> vectors;
+		CopyTo(vectors);
+		return vectors;
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Dot(const Vector3<T>& aVector, T* aOutput) const
+	{
+		Vector3StreamKernels::Dot(myX, myY, myZ, aVector.x, aVector.y, aVector.z, aOutput, myCount);
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Dot(const Vector3Stream& aStream, T* aOutput) const
+	{
+		assert(aStream.myCount == myCount && "Streams of different size can't be used as argument!");
+		Vector3StreamKernels::Dot(myX, myY, myZ, aStream.myX, aStream.myY, aStream.myZ, aOutput, myCount);
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::LengthSqr(T* aOutput) const
+	{
+		Vector3StreamKernels::LengthSqr(myX, myY, myZ, aOutput, myCount);
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Length(T* aOutput) const
+	{
+		Vector3StreamKernels::Length(myX, myY, myZ, aOutput, myCount);
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Normalize()
+	{
+		Vector3StreamKernels::Normalize(myX, myY, myZ, myCount);
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::Cross(const Vector3Stream& aStream, Vector3Stream& aOutput) const
+	{
+		assert(aStream.myCount == myCount && "Streams of different size can't be used as argument!");
+		aOutput.Resize(myCount);
+		Vector3StreamKernels::Cross(myX, myY, myZ, aStream.myX, aStream.myY, aStream.myZ, aOutput.myX, aOutput.myY, aOutput.myZ, myCount);
+	}
+
+	template<class T>
+	inline void Vector3Stream<T>::AddScaled(const Vector3Stream& aStream, const T aScale)
+	{
+		assert(aStream.myCount == myCount && "Streams of different size can't be used as argument!");
+		Vector3StreamKernels::AddScaled(myX, myY, myZ, aStream.myX, aStream.myY, aStream.myZ, aScale, myCount);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>& Vector3Stream<T>::operator+=(const Vector3Stream& aStream)
+	{
+		AddScaled(aStream, T(1));
+		return (*this);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>& Vector3Stream<T>::operator-=(const Vector3Stream& aStream)
+	{
+		AddScaled(aStream, T(-1));
+		return (*this);
+	}
+
+	template<class T>
+	inline Vector3Stream<T>& Vector3Stream<T>::operator*=(const T aScale)
+	{
+		Vector3StreamKernels::Scale(myX, myY, myZ, aScale, myCount);
+		return (*this);
+	}
+}
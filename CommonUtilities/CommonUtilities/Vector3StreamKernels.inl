@@ -0,0 +1,175 @@
+// Vector3Stream kernels written once over a Pack (SimdPack.hpp).
+// Included by Vector3Stream.cpp once per instruction set, inside a namespace that defines WidePack.
+// Each kernel runs [aBegin, anEnd) where the range is a multiple of Pack::ourWidth.
+
+template<class Pack>
+void DotVectorKernel(const float* aX, const float* aY, const float* aZ, const float aVectorX, const float aVectorY, const float aVectorZ, float* aOutput, const int aBegin, const int anEnd)
+{
+	const typename Pack::Type vectorX = Pack::Set(aVectorX);
+	const typename Pack::Type vectorY = Pack::Set(aVectorY);
+	const typename Pack::Type vectorZ = Pack::Set(aVectorZ);
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		typename Pack::Type sum = Pack::Mul(Pack::Load(aX + index), vectorX);
+		sum = Pack::MulAdd(Pack::Load(aY + index), vectorY, sum);
+		sum = Pack::MulAdd(Pack::Load(aZ + index), vectorZ, sum);
+		Pack::Store(aOutput + index, sum);
+	}
+}
+
+template<class Pack>
+void DotStreamKernel(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* aOutput, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		typename Pack::Type sum = Pack::Mul(Pack::Load(aX + index), Pack::Load(aSecondX + index));
+		sum = Pack::MulAdd(Pack::Load(aY + index), Pack::Load(aSecondY + index), sum);
+		sum = Pack::MulAdd(Pack::Load(aZ + index), Pack::Load(aSecondZ + index), sum);
+		Pack::Store(aOutput + index, sum);
+	}
+}
+
+template<class Pack>
+void LengthKernel(const float* aX, const float* aY, const float* aZ, float* aOutput, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		const typename Pack::Type x = Pack::Load(aX + index);
+		const typename Pack::Type y = Pack::Load(aY + index);
+		const typename Pack::Type z = Pack::Load(aZ + index);
+		Pack::Store(aOutput + index, Pack::Sqrt(Pack::MulAdd(z, z, Pack::MulAdd(y, y, Pack::Mul(x, x)))));
+	}
+}
+
+template<class Pack>
+void NormalizeKernel(float* aX, float* aY, float* aZ, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		const typename Pack::Type x = Pack::Load(aX + index);
+		const typename Pack::Type y = Pack::Load(aY + index);
+		const typename Pack::Type z = Pack::Load(aZ + index);
+		const typename Pack::Type length = Pack::Sqrt(Pack::MulAdd(z, z, Pack::MulAdd(y, y, Pack::Mul(x, x))));
+		Pack::Store(aX + index, Pack::Div(x, length));
+		Pack::Store(aY + index, Pack::Div(y, length));
+		Pack::Store(aZ + index, Pack::Div(z, length));
+	}
+}
+
+template<class Pack>
+void CrossKernel(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* anOutputX, float* anOutputY, float* anOutputZ, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		const typename Pack::Type x = Pack::Load(aX + index);
+		const typename Pack::Type y = Pack::Load(aY + index);
+		const typename Pack::Type z = Pack::Load(aZ + index);
+		const typename Pack::Type secondX = Pack::Load(aSecondX + index);
+		const typename Pack::Type secondY = Pack::Load(aSecondY + index);
+		const typename Pack::Type secondZ = Pack::Load(aSecondZ + index);
+		Pack::Store(anOutputX + index, Pack::Sub(Pack::Mul(y, secondZ), Pack::Mul(z, secondY)));
+		Pack::Store(anOutputY + index, Pack::Sub(Pack::Mul(z, secondX), Pack::Mul(x, secondZ)));
+		Pack::Store(anOutputZ + index, Pack::Sub(Pack::Mul(x, secondY), Pack::Mul(y, secondX)));
+	}
+}
+
+template<class Pack>
+void AddScaledKernel(float* aX, float* aY, float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, const float aScale, const int aBegin, const int anEnd)
+{
+	const typename Pack::Type scale = Pack::Set(aScale);
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		Pack::Store(aX + index, Pack::MulAdd(Pack::Load(aSecondX + index), scale, Pack::Load(aX + index)));
+		Pack::Store(aY + index, Pack::MulAdd(Pack::Load(aSecondY + index), scale, Pack::Load(aY + index)));
+		Pack::Store(aZ + index, Pack::MulAdd(Pack::Load(aSecondZ + index), scale, Pack::Load(aZ + index)));
+	}
+}
+
+template<class Pack>
+void ScaleKernel(float* aX, float* aY, float* aZ, const float aScale, const int aBegin, const int anEnd)
+{
+	const typename Pack::Type scale = Pack::Set(aScale);
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		Pack::Store(aX + index, Pack::Mul(Pack::Load(aX + index), scale));
+		Pack::Store(aY + index, Pack::Mul(Pack::Load(aY + index), scale));
+		Pack::Store(aZ + index, Pack::Mul(Pack::Load(aZ + index), scale));
+	}
+}
+
+template<class Pack>
+void DeinterleaveKernel(const float* aXYZ, float* aX, float* aY, float* aZ, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		typename Pack::Type x, y, z;
+		Pack::LoadXYZ(aXYZ + index * 3, x, y, z);
+		Pack::Store(aX + index, x);
+		Pack::Store(aY + index, y);
+		Pack::Store(aZ + index, z);
+	}
+}
+
+template<class Pack>
+void InterleaveKernel(const float* aX, const float* aY, const float* aZ, float* aXYZ, const int aBegin, const int anEnd)
+{
+	for (int index = aBegin; index < anEnd; index += Pack::ourWidth)
+	{
+		Pack::StoreXYZ(aXYZ + index * 3, Pack::Load(aX + index), Pack::Load(aY + index), Pack::Load(aZ + index));
+	}
+}
+
+// Wide pack over the bulk of the range, one float at a time for the tail
+#define CU_STREAM_KERNEL_RUN(aKernel, aCount, ...) \
+	{ \
+		const int packedEnd = (aCount) - (aCount) % WidePack::ourWidth; \
+		aKernel<WidePack>(__VA_ARGS__, 0, packedEnd); \
+		aKernel<CU::Simd::PackScalar>(__VA_ARGS__, packedEnd, (aCount)); \
+	}
+
+void Dot(const float* aX, const float* aY, const float* aZ, const float aVectorX, const float aVectorY, const float aVectorZ, float* aOutput, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(DotVectorKernel, aCount, aX, aY, aZ, aVectorX, aVectorY, aVectorZ, aOutput);
+}
+
+void Dot(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* aOutput, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(DotStreamKernel, aCount, aX, aY, aZ, aSecondX, aSecondY, aSecondZ, aOutput);
+}
+
+void Length(const float* aX, const float* aY, const float* aZ, float* aOutput, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(LengthKernel, aCount, aX, aY, aZ, aOutput);
+}
+
+void Normalize(float* aX, float* aY, float* aZ, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(NormalizeKernel, aCount, aX, aY, aZ);
+}
+
+void Cross(const float* aX, const float* aY, const float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, float* anOutputX, float* anOutputY, float* anOutputZ, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(CrossKernel, aCount, aX, aY, aZ, aSecondX, aSecondY, aSecondZ, anOutputX, anOutputY, anOutputZ);
+}
+
+void AddScaled(float* aX, float* aY, float* aZ, const float* aSecondX, const float* aSecondY, const float* aSecondZ, const float aScale, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(AddScaledKernel, aCount, aX, aY, aZ, aSecondX, aSecondY, aSecondZ, aScale);
+}
+
+void Scale(float* aX, float* aY, float* aZ, const float aScale, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(ScaleKernel, aCount, aX, aY, aZ, aScale);
+}
+
+void Deinterleave(const float* aXYZ, float* aX, float* aY, float* aZ, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(DeinterleaveKernel, aCount, aXYZ, aX, aY, aZ);
+}
+
+void Interleave(const float* aX, const float* aY, const float* aZ, float* aXYZ, const int aCount)
+{
+	CU_STREAM_KERNEL_RUN(InterleaveKernel, aCount, aX, aY, aZ, aXYZ);
+}
+
+#undef CU_STREAM_KERNEL_RUN
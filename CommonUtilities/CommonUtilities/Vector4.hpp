@@ -1,10 +1,12 @@
 #pragma once
 #include <math.h>
+#include "VectorExpression.hpp"
+#include "Simd.hpp"
 
 namespace CommonUtilities
 {
 	template <class T>
-	class Vector4
+	class alignas(SimdAlignment<T, 4>::value) Vector4 : public VectorExpression<Vector4<T>, T, 4>
 	{
 	public:
 		T x;
@@ -18,6 +20,16 @@ namespace CommonUtilities
 
 		Vector4<T>(const Vector4<T>& aVector) = default;
 
+		template <class Expression>
+		Vector4<T>(const VectorExpression<Expression, T, 4>& anExpression);
+
+		template <class Expression>
+		Vector4<T>& operator=(const VectorExpression<Expression, T, 4>& anExpression);
+
+		T& operator[](const int anIndex);
+
+		const T& operator[](const int anIndex) const;
+
 		~Vector4<T>() = default;
 
 		T LengthSqr() const;
@@ -49,6 +61,43 @@ namespace CommonUtilities
 		w = aW;
 	}
 
+	template <class T>
+	template <class Expression>
+	inline Vector4<T>::Vector4(const VectorExpression<Expression, T, 4>& anExpression)
+	{
+		const Expression& expression = static_cast<const Expression&>(anExpression);
+		x = expression[0];
+		y = expression[1];
+		z = expression[2];
+		w = expression[3];
+	}
+
+	template <class T>
+	template <class Expression>
+	inline Vector4<T>& Vector4<T>::operator=(const VectorExpression<Expression, T, 4>& anExpression)
+	{
+		const Expression& expression = static_cast<const Expression&>(anExpression);
+		x = expression[0];
+		y = expression[1];
+		z = expression[2];
+		w = expression[3];
+		return (*this);
+	}
+
+	template <class T>
+	inline T& Vector4<T>::operator[](const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < 4 && "Index out of range!");
+		return (&x)[anIndex];
+	}
+
+	template <class T>
+	inline const T& Vector4<T>::operator[](const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < 4 && "Index out of range!");
+		return (&x)[anIndex];
+	}
+
 	template <class T>
 	inline T Vector4<T>::LengthSqr() const
 	{
@@ -83,57 +132,44 @@ namespace CommonUtilities
 		return T(x * aVector.x + y * aVector.y + z * aVector.z + w * aVector.w);
 	}
 
-	template <class T>
-	inline Vector4<T> operator+(const Vector4<T>& aVector, const Vector4<T>& aSecondVector)
-	{
-		return Vector4<T>(aVector.x + aSecondVector.x, aVector.y + aSecondVector.y, aVector.z + aSecondVector.z, aVector.w + aSecondVector.w);
-	}
-
-	template <class T>
-	inline Vector4<T> operator-(const Vector4<T>& aVector, const Vector4<T>& aSecondVector)
+	// Compound operators update the vector in place
+	template <class T, class Expression>
+	inline Vector4<T>& operator+=(Vector4<T>& aVector, const VectorExpression<Expression, T, 4>& aSecondVector)
 	{
-		return Vector4<T>(aVector.x - aSecondVector.x, aVector.y - aSecondVector.y, aVector.z - aSecondVector.z, aVector.w - aSecondVector.w);
+		aVector.x += aSecondVector[0];
+		aVector.y += aSecondVector[1];
+		aVector.z += aSecondVector[2];
+		aVector.w += aSecondVector[3];
+		return aVector;
 	}
 
-	template <class T>
-	inline Vector4<T> operator*(const Vector4<T>& aVector, const T& aScalar)
-	{
-		return Vector4<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar, aVector.w * aScalar);
-	}
-
-	template <class T>
-	inline Vector4<T> operator*(const T& aScalar, const Vector4<T>& aVector)
-	{
-		return Vector4<T>(aVector.x * aScalar, aVector.y * aScalar, aVector.z * aScalar, aVector.w * aScalar);
-	}
-
-	template <class T>
-	inline Vector4<T> operator/(const Vector4<T>& aVector, const T& aScalar)
-	{
-		return Vector4<T>(aVector.x / aScalar, aVector.y / aScalar, aVector.z / aScalar, aVector.w / aScalar);
-	}
-
-	template <class T>
-	inline void operator+=(Vector4<T>& aVector, const Vector4<T>& aSecondVector)
-	{
-		aVector = aVector + aSecondVector;
-	}
-
-	template <class T>
-	inline void operator-=(Vector4<T>& aVector, const Vector4<T>& aSecondVector)
+	template <class T, class Expression>
+	inline Vector4<T>& operator-=(Vector4<T>& aVector, const VectorExpression<Expression, T, 4>& aSecondVector)
 	{
-		aVector = aVector - aSecondVector;
+		aVector.x -= aSecondVector[0];
+		aVector.y -= aSecondVector[1];
+		aVector.z -= aSecondVector[2];
+		aVector.w -= aSecondVector[3];
+		return aVector;
 	}
 
 	template <class T>
-	inline void operator*=(Vector4<T>& aVector, const T& aScalar)
+	inline Vector4<T>& operator*=(Vector4<T>& aVector, const T& aScalar)
 	{
-		aVector = aVector * aScalar;
+		aVector.x *= aScalar;
+		aVector.y *= aScalar;
+		aVector.z *= aScalar;
+		aVector.w *= aScalar;
+		return aVector;
 	}
 
 	template <class T>
-	inline void operator/=(Vector4<T>& aVector, const T& aScalar)
+	inline Vector4<T>& operator/=(Vector4<T>& aVector, const T& aScalar)
 	{
-		aVector = aVector / aScalar;
+		aVector.x /= aScalar;
+		aVector.y /= aScalar;
+		aVector.z /= aScalar;
+		aVector.w /= aScalar;
+		return aVector;
 	}
-}
\ No newline at end of file
+}
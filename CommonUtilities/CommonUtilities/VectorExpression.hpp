@@ -0,0 +1,172 @@
+#pragma once
+#include <assert.h>
+
+namespace CommonUtilities
+{
+	template <class T>
+	class Vector2;
+	template <class T>
+	class Vector3;
+	template <class T>
+	class Vector4;
+
+	template <class T, int Size>
+	struct VectorOfSize;
+	template <class T>
+	struct VectorOfSize<T, 2> { typedef Vector2<T> Type; };
+	template <class T>
+	struct VectorOfSize<T, 3> { typedef Vector3<T> Type; };
+	template <class T>
+	struct VectorOfSize<T, 4> { typedef Vector4<T> Type; };
+
+	// Base of the vectors and of every arithmetic expression on them. An expression like a + b * s - c
+	// builds a small tree of nodes that is evaluated one component at a time when it is assigned to a
+	// vector, so no intermediate vectors are created. All nodes are component-wise, which makes it
+	// safe for the target to also appear in the expression (a = b - a).
+	// Every node holds its operands by value, vectors included, so an expression built from temporaries
+	// can be kept in an auto variable or returned. The vectors are small and the copies optimize away.
+	// Expressions have the read-only functions of the vectors, so (a - b).Length() works. Components are
+	// fields on the vectors and can't be lazy, so reading one off an expression goes through (a - b).Eval().x.
+	template <class Expression, class T, int Size>
+	class VectorExpression
+	{
+	public:
+		typedef T ValueType;
+		typedef typename VectorOfSize<T, Size>::Type VectorType;
+		static const int ourSize = Size;
+
+		T operator[](const int anIndex) const
+		{
+			return static_cast<const Expression&>(*this)[anIndex];
+		}
+
+		VectorType Eval() const
+		{
+			return VectorType(*this);
+		}
+
+		T LengthSqr() const
+		{
+			return Eval().LengthSqr();
+		}
+
+		T Length() const
+		{
+			return Eval().Length();
+		}
+
+		VectorType GetNormalized() const
+		{
+			return Eval().GetNormalized();
+		}
+
+		template <class Other>
+		T Dot(const VectorExpression<Other, T, Size>& aVector) const
+		{
+			return Eval().Dot(VectorType(aVector));
+		}
+
+		template <class Other>
+		VectorType Cross(const VectorExpression<Other, T, Size>& aVector) const
+		{
+			static_assert(Size == 3, "Cross is only defined for 3D vectors!");
+			return Eval().Cross(VectorType(aVector));
+		}
+	};
+
+	template <class Left, class Right, class T, int Size>
+	class VectorSum : public VectorExpression<VectorSum<Left, Right, T, Size>, T, Size>
+	{
+	public:
+		VectorSum(const Left& aLeft, const Right& aRight) : myLeft(aLeft), myRight(aRight) {}
+		T operator[](const int anIndex) const { return myLeft[anIndex] + myRight[anIndex]; }
+
+	private:
+		Left myLeft;
+		Right myRight;
+	};
+
+	template <class Left, class Right, class T, int Size>
+	class VectorDifference : public VectorExpression<VectorDifference<Left, Right, T, Size>, T, Size>
+	{
+	public:
+		VectorDifference(const Left& aLeft, const Right& aRight) : myLeft(aLeft), myRight(aRight) {}
+		T operator[](const int anIndex) const { return myLeft[anIndex] - myRight[anIndex]; }
+
+	private:
+		Left myLeft;
+		Right myRight;
+	};
+
+	template <class Operand, class T, int Size>
+	class VectorScalarSum : public VectorExpression<VectorScalarSum<Operand, T, Size>, T, Size>
+	{
+	public:
+		VectorScalarSum(const Operand& anOperand, const T& aScalar) : myOperand(anOperand), myScalar(aScalar) {}
+		T operator[](const int anIndex) const { return myOperand[anIndex] + myScalar; }
+
+	private:
+		Operand myOperand;
+		T myScalar;
+	};
+
+	template <class Operand, class T, int Size>
+	class VectorScaled : public VectorExpression<VectorScaled<Operand, T, Size>, T, Size>
+	{
+	public:
+		VectorScaled(const Operand& anOperand, const T& aScalar) : myOperand(anOperand), myScalar(aScalar) {}
+		T operator[](const int anIndex) const { return myOperand[anIndex] * myScalar; }
+
+	private:
+		Operand myOperand;
+		T myScalar;
+	};
+
+	template <class Operand, class T, int Size>
+	class VectorQuotient : public VectorExpression<VectorQuotient<Operand, T, Size>, T, Size>
+	{
+	public:
+		VectorQuotient(const Operand& anOperand, const T& aScalar) : myOperand(anOperand), myScalar(aScalar) {}
+		T operator[](const int anIndex) const { return myOperand[anIndex] / myScalar; }
+
+	private:
+		Operand myOperand;
+		T myScalar;
+	};
+
+	template <class Left, class Right, class T, int Size>
+	inline VectorSum<Left, Right, T, Size> operator+(const VectorExpression<Left, T, Size>& aVector, const VectorExpression<Right, T, Size>& aSecondVector)
+	{
+		return VectorSum<Left, Right, T, Size>(static_cast<const Left&>(aVector), static_cast<const Right&>(aSecondVector));
+	}
+
+	template <class Operand, class T, int Size>
+	inline VectorScalarSum<Operand, T, Size> operator+(const VectorExpression<Operand, T, Size>& aVector, const T& aScalar)
+	{
+		return VectorScalarSum<Operand, T, Size>(static_cast<const Operand&>(aVector), aScalar);
+	}
+
+	template <class Left, class Right, class T, int Size>
+	inline VectorDifference<Left, Right, T, Size> operator-(const VectorExpression<Left, T, Size>& aVector, const VectorExpression<Right, T, Size>& aSecondVector)
+	{
+		return VectorDifference<Left, Right, T, Size>(static_cast<const Left&>(aVector), static_cast<const Right&>(aSecondVector));
+	}
+
+	template <class Operand, class T, int Size>
+	inline VectorScaled<Operand, T, Size> operator*(const VectorExpression<Operand, T, Size>& aVector, const T& aScalar)
+	{
+		return VectorScaled<Operand, T, Size>(static_cast<const Operand&>(aVector), aScalar);
+	}
+
+	template <class Operand, class T, int Size>
+	inline VectorScaled<Operand, T, Size> operator*(const T& aScalar, const VectorExpression<Operand, T, Size>& aVector)
+	{
+		return VectorScaled<Operand, T, Size>(static_cast<const Operand&>(aVector), aScalar);
+	}
+
+	template <class Operand, class T, int Size>
+	inline VectorQuotient<Operand, T, Size> operator/(const VectorExpression<Operand, T, Size>& aVector, const T& aScalar)
+	{
+		return VectorQuotient<Operand, T, Size>(static_cast<const Operand&>(aVector), aScalar);
+	}
+}
@@ -0,0 +1,439 @@
+#pragma once
+#include <assert.h>
+#include <algorithm>
+#include <initializer_list>
+#include <new>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "AlignedAllocation.hpp"
+
+namespace CommonUtilities
+{
+	// Growable array that keeps its first InlineCapacity elements inside the object and only moves
+	// to heap memory from Allocator when it grows past that. Trivially copyable elements are relocated
+	// with memcpy/memmove like in GrowingArray.
+	template<class T, int InlineCapacity, class Allocator = AlignedAllocator>
+	class VectorOnStack
+	{
+	public:
+		static_assert(InlineCapacity > 0, "VectorOnStack needs room for at least one element inline!");
+
+		VectorOnStack(const Allocator& anAllocator = Allocator());
+		VectorOnStack(const std::initializer_list<T>& aInitList);
+		VectorOnStack(const VectorOnStack& aVector);
+		VectorOnStack(VectorOnStack&& aVector);
+		~VectorOnStack();
+
+		VectorOnStack& operator=(const VectorOnStack& aVector);
+		VectorOnStack& operator=(VectorOnStack&& aVector);
+
+		inline T& operator[](const int anIndex);
+		inline const T& operator[](const int anIndex) const;
+
+		inline void Add(const T& anObject);
+		inline void Add(T&& anObject);
+		template<class... Arguments>
+		inline T& Emplace(Arguments&&... someArguments);
+		// Shifts the elements from anIndex one step up, anIndex may be Count()
+		inline void Insert(const int anIndex, const T& anObject);
+
+		// Swaps with the last element and pops it, like CYCLIC_ERASE. Returns false if anObject isn't found.
+		inline bool RemoveCyclic(const T& anObject);
+		inline void RemoveCyclicAtIndex(const int anIndex);
+		inline void RemoveAtIndex(const int anIndex);
+		inline void RemoveAll();
+
+		inline T& GetLast();
+		inline const T& GetLast() const;
+
+		void Reserve(const int aCapacity);
+
+		inline int Count() const;
+		inline int Capacity() const;
+		inline bool IsEmpty() const;
+		// True once the elements have spilled to the heap
+		inline bool IsOnHeap() const;
+
+		inline T* GetData();
+		inline const T* GetData() const;
+		inline T* begin();
+		inline T* end();
+		inline const T* begin() const;
+		inline const T* end() const;
+
+	private:
+		typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value> IsTriviallyCopyable;
+
+		inline T* GetInline();
+		inline const T* GetInline() const;
+		void Reallocate(const int aCapacity);
+		// Moves the elements of aVector, which is on the stack, into our empty inline storage
+		void TakeInline(VectorOnStack& aVector);
+
+		static void Relocate(T* aDestination, T* aSource, const int aCount, std::true_type);
+		static void Relocate(T* aDestination, T* aSource, const int aCount, std::false_type);
+		void ShiftUp(const int anIndex, std::true_type);
+		void ShiftUp(const int anIndex, std::false_type);
+		void ShiftDown(const int anIndex, std::true_type);
+		void ShiftDown(const int anIndex, std::false_type);
+
+		T* myData;
+		int myCount;
+		int myCapacity;
+		Allocator myAllocator;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type myInline[InlineCapacity];
+	};
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline VectorOnStack<T, InlineCapacity, Allocator>::VectorOnStack(const Allocator& anAllocator) : myAllocator(anAllocator)
+	{
+		myData = GetInline();
+		myCount = 0;
+		myCapacity = InlineCapacity;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline VectorOnStack<T, InlineCapacity, Allocator>::VectorOnStack(const std::initializer_list<T>& aInitList) : VectorOnStack()
+	{
+		Reserve(static_cast<int>(aInitList.size()));
+		for (const T& element : aInitList)
+		{
+			Add(element);
+		}
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline VectorOnStack<T, InlineCapacity, Allocator>::VectorOnStack(const VectorOnStack& aVector) : VectorOnStack(aVector.myAllocator)
+	{
+		(*this) = aVector;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline VectorOnStack<T, InlineCapacity, Allocator>::VectorOnStack(VectorOnStack&& aVector) : VectorOnStack(aVector.myAllocator)
+	{
+		(*this) = std::move(aVector);
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline VectorOnStack<T, InlineCapacity, Allocator>::~VectorOnStack()
+	{
+		RemoveAll();
+		if (IsOnHeap())
+		{
+			myAllocator.Free(myData);
+		}
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline VectorOnStack<T, InlineCapacity, Allocator>& VectorOnStack<T, InlineCapacity, Allocator>::operator=(const VectorOnStack& aVector)
+	{
+		if (this != &aVector)
+		{
+			RemoveAll();
+			Reserve(aVector.myCount);
+			for (const T& element : aVector)
+			{
+				new (myData + myCount) T(element);
+				++myCount;
+			}
+		}
+		return (*this);
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline VectorOnStack<T, InlineCapacity, Allocator>& VectorOnStack<T, InlineCapacity, Allocator>::operator=(VectorOnStack&& aVector)
+	{
+		if (this == &aVector)
+		{
+			return (*this);
+		}
+
+		RemoveAll();
+		if (IsOnHeap())
+		{
+			myAllocator.Free(myData);
+			myData = GetInline();
+			myCapacity = InlineCapacity;
+		}
+
+		if (aVector.IsOnHeap())
+		{
+			// Heap memory changes owner, the allocator that handed it out goes with it
+			std::swap(myAllocator, aVector.myAllocator);
+			myData = aVector.myData;
+			myCount = aVector.myCount;
+			myCapacity = aVector.myCapacity;
+			aVector.myData = aVector.GetInline();
+			aVector.myCount = 0;
+			aVector.myCapacity = InlineCapacity;
+		}
+		else
+		{
+			TakeInline(aVector);
+		}
+		return (*this);
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::TakeInline(VectorOnStack& aVector)
+	{
+		Relocate(myData, aVector.myData, aVector.myCount, IsTriviallyCopyable{});
+		myCount = aVector.myCount;
+		aVector.myCount = 0;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline T& VectorOnStack<T, InlineCapacity, Allocator>::operator[](const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < myCount && "Index out of range!");
+		return myData[anIndex];
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline const T& VectorOnStack<T, InlineCapacity, Allocator>::operator[](const int anIndex) const
+	{
+		assert(anIndex >= 0 && anIndex < myCount && "Index out of range!");
+		return myData[anIndex];
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::Add(const T& anObject)
+	{
+		Emplace(anObject);
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::Add(T&& anObject)
+	{
+		Emplace(std::move(anObject));
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	template<class... Arguments>
+	inline T& VectorOnStack<T, InlineCapacity, Allocator>::Emplace(Arguments&&... someArguments)
+	{
+		if (myCount == myCapacity)
+		{
+			// The arguments may refer to one of our elements, so they are used before the elements move
+			T object(std::forward<Arguments>(someArguments)...);
+			Reallocate(myCapacity * 2);
+			new (myData + myCount) T(std::move(object));
+		}
+		else
+		{
+			new (myData + myCount) T(std::forward<Arguments>(someArguments)...);
+		}
+		return myData[myCount++];
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::Insert(const int anIndex, const T& anObject)
+	{
+		assert(anIndex >= 0 && anIndex <= myCount && "Index out of range!");
+		Add(anObject);
+		if (anIndex < myCount - 1)
+		{
+			T object(std::move(myData[myCount - 1]));
+			ShiftUp(anIndex, IsTriviallyCopyable{});
+			myData[anIndex] = std::move(object);
+		}
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline bool VectorOnStack<T, InlineCapacity, Allocator>::RemoveCyclic(const T& anObject)
+	{
+		for (int index = 0; index < myCount; ++index)
+		{
+			if (myData[index] == anObject)
+			{
+				RemoveCyclicAtIndex(index);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::RemoveCyclicAtIndex(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < myCount && "Index out of range!");
+		--myCount;
+		if (anIndex != myCount)
+		{
+			myData[anIndex] = std::move(myData[myCount]);
+		}
+		myData[myCount].~T();
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::RemoveAtIndex(const int anIndex)
+	{
+		assert(anIndex >= 0 && anIndex < myCount && "Index out of range!");
+		ShiftDown(anIndex, IsTriviallyCopyable{});
+		--myCount;
+		myData[myCount].~T();
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::RemoveAll()
+	{
+		for (int index = 0; index < myCount; ++index)
+		{
+			myData[index].~T();
+		}
+		myCount = 0;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline T& VectorOnStack<T, InlineCapacity, Allocator>::GetLast()
+	{
+		assert(myCount > 0 && "Vector is empty!");
+		return myData[myCount - 1];
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline const T& VectorOnStack<T, InlineCapacity, Allocator>::GetLast() const
+	{
+		assert(myCount > 0 && "Vector is empty!");
+		return myData[myCount - 1];
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::Reserve(const int aCapacity)
+	{
+		if (aCapacity > myCapacity)
+		{
+			Reallocate(aCapacity);
+		}
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline int VectorOnStack<T, InlineCapacity, Allocator>::Count() const
+	{
+		return myCount;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline int VectorOnStack<T, InlineCapacity, Allocator>::Capacity() const
+	{
+		return myCapacity;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline bool VectorOnStack<T, InlineCapacity, Allocator>::IsEmpty() const
+	{
+		return myCount == 0;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline bool VectorOnStack<T, InlineCapacity, Allocator>::IsOnHeap() const
+	{
+		// Decided by the pointer rather than the capacity, so the compiler can see that only heap memory is freed
+		return myData != GetInline();
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline T* VectorOnStack<T, InlineCapacity, Allocator>::GetData()
+	{
+		return myData;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline const T* VectorOnStack<T, InlineCapacity, Allocator>::GetData() const
+	{
+		return myData;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline T* VectorOnStack<T, InlineCapacity, Allocator>::begin()
+	{
+		return myData;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline T* VectorOnStack<T, InlineCapacity, Allocator>::end()
+	{
+		return myData + myCount;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline const T* VectorOnStack<T, InlineCapacity, Allocator>::begin() const
+	{
+		return myData;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline const T* VectorOnStack<T, InlineCapacity, Allocator>::end() const
+	{
+		return myData + myCount;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline T* VectorOnStack<T, InlineCapacity, Allocator>::GetInline()
+	{
+		return reinterpret_cast<T*>(myInline);
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline const T* VectorOnStack<T, InlineCapacity, Allocator>::GetInline() const
+	{
+		return reinterpret_cast<const T*>(myInline);
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::Reallocate(const int aCapacity)
+	{
+		T* data = static_cast<T*>(myAllocator.Allocate(sizeof(T) * aCapacity, alignof(T)));
+		Relocate(data, myData, myCount, IsTriviallyCopyable{});
+		if (IsOnHeap())
+		{
+			myAllocator.Free(myData);
+		}
+		myData = data;
+		myCapacity = aCapacity;
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::Relocate(T* aDestination, T* aSource, const int aCount, std::true_type)
+	{
+		if (aCount > 0)
+		{
+			memcpy(aDestination, aSource, sizeof(T) * aCount);
+		}
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::Relocate(T* aDestination, T* aSource, const int aCount, std::false_type)
+	{
+		for (int index = 0; index < aCount; ++index)
+		{
+			new (aDestination + index) T(std::move(aSource[index]));
+			aSource[index].~T();
+		}
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::ShiftUp(const int anIndex, std::true_type)
+	{
+		memmove(myData + anIndex + 1, myData + anIndex, sizeof(T) * (myCount - 1 - anIndex));
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::ShiftUp(const int anIndex, std::false_type)
+	{
+		std::move_backward(myData + anIndex, myData + myCount - 1, myData + myCount);
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::ShiftDown(const int anIndex, std::true_type)
+	{
+		memmove(myData + anIndex, myData + anIndex + 1, sizeof(T) * (myCount - 1 - anIndex));
+	}
+
+	template<class T, int InlineCapacity, class Allocator>
+	inline void VectorOnStack<T, InlineCapacity, Allocator>::ShiftDown(const int anIndex, std::false_type)
+	{
+		std::move(myData + anIndex + 1, myData + myCount, myData + anIndex);
+	}
+}